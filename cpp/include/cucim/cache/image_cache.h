@@ -125,6 +125,13 @@ public:
 
     virtual std::shared_ptr<ImageCacheValue> find(const std::shared_ptr<ImageCacheKey>& key) = 0;
 
+    /**
+     * @brief Return true if `key` is in the cache, without counting a hit or a miss.
+     *
+     * For lookups that don't use the value (e.g., skipping cached pieces when prefetching).
+     */
+    virtual bool contains(const std::shared_ptr<ImageCacheKey>& key) const = 0;
+
 protected:
     CacheType type_ = CacheType::kNoCache;
     cucim::io::DeviceType device_type_ = cucim::io::DeviceType::kCPU;
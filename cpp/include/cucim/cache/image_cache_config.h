@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -40,6 +40,7 @@ constexpr uint32_t kDefaultCacheMutexPoolCapacity = 100003;
 constexpr uint32_t kDefaultCacheListPadding = 10000;
 constexpr uint32_t kDefaultCacheExtraSharedMemorySize = 100;
 constexpr bool kDefaultCacheRecordStat = false;
+constexpr bool kDefaultCacheVirtualPyramid = false;
 // Assume that user uses memory block whose size is least 256 x 256 x 3 bytes.
 constexpr uint32_t calc_default_cache_capacity(uint64_t memory_capacity_in_bytes)
 {
@@ -57,6 +58,9 @@ struct EXPORT_VISIBLE ImageCacheConfig
     uint32_t list_padding = kDefaultCacheListPadding;
     uint32_t extra_shared_memory_size = kDefaultCacheExtraSharedMemorySize;
     bool record_stat = kDefaultCacheRecordStat;
+    /// Synthesize downsampled levels (whose tiles are built on demand and cached) for images with a single level.
+    /// Ignored (with a warning) for the kNoCache type.
+    bool virtual_pyramid = kDefaultCacheVirtualPyramid;
 };
 
 } // namespace cucim::cache
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_CONCURRENT_CANCELLATION_TOKEN_H
+#define CUCIM_CONCURRENT_CANCELLATION_TOKEN_H
+
+#include "cucim/macros/api_header.h"
+
+#include <atomic>
+#include <memory>
+
+namespace cucim::concurrent
+{
+
+/**
+ * @brief Shared flag telling queued tasks to return without doing their work.
+ *
+ * Copies of a token share the same state, so a token captured by a task observes cancel() called on the original.
+ */
+class EXPORT_VISIBLE CancellationToken
+{
+public:
+    CancellationToken();
+
+    void cancel() const;
+    bool is_cancelled() const;
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+} // namespace cucim::concurrent
+
+#endif // CUCIM_CONCURRENT_CANCELLATION_TOKEN_H
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_CONCURRENT_CONCURRENCY_CONFIG_H
+#define CUCIM_CONCURRENT_CONCURRENCY_CONFIG_H
+
+#include "cucim/concurrent/tile_schedule.h"
+#include "cucim/core/framework.h"
+
+#include <cstdint>
+
+namespace cucim::concurrent
+{
+
+constexpr uint32_t kDefaultConcurrencyNumWorkers = 0; // 0: the number of hardware threads
+constexpr uint32_t kDefaultConcurrencyRegionSplitTileCount = 16;
+constexpr std::string_view kDefaultConcurrencyTileScheduleStr = "none";
+constexpr uint32_t kDefaultConcurrencyScheduleWindow = 1;
+constexpr bool kDefaultConcurrencyAdaptivePrefetch = false;
+constexpr uint32_t kDefaultConcurrencyMinPrefetchFactor = 1;
+constexpr uint32_t kDefaultConcurrencyMaxPrefetchFactor = 8;
+constexpr uint32_t kDefaultConcurrencyReadaheadBatches = 4;
+constexpr bool kDefaultConcurrencyNuma = false;
+
+struct EXPORT_VISIBLE ConcurrencyConfig
+{
+    void load_config(const void* json_obj);
+
+    /// The number of threads of the process-wide executor shared by all loaders and reads.
+    uint32_t num_workers = kDefaultConcurrencyNumWorkers;
+    /// A single-region read covering more tiles than this is split into chunks of about this many tiles, which are
+    /// decoded in parallel on the shared executor (0: disabled).
+    uint32_t region_split_tile_count = kDefaultConcurrencyRegionSplitTileCount;
+    /// The order in which the batch data loader loads the unique tiles of a schedule window.
+    TileSchedule tile_schedule = lookup_tile_schedule(kDefaultConcurrencyTileScheduleStr);
+    /// The number of batches whose tiles are planned (deduplicated and ordered) together. Bounded by the number of
+    /// prefetched batches; the first batch of a window is delivered when all tiles of the window are loaded.
+    uint32_t schedule_window = kDefaultConcurrencyScheduleWindow;
+    /// If true, the batch data loader adjusts the number of batches prefetched ahead of the consumer (starting from
+    /// `prefetch_factor`) between `min_prefetch_factor` and `max_prefetch_factor`, based on how long `next_data()`
+    /// waits for batches.
+    bool adaptive_prefetch = kDefaultConcurrencyAdaptivePrefetch;
+    uint32_t min_prefetch_factor = kDefaultConcurrencyMinPrefetchFactor;
+    uint32_t max_prefetch_factor = kDefaultConcurrencyMaxPrefetchFactor;
+    /// The number of batches, past the batches being loaded, whose image pieces the batch data loader hints to the
+    /// file's byte source as soon as they are known: the kernel reads them ahead into the page cache (local files) or
+    /// they are fetched asynchronously (remote files). 0: disabled.
+    uint32_t readahead_batches = kDefaultConcurrencyReadaheadBatches;
+    /// If true (and the system has multiple NUMA nodes), executor threads are pinned to NUMA nodes (spread evenly)
+    /// and the buffer pool keeps CPU buffers per node, placed on the node of the allocating thread.
+    bool numa = kDefaultConcurrencyNuma;
+};
+
+} // namespace cucim::concurrent
+
+#endif // CUCIM_CONCURRENT_CONCURRENCY_CONFIG_H
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -8,16 +8,57 @@
 
 #include "cucim/macros/api_header.h"
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
+#include <stdexcept>
 
 namespace cucim::concurrent
 {
 
+/**
+ * @brief Priority of a task. Queued tasks of a higher priority are started first (FIFO within a priority).
+ */
+enum class TaskPriority : uint8_t
+{
+    kHigh = 0, /// interactive reads (e.g., `read_region()` of a single region)
+    kNormal = 1,
+    kLow = 2, /// background work (e.g., batch loader prefetch)
+};
+
+using TaskDeadline = std::chrono::steady_clock::time_point;
+constexpr TaskDeadline kNoTaskDeadline = TaskDeadline::max();
+
+/**
+ * @brief Error of the future of a task that was dropped because its deadline passed before it started.
+ */
+class EXPORT_VISIBLE TaskExpiredError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief A handle to submit tasks into the process-wide executor.
+ *
+ * The executor is created lazily on first use and shared by all thread pools (so creating a thread pool doesn't
+ * create threads). Its number of threads is configured by `concurrency.num_workers` (0: the number of hardware
+ * threads).
+ * wait() and the destructor wait only for the tasks enqueued through this thread pool.
+ * Tasks are queued by priority: an interactive read doesn't wait behind the queued tasks of batch loaders. A task
+ * with a deadline is dropped (its future throws TaskExpiredError) if it can't start before the deadline.
+ */
 class EXPORT_VISIBLE ThreadPool
 {
 public:
+    /**
+     * @brief Create a thread pool.
+     *
+     * @param num_workers If zero, the thread pool is disabled (operator bool() returns false) and tasks should be
+     *                    run by the caller.
+     */
     explicit ThreadPool(int32_t num_workers);
     ThreadPool(const ThreadPool&) = delete;
 
@@ -27,12 +68,44 @@ public:
 
     ~ThreadPool();
 
-    std::future<void> enqueue(std::function<void()> task);
+    std::future<void> enqueue(std::function<void()> task,
+                              TaskPriority priority = TaskPriority::kNormal,
+                              TaskDeadline deadline = kNoTaskDeadline);
     void wait();
 
+    /**
+     * @brief Run a task on the process-wide executor without tracking it in a thread pool.
+     *
+     * The returned future doesn't block on destruction.
+     */
+    static std::future<void> submit(std::function<void()> task,
+                                    TaskPriority priority = TaskPriority::kNormal,
+                                    TaskDeadline deadline = kNoTaskDeadline);
+
+    /**
+     * @brief Return the number of threads of the process-wide executor (creating the executor if needed).
+     */
+    static size_t shared_worker_count();
+    /**
+     * @brief Return true if the calling thread is a thread of the process-wide executor.
+     *
+     * A task running on the executor should not block waiting for other tasks of the executor.
+     */
+    static bool is_worker_thread();
+    /**
+     * @brief Return true if NUMA mode (`concurrency.numa`) is enabled and the system has multiple NUMA nodes.
+     *
+     * In NUMA mode, each executor thread is pinned to a NUMA node (threads are spread evenly over the nodes).
+     */
+    static bool is_numa_enabled();
+
 private:
     struct Executor;
-    std::unique_ptr<Executor> executor_;
+    struct TaskCounter;
+    static std::shared_ptr<Executor> shared_executor();
+
+    std::shared_ptr<Executor> executor_;
+    std::shared_ptr<TaskCounter> pending_tasks_;
     size_t num_workers_;
 };
 
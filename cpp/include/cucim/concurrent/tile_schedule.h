@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_CONCURRENT_TILE_SCHEDULE_H
+#define CUCIM_CONCURRENT_TILE_SCHEDULE_H
+
+#include "cucim/macros/api_header.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace cucim::concurrent
+{
+
+/**
+ * @brief Order in which the tiles planned for a window of batches are loaded by the batch data loader.
+ *
+ * Batches are always delivered in the requested order; only the order of tile loading inside a schedule window
+ * changes.
+ */
+constexpr std::size_t kTileScheduleCount = 3;
+enum class TileSchedule : uint8_t
+{
+    kNone, // order of the patches
+    kHilbert, // Hilbert curve over tile coordinates (tile cache locality)
+    kOffset // file offset of tiles (sequential I/O)
+};
+
+// Using constexpr map (https://www.youtube.com/watch?v=INn3xa4pMfg)
+struct TileScheduleMap
+{
+    std::array<std::pair<std::string_view, TileSchedule>, kTileScheduleCount> data;
+
+    [[nodiscard]] constexpr TileSchedule at(const std::string_view& key) const;
+};
+
+EXPORT_VISIBLE TileSchedule lookup_tile_schedule(const std::string_view sv);
+
+struct TileScheduleStrMap
+{
+    std::array<std::pair<TileSchedule, std::string_view>, kTileScheduleCount> data;
+
+    [[nodiscard]] constexpr std::string_view at(const TileSchedule& key) const;
+};
+
+EXPORT_VISIBLE std::string_view lookup_tile_schedule_str(const TileSchedule schedule);
+
+/**
+ * @brief Return the distance of tile (x, y) along a Hilbert curve covering a 65536 x 65536 tile grid.
+ */
+EXPORT_VISIBLE uint64_t hilbert_curve_index(uint32_t x, uint32_t y);
+
+} // namespace cucim::concurrent
+
+#endif // CUCIM_CONCURRENT_TILE_SCHEDULE_H
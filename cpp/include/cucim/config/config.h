@@ -9,6 +9,8 @@
 #include "cucim/macros/api_header.h"
 #include "cucim/cache/cache_type.h"
 #include "cucim/cache/image_cache_config.h"
+#include "cucim/concurrent/concurrency_config.h"
+#include "cucim/memory/buffer_pool_config.h"
 #include "cucim/plugin/plugin_config.h"
 #include "cucim/profiler/profiler_config.h"
 
@@ -28,7 +30,9 @@ class EXPORT_VISIBLE Config
 public:
     Config();
 
+    cucim::memory::BufferPoolConfig& buffer_pool();
     cucim::cache::ImageCacheConfig& cache();
+    cucim::concurrent::ConcurrencyConfig& concurrency();
     cucim::plugin::PluginConfig& plugin();
     cucim::profiler::ProfilerConfig& profiler();
 
@@ -46,7 +50,9 @@ private:
 
     std::string source_path_;
 
+    cucim::memory::BufferPoolConfig buffer_pool_;
     cucim::cache::ImageCacheConfig cache_;
+    cucim::concurrent::ConcurrencyConfig concurrency_;
     cucim::plugin::PluginConfig plugin_;
     cucim::profiler::ProfilerConfig profiler_;
 };
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -8,10 +8,12 @@
 
 #include "cucim/core/framework.h"
 #include "cucim/cache/image_cache_manager.h"
+#include "cucim/concurrent/threadpool.h"
 #include "cucim/config/config.h"
 #include "cucim/filesystem/file_path.h"
 #include "cucim/io/device.h"
 #include "cucim/io/format/image_format.h"
+#include "cucim/loader/grid_sampler.h"
 #include "cucim/loader/thread_batch_data_loader.h"
 #include "cucim/memory/dlpack.h"
 #include "cucim/plugin/image_format.h"
@@ -19,6 +21,8 @@
 
 #include <array>
 #include <cstddef> // for std::ptrdiff_t
+#include <functional>
+#include <future>
 #include <iterator> // for std::forward_iterator_tag
 #include <memory>
 #include <mutex>
@@ -41,6 +45,10 @@ namespace cucim
 class CuImage;
 template <typename DataType>
 class CuImageIterator;
+namespace loader
+{
+class DatasetLoader;
+} // namespace loader
 
 using DetectedFormat = std::pair<std::string, std::vector<std::string>>;
 using Metadata = std::string;
@@ -177,12 +185,112 @@ public:
                         const DimIndices& region_dim_indices = {},
                         const io::Device& device = "cpu",
                         DLTensor* buf = nullptr,
-                        const std::string& shm_name = std::string{}) const;
+                        const std::string& shm_name = std::string{},
+                        const std::string& dims = std::string{}) const;
+
+    /**
+     * @brief Read a region at an arbitrary downsample (relative to level 0).
+     *
+     * `location` is level-0 based and `size` is the size of the output at the downsample. The finest level needed
+     * (the coarsest level whose downsample is not greater than `downsample`) is read in bands of rows, each band being
+     * area-averaged into the output as it is read, so the larger region at that level is never in memory at once.
+     * If a level matches the downsample, the region is read from it as read_region() does.
+     * Only 8-bit images in the 'YXC' order are supported.
+     */
+    CuImage read_region_scaled(std::vector<int64_t>&& location,
+                               std::vector<int64_t>&& size,
+                               float downsample,
+                               const DimIndices& region_dim_indices = {},
+                               const io::Device& device = "cpu") const;
+
+    /**
+     * @brief Return the downsample (relative to level 0) of a resolution in micrometers per pixel.
+     *
+     * Throws std::runtime_error if the physical pixel size of the image is not known.
+     */
+    float mpp_to_downsample(float mpp) const;
+
+    /**
+     * @brief Read a region asynchronously on the process-wide executor.
+     *
+     * Same as read_region() for a single region without a batch loader, so many requests can be in flight without a
+     * thread per request. Only CPU output is supported. `on_ready` (if given) is called on the executor thread once
+     * the returned future is ready.
+     * The read is queued with `priority`. If it can't start before `deadline`, it is dropped and the future throws
+     * concurrent::TaskExpiredError.
+     * The image must be owned by a std::shared_ptr (std::invalid_argument is thrown otherwise); a reference to it is
+     * kept until the read completes.
+     */
+    std::future<CuImage> read_region_async(std::vector<int64_t>&& location,
+                                           std::vector<int64_t>&& size,
+                                           uint16_t level = 0,
+                                           const DimIndices& region_dim_indices = {},
+                                           const io::Device& device = "cpu",
+                                           const std::string& dims = std::string{},
+                                           std::function<void()> on_ready = nullptr,
+                                           concurrent::TaskPriority priority = concurrent::TaskPriority::kHigh,
+                                           concurrent::TaskDeadline deadline = concurrent::kNoTaskDeadline) const;
+
+    /**
+     * @brief Read the patches generated by the grid sampler.
+     *
+     * Same as read_region() with the sampler's locations, size and level, except that a batch loader is always used.
+     * The sampler's locations are generated here, so no location list needs to be built by the caller.
+     */
+    CuImage read_grid(const loader::GridSampler& sampler,
+                      uint32_t num_workers = 1,
+                      uint32_t batch_size = 1,
+                      bool drop_last = false,
+                      uint32_t prefetch_factor = 2,
+                      bool shuffle = false,
+                      uint64_t seed = 0,
+                      const io::Device& device = "cpu") const;
 
     std::set<std::string> associated_images() const;
     CuImage associated_image(const std::string& name, const io::Device& device = "cpu") const;
 
-    void save(std::string file_path) const;
+    /**
+     * @brief Write the image (level 0 or the image data in memory) to a single image file.
+     *
+     * The format is `format` ('ppm', 'png', 'jpeg' or 'tiff') or, if it is empty, the format of the extension of
+     * `file_path` (PPM for unknown extensions). PPM (PGM for grayscale images) files are mapped and filled at once. The
+     * other formats are written by the image format plugin that writes them (cuslide encodes PNG and JPEG files in
+     * strips, and TIFF files (deflate-compressed, single level) in tiles, in parallel). `quality` (1-100) is used for
+     * JPEG files. Only 8-bit images in the 'YXC' or 'YX' order are supported.
+     */
+    void save(std::string file_path, const std::string& format = "", int32_t quality = 90) const;
+
+    /**
+     * @brief Write the image (level 0 or the image data in memory) as a tiled, pyramidal TIFF file.
+     *
+     * The image is streamed to the writer of the image format plugin that accepts `file_path` (cuslide for '.tif'
+     * files), which encodes tiles of `tile_size` pixels with `compression` ('jpeg', 'deflate', 'zstd' or 'raw') and
+     * builds `level_count` levels (0: until a level fits in a tile) by 2x2 averaging.
+     * If `copy_tiles` is true and the image is a file of the writer's format, the writer may copy compressed tiles of
+     * the file instead of decoding and encoding them again (cuslide copies the JPEG tiles of the upper levels as they
+     * are, and computes only the levels below them).
+     * Only 8-bit images in the 'YXC' or 'YX' order are supported.
+     */
+    void save_pyramid(const std::string& file_path,
+                      uint32_t tile_size = 256,
+                      const std::string& compression = "jpeg",
+                      int32_t quality = 90,
+                      uint16_t level_count = 0,
+                      bool copy_tiles = true) const;
+
+    /**
+     * @brief Write the levels of the image as an OME-Zarr (OME-NGFF 0.4 multiscale image in a Zarr v2 directory).
+     *
+     * Each level of the file (or the image data in memory) becomes an array of the multiscale image, in the 'cyx' (or
+     * 'yx') order. Chunks are the tiles of each level, or `chunk_size` x `chunk_size` pixels if `chunk_size` is given
+     * or the level is not tiled (256 by default), and are compressed with `compression` ('zstd' or 'raw').
+     * `level_count` limits the number of levels written (0: all levels). `dir_path` must end with '.zarr' and must not
+     * exist. Only 8-bit images in the 'YXC' or 'YX' order are supported.
+     */
+    void save_zarr(const std::string& dir_path,
+                   const std::string& compression = "zstd",
+                   uint16_t level_count = 0,
+                   uint32_t chunk_size = 0) const;
 
     void close();
 
@@ -195,6 +303,7 @@ public:
 
     friend class CuImageIterator<CuImage>;
     friend class CuImageIterator<const CuImage>;
+    friend class loader::DatasetLoader;
 
     iterator begin();
     iterator end();
@@ -208,9 +317,20 @@ private:
 
     explicit CuImage();
 
-    void ensure_init();
+    void ensure_init() const;
     bool crop_image(const io::format::ImageReaderRegionRequestDesc& request,
                     io::format::ImageDataDesc& out_image_data) const;
+    // Create the image of a region read by read_region() (taking the ownership of `region_data`).
+    CuImage make_region_image(io::format::ImageDataDesc* region_data,
+                              const int64_t* size,
+                              uint32_t size_ndim,
+                              const std::string& region_dims,
+                              uint32_t batch_size,
+                              int64_t channel_index,
+                              float downsample) const;
+    // Read a region ('YXC') of `size` (width, height) at the level into `buf` (CPU memory of `buf`'s shape and data
+    // type) through the image format's reader, so that the tile cache of the file applies. Return false on failure.
+    bool read_region_to(const int64_t* location, const int64_t* size, uint16_t level, DLTensor& buf) const;
 
 
     static Framework* framework_;
@@ -253,6 +373,19 @@ public:
     int64_t index(); /// batch index
     uint64_t size() const; /// number of batches
 
+    /**
+     * @brief Stop loading the remaining batches without waiting for running tasks.
+     *
+     * The iterator then points to the end.
+     */
+    void cancel();
+    /**
+     * @brief Stop loading the remaining batches, wait for running tasks and release prefetched batch buffers.
+     *
+     * The iterator then points to the end.
+     */
+    void close();
+
 private:
     void increase_index_();
 
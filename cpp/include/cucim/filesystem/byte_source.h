@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_BYTE_SOURCE_H
+#define CUCIM_BYTE_SOURCE_H
+
+#include "cucim/macros/defines.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cucim/filesystem/file_path.h"
+
+namespace cucim::filesystem
+{
+
+/// Default size of a block of CachedByteSource (bytes).
+constexpr uint64_t kDefaultByteSourceBlockSize = 256 * 1024;
+/// Default number of blocks kept by CachedByteSource (64MiB with the default block size).
+constexpr uint64_t kDefaultByteSourceCacheBlocks = 256;
+/// Default number of blocks read ahead by CachedByteSource when blocks are read sequentially.
+constexpr uint32_t kDefaultByteSourceReadaheadBlocks = 8;
+/// Maximal number of consecutive blocks that CachedByteSource fetches with one read of the underlying source.
+constexpr uint32_t kByteSourceMaxBlocksPerFetch = 16;
+
+struct ByteRange
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+/**
+ * @brief Random-access source of the bytes of a file (a local file or a remote object).
+ *
+ * Methods are thread-safe.
+ */
+class EXPORT_VISIBLE ByteSource
+{
+public:
+    virtual ~ByteSource() = default;
+
+    /**
+     * @brief Read up to `count` bytes at `offset`.
+     *
+     * Returns the number of bytes read, which is less than `count` only at the end of the source.
+     * Throws std::runtime_error if the bytes cannot be read.
+     */
+    virtual size_t read(void* buf, size_t count, uint64_t offset) = 0;
+
+    /// Return the size of the source (bytes).
+    virtual uint64_t size() const = 0;
+
+    /**
+     * @brief Return a value that identifies the version of the content (e.g., a hash of the entity tag of a remote
+     * object), or 0 if unknown.
+     */
+    virtual uint64_t version() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief Hint that the given byte ranges will be read soon.
+     *
+     * The ranges may be fetched asynchronously. The default implementation does nothing.
+     */
+    virtual void prefetch(const std::vector<ByteRange>& ranges)
+    {
+        (void)ranges;
+    }
+};
+
+/**
+ * @brief Byte source of a local file descriptor (which is not owned).
+ *
+ * prefetch() asks the kernel to read the ranges ahead into the page cache (`posix_fadvise(POSIX_FADV_WILLNEED)`).
+ */
+class EXPORT_VISIBLE LocalByteSource : public ByteSource
+{
+public:
+    explicit LocalByteSource(int fd);
+
+    size_t read(void* buf, size_t count, uint64_t offset) override;
+    uint64_t size() const override;
+    void prefetch(const std::vector<ByteRange>& ranges) override;
+
+private:
+    int fd_ = -1;
+    uint64_t size_ = 0;
+};
+
+/**
+ * @brief Byte source of a remote object served over HTTP (`http://host[:port]/path[?query]`), read with range
+ * requests (e.g., an object of an S3-compatible object store, with a presigned URL or public access).
+ *
+ * Connections are kept alive and reused. If the entity tag of the object changes while it is read, reads throw.
+ */
+class EXPORT_VISIBLE HttpByteSource : public ByteSource
+{
+public:
+    /// Throws std::invalid_argument for an unsupported URL and std::runtime_error if the object cannot be accessed.
+    explicit HttpByteSource(const std::string& url);
+    ~HttpByteSource() override;
+
+    size_t read(void* buf, size_t count, uint64_t offset) override;
+    uint64_t size() const override;
+    uint64_t version() const override;
+
+private:
+    struct Response;
+
+    int connect() const;
+    /// Send a range request and read the headers. `connection` is set to the socket that has the body to read.
+    Response request(uint64_t first, uint64_t last, int& connection, std::vector<uint8_t>& body_prefix);
+    void release_connection(int connection, bool keep_alive);
+
+    std::string url_;
+    std::string host_;
+    std::string port_;
+    std::string target_;
+    uint64_t size_ = 0;
+    std::string etag_;
+    uint64_t version_ = 0;
+
+    std::mutex connection_mutex_;
+    std::vector<int> idle_connections_;
+};
+
+/**
+ * @brief Byte source that caches the blocks of another byte source.
+ *
+ * - Missing blocks of a read are fetched in parallel on the process-wide executor (runs of consecutive blocks are
+ *   fetched with one read of the underlying source).
+ * - A block being fetched is not fetched again: readers of the block wait for the fetch.
+ * - When blocks are read sequentially, the next blocks are fetched ahead asynchronously.
+ * - prefetch() fetches the blocks of the given ranges asynchronously.
+ *
+ * Least recently used blocks are evicted when more than `capacity_blocks` blocks are cached.
+ */
+class EXPORT_VISIBLE CachedByteSource : public ByteSource
+{
+public:
+    explicit CachedByteSource(std::shared_ptr<ByteSource> source,
+                              uint64_t block_size = kDefaultByteSourceBlockSize,
+                              uint64_t capacity_blocks = kDefaultByteSourceCacheBlocks,
+                              uint32_t readahead_blocks = kDefaultByteSourceReadaheadBlocks);
+
+    size_t read(void* buf, size_t count, uint64_t offset) override;
+    uint64_t size() const override;
+    uint64_t version() const override;
+    void prefetch(const std::vector<ByteRange>& ranges) override;
+
+private:
+    struct Fetch;
+    struct Block
+    {
+        std::shared_ptr<Fetch> fetch;
+        std::list<uint64_t>::iterator lru_pos;
+    };
+
+    /**
+     * @brief Return the fetch of each block in [first_block, last_block], creating fetches (not started) for missing
+     * blocks. New fetches are appended to `new_fetches`.
+     */
+    std::vector<std::shared_ptr<Fetch>> acquire_blocks(uint64_t first_block,
+                                                       uint64_t last_block,
+                                                       std::vector<std::shared_ptr<Fetch>>& new_fetches);
+    void forget_fetch(const std::shared_ptr<Fetch>& fetch);
+    void start_fetches(const std::vector<std::shared_ptr<Fetch>>& fetches);
+
+    std::shared_ptr<ByteSource> source_;
+    uint64_t block_size_ = 0;
+    uint64_t capacity_blocks_ = 0;
+    uint32_t readahead_blocks_ = 0;
+    uint64_t block_count_ = 0;
+
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, Block> blocks_;
+    std::list<uint64_t> lru_; /// block indices, most recently used first
+    std::atomic<uint64_t> next_sequential_block_{ 0 };
+};
+
+/// Return true if the path is a URL of a remote object (`http://...`).
+EXPORT_VISIBLE bool is_remote_path(const Path& path);
+
+/**
+ * @brief Open a cached byte source for a remote object (see is_remote_path()).
+ *
+ * Throws std::invalid_argument for an unsupported URL and std::runtime_error if the object cannot be accessed.
+ */
+EXPORT_VISIBLE std::shared_ptr<ByteSource> open_remote_byte_source(const Path& url);
+
+} // namespace cucim::filesystem
+
+#endif // CUCIM_BYTE_SOURCE_H
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 #ifndef CUCIM_CUFILE_DRIVER_H
@@ -7,6 +7,7 @@
 
 #include "file_handle.h"
 #include "file_path.h"
+#include "cucim/memory/buffer_pool_config.h"
 #include <memory>
 #include <mutex>
 
@@ -28,6 +29,16 @@ class CuFileDriver;
  */
 bool EXPORT_VISIBLE is_gds_available();
 
+/**
+ * Set the size and the number of idle bounce buffers (`bounce_buffer_size` and `bounce_buffer_count` of `config`)
+ * that stage unaligned O_DIRECT reads and transfers from/to GPU memory.
+ *
+ * CuImage passes its configuration when it is initialized. Buffers acquired afterwards have the new size.
+ *
+ * @param config Buffer pool configuration.
+ */
+void EXPORT_VISIBLE set_bounce_buffer_config(const cucim::memory::BufferPoolConfig& config);
+
 /**
  * Open file with specific flags and mode.
  *
@@ -117,17 +128,12 @@ public:
     {
         return max_device_cache_size_;
     }
-    inline uint64_t max_host_cache_size() const
-    {
-        return max_host_cache_size_;
-    }
 
     ~CuFileDriverInitializer();
 
 private:
     bool is_available_ = false;
     uint64_t max_device_cache_size_ = 0;
-    uint64_t max_host_cache_size_ = 0;
 };
 
 class CuFileDriverCache
@@ -136,24 +142,17 @@ public:
     CuFileDriverCache();
 
     void* device_cache();
-    void* host_cache();
 
     inline bool is_device_cache_available()
     {
         return !!device_cache_;
     }
-    inline bool is_host_cache_available()
-    {
-        return !!host_cache_;
-    }
 
     ~CuFileDriverCache();
 
 private:
     void* device_cache_ = nullptr;
     void* device_cache_aligned_ = nullptr;
-    void* host_cache_ = nullptr;
-    void* host_cache_aligned_ = nullptr;
 };
 
 class EXPORT_VISIBLE CuFileDriver : public std::enable_shared_from_this<CuFileDriver>
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -19,6 +19,11 @@
 
 #include "cucim/memory/memory_manager.h"
 
+namespace cucim::filesystem
+{
+class ByteSource;
+} // namespace cucim::filesystem
+
 typedef void* CUfileHandle_t;
 typedef void* CuCIMFileHandle_share;
 typedef void* CuCIMFileHandle_ptr;
@@ -87,6 +92,8 @@ struct EXPORT_VISIBLE CuCIMFileHandle : public std::enable_shared_from_this<CuCI
     uint64_t ino = 0;
     int64_t mtime = 0;
     bool own_fd = false; /// whether if the file descriptor is created internally by the driver
+    /// source of the bytes of the file (a remote file has no file descriptor (fd: -1) and is read only through it)
+    std::shared_ptr<cucim::filesystem::ByteSource> source;
     CuCIMFileHandleDeleter deleter = nullptr;
 };
 #else
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2025, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -209,11 +209,15 @@ struct ImageReaderRegionRequestDesc
     uint32_t prefetch_factor = 2;
     bool shuffle = false;
     uint64_t seed = 0;
-    DimIndicesDesc region_dim_indices{};
+    /// Index to read for each dimension (-1: whole range). E.g., indices['C' - 'A'] selects a single channel.
+    DimIndicesDesc region_dim_indices{ { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 } };
     char* associated_image_name = nullptr;
     char* device = nullptr;
     DLTensor* buf = nullptr;
     char* shm_name = nullptr;
+    /// Dimension order of the output image ("YXC" if nullptr). "CYX" returns channel-first (planar) data.
+    char* dims = nullptr;
 };
 
 struct ImageReaderDesc
@@ -233,18 +237,57 @@ struct ImageReaderDesc
                           ImageMetadataDesc* out_metadata);
 };
 
+struct ImageWriterRequestDesc
+{
+    char* file_path = nullptr;
+    int64_t width = 0;
+    int64_t height = 0;
+    uint32_t samples_per_pixel = 3; /// Number of interleaved 8-bit samples of a pixel
+    /**
+     * Reads `row_count` rows from row `row` of a level of the source image into `buf` (pixels of the whole level width
+     * per row, interleaved).
+     *
+     * Rows are requested in order so the source can be streamed (it doesn't need to fit in memory). `level` is always 0
+     * unless `source_handle` is given.
+     */
+    bool(CUCIM_ABI* read_rows)(void* context, uint16_t level, int64_t row, int64_t row_count, uint8_t* buf) = nullptr;
+    void* context = nullptr; /// Passed to `read_rows`
+    /**
+     * File handle of the source image if it was opened by the same plugin (nullptr otherwise).
+     *
+     * The writer may copy the compressed tiles of the source levels instead of encoding them again.
+     */
+    CuCIMFileHandle_ptr source_handle = nullptr;
+    /**
+     * Levels of the source image, for writers that keep the pyramid of the source (0: only level 0 is described by
+     * `width` and `height`).
+     */
+    uint16_t source_level_count = 0;
+    const int64_t* source_level_dimensions = nullptr; /// (width, height) of each source level
+    const float* source_level_downsamples = nullptr; /// Downsample of each source level
+    const uint32_t* source_level_tile_sizes = nullptr; /// (tile width, tile height) of each source level (0: not tiled)
+    uint32_t tile_width = 256;
+    uint32_t tile_height = 256;
+    uint16_t level_count = 0; /// Number of levels to write (0: add levels until a level fits in a tile)
+    char* compression = nullptr; /// "jpeg" (default for TIFF), "deflate", "zstd" or "raw" ("png"/"jpeg" for files)
+    int32_t quality = 90; /// JPEG quality (1-100)
+    float spacing[2] = { 0.0f, 0.0f }; /// Pixel spacing (x, y) of the source image in micrometers (0: unknown)
+};
+
 struct ImageWriterDesc
 {
     /**
+     * Writes an image to `request->file_path`.
      *
-     * @param handle
-     * @param metadata
-     * @param image_data
-     * @return
+     * nullptr if the format cannot be written.
+     *
+     * Errors are reported as exceptions: std::invalid_argument for a request the format doesn't support (e.g., its
+     * compression or number of samples) and std::runtime_error for I/O errors, so that the caller gets the reason.
+     *
+     * @param request
+     * @return true if it succeeds (false if it failed without a reason to report)
      */
-    bool(CUCIM_ABI* write)(const CuCIMFileHandle_ptr handle,
-                           const ImageMetadataDesc* metadata,
-                           const ImageDataDesc* image_data);
+    bool(CUCIM_ABI* write)(const ImageWriterRequestDesc* request);
 };
 
 struct ImageFormatDesc
@@ -260,7 +303,7 @@ struct ImageFormatDesc
 
 struct IImageFormat
 {
-    CUCIM_PLUGIN_INTERFACE("cucim::io::IImageFormat", 0, 1)
+    CUCIM_PLUGIN_INTERFACE("cucim::io::IImageFormat", 0, 2)
     ImageFormatDesc* formats;
     size_t format_count;
 };
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_LOADER_DATASET_LOADER_H
+#define CUCIM_LOADER_DATASET_LOADER_H
+
+#include "cucim/macros/api_header.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cucim/io/device.h"
+
+namespace cucim
+{
+class CuImage;
+} // namespace cucim
+
+namespace cucim::loader
+{
+
+constexpr uint32_t kDefaultDatasetMaxOpenFiles = 64;
+
+/**
+ * @brief A patch of a dataset: the top-left location (at the level) of a region in a file.
+ */
+struct EXPORT_VISIBLE DatasetSample
+{
+    uint32_t file_index = 0; /// index of the file in DatasetLoader::paths()
+    uint16_t level = 0;
+    int64_t x = 0;
+    int64_t y = 0;
+};
+
+/**
+ * @brief Load batches of same-sized patches from many image files.
+ *
+ * Files are opened on demand and at most `max_open_files` of them are kept open (least recently used ones are
+ * closed first). Patches are read by the process-wide executor and share the tile cache, so patches of different
+ * files can be mixed in a batch without extra cost.
+ */
+class EXPORT_VISIBLE DatasetLoader
+{
+public:
+    explicit DatasetLoader(std::vector<std::string> paths, uint32_t max_open_files = kDefaultDatasetMaxOpenFiles);
+    DatasetLoader(const DatasetLoader&) = delete;
+    DatasetLoader& operator=(const DatasetLoader&) = delete;
+    ~DatasetLoader();
+
+    const std::vector<std::string>& paths() const;
+    uint32_t max_open_files() const;
+    /**
+     * @brief Return the number of files currently kept open.
+     */
+    size_t open_file_count() const;
+
+    /**
+     * @brief Read patches of `size` (width, height) at the sample locations.
+     *
+     * Every patch must have the same number of channels and data type (those of the file of the first sample). Patches
+     * are decoded by the reader of their file (through the image cache) directly into the batch buffer.
+     *
+     * @return An image whose iterator (begin()/end()) yields batches of `batch_size` patches ('NYXC', or 'YXC' if
+     *         `batch_size` is 1). Its container holds the current batch.
+     */
+    std::shared_ptr<CuImage> read(std::vector<DatasetSample> samples,
+                                  const std::vector<int64_t>& size,
+                                  uint32_t batch_size = 1,
+                                  uint32_t num_workers = 1,
+                                  bool drop_last = false,
+                                  uint32_t prefetch_factor = 2,
+                                  bool shuffle = false,
+                                  uint64_t seed = 0,
+                                  const io::Device& device = "cpu") const;
+
+private:
+    class FileCache;
+
+    // Shared with the loaders of images returned by read() so that they can outlive this object.
+    std::shared_ptr<FileCache> files_;
+};
+
+} // namespace cucim::loader
+
+#endif // CUCIM_LOADER_DATASET_LOADER_H
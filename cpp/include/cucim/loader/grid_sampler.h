@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_LOADER_GRID_SAMPLER_H
+#define CUCIM_LOADER_GRID_SAMPLER_H
+
+#include "cucim/macros/api_header.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cucim
+{
+class CuImage;
+} // namespace cucim
+
+namespace cucim::loader
+{
+
+constexpr float kDefaultMinTissueFraction = 0.5f;
+
+/**
+ * @brief Return the smallest level-0 coordinate (if not negative) that CuImage::read_region() maps to `value` at a
+ * level of the downsample.
+ */
+EXPORT_VISIBLE int64_t level_to_base(int64_t value, float downsample);
+
+/**
+ * @brief A binary mask of the tissue area of a whole image.
+ *
+ * The mask covers the whole image (level 0) at a low resolution; any nonzero value marks tissue.
+ */
+class EXPORT_VISIBLE TissueMask
+{
+public:
+    TissueMask(std::vector<uint8_t> data, uint32_t width, uint32_t height);
+
+    /**
+     * @brief Compute the tissue mask of the image from its lowest-resolution level.
+     *
+     * A pixel is tissue if its saturation (of HSV) is above the Otsu threshold of the saturation histogram, which
+     * separates stained tissue from the (white or gray) glass background.
+     */
+    static std::shared_ptr<TissueMask> from_image(const CuImage& image);
+
+    uint32_t width() const;
+    uint32_t height() const;
+    const std::vector<uint8_t>& data() const;
+
+    /**
+     * @brief Return the fraction of tissue pixels in a rectangle given in normalized ([0, 1]) image coordinates.
+     */
+    double tissue_fraction(double left, double top, double right, double bottom) const;
+
+private:
+    std::vector<uint8_t> data_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    // Summed-area table of the tissue pixels ((height_ + 1) x (width_ + 1)).
+    std::vector<uint32_t> integral_;
+};
+
+/**
+ * @brief Generate the locations of patches on a regular grid over a level of an image.
+ *
+ * Patches are placed every `stride` pixels (overlapping if stride < size) from the top-left corner of the level,
+ * covering the whole level (patches on the right/bottom border may go past the edge). If a tissue mask is given,
+ * only patches whose tissue fraction is at least `min_tissue_fraction` are kept.
+ */
+class EXPORT_VISIBLE GridSampler
+{
+public:
+    GridSampler(const CuImage& image,
+                std::vector<int64_t> size,
+                uint16_t level = 0,
+                std::vector<int64_t> stride = {},
+                std::shared_ptr<const TissueMask> tissue_mask = nullptr,
+                float min_tissue_fraction = kDefaultMinTissueFraction);
+
+    const std::vector<int64_t>& size() const;
+    uint16_t level() const;
+    const std::vector<int64_t>& stride() const;
+    const std::shared_ptr<const TissueMask>& tissue_mask() const;
+    float min_tissue_fraction() const;
+
+    /**
+     * @brief Return the number of grid positions (before filtering by the tissue mask).
+     */
+    uint64_t grid_count() const;
+
+    /**
+     * @brief Return the locations of the kept patches in row-major grid order.
+     *
+     * Locations are (x, y) pairs at level 0 (as expected by CuImage::read_region()) which map exactly to the grid
+     * positions at the level.
+     */
+    std::vector<int64_t> locations() const;
+
+private:
+    std::vector<int64_t> size_;
+    uint16_t level_ = 0;
+    std::vector<int64_t> stride_;
+    std::shared_ptr<const TissueMask> tissue_mask_;
+    float min_tissue_fraction_ = kDefaultMinTissueFraction;
+    std::vector<int64_t> level_dimension_;
+    std::vector<int64_t> base_dimension_;
+    float level_downsample_ = 1.0f;
+};
+
+} // namespace cucim::loader
+
+#endif // CUCIM_LOADER_GRID_SAMPLER_H
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -8,12 +8,16 @@
 
 #include "cucim/macros/api_header.h"
 
+#include <chrono>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "cucim/cache/image_cache.h"
+#include "cucim/concurrent/cancellation_token.h"
 #include "cucim/concurrent/threadpool.h"
 #include "cucim/io/device.h"
 #include "cucim/loader/batch_data_processor.h"
@@ -22,10 +26,34 @@
 namespace cucim::loader
 {
 
+/**
+ * @brief Statistics of a batch data loader.
+ */
+struct LoaderStats
+{
+    /// The current number of batches loaded ahead of the batch being consumed.
+    uint32_t prefetch_factor = 0;
+    /// The largest prefetch factor used so far.
+    uint32_t peak_prefetch_factor = 0;
+    /// The number of batches returned by next_data().
+    uint64_t batch_count = 0;
+    /// The number of batches that were not ready when next_data() was called.
+    uint64_t stall_count = 0;
+    /// The total time next_data() waited for batches to be loaded (in nanoseconds).
+    uint64_t stall_time_ns = 0;
+    /// The number of locations whose data was hinted ahead with the readahead function (see set_readahead_func()).
+    uint64_t readahead_count = 0;
+    /// The number of bytes hinted by the readahead function.
+    uint64_t readahead_bytes = 0;
+};
+
 class EXPORT_VISIBLE ThreadBatchDataLoader
 {
 public:
     using LoadFunc = std::function<void(ThreadBatchDataLoader* loader_ptr, uint64_t location_index)>;
+    using TileLoadFunc = std::function<std::shared_ptr<uint8_t>()>;
+    using TileCopyFunc = std::function<void(const uint8_t* tile_data)>;
+    using ReadaheadFunc = std::function<uint64_t(uint64_t location_begin, uint64_t location_end)>;
 
     ThreadBatchDataLoader(LoadFunc load_func,
                           std::unique_ptr<BatchDataProcessor> batch_data_processor,
@@ -38,6 +66,9 @@ public:
                           uint32_t prefetch_factor,
                           uint32_t num_workers);
 
+    /**
+     * @brief Cancel the loader and wait only for the tasks that are running.
+     */
     ~ThreadBatchDataLoader();
 
     operator bool() const;
@@ -64,10 +95,72 @@ public:
     uint8_t* data() const;
     uint32_t data_batch_size() const;
 
+    /**
+     * @brief Return the current number of batches loaded ahead of the batch being consumed.
+     *
+     * If `concurrency.adaptive_prefetch` is enabled, this changes between `concurrency.min_prefetch_factor` and
+     * `concurrency.max_prefetch_factor` while batches are consumed.
+     */
+    uint32_t prefetch_factor() const;
+    LoaderStats stats() const;
+
+    /**
+     * @brief Cancel loading the remaining batches.
+     *
+     * Queued tasks return without loading, no more batches are requested, and next_data() returns nullptr.
+     * This does not wait for running tasks (see close()).
+     */
+    void cancel();
+    /**
+     * @brief Cancel loading, wait for running tasks and release the buffers of prefetched batches.
+     *
+     * The data of the batch last returned by next_data() is not released.
+     */
+    void close();
+    bool is_cancelled() const;
+
     bool enqueue(std::function<void()> task, const TileInfo& tile);
 
+    /**
+     * @brief Return true if tiles can be added to the tile plan of the batch (see plan_tile()).
+     *
+     * Tile plans are used when workers load data into CPU memory without a batch data processor.
+     */
+    bool is_tile_plan_enabled() const;
+
+    /**
+     * @brief Add a tile needed by a patch to the tile plan of the schedule window being requested.
+     *
+     * A schedule window is `concurrency.schedule_window` consecutive batches. When all patches of the window are
+     * requested, one task is enqueued per unique `tile_index`, in ascending `order_key` order. The task loads the tile
+     * once with `load_func` and passes the tile data to every `copy_func` registered for the tile.
+     */
+    void plan_tile(uint64_t tile_index, TileLoadFunc load_func, TileCopyFunc copy_func, uint64_t order_key = 0);
+
+    /**
+     * @brief Set the function that hints the data of locations [location_begin, location_end) will be loaded soon.
+     *
+     * When batches are requested, the locations of the next `concurrency.readahead_batches` batches (and of the
+     * requested batches, if not hinted yet) are passed to `func` in order, before their tasks are enqueued. Each
+     * location is passed once. `func` returns the number of bytes it hinted.
+     */
+    void set_readahead_func(ReadaheadFunc func);
+
 private:
+    struct PlannedTile
+    {
+        uint64_t order_key = 0;
+        TileLoadFunc load_func;
+        std::vector<TileCopyFunc> copy_funcs;
+    };
+
+    uint32_t flush_tile_plan();
+    void readahead(uint64_t location_end);
+    void ensure_raster(size_t buffer_item_index);
+    void adapt_prefetch_factor(uint64_t stall_ns, uint64_t consume_ns);
+
     bool stopped_ = false;
+    cucim::concurrent::CancellationToken cancellation_token_;
     LoadFunc load_func_;
     cucim::io::Device out_device_;
     std::unique_ptr<std::vector<int64_t>> location_ = nullptr;
@@ -77,6 +170,11 @@ private:
     uint32_t batch_size_ = 1;
     uint32_t prefetch_factor_ = 2;
     uint32_t num_workers_ = 0;
+    uint32_t schedule_window_ = 1;
+    bool adaptive_prefetch_ = false;
+    uint32_t min_prefetch_factor_ = 0;
+    uint32_t max_prefetch_factor_ = 0;
+    uint32_t ready_batch_streak_ = 0;
 
     // For nvjpeg
     std::unique_ptr<BatchDataProcessor> batch_data_processor_;
@@ -85,6 +183,11 @@ private:
     size_t buffer_size_ = 0;
     std::vector<uint8_t*> raster_data_;
     std::deque<std::future<void>> tasks_;
+    std::vector<PlannedTile> tile_plan_;
+    std::unordered_map<uint64_t, size_t> tile_plan_index_;
+    ReadaheadFunc readahead_func_;
+    uint32_t readahead_batches_ = 0;
+    uint64_t readahead_item_count_ = 0;
     // NOTE: the order is important ('thread_pool_' depends on 'raster_data_' and 'tasks_')
     cucim::concurrent::ThreadPool thread_pool_;
 
@@ -96,6 +199,9 @@ private:
     uint64_t processed_batch_count_ = 0;
     uint8_t* current_data_ = nullptr;
     uint32_t current_data_batch_size_ = 0;
+
+    LoaderStats stats_;
+    std::chrono::steady_clock::time_point last_delivery_time_;
 };
 
 } // namespace cucim::loader
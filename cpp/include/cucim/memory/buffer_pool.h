@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_MEMORY_BUFFER_POOL_H
+#define CUCIM_MEMORY_BUFFER_POOL_H
+
+#include "cucim/macros/api_header.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cucim/io/device_type.h"
+
+namespace cucim::memory
+{
+
+/**
+ * @brief Size-bucketed pool of raster buffers (CPU memory or CUDA device memory).
+ *
+ * Buffers are allocated with a size rounded up to a bucket size (at most 12.5% larger than requested). Released
+ * buffers are kept for reuse while the total size of idle buffers is within the capacity, and freed otherwise.
+ * Pointers not allocated by the pool can be passed to release(); they are freed with cucim_free()/cudaFree() (on the
+ * device that owns the memory, as reported by cudaPointerGetAttributes()).
+ * In NUMA mode (see ThreadPool::is_numa_enabled()), CPU buffers are pooled per NUMA node: a buffer is taken from
+ * (or placed on) the node of the allocating thread, e.g. the consumer thread for loader batch buffers.
+ */
+class EXPORT_VISIBLE BufferPool
+{
+public:
+    explicit BufferPool(uint64_t capacity_nbytes);
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    ~BufferPool();
+
+    void* allocate(size_t size, cucim::io::DeviceType device_type);
+    /**
+     * @brief Allocate a CPU buffer pooled for NUMA node `numa_node` (-1: any node), whether NUMA mode is enabled or
+     * not.
+     */
+    void* allocate_on_node(size_t size, int numa_node);
+    void release(void* ptr, cucim::io::DeviceType device_type);
+
+    /**
+     * @brief Free all idle buffers.
+     */
+    void clear();
+
+    uint64_t capacity() const;
+    /**
+     * @brief Set the capacity (in bytes) and free idle buffers exceeding it.
+     */
+    void capacity(uint64_t capacity_nbytes);
+
+    uint64_t idle_nbytes() const;
+    uint64_t hit_count() const;
+    uint64_t miss_count() const;
+
+    static size_t bucket_size(size_t size);
+
+private:
+    struct BucketKey
+    {
+        size_t size = 0;
+        int device_index = -1; /// CUDA device index or -1 for CPU memory
+        int numa_node = -1; /// NUMA node of CPU memory in NUMA mode (-1: any)
+
+        bool operator<(const BucketKey& other) const
+        {
+            return std::tie(size, device_index, numa_node) < std::tie(other.size, other.device_index, other.numa_node);
+        }
+    };
+
+    void* allocate_buffer(const BucketKey& key);
+    void trim(uint64_t capacity_nbytes);
+    /**
+     * @brief Return the index of the CUDA device owning `ptr`, or -1 if it is not CUDA device (or managed) memory.
+     */
+    static int cuda_device_of(const void* ptr);
+    static void free_buffer(void* ptr, int device_index);
+
+    mutable std::mutex mutex_;
+    uint64_t capacity_nbytes_ = 0;
+    uint64_t idle_nbytes_ = 0;
+    uint64_t hit_count_ = 0;
+    uint64_t miss_count_ = 0;
+    std::map<BucketKey, std::vector<void*>> idle_buffers_;
+    std::unordered_map<void*, BucketKey> used_buffers_;
+};
+
+/**
+ * @brief Return the process-wide buffer pool used for loader batch buffers and `read_region()` rasters.
+ *
+ * Its capacity is configured by `buffer_pool.memory_capacity`.
+ */
+EXPORT_VISIBLE BufferPool& buffer_pool();
+
+} // namespace cucim::memory
+
+#endif // CUCIM_MEMORY_BUFFER_POOL_H
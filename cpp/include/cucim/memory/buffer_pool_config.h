@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_MEMORY_BUFFER_POOL_CONFIG_H
+#define CUCIM_MEMORY_BUFFER_POOL_CONFIG_H
+
+#include "cucim/core/framework.h"
+
+#include <cstdint>
+
+namespace cucim::memory
+{
+
+constexpr uint32_t kDefaultBufferPoolMemoryCapacity = 256; // in MiB
+constexpr uint32_t kDefaultBounceBufferSize = 4096; // in KiB
+constexpr uint32_t kDefaultBounceBufferCount = 16;
+
+struct EXPORT_VISIBLE BufferPoolConfig
+{
+    void load_config(const void* json_obj);
+
+    /// The maximal size (in MiB) of idle raster buffers kept for reuse (0: disabled).
+    uint32_t memory_capacity = kDefaultBufferPoolMemoryCapacity;
+    /// The size (in KiB) of each page-aligned bounce buffer used to read O_DIRECT files (rounded up to whole pages).
+    uint32_t bounce_buffer_size = kDefaultBounceBufferSize;
+    /// The maximal number of idle bounce buffers kept for reuse.
+    uint32_t bounce_buffer_count = kDefaultBounceBufferCount;
+};
+
+} // namespace cucim::memory
+
+#endif // CUCIM_MEMORY_BUFFER_POOL_CONFIG_H
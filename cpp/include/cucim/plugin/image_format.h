@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -21,6 +21,11 @@ public:
 
     bool add_interfaces(const cucim::io::format::IImageFormat* image_formats);
     cucim::io::format::ImageFormatDesc* detect_image_format(const filesystem::Path& path);
+    /**
+     * @brief Return the format that can write a file at `path` (the first format accepting the path and having a
+     * writer).
+     */
+    cucim::io::format::ImageFormatDesc* detect_image_writer(const filesystem::Path& path);
 
     operator bool() const
     {
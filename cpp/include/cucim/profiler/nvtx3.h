@@ -150,6 +150,15 @@ struct category_compute
 // Message/Event
 DEFINE_EVENT(cucim_malloc, "cucim_malloc()", memory, 255, 63, 72, 204);
 DEFINE_EVENT(cucim_free, "cucim_free()", memory, 255, 211, 213, 245);
+DEFINE_EVENT(buffer_pool_allocate, "BufferPool::allocate()", memory, 255, 63, 72, 204);
+DEFINE_EVENT(buffer_pool_release, "BufferPool::release()", memory, 255, 211, 213, 245);
+
+DEFINE_EVENT(threadpool_create_executor, "ThreadPool::shared_executor()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(thread_batch_data_loader_flush_tile_plan, "ThreadBatchDataLoader::flush_tile_plan()", io, 255, 255, 0, 0);
+DEFINE_EVENT(dataset_loader_read, "DatasetLoader::read()", io, 255, 255, 160, 0);
+DEFINE_EVENT(dataset_loader_open_file, "DatasetLoader::FileCache::open()", io, 255, 255, 200, 0);
+DEFINE_EVENT(tissue_mask_from_image, "TissueMask::from_image()", compute, 255, 160, 255, 0);
+DEFINE_EVENT(grid_sampler_locations, "GridSampler::locations()", compute, 255, 200, 255, 0);
 
 DEFINE_EVENT(cucim_plugin_detect_image_format, "ImageFormat::detect_image_format()", io, 255, 255, 0, 0);
 
@@ -160,8 +169,13 @@ DEFINE_EVENT(cuimage_ensure_init_plugin_iter, "CuImage::ensure_init::plugin_iter
 DEFINE_EVENT(cuimage_cuimage_open, "CuImage::CuImage::open", io, 255, 255, 0, 0);
 
 DEFINE_EVENT(cuimage_read_region, "CuImage::read_region()", io, 255, 255, 0, 0);
+DEFINE_EVENT(cuimage_read_grid, "CuImage::read_grid()", io, 255, 255, 0, 0);
+DEFINE_EVENT(cuimage_read_region_scaled, "CuImage::read_region_scaled()", io, 255, 255, 0, 0);
 DEFINE_EVENT(cuimage_associated_image, "CuImage::associated_image()", io, 255, 255, 0, 0);
 DEFINE_EVENT(cuimage_crop_image, "CuImage::crop_image()", io, 255, 255, 0, 0);
+DEFINE_EVENT(cuimage_save, "CuImage::save()", io, 255, 255, 0, 0);
+DEFINE_EVENT(cuimage_save_pyramid, "CuImage::save_pyramid()", io, 255, 255, 0, 0);
+DEFINE_EVENT(cuimage_save_zarr, "CuImage::save_zarr()", io, 255, 255, 0, 0);
 
 DEFINE_EVENT(image_cache_create_cache, "ImageCacheManager::create_cache()", memory, 255, 63, 72, 204);
 
@@ -181,7 +195,17 @@ DEFINE_EVENT(ifd_read_region_tiles_task, "IFD::read_region_tiles::task", io, 255
 DEFINE_EVENT(ifd_read_region_tiles_boundary, "IFD::read_region_tiles_boundary()", io, 255, 255, 0, 0);
 DEFINE_EVENT(ifd_read_region_tiles_boundary_iter, "IFD::read_region_tiles_boundary::iter", io, 255, 255, 0, 0);
 DEFINE_EVENT(ifd_read_region_tiles_boundary_task, "IFD::read_region_tiles_boundary::task", io, 255, 255, 0, 0);
+DEFINE_EVENT(ifd_read_region_tiles_separate, "IFD::read_region_tiles_separate()", io, 255, 255, 0, 0);
+DEFINE_EVENT(ifd_readahead_patches, "IFD::readahead_patches()", io, 255, 255, 0, 0);
 DEFINE_EVENT(ifd_decompression, "IFD::decompression", compute, 255, 0, 255, 0);
+DEFINE_EVENT(ifd_build_virtual_tile, "IFD::build_virtual_tile()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(tiff_writer_write_pyramid, "cuslide::tiff::write_pyramid()", io, 255, 255, 0, 0);
+DEFINE_EVENT(tiff_writer_encode_tile, "cuslide::tiff::write_pyramid::encode_tile", compute, 255, 0, 255, 0);
+DEFINE_EVENT(tiff_writer_copy_tiles, "cuslide::tiff::write_pyramid::copy_tiles", io, 255, 255, 0, 0);
+DEFINE_EVENT(zarr_writer_write_multiscales, "cuslide::zarr::write_multiscales()", io, 255, 255, 0, 0);
+DEFINE_EVENT(zarr_writer_write_chunk, "cuslide::zarr::write_multiscales::write_chunk", compute, 255, 0, 255, 0);
+DEFINE_EVENT(raster_writer_write_image, "cuslide::raster::write_image()", io, 255, 255, 0, 0);
+DEFINE_EVENT(raster_writer_encode_strip, "cuslide::raster::write_image::encode_strip", compute, 255, 0, 255, 0);
 
 DEFINE_EVENT(decoder_libjpeg_turbo_tjAlloc, "libjpeg-turbo::tjAlloc()", memory, 255, 63, 72, 204);
 DEFINE_EVENT(decoder_libjpeg_turbo_tjFree, "libjpeg-turbo::tjFree()", memory, 255, 211, 213, 245);
@@ -191,10 +215,23 @@ DEFINE_EVENT(decoder_libjpeg_turbo_tjDestroy, "libjpeg-turbo::tjDestroy()", comp
 DEFINE_EVENT(
     decoder_libjpeg_turbo_read_jpeg_header_tables, "cuslide::jpeg::read_jpeg_header_tables()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(decoder_libjpeg_turbo_jpeg_decode_buffer, "cuslide::jpeg::jpeg_decode_buffer()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(encoder_libjpeg_turbo_tjCompress2, "libjpeg-turbo::tjCompress2()", compute, 255, 0, 255, 0);
 
 DEFINE_EVENT(libdeflate_alloc_decompressor, "libdeflate::libdeflate_alloc_decompressor()", memory, 255, 63, 72, 204);
 DEFINE_EVENT(libdeflate_zlib_decompress, "libdeflate::libdeflate_zlib_decompress()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(libdeflate_free_decompressor, "libdeflate::libdeflate_free_decompressor()", memory, 255, 211, 213, 245);
+DEFINE_EVENT(libdeflate_alloc_compressor, "libdeflate::libdeflate_alloc_compressor()", memory, 255, 63, 72, 204);
+DEFINE_EVENT(libdeflate_zlib_compress, "libdeflate::libdeflate_zlib_compress()", compute, 255, 0, 255, 0);
+
+DEFINE_EVENT(zstd_create_dctx, "zstd::ZSTD_createDCtx()", memory, 255, 63, 72, 204);
+DEFINE_EVENT(zstd_decompress, "zstd::ZSTD_decompressDCtx()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(zstd_create_cctx, "zstd::ZSTD_createCCtx()", memory, 255, 63, 72, 204);
+DEFINE_EVENT(zstd_compress, "zstd::ZSTD_compressCCtx()", compute, 255, 0, 255, 0);
+
+DEFINE_EVENT(libwebp_decode, "libwebp::WebPDecodeInto()", compute, 255, 0, 255, 0);
+
+DEFINE_EVENT(libjxl_create_decoder, "libjxl::JxlDecoderCreate()", memory, 255, 63, 72, 204);
+DEFINE_EVENT(libjxl_decode, "libjxl::JxlDecoderProcessInput()", compute, 255, 0, 255, 0);
 
 DEFINE_EVENT(opj_stream_create, "libopenjpeg::opj_stream_create()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(opj_create_decompress, "libopenjpeg::opj_create_decompress()", compute, 255, 0, 255, 0);
@@ -216,6 +253,8 @@ DEFINE_EVENT(lzw_LZWPreDecode, "lzw::LZWPreDecode()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(lzw_LZWDecode, "lzw::LZWDecode()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(lzw_LZWCleanup, "lzw::LZWCleanup()", compute, 255, 0, 255, 0);
 DEFINE_EVENT(lzw_horAcc8, "lzw::LZWCleanup()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(lzw_horAcc16, "lzw::horAcc16()", compute, 255, 0, 255, 0);
+DEFINE_EVENT(lzw_horAcc32, "lzw::horAcc32()", compute, 255, 0, 255, 0);
 
 } // namespace cucim::profiler
 
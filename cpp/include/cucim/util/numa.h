@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+//
+#ifndef CUCIM_UTIL_NUMA_H
+#define CUCIM_UTIL_NUMA_H
+
+#include "cucim/macros/api_header.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief NUMA topology, thread pinning and memory placement (Linux, without libnuma).
+ */
+namespace cucim::util
+{
+
+/**
+ * @brief Return the IDs of the online NUMA nodes ({0} if unknown).
+ */
+EXPORT_VISIBLE const std::vector<int>& numa_nodes();
+
+/**
+ * @brief Return the NUMA node of the CPU the calling thread runs on (0 if unknown).
+ */
+EXPORT_VISIBLE int numa_current_node();
+
+/**
+ * @brief Pin the calling thread to the CPUs of the NUMA node. Return false on failure.
+ */
+EXPORT_VISIBLE bool numa_bind_current_thread(int node);
+
+/**
+ * @brief Prefer the NUMA node for the pages of the memory range that are not touched yet. Return false on failure.
+ */
+EXPORT_VISIBLE bool numa_prefer_memory(void* ptr, size_t size, int node);
+
+/**
+ * @brief Parse an ID list like "0-3,8,10-11" (as in /sys/devices/system/node/online). Return {} if it is invalid.
+ */
+EXPORT_VISIBLE std::vector<int> parse_numa_id_list(const std::string& list);
+
+} // namespace cucim::util
+
+#endif // CUCIM_UTIL_NUMA_H
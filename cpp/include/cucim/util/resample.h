@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUCIM_UTIL_RESAMPLE_H
+#define CUCIM_UTIL_RESAMPLE_H
+
+#include "cucim/macros/api_header.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cucim::util
+{
+
+/**
+ * @brief Area-average (box filter) downsampling of 8-bit interleaved images by a non-integer factor.
+ *
+ * Output pixel (x, y) is the average of the source area [offset_x + x * scale, offset_x + (x + 1) * scale) x
+ * [offset_y + y * scale, offset_y + (y + 1) * scale), with partially covered source pixels weighted by their
+ * coverage. The filter is separable: source rows are summed into a float row first (a contiguous multiply-add the
+ * compiler vectorizes), then the columns of that row are averaged.
+ *
+ * Output rows can be resampled in bands, so the caller needs only the source rows of a band in memory.
+ */
+class EXPORT_VISIBLE AreaResampler
+{
+public:
+    /**
+     * @param scale Source pixels per output pixel (>= 1).
+     * @param offset_x Source x coordinate of the left edge of the output (>= 0).
+     * @param offset_y Source y coordinate of the top edge of the output (>= 0).
+     */
+    AreaResampler(double scale, double offset_x, double offset_y, int64_t out_width, int64_t out_height);
+
+    int64_t out_width() const;
+    int64_t out_height() const;
+
+    /**
+     * @brief Return the number of source columns (from column 0) used by the output.
+     */
+    int64_t source_width() const;
+
+    /**
+     * @brief Return the range [begin, end) of source rows used by output rows [out_row_begin, out_row_end).
+     */
+    std::pair<int64_t, int64_t> source_rows(int64_t out_row_begin, int64_t out_row_end) const;
+
+    /**
+     * @brief Resample output rows [out_row_begin, out_row_end).
+     *
+     * @param src Source rows from `src_row_begin` (including the rows returned by source_rows()), each of
+     *            `source_width()` pixels of `channels` bytes.
+     * @param out The first output row to write (`out_row_begin`).
+     */
+    void resample_rows(const uint8_t* src,
+                       int64_t src_row_begin,
+                       size_t src_stride,
+                       uint8_t* out,
+                       size_t out_stride,
+                       int64_t out_row_begin,
+                       int64_t out_row_end,
+                       int64_t channels) const;
+
+private:
+    // Source pixels [begin, end) of an output pixel, whose weights start at `weight_offset`.
+    struct Span
+    {
+        int64_t begin = 0;
+        int64_t end = 0;
+        size_t weight_offset = 0;
+    };
+
+    static void build_spans(
+        double scale, double offset, int64_t count, std::vector<Span>& spans, std::vector<float>& weights);
+
+    std::vector<Span> column_spans_;
+    std::vector<float> column_weights_;
+    std::vector<Span> row_spans_;
+    std::vector<float> row_weights_;
+};
+
+} // namespace cucim::util
+
+#endif // CUCIM_UTIL_RESAMPLE_H
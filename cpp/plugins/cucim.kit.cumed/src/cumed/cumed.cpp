@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 #define CUCIM_EXPORTS
@@ -365,25 +365,14 @@ static bool CUCIM_ABI reader_read(const CuCIMFileHandle_ptr handle_ptr,
     return true;
 }
 
-static bool CUCIM_ABI writer_write(const CuCIMFileHandle_ptr handle_ptr,
-                                   const cucim::io::format::ImageMetadataDesc* metadata,
-                                   const cucim::io::format::ImageDataDesc* image_data)
-{
-    CuCIMFileHandle* handle = reinterpret_cast<CuCIMFileHandle*>(handle_ptr);
-    (void)handle;
-    (void)metadata;
-    (void)image_data;
-
-    return true;
-}
-
 void fill_interface(cucim::io::format::IImageFormat& iface)
 {
     static cucim::io::format::ImageCheckerDesc image_checker = { 0, 0, checker_is_valid };
     static cucim::io::format::ImageParserDesc image_parser = { parser_open, parser_parse, parser_close };
 
     static cucim::io::format::ImageReaderDesc image_reader = { reader_read };
-    static cucim::io::format::ImageWriterDesc image_writer = { writer_write };
+    // Writing is not supported.
+    static cucim::io::format::ImageWriterDesc image_writer = { nullptr };
 
     // clang-format off
     static cucim::io::format::ImageFormatDesc image_format_desc = {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -10,6 +10,8 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <random>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <CLI/CLI.hpp>
@@ -17,7 +19,10 @@
 #include <openslide/openslide.h>
 
 #include "cucim/core/framework.h"
+#include "cucim/cuimage.h"
 #include "cucim/io/format/image_format.h"
+#include "cucim/loader/thread_batch_data_loader.h"
+#include "cucim/memory/buffer_pool.h"
 #include "cucim/memory/memory_manager.h"
 
 #define XSTR(x) STR(x)
@@ -105,7 +110,7 @@ static void test_basic(benchmark::State& state)
 
         image_format->formats[0].image_reader.read(
             file_handle.get(), &metadata.desc(), &request, &image_data, nullptr /*out_metadata*/);
-        cucim_free(image_data.container.data);
+        cucim::memory::buffer_pool().release(image_data.container.data, cucim::io::DeviceType::kCPU);
 
         //        auto end = std::chrono::high_resolution_clock::now();
         //        auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
@@ -153,8 +158,209 @@ static void test_openslide(benchmark::State& state)
     }
 }
 
+// Read random patches with the batch data loader, scheduling tile loads with the given cucim::concurrent::TileSchedule
+// (0: none, 1: hilbert, 2: offset).
+static void test_tile_schedule(benchmark::State& state)
+{
+    constexpr int64_t kPatchSize = 256;
+    constexpr uint64_t kPatchCount = 1024;
+    constexpr uint32_t kBatchSize = 32;
+    constexpr uint32_t kPrefetchFactor = 3;
+    constexpr uint32_t kNumWorkers = 8;
+
+    std::string input_path = g_config.get_input_path();
+
+    cucim::Framework* framework = cucim::acquire_framework("cuslide.app");
+    if (!framework)
+    {
+        fmt::print("framework is not available!\n");
+        return;
+    }
+    cucim::io::format::IImageFormat* image_format =
+        framework->acquire_interface_from_library<cucim::io::format::IImageFormat>(
+            "cucim.kit.cuslide@" XSTR(CUSLIDE_VERSION) ".so");
+    if (image_format == nullptr)
+    {
+        fmt::print("plugin library is not available!\n");
+        return;
+    }
+
+    auto& concurrency = cucim::CuImage::get_config()->concurrency();
+    concurrency.tile_schedule = static_cast<cucim::concurrent::TileSchedule>(state.range(0));
+    concurrency.schedule_window = 1 + kPrefetchFactor;
+
+    // A cache smaller than the image so that the order of tile loads matters.
+    cucim::cache::ImageCacheConfig cache_config;
+    cache_config.type = cucim::cache::CacheType::kPerProcess;
+    cache_config.memory_capacity = 64;
+    cache_config.capacity = cucim::cache::calc_default_cache_capacity(cucim::cache::kOneMiB * 64);
+    cache_config.record_stat = true;
+
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    std::mt19937_64 rng(g_config.random_seed);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto cache = cucim::CuImage::cache_manager().cache(cache_config);
+        // Same random order of patches for every schedule
+        auto location = new std::vector<int64_t>();
+        location->reserve(kPatchCount * 2);
+        for (uint64_t i = 0; i < kPatchCount; ++i)
+        {
+            location->push_back(static_cast<int64_t>(rng() % (g_config.image_width - kPatchSize)));
+            location->push_back(static_cast<int64_t>(rng() % (g_config.image_height - kPatchSize)));
+        }
+        auto size = new std::vector<int64_t>{ kPatchSize, kPatchSize };
+        state.ResumeTiming();
+
+        std::shared_ptr<CuCIMFileHandle>* file_handle_shared = reinterpret_cast<std::shared_ptr<CuCIMFileHandle>*>(
+            image_format->formats[0].image_parser.open(input_path.c_str()));
+        std::shared_ptr<CuCIMFileHandle> file_handle = *file_handle_shared;
+        delete file_handle_shared;
+        file_handle->set_deleter(image_format->formats[0].image_parser.close);
+
+        cucim::io::format::ImageMetadata metadata{};
+        image_format->formats[0].image_parser.parse(file_handle.get(), &metadata.desc());
+
+        cucim::io::format::ImageReaderRegionRequestDesc request{};
+        request.location = location->data();
+        request.location_unique = new std::unique_ptr<std::vector<int64_t>>(location);
+        request.size = size->data();
+        request.size_unique = new std::unique_ptr<std::vector<int64_t>>(size);
+        request.location_len = kPatchCount;
+        request.size_ndim = 2;
+        request.level = 0;
+        request.num_workers = kNumWorkers;
+        request.batch_size = kBatchSize;
+        request.prefetch_factor = kPrefetchFactor;
+        request.device = const_cast<char*>("cpu");
+
+        cucim::io::format::ImageDataDesc image_data{};
+        image_format->formats[0].image_reader.read(
+            file_handle.get(), &metadata.desc(), &request, &image_data, nullptr /*out_metadata*/);
+
+        auto loader = static_cast<cucim::loader::ThreadBatchDataLoader*>(image_data.loader);
+        while (uint8_t* batch = loader->next_data())
+        {
+            cucim::memory::buffer_pool().release(batch, cucim::io::DeviceType::kCPU);
+        }
+        delete loader;
+        cucim::memory::buffer_pool().release(image_data.container.data, cucim::io::DeviceType::kCPU);
+
+        state.PauseTiming();
+        hit_count += cache->hit_count();
+        miss_count += cache->miss_count();
+        state.ResumeTiming();
+    }
+
+    state.counters["cache_hit_rate"] =
+        (hit_count + miss_count) ? static_cast<double>(hit_count) / (hit_count + miss_count) : 0.0;
+    state.counters["patches_per_second"] =
+        benchmark::Counter(static_cast<double>(kPatchCount * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// Read random patches with the batch data loader, hinting the tiles of the next state.range(0) batches ahead
+// (`concurrency.readahead_batches`, 0: disabled). Use `--discard_cache true` to measure reads from a cold page cache.
+static void test_readahead(benchmark::State& state)
+{
+    constexpr int64_t kPatchSize = 256;
+    constexpr uint64_t kPatchCount = 1024;
+    constexpr uint32_t kBatchSize = 32;
+    constexpr uint32_t kPrefetchFactor = 2;
+    constexpr uint32_t kNumWorkers = 8;
+
+    std::string input_path = g_config.get_input_path();
+
+    cucim::Framework* framework = cucim::acquire_framework("cuslide.app");
+    if (!framework)
+    {
+        fmt::print("framework is not available!\n");
+        return;
+    }
+    cucim::io::format::IImageFormat* image_format =
+        framework->acquire_interface_from_library<cucim::io::format::IImageFormat>(
+            "cucim.kit.cuslide@" XSTR(CUSLIDE_VERSION) ".so");
+    if (image_format == nullptr)
+    {
+        fmt::print("plugin library is not available!\n");
+        return;
+    }
+
+    auto& concurrency = cucim::CuImage::get_config()->concurrency();
+    const uint32_t readahead_batches = concurrency.readahead_batches;
+    concurrency.readahead_batches = static_cast<uint32_t>(state.range(0));
+
+    // Every tile is read from the file.
+    cucim::cache::ImageCacheConfig cache_config;
+    cache_config.type = cucim::cache::CacheType::kNoCache;
+    cucim::CuImage::cache_manager().cache(cache_config);
+
+    std::mt19937_64 rng(g_config.random_seed);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        if (g_config.discard_cache)
+        {
+            int fd = open(input_path.c_str(), O_RDONLY);
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+        auto location = new std::vector<int64_t>();
+        location->reserve(kPatchCount * 2);
+        for (uint64_t i = 0; i < kPatchCount; ++i)
+        {
+            location->push_back(static_cast<int64_t>(rng() % (g_config.image_width - kPatchSize)));
+            location->push_back(static_cast<int64_t>(rng() % (g_config.image_height - kPatchSize)));
+        }
+        auto size = new std::vector<int64_t>{ kPatchSize, kPatchSize };
+        state.ResumeTiming();
+
+        std::shared_ptr<CuCIMFileHandle>* file_handle_shared = reinterpret_cast<std::shared_ptr<CuCIMFileHandle>*>(
+            image_format->formats[0].image_parser.open(input_path.c_str()));
+        std::shared_ptr<CuCIMFileHandle> file_handle = *file_handle_shared;
+        delete file_handle_shared;
+        file_handle->set_deleter(image_format->formats[0].image_parser.close);
+
+        cucim::io::format::ImageMetadata metadata{};
+        image_format->formats[0].image_parser.parse(file_handle.get(), &metadata.desc());
+
+        cucim::io::format::ImageReaderRegionRequestDesc request{};
+        request.location = location->data();
+        request.location_unique = new std::unique_ptr<std::vector<int64_t>>(location);
+        request.size = size->data();
+        request.size_unique = new std::unique_ptr<std::vector<int64_t>>(size);
+        request.location_len = kPatchCount;
+        request.size_ndim = 2;
+        request.level = 0;
+        request.num_workers = kNumWorkers;
+        request.batch_size = kBatchSize;
+        request.prefetch_factor = kPrefetchFactor;
+        request.device = const_cast<char*>("cpu");
+
+        cucim::io::format::ImageDataDesc image_data{};
+        image_format->formats[0].image_reader.read(
+            file_handle.get(), &metadata.desc(), &request, &image_data, nullptr /*out_metadata*/);
+
+        auto loader = static_cast<cucim::loader::ThreadBatchDataLoader*>(image_data.loader);
+        while (uint8_t* batch = loader->next_data())
+        {
+            cucim::memory::buffer_pool().release(batch, cucim::io::DeviceType::kCPU);
+        }
+        delete loader;
+        cucim::memory::buffer_pool().release(image_data.container.data, cucim::io::DeviceType::kCPU);
+    }
+    concurrency.readahead_batches = readahead_batches;
+
+    state.counters["patches_per_second"] =
+        benchmark::Counter(static_cast<double>(kPatchCount * state.iterations()), benchmark::Counter::kIsRate);
+}
+
 BENCHMARK(test_basic)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1, 4096); //->UseManualTime();
 BENCHMARK(test_openslide)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1, 4096);
+BENCHMARK(test_tile_schedule)->Unit(benchmark::kMillisecond)->DenseRange(0, 2)->UseRealTime();
+BENCHMARK(test_readahead)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(4)->UseRealTime();
 
 static bool remove_help_option(int* argc, char** argv)
 {
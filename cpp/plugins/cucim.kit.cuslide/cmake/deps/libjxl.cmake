@@ -0,0 +1,53 @@
+# cmake-format: off
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+# cmake-format: on
+
+if (NOT TARGET deps::libjxl)
+    FetchContent_Declare(
+            deps-libjxl
+            GIT_REPOSITORY https://github.com/libjxl/libjxl.git
+            GIT_TAG v0.11.1
+            GIT_SHALLOW TRUE
+            # highway, brotli and skcms are git submodules of libjxl
+            GIT_SUBMODULES third_party/highway third_party/brotli third_party/skcms
+            EXCLUDE_FROM_ALL
+    )
+    message(STATUS "Fetching libjxl sources")
+
+    # Create static library (decoder only)
+    set(JPEGXL_ENABLE_TOOLS OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_JPEGLI OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_DOXYGEN OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_MANPAGES OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_BENCHMARK OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_EXAMPLES OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_JNI OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_SJPEG OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_OPENEXR OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_TRANSCODE_JPEG OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_ENABLE_BOXES OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_BUNDLE_LIBPNG OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_FORCE_SYSTEM_BROTLI OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_FORCE_SYSTEM_HWY OFF CACHE BOOL "" FORCE)
+    set(JPEGXL_STATIC ON CACHE BOOL "" FORCE)
+    set(BUILD_TESTING OFF CACHE BOOL "" FORCE)
+    cucim_set_build_shared_libs(OFF)
+    FetchContent_MakeAvailable(deps-libjxl)
+    cucim_restore_build_shared_libs()
+
+    message(STATUS "Fetching libjxl sources - done")
+
+    # Disable visibility to not expose unnecessary symbols
+    set_target_properties(jxl_dec-obj
+        PROPERTIES
+            C_VISIBILITY_PRESET hidden
+            CXX_VISIBILITY_PRESET hidden
+            VISIBILITY_INLINES_HIDDEN YES
+            POSITION_INDEPENDENT_CODE ON)
+
+    add_library(deps::libjxl INTERFACE IMPORTED GLOBAL)
+    target_link_libraries(deps::libjxl INTERFACE jxl_dec)
+    set(deps-libjxl_SOURCE_DIR ${deps-libjxl_SOURCE_DIR} CACHE INTERNAL "" FORCE)
+    mark_as_advanced(deps-libjxl_SOURCE_DIR)
+endif ()
@@ -0,0 +1,45 @@
+# cmake-format: off
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+# cmake-format: on
+
+if (NOT TARGET deps::libwebp)
+    FetchContent_Declare(
+            deps-libwebp
+            GIT_REPOSITORY https://github.com/webmproject/libwebp.git
+            GIT_TAG v1.4.0
+            GIT_SHALLOW TRUE
+            EXCLUDE_FROM_ALL
+    )
+    message(STATUS "Fetching libwebp sources")
+
+    # Create static library (decoder only)
+    set(WEBP_BUILD_ANIM_UTILS OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_CWEBP OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_DWEBP OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_GIF2WEBP OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_IMG2WEBP OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_VWEBP OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_WEBPINFO OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_WEBPMUX OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_EXTRAS OFF CACHE BOOL "" FORCE)
+    set(WEBP_BUILD_LIBWEBPMUX OFF CACHE BOOL "" FORCE)
+    cucim_set_build_shared_libs(OFF)
+    FetchContent_MakeAvailable(deps-libwebp)
+    cucim_restore_build_shared_libs()
+
+    message(STATUS "Fetching libwebp sources - done")
+
+    # Disable visibility to not expose unnecessary symbols
+    set_target_properties(webpdecoder
+        PROPERTIES
+            C_VISIBILITY_PRESET hidden
+            VISIBILITY_INLINES_HIDDEN YES
+            POSITION_INDEPENDENT_CODE ON)
+
+    add_library(deps::libwebp INTERFACE IMPORTED GLOBAL)
+    target_link_libraries(deps::libwebp INTERFACE webpdecoder)
+    target_include_directories(deps::libwebp INTERFACE ${deps-libwebp_SOURCE_DIR}/src)
+    set(deps-libwebp_SOURCE_DIR ${deps-libwebp_SOURCE_DIR} CACHE INTERNAL "" FORCE)
+    mark_as_advanced(deps-libwebp_SOURCE_DIR)
+endif ()
@@ -0,0 +1,42 @@
+# cmake-format: off
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+# cmake-format: on
+
+if (NOT TARGET deps::zstd)
+    FetchContent_Declare(
+            deps-zstd
+            GIT_REPOSITORY https://github.com/facebook/zstd.git
+            GIT_TAG v1.5.6
+            GIT_SHALLOW TRUE
+            SOURCE_SUBDIR build/cmake
+            EXCLUDE_FROM_ALL
+    )
+    message(STATUS "Fetching zstd sources")
+
+    # Create static library (decompression only)
+    set(ZSTD_BUILD_PROGRAMS OFF CACHE BOOL "" FORCE)
+    set(ZSTD_BUILD_TESTS OFF CACHE BOOL "" FORCE)
+    set(ZSTD_BUILD_CONTRIB OFF CACHE BOOL "" FORCE)
+    set(ZSTD_BUILD_SHARED OFF CACHE BOOL "" FORCE)
+    set(ZSTD_BUILD_STATIC ON CACHE BOOL "" FORCE)
+    set(ZSTD_LEGACY_SUPPORT OFF CACHE BOOL "" FORCE)
+    cucim_set_build_shared_libs(OFF)
+    FetchContent_MakeAvailable(deps-zstd)
+    cucim_restore_build_shared_libs()
+
+    message(STATUS "Fetching zstd sources - done")
+
+    # Disable visibility to not expose unnecessary symbols
+    set_target_properties(libzstd_static
+        PROPERTIES
+            C_VISIBILITY_PRESET hidden
+            VISIBILITY_INLINES_HIDDEN YES
+            POSITION_INDEPENDENT_CODE ON)
+
+    add_library(deps::zstd INTERFACE IMPORTED GLOBAL)
+    target_link_libraries(deps::zstd INTERFACE libzstd_static)
+    target_include_directories(deps::zstd INTERFACE ${deps-zstd_SOURCE_DIR}/lib)
+    set(deps-zstd_SOURCE_DIR ${deps-zstd_SOURCE_DIR} CACHE INTERNAL "" FORCE)
+    mark_as_advanced(deps-zstd_SOURCE_DIR)
+endif ()
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 #define CUCIM_EXPORTS
@@ -10,6 +10,9 @@
 #include "cucim/core/plugin_util.h"
 #include "cucim/io/format/image_format.h"
 #include "tiff/tiff.h"
+#include "raster/raster_writer.h"
+#include "tiff/tiff_writer.h"
+#include "zarr/zarr_writer.h"
 
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
@@ -71,6 +74,37 @@ static bool CUCIM_ABI checker_is_valid(const char* file_name, const char* buf, s
     return false;
 }
 
+static const char* zarr_get_format_name()
+{
+    return "Zarr";
+}
+
+static bool CUCIM_ABI zarr_checker_is_valid(const char* file_name, const char* buf, size_t size)
+{
+    (void)buf;
+    (void)size;
+    auto file = std::filesystem::path(file_name);
+    if (!file.has_filename())
+    {
+        file = file.parent_path(); // "image.zarr/"
+    }
+    return file.extension().string().compare(".zarr") == 0;
+}
+
+static const char* raster_get_format_name()
+{
+    return "PNG/JPEG";
+}
+
+static bool CUCIM_ABI raster_checker_is_valid(const char* file_name, const char* buf, size_t size)
+{
+    (void)buf;
+    (void)size;
+    auto file = std::filesystem::path(file_name);
+    auto extension = file.extension().string();
+    return extension.compare(".png") == 0 || extension.compare(".jpg") == 0 || extension.compare(".jpeg") == 0;
+}
+
 static CuCIMFileHandle_share CUCIM_ABI parser_open(const char* file_path)
 {
     auto tif = new cuslide::tiff::TIFF(file_path, O_RDONLY);
@@ -133,11 +167,11 @@ static bool CUCIM_ABI parser_parse(CuCIMFileHandle_ptr handle_ptr, cucim::io::fo
     std::pmr::vector<int64_t> shape(
         { level0_ifd->height(), level0_ifd->width(), level0_ifd->samples_per_pixel() }, &resource);
 
-    DLDataType dtype{ kDLUInt, 8, 1 };
+    DLDataType dtype = level0_ifd->dtype();
 
     // TODO: Fill correct values for cucim::io::format::ImageMetadataDesc
-    uint8_t n_ch = level0_ifd->samples_per_pixel();
-    if (n_ch != 3)
+    uint16_t n_ch = level0_ifd->samples_per_pixel();
+    if (!level0_ifd->is_read_optimizable())
     {
         // Image loaded by a slow-path(libtiff) always will have 4 channel
         // (by TIFFRGBAImageGet() method in libtiff)
@@ -146,18 +180,32 @@ static bool CUCIM_ABI parser_parse(CuCIMFileHandle_ptr handle_ptr, cucim::io::fo
     }
     std::pmr::vector<std::string_view> channel_names(&resource);
     channel_names.reserve(n_ch);
-    if (n_ch == 3)
+    switch (n_ch)
     {
+    case 1:
+        channel_names.emplace_back(std::string_view{ "L" });
+        break;
+    case 3:
         channel_names.emplace_back(std::string_view{ "R" });
         channel_names.emplace_back(std::string_view{ "G" });
         channel_names.emplace_back(std::string_view{ "B" });
-    }
-    else
-    {
+        break;
+    case 4:
         channel_names.emplace_back(std::string_view{ "R" });
         channel_names.emplace_back(std::string_view{ "G" });
         channel_names.emplace_back(std::string_view{ "B" });
         channel_names.emplace_back(std::string_view{ "A" });
+        break;
+    default:
+        // Multi-channel (e.g., fluorescence) image: name channels by their index ('C0', 'C1', ...)
+        for (uint16_t i = 0; i < n_ch; ++i)
+        {
+            std::string channel_name = fmt::format("C{}", i);
+            char* channel_name_ptr = static_cast<char*>(out_metadata.allocate(channel_name.size() + 1));
+            memcpy(channel_name_ptr, channel_name.c_str(), channel_name.size() + 1);
+            channel_names.emplace_back(std::string_view{ channel_name_ptr, channel_name.size() });
+        }
+        break;
     }
 
     // Spacing units
@@ -304,15 +352,22 @@ static bool CUCIM_ABI reader_read(const CuCIMFileHandle_ptr handle_ptr,
     return result;
 }
 
-static bool CUCIM_ABI writer_write(const CuCIMFileHandle_ptr handle_ptr,
-                                   const cucim::io::format::ImageMetadataDesc* metadata,
-                                   const cucim::io::format::ImageDataDesc* image_data)
+// Writers throw on unsupported requests and I/O errors (see ImageWriterDesc::write), so returning means success.
+static bool CUCIM_ABI writer_write(const cucim::io::format::ImageWriterRequestDesc* request)
 {
-    CuCIMFileHandle* handle = reinterpret_cast<CuCIMFileHandle*>(handle_ptr);
-    (void)handle;
-    (void)metadata;
-    (void)image_data;
+    cuslide::tiff::write_pyramid(*request);
+    return true;
+}
 
+static bool CUCIM_ABI raster_writer_write(const cucim::io::format::ImageWriterRequestDesc* request)
+{
+    cuslide::raster::write_image(*request);
+    return true;
+}
+
+static bool CUCIM_ABI zarr_writer_write(const cucim::io::format::ImageWriterRequestDesc* request)
+{
+    cuslide::zarr::write_multiscales(*request);
     return true;
 }
 
@@ -324,23 +379,55 @@ void fill_interface(cucim::io::format::IImageFormat& iface)
     static cucim::io::format::ImageReaderDesc image_reader = { reader_read };
     static cucim::io::format::ImageWriterDesc image_writer = { writer_write };
 
+    // Zarr directories can only be written.
+    static cucim::io::format::ImageCheckerDesc zarr_image_checker = { 0, 0, zarr_checker_is_valid };
+    static cucim::io::format::ImageParserDesc zarr_image_parser = { nullptr, nullptr, nullptr };
+    static cucim::io::format::ImageReaderDesc zarr_image_reader = { nullptr };
+    static cucim::io::format::ImageWriterDesc zarr_image_writer = { zarr_writer_write };
+
+    // PNG and JPEG files can only be written.
+    static cucim::io::format::ImageCheckerDesc raster_image_checker = { 0, 0, raster_checker_is_valid };
+    static cucim::io::format::ImageParserDesc raster_image_parser = { nullptr, nullptr, nullptr };
+    static cucim::io::format::ImageReaderDesc raster_image_reader = { nullptr };
+    static cucim::io::format::ImageWriterDesc raster_image_writer = { raster_writer_write };
+
     // clang-format off
-    static cucim::io::format::ImageFormatDesc image_format_desc = {
-        set_enabled,
-        is_enabled,
-        get_format_name,
-        image_checker,
-        image_parser,
-        image_reader,
-        image_writer
+    static cucim::io::format::ImageFormatDesc image_format_descs[] = {
+        {
+            set_enabled,
+            is_enabled,
+            get_format_name,
+            image_checker,
+            image_parser,
+            image_reader,
+            image_writer
+        },
+        {
+            set_enabled,
+            is_enabled,
+            zarr_get_format_name,
+            zarr_image_checker,
+            zarr_image_parser,
+            zarr_image_reader,
+            zarr_image_writer
+        },
+        {
+            set_enabled,
+            is_enabled,
+            raster_get_format_name,
+            raster_image_checker,
+            raster_image_parser,
+            raster_image_reader,
+            raster_image_writer
+        }
     };
     // clang-format on
 
     // clang-format off
     iface =
     {
-        &image_format_desc,
-        1
+        image_format_descs,
+        3
     };
     // clang-format on
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2025, NVIDIA CORPORATION
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -10,6 +10,7 @@
 
 #include "deflate.h"
 
+#include <memory>
 #include <stdexcept>
 #include <unistd.h>
 
@@ -93,4 +94,36 @@ bool decode_deflate(int fd,
     return true;
 }
 
+void encode_deflate(const uint8_t* src, uint64_t src_nbytes, int level, std::vector<uint8_t>& dest)
+{
+    // A compressor is created once per thread (and compression level).
+    thread_local std::unique_ptr<libdeflate_compressor, decltype(&libdeflate_free_compressor)> compressor(
+        nullptr, libdeflate_free_compressor);
+    thread_local int compressor_level = 0;
+    if (!compressor || compressor_level != level)
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(libdeflate_alloc_compressor));
+        compressor.reset(libdeflate_alloc_compressor(level));
+        if (!compressor)
+        {
+            throw std::runtime_error("Unable to allocate compressor for libdeflate!");
+        }
+        compressor_level = level;
+    }
+
+    const size_t dest_offset = dest.size();
+    dest.resize(dest_offset + libdeflate_zlib_compress_bound(compressor.get(), src_nbytes));
+    size_t out_size;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(libdeflate_zlib_compress));
+        out_size = libdeflate_zlib_compress(
+            compressor.get(), src, src_nbytes, dest.data() + dest_offset, dest.size() - dest_offset);
+    }
+    if (out_size == 0)
+    {
+        throw std::runtime_error("Unable to compress data with libdeflate!");
+    }
+    dest.resize(dest_offset + out_size);
+}
+
 } // namespace cuslide::deflate
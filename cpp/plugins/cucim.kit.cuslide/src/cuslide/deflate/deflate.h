@@ -1,10 +1,12 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2025, NVIDIA CORPORATION
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION
  * SPDX-License-Identifier: Apache-2.0
  */
 #ifndef CUSLIDE_DEFLATE_H
 #define CUSLIDE_DEFLATE_H
 
+#include <vector>
+
 #include <cucim/io/device.h>
 
 namespace cuslide::deflate
@@ -17,5 +19,12 @@ bool decode_deflate(int fd,
                     uint8_t** dest,
                     uint64_t dest_nbytes,
                     const cucim::io::Device& out_device);
+
+/**
+ * Compresses `src` into a zlib stream (TIFF's Adobe Deflate compression) appended to `dest`.
+ *
+ * @param level compression level (1-12)
+ */
+void encode_deflate(const uint8_t* src, uint64_t src_nbytes, int level, std::vector<uint8_t>& dest);
 }
 #endif // CUSLIDE_DEFLATE_H
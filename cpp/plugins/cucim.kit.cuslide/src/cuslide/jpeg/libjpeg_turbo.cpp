@@ -1,6 +1,6 @@
 /*
  * SPDX-FileCopyrightText: Copyright (C) 2009-2020 D. R. Commander.
- * SPDX-FileCopyrightText: Copyright (c) 2020-2025, NVIDIA CORPORATION
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION
  * SPDX-License-Identifier: Apache-2.0 AND BSD-3-Clause AND IJG-short AND Zlib
  */
 
@@ -18,11 +18,14 @@
 #include "libjpeg_turbo.h"
 
 #include <cstring>
+#include <memory>
+#include <stdexcept>
 #include <jpeglib.h>
 #include <setjmp.h>
 #include <unistd.h>
 
 #include <cucim/profiler/nvtx3.h>
+#include <fmt/format.h>
 #include <turbojpeg.h>
 
 static thread_local char errStr[JMSG_LENGTH_MAX] = "No error";
@@ -100,6 +103,129 @@ static J_COLOR_SPACE pf2cs[TJ_NUMPF] = { JCS_EXT_RGB,  JCS_EXT_BGR,  JCS_EXT_RGB
 
 // static const char* colorspaceName[TJ_NUMCS] = { "RGB", "YCbCr", "GRAY", "CMYK", "YCCK" };
 
+struct JpegTables
+{
+    bool has_quant_tbl[NUM_QUANT_TBLS] = {};
+    JQUANT_TBL quant_tbl[NUM_QUANT_TBLS];
+    bool has_dc_huff_tbl[NUM_HUFF_TBLS] = {};
+    JHUFF_TBL dc_huff_tbl[NUM_HUFF_TBLS];
+    bool has_ac_huff_tbl[NUM_HUFF_TBLS] = {};
+    JHUFF_TBL ac_huff_tbl[NUM_HUFF_TBLS];
+};
+
+/**
+ * Returns the decompressor of the current thread.
+ *
+ * The decompressor is created once per worker thread and reused for all tiles decoded by the thread.
+ *
+ * @param reset destroy the current decompressor (e.g., after an error) and create a new one
+ */
+static tjhandle thread_decompressor(bool reset = false)
+{
+    thread_local std::unique_ptr<void, decltype(&tjDestroy)> instance(nullptr, tjDestroy);
+    if (reset)
+    {
+        instance.reset();
+    }
+    if (!instance)
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjInitDecompress));
+        instance.reset(tjInitDecompress());
+    }
+    return instance.get();
+}
+
+/**
+ * Copies parsed jpeg tables into the decompressor.
+ *
+ * Tables are allocated in the permanent pool of the decompressor so they survive jpeg_abort_decompress() and are
+ * used by the next abbreviated image stream.
+ */
+static bool load_jpeg_tables(const void* handle, const JpegTables* jpeg_tables)
+{
+    tjinstance* instance = (tjinstance*)handle;
+    j_decompress_ptr dinfo = &instance->dinfo;
+    j_common_ptr cinfo = reinterpret_cast<j_common_ptr>(dinfo);
+
+    if (setjmp(instance->jerr.setjmp_buffer))
+    {
+        /* If we get here, the JPEG code has signaled an error. */
+        return false;
+    }
+
+    for (int i = 0; i < NUM_QUANT_TBLS; ++i)
+    {
+        if (jpeg_tables->has_quant_tbl[i])
+        {
+            if (dinfo->quant_tbl_ptrs[i] == nullptr)
+            {
+                dinfo->quant_tbl_ptrs[i] = jpeg_alloc_quant_table(cinfo);
+            }
+            *dinfo->quant_tbl_ptrs[i] = jpeg_tables->quant_tbl[i];
+        }
+    }
+    for (int i = 0; i < NUM_HUFF_TBLS; ++i)
+    {
+        if (jpeg_tables->has_dc_huff_tbl[i])
+        {
+            if (dinfo->dc_huff_tbl_ptrs[i] == nullptr)
+            {
+                dinfo->dc_huff_tbl_ptrs[i] = jpeg_alloc_huff_table(cinfo);
+            }
+            *dinfo->dc_huff_tbl_ptrs[i] = jpeg_tables->dc_huff_tbl[i];
+        }
+        if (jpeg_tables->has_ac_huff_tbl[i])
+        {
+            if (dinfo->ac_huff_tbl_ptrs[i] == nullptr)
+            {
+                dinfo->ac_huff_tbl_ptrs[i] = jpeg_alloc_huff_table(cinfo);
+            }
+            *dinfo->ac_huff_tbl_ptrs[i] = jpeg_tables->ac_huff_tbl[i];
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<const JpegTables> parse_jpeg_tables(const void* jpegtable_data, uint32_t jpegtable_count)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_read_jpeg_header_tables));
+    if (jpegtable_data == nullptr || jpegtable_count == 0)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<void, decltype(&tjDestroy)> instance(tjInitDecompress(), tjDestroy);
+    if (!instance || !read_jpeg_header_tables(instance.get(), jpegtable_data, jpegtable_count))
+    {
+        return nullptr;
+    }
+
+    auto jpeg_tables = std::make_shared<JpegTables>();
+    j_decompress_ptr dinfo = &static_cast<tjinstance*>(instance.get())->dinfo;
+    for (int i = 0; i < NUM_QUANT_TBLS; ++i)
+    {
+        if (dinfo->quant_tbl_ptrs[i])
+        {
+            jpeg_tables->has_quant_tbl[i] = true;
+            jpeg_tables->quant_tbl[i] = *dinfo->quant_tbl_ptrs[i];
+        }
+    }
+    for (int i = 0; i < NUM_HUFF_TBLS; ++i)
+    {
+        if (dinfo->dc_huff_tbl_ptrs[i])
+        {
+            jpeg_tables->has_dc_huff_tbl[i] = true;
+            jpeg_tables->dc_huff_tbl[i] = *dinfo->dc_huff_tbl_ptrs[i];
+        }
+        if (dinfo->ac_huff_tbl_ptrs[i])
+        {
+            jpeg_tables->has_ac_huff_tbl[i] = true;
+            jpeg_tables->ac_huff_tbl[i] = *dinfo->ac_huff_tbl_ptrs[i];
+        }
+    }
+    return jpeg_tables;
+}
+
 bool decode_libjpeg(int fd,
                     unsigned char* jpeg_buf,
                     uint64_t offset,
@@ -109,6 +235,28 @@ bool decode_libjpeg(int fd,
                     uint8_t** dest,
                     const cucim::io::Device& out_device,
                     int jpeg_color_space)
+{
+    std::shared_ptr<const JpegTables> jpeg_tables;
+    if (jpegtable_count)
+    {
+        jpeg_tables = parse_jpeg_tables(jpegtable_data, jpegtable_count);
+        if (!jpeg_tables)
+        {
+            printf("ERROR in line %d while %s\n", __LINE__, "reading JPEG header tables");
+            return false;
+        }
+    }
+    return decode_libjpeg(fd, jpeg_buf, offset, size, jpeg_tables.get(), dest, out_device, jpeg_color_space);
+}
+
+bool decode_libjpeg(int fd,
+                    unsigned char* jpeg_buf,
+                    uint64_t offset,
+                    uint64_t size,
+                    const JpegTables* jpeg_tables,
+                    uint8_t** dest,
+                    const cucim::io::Device& out_device,
+                    int jpeg_color_space)
 {
     (void)out_device;
 
@@ -156,35 +304,30 @@ bool decode_libjpeg(int fd,
         jpeg_buf += offset;
     }
 
+    if ((tjInstance = thread_decompressor()) == nullptr)
+        THROW_TJ("initializing decompressor");
+
+    // Load pre-parsed jpeg tables if exists
+    if (jpeg_tables && !load_jpeg_tables(tjInstance, jpeg_tables))
     {
-        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjInitDecompress));
-        if ((tjInstance = tjInitDecompress()) == nullptr)
-            THROW_TJ("initializing decompressor");
+        THROW_TJ("loading JPEG header tables");
     }
 
-    // Read jpeg tables if exists
-    if (jpegtable_count)
+    // Allocate memory only when dest is not null.
+    // Otherwise, the image size is not needed in advance (width/height of 0 means the size of the JPEG image).
+    width = 0;
+    height = 0;
+    if (*dest == nullptr)
     {
-        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_read_jpeg_header_tables));
-        if (!read_jpeg_header_tables(tjInstance, jpegtable_data, jpegtable_count))
         {
-            THROW_TJ("reading JPEG header tables");
+            PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjDecompressHeader3));
+            if (tjDecompressHeader3(tjInstance, jpeg_buf, size, &width, &height, &inSubsamp, &inColorspace) < 0)
+                THROW_TJ("reading JPEG header");
         }
-    }
-
-    {
-        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjDecompressHeader3));
-        if (tjDecompressHeader3(tjInstance, jpeg_buf, size, &width, &height, &inSubsamp, &inColorspace) < 0)
-            THROW_TJ("reading JPEG header");
-    }
 
-    //    printf("%s Image:  %d x %d pixels, %s subsampling, %s colorspace\n", (doTransform ? "Transformed" : "Input"),
-    //    width,
-    //           height, subsampName[inSubsamp], colorspaceName[inColorspace]);
+        //    printf("%s Image:  %d x %d pixels, %s subsampling, %s colorspace\n", (doTransform ? "Transformed" :
+        //    "Input"), width, height, subsampName[inSubsamp], colorspaceName[inColorspace]);
 
-    // Allocate memory only when dest is not null
-    if (*dest == nullptr)
-    {
         PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjAlloc));
         if ((*dest = (unsigned char*)tjAlloc(width * height * tjPixelSize[pixelFormat])) == nullptr)
             THROW_UNIX("Unable to allocate uncompressed image buffer");
@@ -202,15 +345,15 @@ bool decode_libjpeg(int fd,
         PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjFree));
         tjFree(jpeg_buf);
     }
-    {
-        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjDestroy));
-        tjDestroy(tjInstance);
-    }
     return true;
 
 bailout:
+    // Do not reuse the decompressor in an unknown state.
     if (tjInstance)
-        tjDestroy(tjInstance);
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(decoder_libjpeg_turbo_tjDestroy));
+        thread_decompressor(true);
+    }
     if (fd != -1)
     {
         tjFree(jpeg_buf);
@@ -390,4 +533,58 @@ bailout:
     return false;
 }
 
+void encode_libjpeg(const uint8_t* src,
+                    uint32_t width,
+                    uint32_t height,
+                    uint32_t samples_per_pixel,
+                    int quality,
+                    std::vector<uint8_t>& dest)
+{
+    int pixel_format;
+    int subsampling;
+    switch (samples_per_pixel)
+    {
+    case 1:
+        pixel_format = TJPF_GRAY;
+        subsampling = TJSAMP_GRAY;
+        break;
+    case 3:
+        pixel_format = TJPF_RGB;
+        subsampling = TJSAMP_420;
+        break;
+    default:
+        throw std::runtime_error(
+            fmt::format("JPEG encoding of {} samples per pixel is not supported!", samples_per_pixel));
+    }
+
+    // The compressor is created once per thread.
+    thread_local std::unique_ptr<void, decltype(&tjDestroy)> instance(nullptr, tjDestroy);
+    if (!instance)
+    {
+        instance.reset(tjInitCompress());
+        if (!instance)
+        {
+            throw std::runtime_error("Unable to initialize the JPEG compressor!");
+        }
+    }
+
+    const size_t dest_offset = dest.size();
+    dest.resize(dest_offset + tjBufSize(width, height, subsampling));
+    unsigned char* jpeg_buf = dest.data() + dest_offset;
+    unsigned long jpeg_size = dest.size() - dest_offset;
+    int result;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(encoder_libjpeg_turbo_tjCompress2));
+        result = tjCompress2(instance.get(), src, width, width * samples_per_pixel, height, pixel_format, &jpeg_buf,
+                             &jpeg_size, subsampling, quality, TJFLAG_NOREALLOC);
+    }
+    if (result < 0)
+    {
+        std::string message = tjGetErrorStr2(instance.get());
+        instance.reset();
+        throw std::runtime_error(fmt::format("Unable to encode JPEG: {}", message));
+    }
+    dest.resize(dest_offset + jpeg_size);
+}
+
 } // namespace cuslide::jpeg
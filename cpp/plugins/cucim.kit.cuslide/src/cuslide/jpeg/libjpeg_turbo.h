@@ -1,15 +1,44 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2025, NVIDIA CORPORATION
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION
  * SPDX-License-Identifier: Apache-2.0
  */
 #ifndef CUSLIDE_LIBJPEG_TURBO_H
 #define CUSLIDE_LIBJPEG_TURBO_H
 
+#include <memory>
+#include <vector>
+
 #include <cucim/io/device.h>
 
 namespace cuslide::jpeg
 {
 
+/**
+ * Quantization and Huffman tables parsed from an abbreviated table-specification stream (TIFFTAG_JPEGTABLES).
+ *
+ * Tables are parsed once per IFD and copied into the (thread-local) decompressor before decoding each tile, so
+ * per-tile work starts at the markers of the tile stream instead of re-parsing the table bytes.
+ */
+struct JpegTables;
+
+/**
+ * Parses jpeg header tables (TIFFTAG_JPEGTABLES) into a reusable form.
+ *
+ * @param jpegtable_data jpeg tables data
+ * @param jpegtable_count jpeg tables size
+ * @return parsed tables, or nullptr if the tables cannot be parsed
+ */
+std::shared_ptr<const JpegTables> parse_jpeg_tables(const void* jpegtable_data, uint32_t jpegtable_count);
+
+bool decode_libjpeg(int fd,
+                    unsigned char* jpeg_buf,
+                    uint64_t offset,
+                    uint64_t size,
+                    const JpegTables* jpeg_tables,
+                    uint8_t** dest,
+                    const cucim::io::Device& out_device,
+                    int jpeg_color_space = 0 /* 0: JCS_UNKNOWN, 2: JCS_RGB, 3: JCS_YCbCr */);
+
 bool decode_libjpeg(int fd,
                     unsigned char* jpeg_buf,
                     uint64_t offset,
@@ -49,6 +78,22 @@ int jpeg_decode_buffer(const void* handle,
 
 bool get_dimension(const void* image_buf, uint64_t offset, uint64_t size, int* out_width, int* out_height);
 
+/**
+ * Encodes an 8-bit image into a JPEG stream (with its own tables) appended to `dest`.
+ *
+ * RGB images (3 samples per pixel) are stored as YCbCr with 4:2:0 chroma subsampling and grayscale images (1 sample per
+ * pixel) as a single component.
+ *
+ * @param src interleaved pixels (`width` * `samples_per_pixel` bytes per row)
+ * @param quality JPEG quality (1-100)
+ */
+void encode_libjpeg(const uint8_t* src,
+                    uint32_t width,
+                    uint32_t height,
+                    uint32_t samples_per_pixel,
+                    int quality,
+                    std::vector<uint8_t>& dest);
+
 } // namespace cuslide::jpeg
 
 
@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Code below is using libjxl library which is under BSD-3-Clause License
+ * Please see LICENSE-3rdparty.md for the detail.
+ */
+
+#include "libjxl.h"
+
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+#include <cucim/memory/memory_manager.h>
+#include <cucim/profiler/nvtx3.h>
+#include <fmt/format.h>
+
+#include <jxl/decode.h>
+
+namespace cuslide::jpegxl
+{
+
+/**
+ * @brief Return the decoder of the current thread.
+ *
+ * Tiles are already decoded in parallel by the loader so each decoder runs single-threaded. The decoder is created
+ * once per worker thread and reset (which keeps its allocations) before decoding each tile.
+ */
+static JxlDecoder* thread_decoder()
+{
+    thread_local std::unique_ptr<JxlDecoder, decltype(&JxlDecoderDestroy)> decoder(nullptr, JxlDecoderDestroy);
+    if (!decoder)
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(libjxl_create_decoder));
+        decoder.reset(JxlDecoderCreate(nullptr));
+        if (!decoder)
+        {
+            throw std::runtime_error("Unable to create decoder for libjxl!");
+        }
+    }
+    else
+    {
+        JxlDecoderReset(decoder.get());
+    }
+    return decoder.get();
+}
+
+static JxlDataType to_jxl_data_type(uint32_t bits_per_sample, bool is_float)
+{
+    if (is_float)
+    {
+        switch (bits_per_sample)
+        {
+        case 16:
+            return JXL_TYPE_FLOAT16;
+        case 32:
+            return JXL_TYPE_FLOAT;
+        }
+    }
+    else
+    {
+        switch (bits_per_sample)
+        {
+        case 8:
+            return JXL_TYPE_UINT8;
+        case 16:
+            return JXL_TYPE_UINT16;
+        }
+    }
+    throw std::runtime_error(
+        fmt::format("JPEG XL doesn't support {}-bit {} samples", bits_per_sample, is_float ? "float" : "integer"));
+}
+
+bool decode_libjxl(int fd,
+                   unsigned char* jxl_buf,
+                   uint64_t offset,
+                   uint64_t size,
+                   uint8_t** dest,
+                   uint64_t dest_nbytes,
+                   uint32_t samples_per_pixel,
+                   uint32_t bits_per_sample,
+                   bool is_float,
+                   const cucim::io::Device& out_device)
+{
+    (void)out_device;
+
+    if (dest == nullptr)
+    {
+        throw std::runtime_error("'dest' shouldn't be nullptr in decode_libjxl()");
+    }
+    if (samples_per_pixel < 1 || samples_per_pixel > 4)
+    {
+        throw std::runtime_error(
+            fmt::format("JPEG XL supports 1 to 4 samples per pixel (samples per pixel: {})", samples_per_pixel));
+    }
+    JxlPixelFormat pixel_format{ samples_per_pixel, to_jxl_data_type(bits_per_sample, is_float), JXL_NATIVE_ENDIAN, 0 };
+
+    // Allocate memory only when dest is not null
+    if (*dest == nullptr)
+    {
+        if ((*dest = (unsigned char*)cucim_malloc(dest_nbytes)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate uncompressed image buffer");
+        }
+    }
+
+    if (jxl_buf == nullptr)
+    {
+        if ((jxl_buf = (unsigned char*)cucim_malloc(size)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate buffer for libjxl!");
+        }
+
+        if (pread(fd, jxl_buf, size, offset) < 1)
+        {
+            cucim_free(jxl_buf);
+            throw std::runtime_error("Unable to read file for libjxl!");
+        }
+    }
+    else
+    {
+        fd = -1;
+        jxl_buf += offset;
+    }
+
+    const char* error_message = nullptr;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(libjxl_decode));
+        JxlDecoder* decoder = thread_decoder();
+
+        if (JxlDecoderSubscribeEvents(decoder, JXL_DEC_FULL_IMAGE) != JXL_DEC_SUCCESS ||
+            JxlDecoderSetInput(decoder, jxl_buf, size) != JXL_DEC_SUCCESS)
+        {
+            error_message = "Unable to initialize decoder for libjxl!";
+        }
+        JxlDecoderCloseInput(decoder);
+
+        bool is_done = (error_message != nullptr);
+        while (!is_done)
+        {
+            switch (JxlDecoderProcessInput(decoder))
+            {
+            case JXL_DEC_NEED_IMAGE_OUT_BUFFER: {
+                size_t buffer_nbytes = 0;
+                if (JxlDecoderImageOutBufferSize(decoder, &pixel_format, &buffer_nbytes) != JXL_DEC_SUCCESS ||
+                    buffer_nbytes > dest_nbytes ||
+                    JxlDecoderSetImageOutBuffer(decoder, &pixel_format, *dest, buffer_nbytes) != JXL_DEC_SUCCESS)
+                {
+                    error_message = "Unable to set output buffer for libjxl!";
+                    is_done = true;
+                }
+                break;
+            }
+            case JXL_DEC_FULL_IMAGE:
+            case JXL_DEC_SUCCESS:
+                // A tile holds a single frame.
+                is_done = true;
+                break;
+            case JXL_DEC_NEED_MORE_INPUT:
+                error_message = "Truncated JPEG XL data!";
+                is_done = true;
+                break;
+            default:
+                error_message = "Unable to decode JPEG XL data!";
+                is_done = true;
+                break;
+            }
+        }
+    }
+
+    if (fd != -1)
+    {
+        cucim_free(jxl_buf);
+    }
+
+    if (error_message)
+    {
+        throw std::runtime_error(error_message);
+    }
+    return true;
+}
+
+} // namespace cuslide::jpegxl
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CUSLIDE_LIBJXL_H
+#define CUSLIDE_LIBJXL_H
+
+#include <cucim/io/device.h>
+
+namespace cuslide::jpegxl
+{
+constexpr uint32_t kCompressionJpegXl = 50002; // JPEG XL (COMPRESSION_JXL in libtiff)
+
+/**
+ * @brief Decode a JPEG XL-compressed tile into interleaved samples.
+ *
+ * @param bits_per_sample 8 or 16 for unsigned integer samples, 16 or 32 for floating point samples.
+ * @param is_float Whether the samples are floating point (SAMPLEFORMAT_IEEEFP).
+ */
+bool decode_libjxl(int fd,
+                   unsigned char* jxl_buf,
+                   uint64_t offset,
+                   uint64_t size,
+                   uint8_t** dest,
+                   uint64_t dest_nbytes,
+                   uint32_t samples_per_pixel,
+                   uint32_t bits_per_sample,
+                   bool is_float,
+                   const cucim::io::Device& out_device);
+
+} // namespace cuslide::jpegxl
+
+#endif // CUSLIDE_LIBJXL_H
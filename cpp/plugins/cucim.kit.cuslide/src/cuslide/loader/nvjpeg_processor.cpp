@@ -95,9 +95,9 @@ NvJpegProcessor::NvJpegProcessor(CuCIMFileHandle* file_handle,
         }
 
         // Read file block in advance
-        tile_width_ = ifd->tile_width();
+        tile_width_ = ifd->image_piece_width();
         tile_width_bytes_ = tile_width_ * ifd->pixel_size_nbytes();
-        tile_height_ = ifd->tile_height();
+        tile_height_ = ifd->image_piece_height();
         tile_raster_nbytes_ = tile_width_bytes_ * tile_height_;
 
         struct stat sb;
@@ -60,9 +60,30 @@ namespace cuslide::lzw
 // The following implementation is based on:
 //   https://github.com/uclouvain/openjpeg/blob/37ac30ceff6640bbab502388c5e0fa0bff23f505/thirdparty/libtiff/tif_predict.c#L268
 
-void horAcc8(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes)
+template <typename T>
+static void horAccN(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes, tmsize_t stride)
+{
+    T* wp = reinterpret_cast<T*>(cp0);
+    const tmsize_t wc = width_nbytes / sizeof(T);
+    while (cc > 0)
+    {
+        for (tmsize_t i = stride; i < wc; ++i)
+        {
+            wp[i] = static_cast<T>(wp[i] + wp[i - stride]);
+        }
+        wp += wc;
+        cc -= width_nbytes;
+    }
+}
+
+void horAcc8(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes, tmsize_t stride)
 {
     PROF_SCOPED_RANGE(PROF_EVENT(lzw_horAcc8));
+    if (stride != 3)
+    {
+        horAccN<uint8_t>(cp0, cc, width_nbytes, stride);
+        return;
+    }
     unsigned char* cp = (unsigned char*)cp0;
     while (cc > 0)
     {
@@ -84,6 +105,18 @@ void horAcc8(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes)
     }
 }
 
+void horAcc16(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes, tmsize_t stride)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(lzw_horAcc16));
+    horAccN<uint16_t>(cp0, cc, width_nbytes, stride);
+}
+
+void horAcc32(uint8_t* cp0, tmsize_t cc, tmsize_t width_nbytes, tmsize_t stride)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(lzw_horAcc32));
+    horAccN<uint32_t>(cp0, cc, width_nbytes, stride);
+}
+
 // **************************************************************************
 
 /*
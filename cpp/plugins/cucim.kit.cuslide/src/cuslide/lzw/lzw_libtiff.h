@@ -79,7 +79,9 @@ struct TIFF
 
 int TIFFInitLZW(TIFF* tif, int scheme = COMPRESSION_LZW);
 
-void horAcc8(uint8_t* cp0, tmsize_t cc, tmsize_t row_size);
+void horAcc8(uint8_t* cp0, tmsize_t cc, tmsize_t row_size, tmsize_t stride = 3);
+void horAcc16(uint8_t* cp0, tmsize_t cc, tmsize_t row_size, tmsize_t stride);
+void horAcc32(uint8_t* cp0, tmsize_t cc, tmsize_t row_size, tmsize_t stride);
 
 } // namespace cuslide::lzw
 #endif // CUSLIDE_LZW_LIBTIFF_H
@@ -0,0 +1,506 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "raster_writer.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <libdeflate.h>
+
+#include <cucim/concurrent/threadpool.h>
+#include <cucim/profiler/nvtx3.h>
+
+#include "cuslide/deflate/deflate.h"
+#include "cuslide/jpeg/libjpeg_turbo.h"
+
+namespace cuslide::raster
+{
+
+namespace
+{
+
+constexpr uint32_t kStripHeight = 256;
+constexpr int kDeflateLevel = 6;
+constexpr uint32_t kMaxJpegSize = 65500; // JPEG_MAX_DIMENSION of libjpeg
+constexpr size_t kPngChunkSize = 1 << 24; // maximum size of an IDAT chunk
+
+using Encoded = std::vector<uint8_t>;
+// Encodes `row_count` rows (`previous_row` is the row above them or nullptr for the first row of the image).
+using EncodeStrip = std::function<void(const uint8_t* rows, const uint8_t* previous_row, uint32_t row_count, Encoded&)>;
+// Writes an encoded strip (called in order of the strips).
+using WriteStrip = std::function<void(uint32_t strip_index, Encoded&)>;
+
+class OutputFile
+{
+public:
+    explicit OutputFile(const std::string& path) : path_(path)
+    {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+        {
+            throw std::runtime_error(fmt::format("Unable to create '{}': {}", path, std::strerror(errno)));
+        }
+    }
+    ~OutputFile()
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    void write(std::vector<iovec> iov)
+    {
+        size_t index = 0;
+        while (index < iov.size())
+        {
+            if (iov[index].iov_len == 0)
+            {
+                ++index;
+                continue;
+            }
+            const int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+            ssize_t written = ::writev(fd_, &iov[index], count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error(fmt::format("Unable to write '{}': {}", path_, std::strerror(errno)));
+            }
+            // Skip the written buffers (and the written part of a partially written buffer).
+            while (written > 0)
+            {
+                if (static_cast<size_t>(written) >= iov[index].iov_len)
+                {
+                    written -= iov[index].iov_len;
+                    ++index;
+                }
+                else
+                {
+                    iov[index].iov_base = static_cast<uint8_t*>(iov[index].iov_base) + written;
+                    iov[index].iov_len -= written;
+                    written = 0;
+                }
+            }
+        }
+    }
+
+    void close()
+    {
+        const int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) != 0)
+        {
+            throw std::runtime_error(fmt::format("Unable to close '{}': {}", path_, std::strerror(errno)));
+        }
+    }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+};
+
+iovec make_iovec(const void* data, size_t size)
+{
+    return { const_cast<void*>(data), size };
+}
+
+/**
+ * Read the image in strips of `strip_height` rows, encode the strips in parallel on the executor and write them in
+ * order, with a bounded number of strips in flight.
+ */
+void process_strips(const cucim::io::format::ImageWriterRequestDesc& request,
+                    uint32_t strip_height,
+                    const EncodeStrip& encode,
+                    const WriteStrip& write)
+{
+    struct PendingStrip
+    {
+        std::future<void> done;
+        std::shared_ptr<Encoded> data;
+    };
+
+    const size_t row_nbytes = static_cast<size_t>(request.width) * request.samples_per_pixel;
+    const bool is_worker_thread = cucim::concurrent::ThreadPool::is_worker_thread();
+    const size_t max_pending = std::max<size_t>(2, 2 * cucim::concurrent::ThreadPool::shared_worker_count());
+    std::deque<PendingStrip> pending;
+    uint32_t strip_index = 0;
+    auto write_next = [&]() {
+        PendingStrip strip = std::move(pending.front());
+        pending.pop_front();
+        strip.done.get(); // rethrows an encoding error
+        write(strip_index++, *strip.data);
+    };
+
+    try
+    {
+        std::shared_ptr<const std::vector<uint8_t>> previous_row;
+        for (int64_t row = 0; row < request.height; row += strip_height)
+        {
+            const uint32_t row_count = static_cast<uint32_t>(std::min<int64_t>(strip_height, request.height - row));
+            std::shared_ptr<uint8_t[]> band(new uint8_t[row_count * row_nbytes]);
+            if (!request.read_rows(request.context, 0, row, row_count, band.get()))
+            {
+                throw std::runtime_error(
+                    fmt::format("Unable to read rows {}-{} of the source image!", row, row + row_count - 1));
+            }
+            auto data = std::make_shared<Encoded>();
+            auto encode_strip = [&encode, band, previous_row, row_count, data]() {
+                PROF_SCOPED_RANGE(PROF_EVENT(raster_writer_encode_strip));
+                encode(band.get(), previous_row ? previous_row->data() : nullptr, row_count, *data);
+            };
+            const uint8_t* last_row = band.get() + (row_count - 1) * row_nbytes;
+            previous_row = std::make_shared<const std::vector<uint8_t>>(last_row, last_row + row_nbytes);
+
+            if (is_worker_thread)
+            {
+                // A task on the executor shouldn't wait for other tasks of the executor.
+                encode_strip();
+                write(strip_index++, *data);
+                continue;
+            }
+            pending.push_back({ cucim::concurrent::ThreadPool::submit(std::move(encode_strip)), std::move(data) });
+            while (pending.size() > max_pending)
+            {
+                write_next();
+            }
+        }
+        while (!pending.empty())
+        {
+            write_next();
+        }
+    }
+    catch (...)
+    {
+        // `encode` is used by the strips in flight.
+        for (auto& strip : pending)
+        {
+            strip.done.wait();
+        }
+        throw;
+    }
+}
+
+uint16_t read_uint16_be(const uint8_t* data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+void store_uint32_be(uint8_t* dest, uint32_t value)
+{
+    dest[0] = static_cast<uint8_t>(value >> 24);
+    dest[1] = static_cast<uint8_t>(value >> 16);
+    dest[2] = static_cast<uint8_t>(value >> 8);
+    dest[3] = static_cast<uint8_t>(value);
+}
+
+////////////////////
+// JPEG
+////////////////////
+
+struct JpegLayout
+{
+    size_t sof_offset = 0; // offset of the SOF0/SOF1 marker
+    size_t sos_offset = 0; // offset of the SOS marker
+    size_t scan_offset = 0; // offset of the entropy-coded data (after the SOS segment)
+    size_t scan_end = 0; // offset of the EOI marker
+};
+
+JpegLayout parse_jpeg(const Encoded& data)
+{
+    JpegLayout layout;
+    size_t pos = 2; // after SOI
+    while (pos + 4 <= data.size() && !layout.scan_offset)
+    {
+        if (data[pos] != 0xFF)
+        {
+            break;
+        }
+        const uint8_t marker = data[pos + 1];
+        if (marker == 0xFF) // fill byte
+        {
+            ++pos;
+            continue;
+        }
+        const uint16_t length = read_uint16_be(&data[pos + 2]);
+        if (marker == 0xC0 || marker == 0xC1)
+        {
+            layout.sof_offset = pos;
+        }
+        else if (marker == 0xDA)
+        {
+            layout.sos_offset = pos;
+            layout.scan_offset = pos + 2 + length;
+        }
+        pos += 2 + length;
+    }
+    const size_t size = data.size();
+    if (!layout.sof_offset || !layout.scan_offset || layout.scan_offset + 2 > size || data[size - 2] != 0xFF ||
+        data[size - 1] != 0xD9)
+    {
+        throw std::runtime_error("Unexpected layout of an encoded JPEG strip!");
+    }
+    layout.scan_end = size - 2;
+    return layout;
+}
+
+void check_jpeg(const cucim::io::format::ImageWriterRequestDesc& request)
+{
+    if (request.samples_per_pixel != 1 && request.samples_per_pixel != 3)
+    {
+        throw std::invalid_argument(fmt::format(
+            "JPEG files need 1 or 3 samples per pixel (samples per pixel: {})!", request.samples_per_pixel));
+    }
+    if (request.width > kMaxJpegSize || request.height > kMaxJpegSize)
+    {
+        throw std::invalid_argument(fmt::format("JPEG files can't be larger than {0}x{0} pixels (size: {1}x{2})!",
+                                                kMaxJpegSize, request.width, request.height));
+    }
+    if (request.quality < 1 || request.quality > 100)
+    {
+        throw std::invalid_argument(fmt::format("JPEG quality must be in [1, 100] (quality: {})!", request.quality));
+    }
+}
+
+void write_jpeg(const cucim::io::format::ImageWriterRequestDesc& request, OutputFile& file)
+{
+    const uint32_t width = static_cast<uint32_t>(request.width);
+    const uint32_t height = static_cast<uint32_t>(request.height);
+    const uint32_t samples_per_pixel = request.samples_per_pixel;
+    const int quality = request.quality;
+
+    // encode_libjpeg() uses 4:2:0 subsampling (16x16 MCUs) for RGB and 8x8 MCUs for grayscale images.
+    const uint32_t mcu_size = samples_per_pixel == 3 ? 16 : 8;
+    const uint32_t mcus_across = (width + mcu_size - 1) / mcu_size;
+    // A restart interval (the MCUs of a strip) is at most 65535 MCUs.
+    const uint32_t mcu_rows = std::max<uint32_t>(1, std::min<uint32_t>(kStripHeight / mcu_size, 0xFFFF / mcus_across));
+    const uint32_t strip_height = mcu_rows * mcu_size;
+    const uint32_t strip_count = (height + strip_height - 1) / strip_height;
+    const uint16_t restart_interval = static_cast<uint16_t>(mcus_across * mcu_rows);
+
+    // Strips are encoded with the same (standard) tables and end at MCU row boundaries, so the entropy-coded data of
+    // each strip is a restart interval of the whole image.
+    auto encode = [&](const uint8_t* rows, const uint8_t*, uint32_t row_count, Encoded& out) {
+        cuslide::jpeg::encode_libjpeg(rows, width, row_count, samples_per_pixel, quality, out);
+    };
+    auto write = [&](uint32_t strip_index, Encoded& data) {
+        const JpegLayout layout = parse_jpeg(data);
+        std::vector<uint8_t> header;
+        std::vector<iovec> iov;
+        if (strip_index == 0)
+        {
+            // The headers of the first strip, with the height of the image and the restart interval.
+            header.assign(data.begin(), data.begin() + layout.sos_offset);
+            header[layout.sof_offset + 5] = static_cast<uint8_t>(height >> 8);
+            header[layout.sof_offset + 6] = static_cast<uint8_t>(height);
+            header.insert(header.end(), { 0xFF, 0xDD, 0x00, 0x04, static_cast<uint8_t>(restart_interval >> 8),
+                                          static_cast<uint8_t>(restart_interval) });
+            header.insert(header.end(), data.begin() + layout.sos_offset, data.begin() + layout.scan_offset);
+            iov.push_back(make_iovec(header.data(), header.size()));
+        }
+        iov.push_back(make_iovec(data.data() + layout.scan_offset, layout.scan_end - layout.scan_offset));
+        // RSTn markers between the strips and EOI after the last one.
+        const uint8_t marker[2] = { 0xFF, static_cast<uint8_t>(
+                                              strip_index + 1 < strip_count ? 0xD0 + strip_index % 8 : 0xD9) };
+        iov.push_back(make_iovec(marker, sizeof(marker)));
+        file.write(std::move(iov));
+        Encoded().swap(data);
+    };
+    process_strips(request, strip_height, encode, write);
+}
+
+////////////////////
+// PNG
+////////////////////
+
+uint8_t paeth_predictor(uint8_t a, uint8_t b, uint8_t c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+    {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+/**
+ * Filter a row (`row_nbytes` bytes) into `out` (filter type and `row_nbytes` bytes).
+ *
+ * All five filters are tried and the one with the smallest sum of absolute (signed) differences is kept.
+ */
+void filter_row(const uint8_t* row, const uint8_t* previous_row, size_t row_nbytes, size_t bpp, uint8_t* out)
+{
+    thread_local std::vector<uint8_t> candidates;
+    candidates.resize(5 * row_nbytes);
+    uint64_t sums[5] = {};
+    for (size_t i = 0; i < row_nbytes; ++i)
+    {
+        const uint8_t x = row[i];
+        const uint8_t a = i >= bpp ? row[i - bpp] : 0;
+        const uint8_t b = previous_row[i];
+        const uint8_t c = i >= bpp ? previous_row[i - bpp] : 0;
+        const uint8_t values[5] = { x, static_cast<uint8_t>(x - a), static_cast<uint8_t>(x - b),
+                                    static_cast<uint8_t>(x - ((a + b) >> 1)),
+                                    static_cast<uint8_t>(x - paeth_predictor(a, b, c)) };
+        for (int filter = 0; filter < 5; ++filter)
+        {
+            candidates[filter * row_nbytes + i] = values[filter];
+            sums[filter] += std::abs(static_cast<int8_t>(values[filter]));
+        }
+    }
+    const int best = static_cast<int>(std::min_element(sums, sums + 5) - sums);
+    out[0] = static_cast<uint8_t>(best);
+    std::memcpy(out + 1, candidates.data() + best * row_nbytes, row_nbytes);
+}
+
+void check_png(const cucim::io::format::ImageWriterRequestDesc& request)
+{
+    if (request.samples_per_pixel < 1 || request.samples_per_pixel > 4)
+    {
+        throw std::invalid_argument(fmt::format(
+            "PNG files need 1, 2, 3 or 4 samples per pixel (samples per pixel: {})!", request.samples_per_pixel));
+    }
+    if (request.width > INT32_MAX || request.height > INT32_MAX)
+    {
+        throw std::invalid_argument(
+            fmt::format("Image is too large for a PNG file (size: {}x{})!", request.width, request.height));
+    }
+}
+
+void write_png(const cucim::io::format::ImageWriterRequestDesc& request, OutputFile& file)
+{
+    const size_t bpp = request.samples_per_pixel;
+    const size_t row_nbytes = static_cast<size_t>(request.width) * bpp;
+    const size_t filtered_row_nbytes = row_nbytes + 1; // with the filter type
+
+    // Rows are filtered in parallel. The filtered rows are a single zlib stream, which is compressed at once.
+    std::vector<uint8_t> filtered;
+    filtered.reserve(filtered_row_nbytes * request.height);
+    const std::vector<uint8_t> zero_row(row_nbytes, 0);
+    auto encode = [&](const uint8_t* rows, const uint8_t* previous_row, uint32_t row_count, Encoded& out) {
+        out.resize(filtered_row_nbytes * row_count);
+        for (uint32_t y = 0; y < row_count; ++y)
+        {
+            const uint8_t* prior = y ? rows + (y - 1) * row_nbytes : (previous_row ? previous_row : zero_row.data());
+            filter_row(rows + y * row_nbytes, prior, row_nbytes, bpp, out.data() + y * filtered_row_nbytes);
+        }
+    };
+    auto write = [&](uint32_t, Encoded& data) {
+        filtered.insert(filtered.end(), data.begin(), data.end());
+        Encoded().swap(data);
+    };
+    process_strips(request, kStripHeight, encode, write);
+
+    std::vector<uint8_t> compressed;
+    cuslide::deflate::encode_deflate(filtered.data(), filtered.size(), kDeflateLevel, compressed);
+    std::vector<uint8_t>().swap(filtered);
+
+    // Signature and IHDR (bit depth, color type (gray, gray + alpha, RGB or RGBA), compression, filter and interlace
+    // methods)
+    static constexpr uint8_t kColorTypes[4] = { 0, 4, 2, 6 };
+    uint8_t header[33] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 13, 'I', 'H', 'D', 'R' };
+    store_uint32_be(header + 16, static_cast<uint32_t>(request.width));
+    store_uint32_be(header + 20, static_cast<uint32_t>(request.height));
+    header[24] = 8;
+    header[25] = kColorTypes[bpp - 1];
+    store_uint32_be(header + 29, libdeflate_crc32(0, header + 12, 4 + 13));
+
+    // IDAT chunks (length and type, data, CRC) and IEND.
+    const size_t chunk_count = (compressed.size() + kPngChunkSize - 1) / kPngChunkSize;
+    std::vector<std::array<uint8_t, 8>> chunk_headers(chunk_count);
+    std::vector<std::array<uint8_t, 4>> chunk_crcs(chunk_count);
+    std::vector<iovec> iov;
+    iov.reserve(chunk_count * 3 + 2);
+    iov.push_back(make_iovec(header, sizeof(header)));
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        const uint8_t* data = compressed.data() + i * kPngChunkSize;
+        const uint32_t size = static_cast<uint32_t>(std::min(kPngChunkSize, compressed.size() - i * kPngChunkSize));
+        store_uint32_be(chunk_headers[i].data(), size);
+        std::memcpy(chunk_headers[i].data() + 4, "IDAT", 4);
+        store_uint32_be(chunk_crcs[i].data(), libdeflate_crc32(libdeflate_crc32(0, "IDAT", 4), data, size));
+
+        iov.push_back(make_iovec(chunk_headers[i].data(), chunk_headers[i].size()));
+        iov.push_back(make_iovec(data, size));
+        iov.push_back(make_iovec(chunk_crcs[i].data(), chunk_crcs[i].size()));
+    }
+    static constexpr uint8_t kIend[12] = { 0, 0, 0, 0, 'I', 'E', 'N', 'D', 0xAE, 0x42, 0x60, 0x82 };
+    iov.push_back(make_iovec(kIend, sizeof(kIend)));
+    file.write(std::move(iov));
+}
+
+} // namespace
+
+void write_image(const cucim::io::format::ImageWriterRequestDesc& request)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(raster_writer_write_image));
+    const std::string_view format = request.compression ? request.compression : "";
+    if (format != "png" && format != "jpeg")
+    {
+        throw std::invalid_argument(fmt::format("Image format '{}' is not supported (use 'png' or 'jpeg')!", format));
+    }
+    if (!request.file_path || !request.read_rows)
+    {
+        throw std::invalid_argument("File path and read_rows() are required to write an image!");
+    }
+    if (request.width <= 0 || request.height <= 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Invalid size ({}x{}) of the image to write!", request.width, request.height));
+    }
+    if (format == "png")
+    {
+        check_png(request);
+    }
+    else
+    {
+        check_jpeg(request);
+    }
+
+    const std::string path = request.file_path;
+    OutputFile file(path);
+    try
+    {
+        if (format == "png")
+        {
+            write_png(request, file);
+        }
+        else
+        {
+            write_jpeg(request, file);
+        }
+        file.close();
+    }
+    catch (...)
+    {
+        ::unlink(path.c_str());
+        throw;
+    }
+}
+
+} // namespace cuslide::raster
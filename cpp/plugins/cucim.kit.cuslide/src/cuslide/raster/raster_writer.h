@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUSLIDE_RASTER_WRITER_H
+#define CUSLIDE_RASTER_WRITER_H
+
+#include <cucim/io/format/image_format.h>
+
+namespace cuslide::raster
+{
+
+/**
+ * @brief Write an image (level 0 only) as a PNG or JPEG file (`request->compression`: 'png' or 'jpeg').
+ *
+ * Source rows are read (`request->read_rows`) in strips that are processed in parallel on the process-wide executor:
+ *
+ * - JPEG: each strip is encoded separately (its height is a multiple of the MCU height) and the entropy-coded data of
+ *   the strips are joined with restart markers (DRI), which makes a single baseline JPEG stream.
+ * - PNG: the rows of each strip are filtered (the filter with the smallest sum of absolute differences is chosen for
+ *   each row), and the filtered rows are compressed as one zlib stream.
+ *
+ * Throws std::invalid_argument for an unsupported request and std::runtime_error if writing fails (the partial file
+ * is removed).
+ */
+void write_image(const cucim::io::format::ImageWriterRequestDesc& request);
+
+} // namespace cuslide::raster
+
+#endif // CUSLIDE_RASTER_WRITER_H
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUSLIDE_TIFF_DOWNSAMPLE_H
+#define CUSLIDE_TIFF_DOWNSAMPLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cuslide::tiff
+{
+
+/**
+ * @brief Average each 2x2 block of 8-bit pixels (rounded to the nearest integer) into a pixel.
+ *
+ * @param src Source rows (2 * `height` rows of at least 2 * `width` pixels, `src_stride` bytes apart)
+ * @param dest Destination rows (`height` rows of `width` pixels, `dest_stride` bytes apart)
+ * @param pixel_nbytes Number of (interleaved) samples of a pixel
+ */
+inline void downsample_2x2(const uint8_t* src,
+                           size_t src_stride,
+                           uint8_t* dest,
+                           size_t dest_stride,
+                           uint32_t width,
+                           uint32_t height,
+                           size_t pixel_nbytes)
+{
+    const size_t row_nbytes = width * pixel_nbytes;
+    for (uint32_t y = 0; y < height; ++y, src += src_stride * 2, dest += dest_stride)
+    {
+        const uint8_t* next_src = src + src_stride;
+        for (size_t i = 0; i < row_nbytes; ++i)
+        {
+            // Index of the sample of the left pixel in the source rows
+            const size_t src_i = (i / pixel_nbytes) * pixel_nbytes * 2 + i % pixel_nbytes;
+            const uint32_t sum = src[src_i] + src[src_i + pixel_nbytes] + next_src[src_i] + next_src[src_i + pixel_nbytes];
+            dest[i] = static_cast<uint8_t>((sum + 2) / 4);
+        }
+    }
+}
+
+} // namespace cuslide::tiff
+
+#endif // CUSLIDE_TIFF_DOWNSAMPLE_H
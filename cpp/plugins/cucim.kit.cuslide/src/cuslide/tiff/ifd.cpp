@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -9,8 +9,12 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <string_view>
 #include <thread>
 
 #include <fmt/format.h>
@@ -19,8 +23,12 @@
 #include <turbojpeg.h>
 
 #include <cucim/codec/hash_function.h>
+#include <cucim/concurrent/threadpool.h>
+#include <cucim/concurrent/tile_schedule.h>
+#include <cucim/filesystem/byte_source.h>
 #include <cucim/cuimage.h>
 #include <cucim/logger/timer.h>
+#include <cucim/memory/buffer_pool.h>
 #include <cucim/memory/memory_manager.h>
 #include <cucim/profiler/nvtx3.h>
 #include <cucim/util/cuda.h>
@@ -28,15 +36,98 @@
 #include "cuslide/deflate/deflate.h"
 #include "cuslide/jpeg/libjpeg_turbo.h"
 #include "cuslide/jpeg2k/libopenjpeg.h"
+#include "cuslide/jpegxl/libjxl.h"
 #include "cuslide/loader/nvjpeg_processor.h"
 #include "cuslide/lzw/lzw.h"
 #include "cuslide/raw/raw.h"
+#include "cuslide/webp/libwebp.h"
+#include "cuslide/zstd/libzstd.h"
+#include "downsample.h"
 #include "tiff.h"
 
 
 namespace cuslide::tiff
 {
 
+/**
+ * @brief Undo horizontal differencing (TIFF predictor 2) of a decoded tile in place.
+ */
+static void undo_horizontal_predictor(
+    uint8_t* data, uint64_t nbytes, uint32_t row_nbytes, uint32_t bits_per_sample, uint32_t samples_per_pixel)
+{
+    switch (bits_per_sample)
+    {
+    case 8:
+        cuslide::lzw::horAcc8(data, nbytes, row_nbytes, samples_per_pixel);
+        break;
+    case 16:
+        cuslide::lzw::horAcc16(data, nbytes, row_nbytes, samples_per_pixel);
+        break;
+    case 32:
+        cuslide::lzw::horAcc32(data, nbytes, row_nbytes, samples_per_pixel);
+        break;
+    default:
+        throw std::runtime_error(fmt::format("Predictor is not supported for {}-bit samples", bits_per_sample));
+    }
+}
+
+/**
+ * @brief Copy `count` samples of a plane row into an interleaved (YXC) row whose pixel stride is `dest_step` samples.
+ */
+template <typename T>
+static void interleave_plane_row(uint8_t* dest, const uint8_t* src, uint32_t count, uint32_t dest_step)
+{
+    T* dest_ptr = reinterpret_cast<T*>(dest);
+    const T* src_ptr = reinterpret_cast<const T*>(src);
+    for (uint32_t i = 0; i < count; ++i, dest_ptr += dest_step)
+    {
+        *dest_ptr = src_ptr[i];
+    }
+}
+
+static void interleave_plane_row(
+    uint8_t* dest, const uint8_t* src, uint32_t count, uint32_t dest_step, uint32_t sample_nbytes)
+{
+    switch (sample_nbytes)
+    {
+    case 1:
+        interleave_plane_row<uint8_t>(dest, src, count, dest_step);
+        break;
+    case 2:
+        interleave_plane_row<uint16_t>(dest, src, count, dest_step);
+        break;
+    case 4:
+        interleave_plane_row<uint32_t>(dest, src, count, dest_step);
+        break;
+    case 8:
+        interleave_plane_row<uint64_t>(dest, src, count, dest_step);
+        break;
+    default:
+        throw std::runtime_error(fmt::format("Sample size ({} bytes) is not supported", sample_nbytes));
+    }
+}
+
+/**
+ * @brief Return the key ordering tile `index` in a tile plan of the batch data loader.
+ */
+static uint64_t tile_order_key(const cucim::concurrent::TileSchedule schedule,
+                               const uint32_t stride_y,
+                               const uint64_t index,
+                               const uint64_t tiledata_offset)
+{
+    switch (schedule)
+    {
+    case cucim::concurrent::TileSchedule::kHilbert:
+        return cucim::concurrent::hilbert_curve_index(
+            static_cast<uint32_t>(index % stride_y), static_cast<uint32_t>(index / stride_y));
+    case cucim::concurrent::TileSchedule::kOffset:
+        return tiledata_offset;
+    case cucim::concurrent::TileSchedule::kNone:
+        break;
+    }
+    return 0;
+}
+
 IFD::IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset) : tiff_(tiff), ifd_index_(index), ifd_offset_(offset)
 {
     PROF_SCOPED_RANGE(PROF_EVENT(ifd_ifd));
@@ -72,6 +163,7 @@ IFD::IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset) : tiff_(tiff), ifd_ind
     }
     bits_per_sample_ = tif_dir.td_bitspersample;
     samples_per_pixel_ = tif_dir.td_samplesperpixel;
+    sample_format_ = tif_dir.td_sampleformat;
     subfile_type_ = tif_dir.td_subfiletype;
     planar_config_ = tif_dir.td_planarconfig;
     photometric_ = tif_dir.td_photometric;
@@ -93,6 +185,8 @@ IFD::IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset) : tiff_(tiff), ifd_ind
         TIFFGetField(tif, TIFFTAG_JPEGTABLES, &jpegtable_count, &jpegtable_data);
         jpegtable_.reserve(jpegtable_count);
         jpegtable_.insert(jpegtable_.end(), jpegtable_data, jpegtable_data + jpegtable_count);
+        // Parse quantization/Huffman tables once instead of parsing them for every tile.
+        jpeg_tables_ = cuslide::jpeg::parse_jpeg_tables(jpegtable_.data(), jpegtable_.size());
 
         if (photometric_ == PHOTOMETRIC_RGB)
         {
@@ -114,6 +208,10 @@ IFD::IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset) : tiff_(tiff), ifd_ind
     image_piece_offsets_.insert(image_piece_offsets_.end(), &td_stripoffset_p[0], &td_stripoffset_p[image_piece_count_]);
     image_piece_bytecounts_.insert(
         image_piece_bytecounts_.end(), &td_stripbytecount_p[0], &td_stripbytecount_p[image_piece_count_]);
+    if (tile_width_ == 0 && compression_ == COMPRESSION_NONE)
+    {
+        split_large_raw_strips();
+    }
 
     // Calculate hash value with IFD index
     hash_value_ = tiff->file_handle_->hash_value ^ cucim::codec::splitmix64(index);
@@ -121,12 +219,50 @@ IFD::IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset) : tiff_(tiff), ifd_ind
     //    TIFFPrintDirectory(tif, stdout, TIFFPRINT_STRIPS);
 }
 
+IFD::IFD(TIFF* tiff, uint16_t index, std::shared_ptr<IFD> source_level)
+    : tiff_(tiff), ifd_index_(index), ifd_offset_(0), source_level_(std::move(source_level))
+{
+    const IFD& source = *source_level_;
+
+    software_ = source.software_;
+    model_ = source.model_;
+    resolution_unit_ = source.resolution_unit_;
+    x_resolution_ = source.x_resolution_ / 2;
+    y_resolution_ = source.y_resolution_ / 2;
+
+    flags_ = source.flags_ | TIFF_ISTILED;
+    width_ = std::max(source.width_ / 2, 1u);
+    height_ = std::max(source.height_ / 2, 1u);
+    tile_width_ = source.tile_width_ ? source.tile_width_ : kVirtualLevelTileSize;
+    tile_height_ = source.tile_height_ ? source.tile_height_ : kVirtualLevelTileSize;
+    bits_per_sample_ = source.bits_per_sample_;
+    samples_per_pixel_ = source.samples_per_pixel_;
+    sample_format_ = source.sample_format_;
+    subfile_type_ = FILETYPE_REDUCEDIMAGE;
+    planar_config_ = PLANARCONFIG_CONTIG;
+    // Tiles hold the pixels produced by the source level's decoder as-is.
+    photometric_ = source.photometric_;
+    compression_ = COMPRESSION_NONE;
+    predictor_ = 1;
+
+    // Offsets are tile indices (see build_virtual_tile()).
+    const uint32_t stride_x = (width_ + tile_width_ - 1) / tile_width_;
+    const uint32_t stride_y = (height_ + tile_height_ - 1) / tile_height_;
+    image_piece_count_ = stride_x * stride_y;
+    image_piece_offsets_.resize(image_piece_count_);
+    std::iota(image_piece_offsets_.begin(), image_piece_offsets_.end(), 0);
+    image_piece_bytecounts_.assign(image_piece_count_, tile_raster_size_nbytes());
+
+    hash_value_ = tiff->file_handle_->hash_value ^ cucim::codec::splitmix64(index);
+}
+
 bool IFD::read(const TIFF* tiff,
                const cucim::io::format::ImageMetadataDesc* metadata,
                const cucim::io::format::ImageReaderRegionRequestDesc* request,
                cucim::io::format::ImageDataDesc* out_image_data)
 {
     PROF_SCOPED_RANGE(PROF_EVENT(ifd_read));
+    (void)metadata;
     ::TIFF* tif = tiff->tiff_client_;
 
     uint16_t ifd_index = ifd_index_;
@@ -147,8 +283,31 @@ bool IFD::read(const TIFF* tiff,
     int32_t n_ch = samples_per_pixel_; // number of channels
     int ndim = 3;
 
-    size_t raster_size = w * h * samples_per_pixel_;
+    // Channel-first output and channel selection are available for planar-separate images whose planes are
+    // stored (and cached) separately.
+    const bool is_planar_separate = (planar_config_ == PLANARCONFIG_SEPARATE);
+    const bool channel_first = request->dims && std::string_view(request->dims) == "CYX";
+    const int64_t channel_index = request->region_dim_indices.indices['C' - 'A'];
+    if ((channel_first || channel_index >= 0) && !(is_planar_separate && is_read_optimizable()))
+    {
+        throw std::invalid_argument(
+            "Reading a channel-first ('CYX') image or a single channel is supported only for planar-separate images!");
+    }
+    if (channel_index >= static_cast<int64_t>(samples_per_pixel_))
+    {
+        throw std::invalid_argument(
+            fmt::format("Channel index ({}) should be less than the number of channels ({})!", channel_index,
+                        samples_per_pixel_));
+    }
+    if (channel_index >= 0)
+    {
+        n_ch = 1;
+    }
+
+    size_t raster_size = w * h * n_ch * ((bits_per_sample_ + 7) / 8);
     void* raster = nullptr;
+    // Levels of an image can have different sample types, so the level being read decides (not the metadata).
+    DLDataType dtype = this->dtype();
     auto raster_type = cucim::io::DeviceType::kCPU;
 
     DLTensor* out_buf = request->buf;
@@ -224,12 +383,27 @@ bool IFD::read(const TIFF* tiff,
             std::unique_ptr<std::vector<int64_t>> request_size = std::move(*size_unique);
             delete size_unique;
 
-            auto load_func = [tiff, ifd, location, w, h, out_device](
+            if (is_planar_separate && out_device.type() == cucim::io::DeviceType::kCUDA)
+            {
+                throw std::invalid_argument(
+                    "Reading planar-separate images into CUDA memory with multiple workers is not supported yet!");
+            }
+            if (tiff->file_handle_->fd < 0 && out_device.type() == cucim::io::DeviceType::kCUDA)
+            {
+                throw std::invalid_argument(
+                    "Reading remote files into CUDA memory with multiple workers is not supported yet!");
+            }
+
+            auto load_func = [tiff, ifd, location, w, h, out_device, is_planar_separate, channel_first, channel_index](
                                  cucim::loader::ThreadBatchDataLoader* loader_ptr, uint64_t location_index) {
                 uint8_t* raster_ptr = loader_ptr->raster_pointer(location_index);
 
-                if (!read_region_tiles(tiff, ifd, location, location_index, w, h,
-                                       raster_ptr, out_device, loader_ptr))
+                bool is_read = is_planar_separate ?
+                                   read_region_tiles_separate(tiff, ifd, location, location_index, w, h, raster_ptr,
+                                                              out_device, loader_ptr, channel_first, channel_index) :
+                                   read_region_tiles(
+                                       tiff, ifd, location, location_index, w, h, raster_ptr, out_device, loader_ptr);
+                if (!is_read)
                 {
                     fmt::print(stderr, "[Error] Failed to read region!\n");
                 }
@@ -244,16 +418,16 @@ bool IFD::read(const TIFF* tiff,
             {
                 raster_type = cucim::io::DeviceType::kCUDA;
 
+                const uint32_t tw = ifd->image_piece_width();
+                const uint32_t th = ifd->image_piece_height();
                 // The maximal number of tiles (x-axis) overapped with the given patch
-                uint32_t tile_across_count = std::min(static_cast<uint64_t>(ifd->width_) + (ifd->tile_width_ - 1),
-                                                      static_cast<uint64_t>(w) + (ifd->tile_width_ - 1)) /
-                                                 ifd->tile_width_ +
-                                             1;
+                uint32_t tile_across_count =
+                    std::min(static_cast<uint64_t>(ifd->width_) + (tw - 1), static_cast<uint64_t>(w) + (tw - 1)) / tw +
+                    1;
                 // The maximal number of tiles (y-axis) overapped with the given patch
-                uint32_t tile_down_count = std::min(static_cast<uint64_t>(ifd->height_) + (ifd->tile_height_ - 1),
-                                                    static_cast<uint64_t>(h) + (ifd->tile_height_ - 1)) /
-                                               ifd->tile_height_ +
-                                           1;
+                uint32_t tile_down_count =
+                    std::min(static_cast<uint64_t>(ifd->height_) + (th - 1), static_cast<uint64_t>(h) + (th - 1)) / th +
+                    1;
                 // The maximal number of possible tiles (# of tasks) to load for the given image batch
                 maximum_tile_count = tile_across_count * tile_down_count * batch_size;
 
@@ -276,7 +450,20 @@ bool IFD::read(const TIFF* tiff,
                 load_func, std::move(batch_processor), out_device, std::move(request_location), std::move(request_size),
                 location_len, one_raster_size, batch_size, prefetch_factor, num_workers);
 
-            const uint32_t load_size = std::min(static_cast<uint64_t>(batch_size) * (1 + prefetch_factor), location_len);
+            // Pieces of the patches to be loaded next are hinted to the byte source of the file ahead of their tasks
+            // (see `concurrency.readahead_batches`).
+            const uint32_t plane_begin =
+                is_planar_separate && channel_index >= 0 ? static_cast<uint32_t>(channel_index) : 0;
+            const uint32_t plane_end =
+                is_planar_separate ? (channel_index >= 0 ? plane_begin + 1 : ifd->samples_per_pixel_) : 1;
+            loader->set_readahead_func([ifd, location, w, h, plane_begin, plane_end](uint64_t location_begin,
+                                                                                     uint64_t location_end) {
+                return readahead_patches(ifd, location, location_begin, location_end, w, h, plane_begin, plane_end);
+            });
+
+            // The loader may adjust the prefetch factor (see `concurrency.adaptive_prefetch`).
+            const uint32_t load_size =
+                std::min(static_cast<uint64_t>(batch_size) * (1 + loader->prefetch_factor()), location_len);
 
             loader->request(load_size);
 
@@ -292,10 +479,84 @@ bool IFD::read(const TIFF* tiff,
         {
             if (!raster)
             {
-                raster = cucim_malloc(one_raster_size);
+                raster = cucim::memory::buffer_pool().allocate(one_raster_size, cucim::io::DeviceType::kCPU);
             }
 
-            if (!read_region_tiles(tiff, ifd, location, 0, w, h, raster, out_device, nullptr))
+            auto read_band = [tiff, ifd, w, out_device, is_planar_separate, channel_first, channel_index](
+                                 const int64_t* band_location, int64_t band_h, void* band_raster) {
+                return is_planar_separate ?
+                           read_region_tiles_separate(tiff, ifd, band_location, 0, w, band_h, band_raster, out_device,
+                                                      nullptr, channel_first, channel_index) :
+                           read_region_tiles(tiff, ifd, band_location, 0, w, band_h, band_raster, out_device, nullptr);
+            };
+
+            // A region covering many tiles is split into bands of whole tile rows which are read in parallel by the
+            // process-wide executor. Channel-first rasters are not contiguous per band so they are read at once (the
+            // tiles of their planes are decoded in parallel by read_region_tiles_separate()).
+            // Regions read by a task of the executor (e.g., by DatasetLoader) are not split to avoid waiting for tasks
+            // queued behind the caller.
+            const uint32_t split_tile_count = cucim::CuImage::get_config()->concurrency().region_split_tile_count;
+            const uint32_t tw = image_piece_width();
+            const uint32_t th = image_piece_height();
+            const uint64_t tile_across_count = (static_cast<uint64_t>(w) + tw - 1) / tw;
+            const uint64_t tile_down_count = (static_cast<uint64_t>(h) + th - 1) / th;
+            const bool split_region = split_tile_count > 0 && !channel_first && tile_down_count > 1 &&
+                                      tile_across_count * tile_down_count > split_tile_count &&
+                                      cucim::concurrent::ThreadPool::shared_worker_count() > 1 &&
+                                      !cucim::concurrent::ThreadPool::is_worker_thread();
+
+            bool is_read = true;
+            if (split_region)
+            {
+                const int64_t sx = location[0];
+                const int64_t sy = location[1];
+                const int64_t ey = sy + h; // exclusive
+                const int64_t band_th =
+                    static_cast<int64_t>(th) * std::max<uint64_t>(1, split_tile_count / tile_across_count);
+                const uint64_t row_nbytes = one_raster_size / h;
+
+                // Band boundaries are aligned to tile rows (floor division handles negative coordinates).
+                std::vector<std::array<int64_t, 2>> band_locations;
+                for (int64_t y0 = sy; y0 < ey;)
+                {
+                    const int64_t band_index = (y0 >= 0 ? y0 : y0 - band_th + 1) / band_th;
+                    band_locations.push_back({ sx, y0 });
+                    y0 = std::min(ey, (band_index + 1) * band_th);
+                }
+
+                std::atomic<bool> all_read{ true };
+                std::vector<std::future<void>> futures;
+                futures.reserve(band_locations.size());
+                cucim::concurrent::ThreadPool thread_pool(
+                    static_cast<int32_t>(cucim::concurrent::ThreadPool::shared_worker_count()));
+                for (size_t i = 0; i < band_locations.size(); ++i)
+                {
+                    const int64_t* band_location = band_locations[i].data();
+                    const int64_t band_ey = (i + 1 < band_locations.size()) ? band_locations[i + 1][1] : ey;
+                    const int64_t band_h = band_ey - band_location[1];
+                    void* band_raster = static_cast<uint8_t*>(raster) + (band_location[1] - sy) * row_nbytes;
+                    futures.emplace_back(thread_pool.enqueue(
+                        [&read_band, &all_read, band_location, band_h, band_raster]() {
+                            if (!read_band(band_location, band_h, band_raster))
+                            {
+                                all_read = false;
+                            }
+                        },
+                        cucim::concurrent::TaskPriority::kHigh));
+                }
+                // All bands write into the same raster so wait for every band before propagating a failure.
+                thread_pool.wait();
+                for (auto& future : futures)
+                {
+                    future.get();
+                }
+                is_read = all_read;
+            }
+            else
+            {
+                is_read = read_band(location, h, raster);
+            }
+            if (!is_read)
             {
                 fmt::print(stderr, "[Error] Failed to read region!\n");
             }
@@ -336,6 +597,7 @@ bool IFD::read(const TIFF* tiff,
         }
         // RGBA -> 4 channels
         n_ch = 4;
+        dtype = DLDataType{ kDLUInt, 8, 1 };
 
         char emsg[1024];
         if (TIFFRGBAImageOK(tif, emsg))
@@ -348,7 +610,7 @@ bool IFD::read(const TIFF* tiff,
                 raster_size = npixels * 4;
                 if (!raster)
                 {
-                    raster = cucim_malloc(raster_size);
+                    raster = cucim::memory::buffer_pool().allocate(raster_size, cucim::io::DeviceType::kCPU);
                 }
                 img.col_offset = sx;
                 img.row_offset = sy;
@@ -379,18 +641,23 @@ bool IFD::read(const TIFF* tiff,
     }
 
     int64_t* shape = static_cast<int64_t*>(cucim_malloc(sizeof(int64_t) * ndim));
-    if (ndim == 3)
+    int64_t* image_shape = shape;
+    if (ndim == 4)
     {
-        shape[0] = h;
-        shape[1] = w;
-        shape[2] = n_ch;
+        shape[0] = batch_size;
+        image_shape = &shape[1];
     }
-    else // ndim == 4
+    if (channel_first)
     {
-        shape[0] = batch_size;
-        shape[1] = h;
-        shape[2] = w;
-        shape[3] = n_ch;
+        image_shape[0] = n_ch;
+        image_shape[1] = h;
+        image_shape[2] = w;
+    }
+    else
+    {
+        image_shape[0] = h;
+        image_shape[1] = w;
+        image_shape[2] = n_ch;
     }
 
     // Copy the raster memory and free it if needed.
@@ -403,7 +670,7 @@ bool IFD::read(const TIFF* tiff,
     out_image_container.data = raster;
     out_image_container.device = DLDevice{ static_cast<DLDeviceType>(out_device.type()), out_device.index() };
     out_image_container.ndim = ndim;
-    out_image_container.dtype = metadata->dtype;
+    out_image_container.dtype = dtype;
     out_image_container.shape = shape;
     out_image_container.strides = nullptr; // Tensor is compact and row-majored
     out_image_container.byte_offset = 0;
@@ -422,6 +689,54 @@ bool IFD::read(const TIFF* tiff,
     return true;
 }
 
+void IFD::split_large_raw_strips()
+{
+    const uint32_t plane_sample_count = planar_config_ == PLANARCONFIG_SEPARATE ? 1 : samples_per_pixel_;
+    const uint64_t row_nbytes = static_cast<uint64_t>(width_) * plane_sample_count * (bits_per_sample_ / 8);
+    const uint32_t strip_rows = std::min(rows_per_strip_, height_);
+    if (bits_per_sample_ % 8 != 0 || row_nbytes == 0 || strip_rows == 0 || strip_rows * row_nbytes <= kLargeStripNbytes)
+    {
+        return;
+    }
+    const uint32_t strips_per_plane = (height_ + strip_rows - 1) / strip_rows;
+    if (image_piece_count_ % strips_per_plane != 0)
+    {
+        return;
+    }
+
+    uint32_t piece_rows = static_cast<uint32_t>(std::max<uint64_t>(kLargeStripNbytes / row_nbytes, 1));
+    if (strips_per_plane > 1)
+    {
+        // All pieces but the last one of a plane should have the same number of rows.
+        while (strip_rows % piece_rows != 0)
+        {
+            --piece_rows;
+        }
+    }
+
+    std::vector<uint64_t> piece_offsets;
+    std::vector<uint64_t> piece_bytecounts;
+    for (uint32_t strip = 0; strip < image_piece_count_; ++strip)
+    {
+        const uint32_t strip_row = (strip % strips_per_plane) * strip_rows;
+        const uint32_t row_count = std::min(strip_rows, height_ - strip_row);
+        // A truncated (or missing) strip gives short (or empty) pieces.
+        uint64_t remaining_nbytes = image_piece_bytecounts_[strip];
+        for (uint32_t row = 0; row < row_count; row += piece_rows)
+        {
+            const uint64_t nbytes =
+                std::min<uint64_t>(std::min(piece_rows, row_count - row) * row_nbytes, remaining_nbytes);
+            piece_offsets.push_back(nbytes ? image_piece_offsets_[strip] + row * row_nbytes : 0);
+            piece_bytecounts.push_back(nbytes);
+            remaining_nbytes -= nbytes;
+        }
+    }
+    rows_per_strip_ = piece_rows;
+    image_piece_count_ = static_cast<uint32_t>(piece_offsets.size());
+    image_piece_offsets_ = std::move(piece_offsets);
+    image_piece_bytecounts_ = std::move(piece_bytecounts);
+}
+
 uint32_t IFD::index() const
 {
     return ifd_index_;
@@ -430,6 +745,10 @@ ifd_offset_t IFD::offset() const
 {
     return ifd_offset_;
 }
+bool IFD::is_virtual() const
+{
+    return source_level_ != nullptr;
+}
 
 std::string& IFD::software()
 {
@@ -483,6 +802,10 @@ uint32_t IFD::samples_per_pixel() const
 {
     return samples_per_pixel_;
 }
+uint16_t IFD::sample_format() const
+{
+    return sample_format_;
+}
 uint64_t IFD::subfile_type() const
 {
     return subfile_type_;
@@ -512,6 +835,19 @@ std::vector<uint64_t>& IFD::subifd_offsets()
 {
     return subifd_offsets_;
 }
+uint32_t IFD::image_piece_width() const
+{
+    return tile_width_ ? tile_width_ : width_;
+}
+uint32_t IFD::image_piece_height() const
+{
+    if (tile_height_)
+    {
+        return tile_height_;
+    }
+    // RowsPerStrip defaults to 2**32-1 (whole image in one strip)
+    return std::min(rows_per_strip_, height_);
+}
 uint32_t IFD::image_piece_count() const
 {
     return image_piece_count_;
@@ -525,19 +861,108 @@ const std::vector<uint64_t>& IFD::image_piece_bytecounts() const
     return image_piece_bytecounts_;
 }
 
+const std::vector<uint8_t>& IFD::jpegtable() const
+{
+    return jpegtable_;
+}
+
 size_t IFD::pixel_size_nbytes() const
 {
-    const int pixel_format = TJPF_RGB; // TODO: support other pixel format
-    const int nbytes = tjPixelSize[pixel_format];
+    const size_t nbytes = static_cast<size_t>(samples_per_pixel_) * ((bits_per_sample_ + 7) / 8);
     return nbytes;
 }
 
 size_t IFD::tile_raster_size_nbytes() const
 {
-    const size_t nbytes = tile_width_ * tile_height_ * pixel_size_nbytes();
+    const size_t nbytes = static_cast<size_t>(image_piece_width()) * image_piece_height() * pixel_size_nbytes();
     return nbytes;
 }
 
+DLDataType IFD::dtype() const
+{
+    if (!is_read_optimizable())
+    {
+        return DLDataType{ kDLUInt, 8, 1 };
+    }
+    switch (sample_format_)
+    {
+    case SAMPLEFORMAT_INT:
+        return DLDataType{ kDLInt, static_cast<uint8_t>(bits_per_sample_), 1 };
+    case SAMPLEFORMAT_IEEEFP:
+        return DLDataType{ kDLFloat, static_cast<uint8_t>(bits_per_sample_), 1 };
+    default:
+        return DLDataType{ kDLUInt, static_cast<uint8_t>(bits_per_sample_), 1 };
+    }
+}
+
+void IFD::fill_background(void* dest, const size_t nbytes) const
+{
+    const uint8_t background_value = tiff_->background_value_;
+    const DLDataType sample_dtype = dtype();
+    const size_t sample_nbytes = (sample_dtype.bits + 7) / 8;
+    // A byte pattern of 0xFF is the maximal value of unsigned samples of any size.
+    if (background_value == 0 || sample_dtype.code == kDLUInt || nbytes < sample_nbytes)
+    {
+        memset(dest, background_value, nbytes);
+        return;
+    }
+
+    uint8_t sample[8] = {};
+    if (sample_dtype.code == kDLFloat)
+    {
+        const float one_f32 = 1.0f;
+        const double one_f64 = 1.0;
+        const uint16_t one_f16 = 0x3C00;
+        switch (sample_dtype.bits)
+        {
+        case 16:
+            memcpy(sample, &one_f16, sizeof(one_f16));
+            break;
+        case 32:
+            memcpy(sample, &one_f32, sizeof(one_f32));
+            break;
+        default:
+            memcpy(sample, &one_f64, sizeof(one_f64));
+            break;
+        }
+    }
+    else
+    {
+        const uint64_t int_max = (uint64_t{ 1 } << (sample_dtype.bits - 1)) - 1;
+        memcpy(sample, &int_max, sample_nbytes); // little-endian
+    }
+
+    // Write one sample, then double the filled part.
+    uint8_t* dest_ptr = static_cast<uint8_t*>(dest);
+    memcpy(dest_ptr, sample, sample_nbytes);
+    size_t filled_nbytes = sample_nbytes;
+    while (filled_nbytes < nbytes)
+    {
+        const size_t copy_nbytes = std::min(filled_nbytes, nbytes - filled_nbytes);
+        memcpy(dest_ptr + filled_nbytes, dest_ptr, copy_nbytes);
+        filled_nbytes += copy_nbytes;
+    }
+}
+
+void IFD::fill_background_2d_cuda(void* dest, const size_t pitch, const size_t width_nbytes, const size_t height) const
+{
+    if (width_nbytes == 0 || height == 0)
+    {
+        return;
+    }
+    cudaError_t cuda_status;
+    const uint8_t background_value = tiff_->background_value_;
+    if (background_value == 0 || dtype().code == kDLUInt)
+    {
+        CUDA_ERROR(cudaMemset2D(dest, pitch, background_value, width_nbytes, height));
+        return;
+    }
+    std::vector<uint8_t> background(width_nbytes * height);
+    fill_background(background.data(), background.size());
+    CUDA_ERROR(cudaMemcpy2D(
+        dest, pitch, background.data(), width_nbytes, width_nbytes, height, cudaMemcpyHostToDevice));
+}
+
 bool IFD::is_compression_supported() const
 {
     switch (compression_)
@@ -550,6 +975,9 @@ bool IFD::is_compression_supported() const
                                               // of 4:2:2
     case cuslide::jpeg2k::kAperioJpeg2kRGB: // 33005: Jpeg 2000 with RGB
     case COMPRESSION_LZW:
+    case cuslide::zstd::kCompressionZstd: // 50000
+    case cuslide::webp::kCompressionWebp: // 50001
+    case cuslide::jpegxl::kCompressionJpegXl: // 50002
         return true;
     default:
         return false;
@@ -558,10 +986,93 @@ bool IFD::is_compression_supported() const
 
 bool IFD::is_read_optimizable() const
 {
-    return is_compression_supported() && bits_per_sample_ == 8 && samples_per_pixel_ == 3 &&
-           (tile_width_ != 0 && tile_height_ != 0) && planar_config_ == PLANARCONFIG_CONTIG &&
-           (photometric_ == PHOTOMETRIC_RGB || photometric_ == PHOTOMETRIC_YCBCR) &&
-           !tiff_->is_in_read_config(TIFF::kUseLibTiff);
+    // Strips are read as tiles whose width is the image width and whose height is the number of rows per strip.
+    bool is_tiled = (tile_width_ != 0 && tile_height_ != 0);
+    bool is_stripped = (tile_width_ == 0 && rows_per_strip_ != 0);
+    // Planar-separate images are read plane by plane (read_region_tiles_separate()). Image codecs (JPEG, JPEG 2000,
+    // WebP and JPEG XL) produce interleaved pixels so they cannot decode a single plane.
+    bool is_planar_config_supported =
+        planar_config_ == PLANARCONFIG_CONTIG ||
+        (planar_config_ == PLANARCONFIG_SEPARATE && compression_ != COMPRESSION_JPEG &&
+         compression_ != cuslide::jpeg2k::kAperioJpeg2kYCbCr && compression_ != cuslide::jpeg2k::kAperioJpeg2kRGB &&
+         compression_ != cuslide::webp::kCompressionWebp && compression_ != cuslide::jpegxl::kCompressionJpegXl);
+    return is_compression_supported() && is_sample_layout_supported() && (is_tiled || is_stripped) &&
+           is_planar_config_supported && !tiff_->is_in_read_config(TIFF::kUseLibTiff);
+}
+
+bool IFD::is_sample_layout_supported() const
+{
+    switch (compression_)
+    {
+    case COMPRESSION_JPEG:
+    case cuslide::jpeg2k::kAperioJpeg2kYCbCr:
+    case cuslide::jpeg2k::kAperioJpeg2kRGB:
+        // The decoders always produce 8-bit RGB pixels.
+        return bits_per_sample_ == 8 && samples_per_pixel_ == 3 &&
+               (photometric_ == PHOTOMETRIC_RGB || photometric_ == PHOTOMETRIC_YCBCR);
+    case cuslide::webp::kCompressionWebp:
+        // The decoder produces 8-bit RGB or RGBA pixels.
+        return bits_per_sample_ == 8 && (samples_per_pixel_ == 3 || samples_per_pixel_ == 4) &&
+               photometric_ == PHOTOMETRIC_RGB && sample_format_ == SAMPLEFORMAT_UINT;
+    case cuslide::jpegxl::kCompressionJpegXl:
+        // The decoder produces up to 4 channels of 8/16-bit unsigned integer or 16/32-bit floating point samples.
+        if (samples_per_pixel_ < 1 || samples_per_pixel_ > 4 || predictor_ != 1 ||
+            !(photometric_ == PHOTOMETRIC_MINISBLACK || photometric_ == PHOTOMETRIC_RGB))
+        {
+            return false;
+        }
+        return (sample_format_ == SAMPLEFORMAT_UINT && (bits_per_sample_ == 8 || bits_per_sample_ == 16)) ||
+               (sample_format_ == SAMPLEFORMAT_IEEEFP && (bits_per_sample_ == 16 || bits_per_sample_ == 32));
+    default:
+        break;
+    }
+
+    if (samples_per_pixel_ == 0)
+    {
+        return false;
+    }
+
+    switch (sample_format_)
+    {
+    case SAMPLEFORMAT_UINT:
+    case SAMPLEFORMAT_INT:
+        if (bits_per_sample_ != 8 && bits_per_sample_ != 16 && bits_per_sample_ != 32)
+        {
+            return false;
+        }
+        break;
+    case SAMPLEFORMAT_IEEEFP:
+        if (bits_per_sample_ != 16 && bits_per_sample_ != 32 && bits_per_sample_ != 64)
+        {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    // Raw samples are copied without interpretation so pixels must be stored as they are presented.
+    bool is_photometric_supported = photometric_ == PHOTOMETRIC_MINISBLACK || photometric_ == PHOTOMETRIC_RGB ||
+                                    (photometric_ == PHOTOMETRIC_YCBCR && bits_per_sample_ == 8 &&
+                                     samples_per_pixel_ == 3);
+    if (!is_photometric_supported)
+    {
+        return false;
+    }
+
+    // Multi-byte samples are not byte-swapped in the fast path.
+    if (bits_per_sample_ > 8 && (flags_ & TIFF_SWAB) != 0)
+    {
+        return false;
+    }
+
+    // Floating point predictor (3) is not supported.
+    if (predictor_ != 1 && !(predictor_ == 2 && sample_format_ != SAMPLEFORMAT_IEEEFP))
+    {
+        return false;
+    }
+
+    return true;
 }
 
 bool IFD::is_format_supported() const
@@ -569,6 +1080,355 @@ bool IFD::is_format_supported() const
     return is_compression_supported();
 }
 
+void IFD::decode_tile(const IFD* ifd,
+                      int fd,
+                      uint64_t offset,
+                      uint64_t size,
+                      uint8_t** tile_data,
+                      uint64_t decode_nbytes,
+                      uint32_t row_nbytes,
+                      uint32_t samples_per_pixel,
+                      const cucim::io::Device& out_device)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(ifd_decompression));
+    if (ifd->source_level_)
+    {
+        build_virtual_tile(ifd, static_cast<uint32_t>(offset), tile_data);
+        return;
+    }
+    // A remote file (no file descriptor) is read here and the tile is decoded in memory.
+    std::unique_ptr<uint8_t, decltype(cucim_free)*> piece_buf(nullptr, cucim_free);
+    if (fd < 0)
+    {
+        piece_buf.reset(ifd->tiff_->read_bytes(offset, size));
+        offset = 0;
+    }
+    uint8_t* const piece = piece_buf.get();
+    switch (ifd->compression_)
+    {
+    case COMPRESSION_NONE:
+        cuslide::raw::decode_raw(fd, piece, offset, size, tile_data, decode_nbytes, out_device);
+        break;
+    case COMPRESSION_JPEG:
+        if (ifd->jpeg_tables_)
+        {
+            cuslide::jpeg::decode_libjpeg(
+                fd, piece, offset, size, ifd->jpeg_tables_.get(), tile_data, out_device, ifd->jpeg_color_space_);
+        }
+        else
+        {
+            cuslide::jpeg::decode_libjpeg(fd, piece, offset, size, ifd->jpegtable_.data(), ifd->jpegtable_.size(),
+                                          tile_data, out_device, ifd->jpeg_color_space_);
+        }
+        break;
+    case COMPRESSION_ADOBE_DEFLATE:
+    case COMPRESSION_DEFLATE:
+        cuslide::deflate::decode_deflate(fd, piece, offset, size, tile_data, decode_nbytes, out_device);
+        break;
+    case cuslide::jpeg2k::kAperioJpeg2kYCbCr: // 33003
+        cuslide::jpeg2k::decode_libopenjpeg(
+            fd, piece, offset, size, tile_data, decode_nbytes, out_device, cuslide::jpeg2k::ColorSpace::kSYCC);
+        break;
+    case cuslide::jpeg2k::kAperioJpeg2kRGB: // 33005
+        cuslide::jpeg2k::decode_libopenjpeg(
+            fd, piece, offset, size, tile_data, decode_nbytes, out_device, cuslide::jpeg2k::ColorSpace::kRGB);
+        break;
+    case COMPRESSION_LZW:
+        cuslide::lzw::decode_lzw(fd, piece, offset, size, tile_data, decode_nbytes, out_device);
+        break;
+    case cuslide::zstd::kCompressionZstd: // 50000
+        cuslide::zstd::decode_zstd(fd, piece, offset, size, tile_data, decode_nbytes, out_device);
+        break;
+    case cuslide::webp::kCompressionWebp: // 50001
+        cuslide::webp::decode_libwebp(
+            fd, piece, offset, size, tile_data, decode_nbytes, row_nbytes, samples_per_pixel, out_device);
+        break;
+    case cuslide::jpegxl::kCompressionJpegXl: // 50002
+        cuslide::jpegxl::decode_libjxl(fd, piece, offset, size, tile_data, decode_nbytes, samples_per_pixel,
+                                       ifd->bits_per_sample_, ifd->sample_format_ == SAMPLEFORMAT_IEEEFP, out_device);
+        break;
+    default:
+        throw std::runtime_error("Unsupported compression method");
+    }
+
+    // Apply unpredictor
+    //   1: none, 2: horizontal differencing, 3: floating point predictor
+    //   https://www.adobe.io/content/dam/udp/en/open/standards/tiff/TIFF6.pdf
+    switch (ifd->compression_)
+    {
+    case COMPRESSION_ADOBE_DEFLATE:
+    case COMPRESSION_DEFLATE:
+    case COMPRESSION_LZW:
+    case cuslide::zstd::kCompressionZstd:
+        if (ifd->predictor_ == 2)
+        {
+            undo_horizontal_predictor(
+                *tile_data, decode_nbytes, row_nbytes, ifd->bits_per_sample_, samples_per_pixel);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void IFD::build_virtual_tile(const IFD* ifd, uint32_t index, uint8_t** tile_data)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(ifd_build_virtual_tile));
+    const IFD* source = ifd->source_level_.get();
+    const uint32_t tw = ifd->tile_width_;
+    const uint32_t th = ifd->tile_height_;
+    const uint32_t stride_x = (ifd->width_ + tw - 1) / tw;
+    const size_t pixel_nbytes = ifd->pixel_size_nbytes();
+    const size_t source_row_nbytes = 2 * static_cast<size_t>(tw) * pixel_nbytes;
+
+    // Read the source area of the tile (2x the tile size). The part past the source image is the background.
+    const int64_t location[2] = { static_cast<int64_t>(index % stride_x) * tw * 2,
+                                  static_cast<int64_t>(index / stride_x) * th * 2 };
+    std::unique_ptr<uint8_t, decltype(cucim_free)*> source_raster(
+        static_cast<uint8_t*>(cucim_malloc(source_row_nbytes * th * 2)), cucim_free);
+    read_region_tiles(ifd->tiff_, source, location, 0, tw * 2, th * 2, source_raster.get(), cucim::io::Device("cpu"),
+                      nullptr);
+
+    if (*tile_data == nullptr)
+    {
+        *tile_data = static_cast<uint8_t*>(cucim_malloc(ifd->tile_raster_size_nbytes()));
+    }
+    downsample_2x2(source_raster.get(), source_row_nbytes, *tile_data, tw * pixel_nbytes, tw, th, pixel_nbytes);
+}
+
+void IFD::prefetch_remote_pieces(const IFD* ifd,
+                                 int64_t tile_sx,
+                                 int64_t tile_ex,
+                                 int64_t tile_sy,
+                                 int64_t tile_ey,
+                                 uint32_t plane_begin,
+                                 uint32_t plane_end)
+{
+    const CuCIMFileHandle* handle = ifd->tiff_->file_handle_;
+    if (handle->fd >= 0 || !handle->source || ifd->source_level_)
+    {
+        return;
+    }
+    std::vector<cucim::filesystem::ByteRange> ranges;
+    append_piece_ranges(ifd, tile_sx, tile_ex, tile_sy, tile_ey, plane_begin, plane_end, ranges);
+    // A single piece is read directly by its decoding task.
+    if (ranges.size() > 1)
+    {
+        handle->source->prefetch(ranges);
+    }
+}
+
+uint64_t IFD::readahead_patches(const IFD* ifd,
+                                const int64_t* location,
+                                uint64_t location_begin,
+                                uint64_t location_end,
+                                int64_t w,
+                                int64_t h,
+                                uint32_t plane_begin,
+                                uint32_t plane_end)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(ifd_readahead_patches));
+    const CuCIMFileHandle* handle = ifd->tiff_->file_handle_;
+    if (!handle->source || ifd->source_level_)
+    {
+        return 0;
+    }
+    const uint32_t tw = ifd->image_piece_width();
+    const uint32_t th = ifd->image_piece_height();
+    const int64_t width = ifd->width_;
+    const int64_t height = ifd->height_;
+    std::vector<cucim::filesystem::ByteRange> ranges;
+    for (uint64_t location_index = location_begin; location_index < location_end; ++location_index)
+    {
+        // Clip the patch to the image.
+        const int64_t sx = std::max<int64_t>(location[location_index * 2], 0);
+        const int64_t sy = std::max<int64_t>(location[location_index * 2 + 1], 0);
+        const int64_t ex = std::min<int64_t>(location[location_index * 2] + w - 1, width - 1);
+        const int64_t ey = std::min<int64_t>(location[location_index * 2 + 1] + h - 1, height - 1);
+        if (sx > ex || sy > ey)
+        {
+            continue;
+        }
+        append_piece_ranges(ifd, sx / tw, ex / tw, sy / th, ey / th, plane_begin, plane_end, ranges);
+    }
+    uint64_t hinted_bytes = 0;
+    for (const auto& range : ranges)
+    {
+        hinted_bytes += range.size;
+    }
+    if (!ranges.empty())
+    {
+        handle->source->prefetch(ranges);
+    }
+    return hinted_bytes;
+}
+
+void IFD::append_piece_ranges(const IFD* ifd,
+                              int64_t tile_sx,
+                              int64_t tile_ex,
+                              int64_t tile_sy,
+                              int64_t tile_ey,
+                              uint32_t plane_begin,
+                              uint32_t plane_end,
+                              std::vector<cucim::filesystem::ByteRange>& ranges)
+{
+    const uint32_t tw = ifd->image_piece_width();
+    const uint32_t th = ifd->image_piece_height();
+    const int64_t tiles_across = (ifd->width_ + tw - 1) / tw;
+    const int64_t tiles_down = (ifd->height_ + th - 1) / th;
+    tile_sx = std::max<int64_t>(tile_sx, 0);
+    tile_sy = std::max<int64_t>(tile_sy, 0);
+    tile_ex = std::min<int64_t>(tile_ex, tiles_across - 1);
+    tile_ey = std::min<int64_t>(tile_ey, tiles_down - 1);
+
+    // Fetching a remote piece costs much more than looking it up in the cache, but hinting a local piece to the page
+    // cache costs less than the lookup (an IPC for the shared memory cache), so cached pieces are skipped only for
+    // remote files.
+    cucim::cache::ImageCache& image_cache = cucim::CuImage::cache_manager().cache();
+    const bool skip_cached =
+        ifd->tiff_->file_handle_->fd < 0 && image_cache.type() != cucim::cache::CacheType::kNoCache;
+    for (uint32_t plane = plane_begin; plane < plane_end; ++plane)
+    {
+        for (int64_t tile_y = tile_sy; tile_y <= tile_ey; ++tile_y)
+        {
+            for (int64_t tile_x = tile_sx; tile_x <= tile_ex; ++tile_x)
+            {
+                const uint64_t index = (plane * tiles_down + tile_y) * tiles_across + tile_x;
+                if (index >= ifd->image_piece_count_ || ifd->image_piece_bytecounts_[index] == 0)
+                {
+                    continue;
+                }
+                if (skip_cached && image_cache.contains(image_cache.create_key(ifd->hash_value_, index)))
+                {
+                    continue;
+                }
+                ranges.push_back({ ifd->image_piece_offsets_[index], ifd->image_piece_bytecounts_[index] });
+            }
+        }
+    }
+}
+
+std::shared_ptr<uint8_t> IFD::load_tile(const IFD* ifd,
+                                        int fd,
+                                        uint32_t index,
+                                        uint64_t offset,
+                                        uint64_t size,
+                                        uint64_t decode_nbytes,
+                                        uint32_t row_nbytes,
+                                        uint32_t samples_per_pixel,
+                                        const cucim::io::Device& out_device)
+{
+    cucim::cache::ImageCache& image_cache = cucim::CuImage::cache_manager().cache();
+    // A piece of a planar-separate image holds a single plane (`samples_per_pixel` is 1).
+    const size_t tile_raster_nbytes = static_cast<size_t>(ifd->image_piece_width()) * ifd->image_piece_height() *
+                                      samples_per_pixel * ((ifd->bits_per_sample_ + 7) / 8);
+    const uint64_t ifd_hash_value = ifd->hash_value_;
+    // Calculate a simple hash value for the tile index
+    const uint64_t index_hash = ifd_hash_value ^ (static_cast<uint64_t>(index) | (static_cast<uint64_t>(index) << 32));
+
+    // Without an image cache, a large compressed strip (e.g., the single strip of a whole image) would be decoded again
+    // for each region or patch overlapping it.
+    if (image_cache.type() == cucim::cache::CacheType::kNoCache && ifd->tile_width_ == 0 &&
+        tile_raster_nbytes > kLargeStripNbytes)
+    {
+        return load_large_strip(ifd, fd, index, offset, size, tile_raster_nbytes, decode_nbytes, row_nbytes,
+                                samples_per_pixel, out_device);
+    }
+
+    auto key = image_cache.create_key(ifd_hash_value, index);
+    image_cache.lock(index_hash);
+    auto value = image_cache.find(key);
+    if (value)
+    {
+        image_cache.unlock(index_hash);
+        return std::shared_ptr<uint8_t>(value, static_cast<uint8_t*>(value->data));
+    }
+
+    // A virtual tile loads tiles of the source level whose locks could share a mutex of the pool with this tile's, so
+    // the lock is not held while building it.
+    const bool is_virtual = ifd->source_level_ != nullptr;
+    if (is_virtual)
+    {
+        image_cache.unlock(index_hash);
+    }
+
+    std::shared_ptr<uint8_t> tile;
+    uint8_t* tile_data = nullptr;
+    if (image_cache.type() != cucim::cache::CacheType::kNoCache)
+    {
+        tile_data = static_cast<uint8_t*>(image_cache.allocate(tile_raster_nbytes));
+    }
+    else
+    {
+        // Allocate temporary buffer for tile data
+        tile_data = static_cast<uint8_t*>(cucim_malloc(tile_raster_nbytes));
+        tile = std::shared_ptr<uint8_t>(tile_data, cucim_free);
+    }
+    try
+    {
+        decode_tile(ifd, fd, offset, size, &tile_data, decode_nbytes, row_nbytes, samples_per_pixel, out_device);
+    }
+    catch (...)
+    {
+        if (!tile)
+        {
+            // The cache value frees the memory allocated by the cache when it is dropped.
+            image_cache.create_value(tile_data, tile_raster_nbytes);
+        }
+        if (!is_virtual)
+        {
+            image_cache.unlock(index_hash);
+        }
+        throw;
+    }
+
+    // Lifetime of tile_data is same with `value`: do not access this data when `value` is not accessible.
+    value = image_cache.create_value(tile_data, tile_raster_nbytes);
+    if (is_virtual)
+    {
+        image_cache.lock(index_hash);
+        // Another thread could have built the same tile in the meantime.
+        if (auto cached_value = image_cache.find(key))
+        {
+            image_cache.unlock(index_hash);
+            return std::shared_ptr<uint8_t>(cached_value, static_cast<uint8_t*>(cached_value->data));
+        }
+    }
+    image_cache.insert(key, value);
+    image_cache.unlock(index_hash);
+    if (!tile)
+    {
+        tile = std::shared_ptr<uint8_t>(value, tile_data);
+    }
+    return tile;
+}
+
+std::shared_ptr<uint8_t> IFD::load_large_strip(const IFD* ifd,
+                                               int fd,
+                                               uint32_t index,
+                                               uint64_t offset,
+                                               uint64_t size,
+                                               size_t raster_nbytes,
+                                               uint64_t decode_nbytes,
+                                               uint32_t row_nbytes,
+                                               uint32_t samples_per_pixel,
+                                               const cucim::io::Device& out_device)
+{
+    // Patches overlapping the same strip are usually read one after another, so one strip is kept. The lock makes
+    // the workers reading the same strip wait for a single decode.
+    std::lock_guard<std::mutex> lock(ifd->large_strip_mutex_);
+    if (!ifd->large_strip_ || ifd->large_strip_index_ != index)
+    {
+        ifd->large_strip_.reset();
+        uint8_t* strip_data = static_cast<uint8_t*>(cucim_malloc(raster_nbytes));
+        std::shared_ptr<uint8_t> strip(strip_data, cucim_free);
+        decode_tile(ifd, fd, offset, size, &strip_data, decode_nbytes, row_nbytes, samples_per_pixel, out_device);
+        ifd->large_strip_ = std::move(strip);
+        ifd->large_strip_index_ = index;
+    }
+    return ifd->large_strip_;
+}
+
 bool IFD::read_region_tiles(const TIFF* tiff,
                             const IFD* ifd,
                             const int64_t* location,
@@ -595,22 +1455,15 @@ bool IFD::read_region_tiles(const TIFF* tiff,
     {
         return read_region_tiles_boundary(tiff, ifd, location, location_index, w, h, raster, out_device, loader);
     }
-    cucim::cache::ImageCache& image_cache = cucim::CuImage::cache_manager().cache();
-    cucim::cache::CacheType cache_type = image_cache.type();
-
-    uint8_t background_value = tiff->background_value_;
     uint16_t compression_method = ifd->compression_;
-    int jpeg_color_space = ifd->jpeg_color_space_;
-    int predictor = ifd->predictor_;
-
-    // TODO: revert this once we can get RGB data instead of RGBA
-    uint32_t samples_per_pixel = 3; // ifd->samples_per_pixel();
 
-    const void* jpegtable_data = ifd->jpegtable_.data();
-    uint32_t jpegtable_count = ifd->jpegtable_.size();
+    const uint32_t samples_per_pixel = ifd->samples_per_pixel_;
+    const uint32_t pixel_nbytes = ifd->pixel_size_nbytes();
 
-    uint32_t tw = ifd->tile_width_;
-    uint32_t th = ifd->tile_height_;
+    // Strips are handled as tiles that span the image width.
+    uint32_t tw = ifd->image_piece_width();
+    uint32_t th = ifd->image_piece_height();
+    bool is_stripped = (ifd->tile_width_ == 0);
 
     uint32_t offset_sx = static_cast<uint32_t>(sx / tw); // x-axis start offset for the requested region in the ifd tile
                                                          // array as grid
@@ -627,6 +1480,7 @@ bool IFD::read_region_tiles(const TIFF* tiff,
     uint32_t pixel_offset_ey = static_cast<uint32_t>(ey % th);
 
     uint32_t stride_y = width / tw + !!(width % tw); // # of tiles in a row(y) in the ifd tile array as grid
+    const cucim::concurrent::TileSchedule tile_schedule = cucim::CuImage::get_config()->concurrency().tile_schedule;
 
     uint32_t start_index_y = offset_sy * stride_y;
     uint32_t end_index_y = offset_ey * stride_y;
@@ -634,10 +1488,10 @@ bool IFD::read_region_tiles(const TIFF* tiff,
     const size_t tile_raster_nbytes = ifd->tile_raster_size_nbytes();
 
     int tiff_file = tiff->file_handle_->fd;
-    uint64_t ifd_hash_value = ifd->hash_value_;
-    uint32_t dest_pixel_step_y = w * samples_per_pixel;
+    prefetch_remote_pieces(ifd, offset_sx, offset_ex, offset_sy, offset_ey);
+    uint32_t dest_pixel_step_y = w * pixel_nbytes;
 
-    uint32_t nbytes_tw = tw * samples_per_pixel;
+    uint32_t nbytes_tw = tw * pixel_nbytes;
     auto dest_start_ptr = static_cast<uint8_t*>(raster);
 
     // TODO: Current implementation doesn't consider endianness so need to consider later
@@ -657,23 +1511,34 @@ bool IFD::read_region_tiles(const TIFF* tiff,
             auto tiledata_offset = static_cast<uint64_t>(ifd->image_piece_offsets_[index]);
             auto tiledata_size = static_cast<uint64_t>(ifd->image_piece_bytecounts_[index]);
 
-            // Calculate a simple hash value for the tile index
-            uint64_t index_hash = ifd_hash_value ^ (static_cast<uint64_t>(index) | (static_cast<uint64_t>(index) << 32));
-
             uint32_t tile_pixel_offset_x = (offset_x == offset_sx) ? pixel_offset_sx : 0;
             uint32_t nbytes_tile_pixel_size_x = (offset_x == offset_ex) ?
-                                                    (pixel_offset_ex - tile_pixel_offset_x + 1) * samples_per_pixel :
-                                                    (tw - tile_pixel_offset_x) * samples_per_pixel;
-            auto decode_func = [=, &image_cache]() {
-                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_task, index_hash));
-                uint32_t nbytes_tile_index = (tile_pixel_offset_sy * tw + tile_pixel_offset_x) * samples_per_pixel;
+                                                    (pixel_offset_ex - tile_pixel_offset_x + 1) * pixel_nbytes :
+                                                    (tw - tile_pixel_offset_x) * pixel_nbytes;
+            // The last strip can have fewer rows than the others.
+            const size_t tile_decode_nbytes =
+                is_stripped ? std::min(th, height - index * th) * static_cast<size_t>(nbytes_tw) : tile_raster_nbytes;
+            auto copy_func = [=](const uint8_t* tile_data) {
+                uint32_t nbytes_tile_index = (tile_pixel_offset_sy * tw + tile_pixel_offset_x) * pixel_nbytes;
+                uint32_t dest_pixel_index = dest_pixel_index_x;
+                for (uint32_t ty = tile_pixel_offset_sy; ty <= tile_pixel_offset_ey;
+                     ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
+                {
+                    memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index, nbytes_tile_pixel_size_x);
+                }
+            };
+            auto load_func = [=]() {
+                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_task, index));
+                return load_tile(ifd, tiff_file, index, tiledata_offset, tiledata_size, tile_decode_nbytes, nbytes_tw,
+                                 samples_per_pixel, out_device);
+            };
+            auto decode_func = [=]() {
+                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_task, index));
+                uint32_t nbytes_tile_index = (tile_pixel_offset_sy * tw + tile_pixel_offset_x) * pixel_nbytes;
                 uint32_t dest_pixel_index = dest_pixel_index_x;
                 uint8_t* tile_data = nullptr;
                 if (tiledata_size > 0)
                 {
-                    std::unique_ptr<uint8_t, decltype(cucim_free)*> tile_raster =
-                        std::unique_ptr<uint8_t, decltype(cucim_free)*>(nullptr, cucim_free);
-
                     if (loader && loader->batch_data_processor())
                     {
                         switch (compression_method)
@@ -698,84 +1563,10 @@ bool IFD::read_region_tiles(const TIFF* tiff,
                     }
                     else
                     {
-                        auto key = image_cache.create_key(ifd_hash_value, index);
-                        image_cache.lock(index_hash);
-                        auto value = image_cache.find(key);
-                        if (value)
-                        {
-                            image_cache.unlock(index_hash);
-                            tile_data = static_cast<uint8_t*>(value->data);
-                        }
-                        else
-                        {
-                            // Lifetime of tile_data is same with `value`
-                            // : do not access this data when `value` is not accessible.
-                            if (cache_type != cucim::cache::CacheType::kNoCache)
-                            {
-                                tile_data = static_cast<uint8_t*>(image_cache.allocate(tile_raster_nbytes));
-                            }
-                            else
-                            {
-                                // Allocate temporary buffer for tile data
-                                tile_raster = std::unique_ptr<uint8_t, decltype(cucim_free)*>(
-                                    reinterpret_cast<uint8_t*>(cucim_malloc(tile_raster_nbytes)), cucim_free);
-                                tile_data = tile_raster.get();
-                            }
-                            {
-                                PROF_SCOPED_RANGE(PROF_EVENT(ifd_decompression));
-                                switch (compression_method)
-                                {
-                                case COMPRESSION_NONE:
-                                    cuslide::raw::decode_raw(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                             &tile_data, tile_raster_nbytes, out_device);
-                                    break;
-                                case COMPRESSION_JPEG:
-                                    cuslide::jpeg::decode_libjpeg(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                                  jpegtable_data, jpegtable_count, &tile_data,
-                                                                  out_device, jpeg_color_space);
-                                    break;
-                                case COMPRESSION_ADOBE_DEFLATE:
-                                case COMPRESSION_DEFLATE:
-                                    cuslide::deflate::decode_deflate(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                                     &tile_data, tile_raster_nbytes, out_device);
-                                    break;
-                                case cuslide::jpeg2k::kAperioJpeg2kYCbCr: // 33003
-                                    cuslide::jpeg2k::decode_libopenjpeg(tiff_file, nullptr, tiledata_offset,
-                                                                        tiledata_size, &tile_data, tile_raster_nbytes,
-                                                                        out_device, cuslide::jpeg2k::ColorSpace::kSYCC);
-                                    break;
-                                case cuslide::jpeg2k::kAperioJpeg2kRGB: // 33005
-                                    cuslide::jpeg2k::decode_libopenjpeg(tiff_file, nullptr, tiledata_offset,
-                                                                        tiledata_size, &tile_data, tile_raster_nbytes,
-                                                                        out_device, cuslide::jpeg2k::ColorSpace::kRGB);
-                                    break;
-                                case COMPRESSION_LZW:
-                                    cuslide::lzw::decode_lzw(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                             &tile_data, tile_raster_nbytes, out_device);
-                                    // Apply unpredictor
-                                    //   1: none, 2: horizontal differencing, 3: floating point predictor
-                                    //   https://www.adobe.io/content/dam/udp/en/open/standards/tiff/TIFF6.pdf
-                                    if (predictor == 2)
-                                    {
-                                        cuslide::lzw::horAcc8(tile_data, tile_raster_nbytes, nbytes_tw);
-                                    }
-                                    break;
-                                default:
-                                    throw std::runtime_error("Unsupported compression method");
-                                }
-                            }
-
-                            value = image_cache.create_value(tile_data, tile_raster_nbytes);
-                            image_cache.insert(key, value);
-                            image_cache.unlock(index_hash);
-                        }
-
-                        for (uint32_t ty = tile_pixel_offset_sy; ty <= tile_pixel_offset_ey;
-                             ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
-                        {
-                            memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
-                                   nbytes_tile_pixel_size_x);
-                        }
+                        std::shared_ptr<uint8_t> tile = load_tile(ifd, tiff_file, index, tiledata_offset,
+                                                                  tiledata_size, tile_decode_nbytes, nbytes_tw,
+                                                                  samples_per_pixel, out_device);
+                        copy_func(tile.get());
                     }
                 }
                 else
@@ -786,20 +1577,25 @@ bool IFD::read_region_tiles(const TIFF* tiff,
                              ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
                         {
                             // Set background value such as (255,255,255)
-                            memset(dest_start_ptr + dest_pixel_index, background_value, nbytes_tile_pixel_size_x);
+                            ifd->fill_background(dest_start_ptr + dest_pixel_index, nbytes_tile_pixel_size_x);
                         }
                     }
                     else
                     {
-                        cudaError_t cuda_status;
-                        CUDA_ERROR(cudaMemset2D(dest_start_ptr + dest_pixel_index, dest_pixel_step_y, background_value,
-                                                nbytes_tile_pixel_size_x,
-                                                tile_pixel_offset_ey - tile_pixel_offset_sy + 1));
+                        ifd->fill_background_2d_cuda(dest_start_ptr + dest_pixel_index, dest_pixel_step_y,
+                                                     nbytes_tile_pixel_size_x,
+                                                     tile_pixel_offset_ey - tile_pixel_offset_sy + 1);
                     }
                 }
             };
 
-            if (loader && *loader)
+            if (loader && loader->is_tile_plan_enabled() && tiledata_size > 0)
+            {
+                // Patches of the batch sharing the tile reuse a single decoded tile.
+                loader->plan_tile(index, std::move(load_func), std::move(copy_func),
+                                  tile_order_key(tile_schedule, stride_y, index, tiledata_offset));
+            }
+            else if (loader && *loader)
             {
                 loader->enqueue(std::move(decode_func),
                                 cucim::loader::TileInfo{ location_index, index, tiledata_offset, tiledata_size });
@@ -833,10 +1629,7 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
     int64_t sx = location[location_index * 2];
     int64_t sy = location[location_index * 2 + 1];
 
-    uint8_t background_value = tiff->background_value_;
     uint16_t compression_method = ifd->compression_;
-    int jpeg_color_space = ifd->jpeg_color_space_;
-    int predictor = ifd->predictor_;
 
     int64_t ex = sx + w - 1;
     int64_t ey = sy + h - 1;
@@ -847,29 +1640,26 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
     // Memory for tile_raster would be manually allocated here, instead of using decode_libjpeg().
     // Need to free the manually. Usually it is set to nullptr and memory is created by decode_libjpeg() by using
     // tjAlloc() (Also need to free with tjFree() after use. See the documentation of tjAlloc() for the detail.)
-    const int pixel_size_nbytes = ifd->pixel_size_nbytes();
+    const size_t pixel_size_nbytes = ifd->pixel_size_nbytes();
     auto dest_start_ptr = static_cast<uint8_t*>(raster);
 
     bool is_out_of_image = (ex < 0 || width <= sx || ey < 0 || height <= sy);
     if (is_out_of_image)
     {
         // Fill background color(255,255,255) and return
-        memset(dest_start_ptr, background_value, w * h * pixel_size_nbytes);
+        ifd->fill_background(dest_start_ptr, w * h * pixel_size_nbytes);
         return true;
     }
-    cucim::cache::ImageCache& image_cache = cucim::CuImage::cache_manager().cache();
-    cucim::cache::CacheType cache_type = image_cache.type();
 
-    uint32_t tw = ifd->tile_width_;
-    uint32_t th = ifd->tile_height_;
+    // Strips are handled as tiles that span the image width.
+    uint32_t tw = ifd->image_piece_width();
+    uint32_t th = ifd->image_piece_height();
+    bool is_stripped = (ifd->tile_width_ == 0);
 
     const size_t tile_raster_nbytes = tw * th * pixel_size_nbytes;
 
-    // TODO: revert this once we can get RGB data instead of RGBA
-    uint32_t samples_per_pixel = 3; // ifd->samples_per_pixel();
-
-    const void* jpegtable_data = ifd->jpegtable_.data();
-    uint32_t jpegtable_count = ifd->jpegtable_.size();
+    const uint32_t samples_per_pixel = ifd->samples_per_pixel_;
+    const uint32_t pixel_nbytes = static_cast<uint32_t>(pixel_size_nbytes);
 
     bool sx_in_range = (sx >= 0 && sx < width);
     bool ex_in_range = (ex >= 0 && ex < width);
@@ -923,6 +1713,7 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
     int64_t offset_max_y = ey_in_range ? offset_ey : offset_boundary_y;
 
     uint32_t stride_y = width / tw + !!(width % tw); // # of tiles in a row(y) in the ifd tile array as grid
+    const cucim::concurrent::TileSchedule tile_schedule = cucim::CuImage::get_config()->concurrency().tile_schedule;
 
     int64_t start_index_y = offset_sy * stride_y;
     int64_t start_index_min_y = offset_min_y * stride_y;
@@ -932,10 +1723,10 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
 
 
     int tiff_file = tiff->file_handle_->fd;
-    uint64_t ifd_hash_value = ifd->hash_value_;
+    prefetch_remote_pieces(ifd, offset_min_x, offset_max_x, offset_min_y, offset_max_y);
 
-    uint32_t dest_pixel_step_y = w * samples_per_pixel;
-    uint32_t nbytes_tw = tw * samples_per_pixel;
+    uint32_t dest_pixel_step_y = w * pixel_nbytes;
+    uint32_t nbytes_tw = tw * pixel_nbytes;
 
 
     // TODO: Current implementation doesn't consider endianness so need to consider later
@@ -956,9 +1747,6 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
             uint64_t tiledata_offset = 0;
             uint64_t tiledata_size = 0;
 
-            // Calculate a simple hash value for the tile index
-            uint64_t index_hash = ifd_hash_value ^ (static_cast<uint64_t>(index) | (static_cast<uint64_t>(index) << 32));
-
             if (offset_x >= offset_min_x && offset_x <= offset_max_x && index_y >= start_index_min_y &&
                 index_y <= end_index_max_y)
             {
@@ -968,54 +1756,104 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
 
             uint32_t tile_pixel_offset_x = (offset_x == offset_sx) ? pixel_offset_sx : 0;
             uint32_t nbytes_tile_pixel_size_x = (offset_x == offset_ex) ?
-                                                    (pixel_offset_ex - tile_pixel_offset_x + 1) * samples_per_pixel :
-                                                    (tw - tile_pixel_offset_x) * samples_per_pixel;
+                                                    (pixel_offset_ex - tile_pixel_offset_x + 1) * pixel_nbytes :
+                                                    (tw - tile_pixel_offset_x) * pixel_nbytes;
+
+            uint32_t nbytes_tile_index_orig = (tile_pixel_offset_sy * tw + tile_pixel_offset_x) * pixel_nbytes;
 
-            uint32_t nbytes_tile_index_orig = (tile_pixel_offset_sy * tw + tile_pixel_offset_x) * samples_per_pixel;
+            // The last strip can have fewer rows than the others.
+            const size_t tile_decode_nbytes =
+                is_stripped ? std::min<int64_t>(th, height - index * th) * static_cast<size_t>(nbytes_tw) :
+                              tile_raster_nbytes;
             uint32_t dest_pixel_index_orig = dest_pixel_index_x;
 
-            auto decode_func = [=, &image_cache]() {
-                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_boundary_task, index_hash));
-                uint32_t nbytes_tile_index = nbytes_tile_index_orig;
-                uint32_t dest_pixel_index = dest_pixel_index_orig;
+            bool copy_partial = false;
+            uint32_t fixed_nbytes_tile_pixel_size_x = nbytes_tile_pixel_size_x;
+            uint32_t fixed_tile_pixel_offset_ey = tile_pixel_offset_ey;
 
-                if (tiledata_size > 0)
+            if (offset_x == offset_boundary_x)
+            {
+                copy_partial = true;
+                if (offset_x != offset_ex)
+                {
+                    fixed_nbytes_tile_pixel_size_x = (pixel_offset_boundary_x - tile_pixel_offset_x + 1) * pixel_nbytes;
+                }
+                else
+                {
+                    fixed_nbytes_tile_pixel_size_x =
+                        (std::min(pixel_offset_boundary_x, pixel_offset_ex) - tile_pixel_offset_x + 1) * pixel_nbytes;
+                }
+            }
+            if (index_y == boundary_index_y)
+            {
+                copy_partial = true;
+                if (index_y != end_index_y)
                 {
-                    bool copy_partial = false;
-                    uint32_t fixed_nbytes_tile_pixel_size_x = nbytes_tile_pixel_size_x;
-                    uint32_t fixed_tile_pixel_offset_ey = tile_pixel_offset_ey;
+                    fixed_tile_pixel_offset_ey = pixel_offset_boundary_y;
+                }
+                else
+                {
+                    fixed_tile_pixel_offset_ey = std::min(pixel_offset_boundary_y, pixel_offset_ey);
+                }
+            }
 
-                    if (offset_x == offset_boundary_x)
+            auto copy_func = [=](const uint8_t* tile_data) {
+                uint32_t nbytes_tile_index = nbytes_tile_index_orig;
+                uint32_t dest_pixel_index = dest_pixel_index_orig;
+                if (copy_partial)
+                {
+                    uint32_t fill_gap_x = nbytes_tile_pixel_size_x - fixed_nbytes_tile_pixel_size_x;
+                    // Fill original, then fill white for remaining
+                    if (fill_gap_x > 0)
                     {
-                        copy_partial = true;
-                        if (offset_x != offset_ex)
-                        {
-                            fixed_nbytes_tile_pixel_size_x =
-                                (pixel_offset_boundary_x - tile_pixel_offset_x + 1) * samples_per_pixel;
-                        }
-                        else
+                        for (uint32_t ty = tile_pixel_offset_sy; ty <= fixed_tile_pixel_offset_ey;
+                             ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
                         {
-                            fixed_nbytes_tile_pixel_size_x =
-                                (std::min(pixel_offset_boundary_x, pixel_offset_ex) - tile_pixel_offset_x + 1) *
-                                samples_per_pixel;
+                            memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
+                                   fixed_nbytes_tile_pixel_size_x);
+                            ifd->fill_background(dest_start_ptr + dest_pixel_index + fixed_nbytes_tile_pixel_size_x,
+                                                 fill_gap_x);
                         }
                     }
-                    if (index_y == boundary_index_y)
+                    else
                     {
-                        copy_partial = true;
-                        if (index_y != end_index_y)
-                        {
-                            fixed_tile_pixel_offset_ey = pixel_offset_boundary_y;
-                        }
-                        else
+                        for (uint32_t ty = tile_pixel_offset_sy; ty <= fixed_tile_pixel_offset_ey;
+                             ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
                         {
-                            fixed_tile_pixel_offset_ey = std::min(pixel_offset_boundary_y, pixel_offset_ey);
+                            memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
+                                   fixed_nbytes_tile_pixel_size_x);
                         }
                     }
 
+                    for (uint32_t ty = fixed_tile_pixel_offset_ey + 1; ty <= tile_pixel_offset_ey;
+                         ++ty, dest_pixel_index += dest_pixel_step_y)
+                    {
+                        ifd->fill_background(dest_start_ptr + dest_pixel_index, nbytes_tile_pixel_size_x);
+                    }
+                }
+                else
+                {
+                    for (uint32_t ty = tile_pixel_offset_sy; ty <= tile_pixel_offset_ey;
+                         ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
+                    {
+                        memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
+                               nbytes_tile_pixel_size_x);
+                    }
+                }
+            };
+            auto load_func = [=]() {
+                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_boundary_task, index));
+                return load_tile(ifd, tiff_file, static_cast<uint32_t>(index), tiledata_offset, tiledata_size,
+                                 tile_decode_nbytes, nbytes_tw, samples_per_pixel, out_device);
+            };
+            auto decode_func = [=]() {
+                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_boundary_task, index));
+                uint32_t nbytes_tile_index = nbytes_tile_index_orig;
+                uint32_t dest_pixel_index = dest_pixel_index_orig;
+
+                if (tiledata_size > 0)
+                {
                     uint8_t* tile_data = nullptr;
-                    std::unique_ptr<uint8_t, decltype(cucim_free)*> tile_raster =
-                        std::unique_ptr<uint8_t, decltype(cucim_free)*>(nullptr, cucim_free);
 
                     if (loader && loader->batch_data_processor())
                     {
@@ -1045,9 +1883,9 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
                                     dest_start_ptr + dest_pixel_index, dest_pixel_step_y, tile_data + nbytes_tile_index,
                                     nbytes_tw, fixed_nbytes_tile_pixel_size_x,
                                     fixed_tile_pixel_offset_ey - tile_pixel_offset_sy + 1, cudaMemcpyDeviceToDevice));
-                                CUDA_ERROR(cudaMemset2D(dest_start_ptr + dest_pixel_index + fixed_nbytes_tile_pixel_size_x,
-                                                        dest_pixel_step_y, background_value, fill_gap_x,
-                                                        fixed_tile_pixel_offset_ey - tile_pixel_offset_sy + 1));
+                                ifd->fill_background_2d_cuda(
+                                    dest_start_ptr + dest_pixel_index + fixed_nbytes_tile_pixel_size_x,
+                                    dest_pixel_step_y, fill_gap_x, fixed_tile_pixel_offset_ey - tile_pixel_offset_sy + 1);
                                 dest_pixel_index +=
                                     dest_pixel_step_y * (fixed_tile_pixel_offset_ey - tile_pixel_offset_sy + 1);
                             }
@@ -1061,9 +1899,9 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
                                     dest_pixel_step_y * (fixed_tile_pixel_offset_ey - tile_pixel_offset_sy + 1);
                             }
 
-                            CUDA_ERROR(cudaMemset2D(dest_start_ptr + dest_pixel_index, dest_pixel_step_y,
-                                                    background_value, nbytes_tile_pixel_size_x,
-                                                    tile_pixel_offset_ey - (fixed_tile_pixel_offset_ey + 1) + 1));
+                            ifd->fill_background_2d_cuda(dest_start_ptr + dest_pixel_index, dest_pixel_step_y,
+                                                         nbytes_tile_pixel_size_x,
+                                                         tile_pixel_offset_ey - (fixed_tile_pixel_offset_ey + 1) + 1);
                         }
                         else
                         {
@@ -1075,116 +1913,10 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
                     }
                     else
                     {
-                        auto key = image_cache.create_key(ifd_hash_value, index);
-                        image_cache.lock(index_hash);
-                        auto value = image_cache.find(key);
-                        if (value)
-                        {
-                            image_cache.unlock(index_hash);
-                            tile_data = static_cast<uint8_t*>(value->data);
-                        }
-                        else
-                        {
-                            // Lifetime of tile_data is same with `value`
-                            // : do not access this data when `value` is not accessible.
-                            if (cache_type != cucim::cache::CacheType::kNoCache)
-                            {
-                                tile_data = static_cast<uint8_t*>(image_cache.allocate(tile_raster_nbytes));
-                            }
-                            else
-                            {
-                                // Allocate temporary buffer for tile data
-                                tile_raster = std::unique_ptr<uint8_t, decltype(cucim_free)*>(
-                                    reinterpret_cast<uint8_t*>(cucim_malloc(tile_raster_nbytes)), cucim_free);
-                                tile_data = tile_raster.get();
-                            }
-                            {
-                                PROF_SCOPED_RANGE(PROF_EVENT(ifd_decompression));
-                                switch (compression_method)
-                                {
-                                case COMPRESSION_NONE:
-                                    cuslide::raw::decode_raw(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                             &tile_data, tile_raster_nbytes, out_device);
-                                    break;
-                                case COMPRESSION_JPEG:
-                                    cuslide::jpeg::decode_libjpeg(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                                  jpegtable_data, jpegtable_count, &tile_data,
-                                                                  out_device, jpeg_color_space);
-                                    break;
-                                case COMPRESSION_ADOBE_DEFLATE:
-                                case COMPRESSION_DEFLATE:
-                                    cuslide::deflate::decode_deflate(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                                     &tile_data, tile_raster_nbytes, out_device);
-                                    break;
-                                case cuslide::jpeg2k::kAperioJpeg2kYCbCr: // 33003
-                                    cuslide::jpeg2k::decode_libopenjpeg(tiff_file, nullptr, tiledata_offset,
-                                                                        tiledata_size, &tile_data, tile_raster_nbytes,
-                                                                        out_device, cuslide::jpeg2k::ColorSpace::kSYCC);
-                                    break;
-                                case cuslide::jpeg2k::kAperioJpeg2kRGB: // 33005
-                                    cuslide::jpeg2k::decode_libopenjpeg(tiff_file, nullptr, tiledata_offset,
-                                                                        tiledata_size, &tile_data, tile_raster_nbytes,
-                                                                        out_device, cuslide::jpeg2k::ColorSpace::kRGB);
-                                    break;
-                                case COMPRESSION_LZW:
-                                    cuslide::lzw::decode_lzw(tiff_file, nullptr, tiledata_offset, tiledata_size,
-                                                             &tile_data, tile_raster_nbytes, out_device);
-                                    // Apply unpredictor
-                                    //   1: none, 2: horizontal differencing, 3: floating point predictor
-                                    //   https://www.adobe.io/content/dam/udp/en/open/standards/tiff/TIFF6.pdf
-                                    if (predictor == 2)
-                                    {
-                                        cuslide::lzw::horAcc8(tile_data, tile_raster_nbytes, nbytes_tw);
-                                    }
-                                    break;
-                                default:
-                                    throw std::runtime_error("Unsupported compression method");
-                                }
-                            }
-                            value = image_cache.create_value(tile_data, tile_raster_nbytes);
-                            image_cache.insert(key, value);
-                            image_cache.unlock(index_hash);
-                        }
-                        if (copy_partial)
-                        {
-                            uint32_t fill_gap_x = nbytes_tile_pixel_size_x - fixed_nbytes_tile_pixel_size_x;
-                            // Fill original, then fill white for remaining
-                            if (fill_gap_x > 0)
-                            {
-                                for (uint32_t ty = tile_pixel_offset_sy; ty <= fixed_tile_pixel_offset_ey;
-                                     ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
-                                {
-                                    memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
-                                           fixed_nbytes_tile_pixel_size_x);
-                                    memset(dest_start_ptr + dest_pixel_index + fixed_nbytes_tile_pixel_size_x,
-                                           background_value, fill_gap_x);
-                                }
-                            }
-                            else
-                            {
-                                for (uint32_t ty = tile_pixel_offset_sy; ty <= fixed_tile_pixel_offset_ey;
-                                     ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
-                                {
-                                    memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
-                                           fixed_nbytes_tile_pixel_size_x);
-                                }
-                            }
-
-                            for (uint32_t ty = fixed_tile_pixel_offset_ey + 1; ty <= tile_pixel_offset_ey;
-                                 ++ty, dest_pixel_index += dest_pixel_step_y)
-                            {
-                                memset(dest_start_ptr + dest_pixel_index, background_value, nbytes_tile_pixel_size_x);
-                            }
-                        }
-                        else
-                        {
-                            for (uint32_t ty = tile_pixel_offset_sy; ty <= tile_pixel_offset_ey;
-                                 ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
-                            {
-                                memcpy(dest_start_ptr + dest_pixel_index, tile_data + nbytes_tile_index,
-                                       nbytes_tile_pixel_size_x);
-                            }
-                        }
+                        std::shared_ptr<uint8_t> tile =
+                            load_tile(ifd, tiff_file, static_cast<uint32_t>(index), tiledata_offset, tiledata_size,
+                                      tile_decode_nbytes, nbytes_tw, samples_per_pixel, out_device);
+                        copy_func(tile.get());
                     }
                 }
                 else
@@ -1196,19 +1928,25 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
                              ++ty, dest_pixel_index += dest_pixel_step_y, nbytes_tile_index += nbytes_tw)
                         {
                             // Set (255,255,255)
-                            memset(dest_start_ptr + dest_pixel_index, background_value, nbytes_tile_pixel_size_x);
+                            ifd->fill_background(dest_start_ptr + dest_pixel_index, nbytes_tile_pixel_size_x);
                         }
                     }
                     else
                     {
-                        cudaError_t cuda_status;
-                        CUDA_ERROR(cudaMemset2D(dest_start_ptr + dest_pixel_index, dest_pixel_step_y, background_value,
-                                                nbytes_tile_pixel_size_x, tile_pixel_offset_ey - tile_pixel_offset_sy));
+                        ifd->fill_background_2d_cuda(dest_start_ptr + dest_pixel_index, dest_pixel_step_y,
+                                                     nbytes_tile_pixel_size_x,
+                                                     tile_pixel_offset_ey - tile_pixel_offset_sy);
                     }
                 }
             };
 
-            if (loader && *loader)
+            if (loader && loader->is_tile_plan_enabled() && tiledata_size > 0)
+            {
+                // Patches of the batch sharing the tile reuse a single decoded tile.
+                loader->plan_tile(index, std::move(load_func), std::move(copy_func),
+                                  tile_order_key(tile_schedule, stride_y, index, tiledata_offset));
+            }
+            else if (loader && *loader)
             {
                 loader->enqueue(std::move(decode_func),
                                 cucim::loader::TileInfo{ location_index, index, tiledata_offset, tiledata_size });
@@ -1225,6 +1963,187 @@ bool IFD::read_region_tiles_boundary(const TIFF* tiff,
     return true;
 }
 
+bool IFD::read_region_tiles_separate(const TIFF* tiff,
+                                     const IFD* ifd,
+                                     const int64_t* location,
+                                     const int64_t location_index,
+                                     const int64_t w,
+                                     const int64_t h,
+                                     void* raster,
+                                     const cucim::io::Device& out_device,
+                                     cucim::loader::ThreadBatchDataLoader* loader,
+                                     const bool channel_first,
+                                     const int64_t channel_index)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(ifd_read_region_tiles_separate));
+    int64_t sx = location[location_index * 2];
+    int64_t sy = location[location_index * 2 + 1];
+    int64_t ex = sx + w - 1;
+    int64_t ey = sy + h - 1;
+
+    uint32_t width = ifd->width_;
+    uint32_t height = ifd->height_;
+
+
+    const uint32_t sample_nbytes = (ifd->bits_per_sample_ + 7) / 8;
+    const uint32_t plane_begin = channel_index >= 0 ? static_cast<uint32_t>(channel_index) : 0;
+    const uint32_t plane_count = channel_index >= 0 ? 1 : ifd->samples_per_pixel_;
+
+    auto dest_start_ptr = static_cast<uint8_t*>(raster);
+    const uint64_t dest_plane_nbytes = static_cast<uint64_t>(w) * h * sample_nbytes;
+
+    // Fill background color first if the region is not entirely inside the image.
+    if (sx < 0 || sy < 0 || ex >= width || ey >= height)
+    {
+        ifd->fill_background(dest_start_ptr, dest_plane_nbytes * plane_count);
+    }
+
+    // Clip the region to the image.
+    int64_t clip_sx = std::max<int64_t>(sx, 0);
+    int64_t clip_sy = std::max<int64_t>(sy, 0);
+    int64_t clip_ex = std::min<int64_t>(ex, static_cast<int64_t>(width) - 1);
+    int64_t clip_ey = std::min<int64_t>(ey, static_cast<int64_t>(height) - 1);
+    if (clip_sx > clip_ex || clip_sy > clip_ey)
+    {
+        return true;
+    }
+
+    // Strips are handled as tiles that span the image width.
+    uint32_t tw = ifd->image_piece_width();
+    uint32_t th = ifd->image_piece_height();
+    bool is_stripped = (ifd->tile_width_ == 0);
+
+    const uint32_t tiles_across = (width + tw - 1) / tw;
+    const uint32_t tiles_down = (height + th - 1) / th;
+    const uint32_t tiles_per_plane = tiles_across * tiles_down;
+
+    const uint32_t nbytes_tw = tw * sample_nbytes;
+    const size_t tile_raster_nbytes = static_cast<size_t>(nbytes_tw) * th;
+
+    int tiff_file = tiff->file_handle_->fd;
+    prefetch_remote_pieces(ifd, clip_sx / tw, clip_ex / tw, clip_sy / th, clip_ey / th, plane_begin,
+                           plane_begin + plane_count);
+
+    // Pixel step (in samples) of the output image for a plane.
+    const uint32_t dest_sample_step_x = channel_first ? 1 : plane_count;
+    const uint64_t dest_nbytes_step_y = static_cast<uint64_t>(w) * dest_sample_step_x * sample_nbytes;
+
+    // Without a batch loader, the pieces (tiles of each plane) are decoded in parallel by the process-wide executor.
+    // This also covers channel-first regions, which are not split into bands. A region read by a task of the executor
+    // (e.g., a band of a split region) is decoded by that task.
+    const uint64_t piece_count = (static_cast<uint64_t>(clip_ex / tw - clip_sx / tw) + 1) *
+                                 (static_cast<uint64_t>(clip_ey / th - clip_sy / th) + 1) * plane_count;
+    const bool decode_in_parallel = !(loader && *loader) && piece_count > 1 &&
+                                    cucim::concurrent::ThreadPool::shared_worker_count() > 1 &&
+                                    !cucim::concurrent::ThreadPool::is_worker_thread();
+    cucim::concurrent::ThreadPool thread_pool(
+        decode_in_parallel ? static_cast<int32_t>(cucim::concurrent::ThreadPool::shared_worker_count()) : 0);
+    std::vector<std::future<void>> futures;
+
+    for (uint32_t tile_y = static_cast<uint32_t>(clip_sy / th); tile_y <= static_cast<uint32_t>(clip_ey / th); ++tile_y)
+    {
+        const int64_t row_begin = std::max<int64_t>(clip_sy, static_cast<int64_t>(tile_y) * th);
+        const int64_t row_end = std::min<int64_t>(clip_ey, static_cast<int64_t>(tile_y) * th + th - 1);
+        const uint32_t row_count = static_cast<uint32_t>(row_end - row_begin + 1);
+
+        // The last strip can have fewer rows than the others.
+        const size_t tile_decode_nbytes =
+            is_stripped ? std::min(th, height - tile_y * th) * static_cast<size_t>(nbytes_tw) : tile_raster_nbytes;
+
+        for (uint32_t tile_x = static_cast<uint32_t>(clip_sx / tw); tile_x <= static_cast<uint32_t>(clip_ex / tw);
+             ++tile_x)
+        {
+            const int64_t col_begin = std::max<int64_t>(clip_sx, static_cast<int64_t>(tile_x) * tw);
+            const int64_t col_end = std::min<int64_t>(clip_ex, static_cast<int64_t>(tile_x) * tw + tw - 1);
+            const uint32_t col_count = static_cast<uint32_t>(col_end - col_begin + 1);
+
+            const uint64_t nbytes_tile_index =
+                ((row_begin - static_cast<int64_t>(tile_y) * th) * tw + (col_begin - static_cast<int64_t>(tile_x) * tw)) *
+                sample_nbytes;
+            const uint64_t dest_pixel_index =
+                ((row_begin - sy) * w + (col_begin - sx)) * static_cast<uint64_t>(dest_sample_step_x) * sample_nbytes;
+
+            for (uint32_t plane = plane_begin; plane < plane_begin + plane_count; ++plane)
+            {
+                const uint32_t index = plane * tiles_per_plane + tile_y * tiles_across + tile_x;
+                PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_iter, index));
+                auto tiledata_offset = static_cast<uint64_t>(ifd->image_piece_offsets_[index]);
+                auto tiledata_size = static_cast<uint64_t>(ifd->image_piece_bytecounts_[index]);
+
+                // Start of the plane in the output image
+                uint8_t* dest_plane_ptr = channel_first ?
+                                              dest_start_ptr + dest_plane_nbytes * (plane - plane_begin) :
+                                              dest_start_ptr + static_cast<uint64_t>(plane - plane_begin) * sample_nbytes;
+
+                auto decode_func = [=]() {
+                    PROF_SCOPED_RANGE(PROF_EVENT_P(ifd_read_region_tiles_task, index));
+                    uint8_t* dest_ptr = dest_plane_ptr + dest_pixel_index;
+                    if (tiledata_size == 0)
+                    {
+                        for (uint32_t ty = 0; ty < row_count; ++ty, dest_ptr += dest_nbytes_step_y)
+                        {
+                            if (channel_first)
+                            {
+                                ifd->fill_background(dest_ptr, col_count * sample_nbytes);
+                            }
+                            else
+                            {
+                                for (uint32_t tx = 0; tx < col_count; ++tx)
+                                {
+                                    ifd->fill_background(dest_ptr + tx * dest_sample_step_x * sample_nbytes,
+                                                         sample_nbytes);
+                                }
+                            }
+                        }
+                        return;
+                    }
+
+                    // Planes are stored as separate pieces of a single sample.
+                    std::shared_ptr<uint8_t> tile = load_tile(ifd, tiff_file, index, tiledata_offset, tiledata_size,
+                                                              tile_decode_nbytes, nbytes_tw, 1, out_device);
+
+                    const uint8_t* src_ptr = tile.get() + nbytes_tile_index;
+                    for (uint32_t ty = 0; ty < row_count; ++ty, dest_ptr += dest_nbytes_step_y, src_ptr += nbytes_tw)
+                    {
+                        if (channel_first)
+                        {
+                            memcpy(dest_ptr, src_ptr, col_count * sample_nbytes);
+                        }
+                        else
+                        {
+                            interleave_plane_row(dest_ptr, src_ptr, col_count, dest_sample_step_x, sample_nbytes);
+                        }
+                    }
+                };
+
+                if (loader && *loader)
+                {
+                    loader->enqueue(std::move(decode_func),
+                                    cucim::loader::TileInfo{ location_index, index, tiledata_offset, tiledata_size });
+                }
+                else if (thread_pool)
+                {
+                    futures.emplace_back(
+                        thread_pool.enqueue(std::move(decode_func), cucim::concurrent::TaskPriority::kHigh));
+                }
+                else
+                {
+                    decode_func();
+                }
+            }
+        }
+    }
+
+    // All pieces write into the same raster so wait for every piece before propagating a failure.
+    thread_pool.wait();
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    return true;
+}
+
 } // namespace cuslide::tiff
 
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -9,6 +9,7 @@
 #include "types.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <cucim/concurrent/threadpool.h>
@@ -17,16 +18,42 @@
 #include <cucim/loader/thread_batch_data_loader.h>
 //#include <tiffio.h>
 
+namespace cucim::filesystem
+{
+// Forward declaration.
+struct ByteRange;
+} // namespace cucim::filesystem
+
+namespace cuslide::jpeg
+{
+// Forward declaration.
+struct JpegTables;
+} // namespace cuslide::jpeg
+
 namespace cuslide::tiff
 {
 
 // Forward declaration.
 class TIFF;
 
+/// Tile size of a virtual level synthesized from a stripped image.
+constexpr uint32_t kVirtualLevelTileSize = 256;
+/// Decoded size above which an uncompressed strip is split into strips of fewer rows, and a compressed strip is kept
+/// by the IFD after decoding when the image cache is disabled.
+constexpr size_t kLargeStripNbytes = 4 * 1024 * 1024;
+
 class EXPORT_VISIBLE IFD : public std::enable_shared_from_this<IFD>
 {
 public:
     IFD(TIFF* tiff, uint16_t index, ifd_offset_t offset);
+    /**
+     * @brief Create a virtual level at half the resolution of `source_level`.
+     *
+     * The virtual level is not stored in the file: its tiles are uncompressed and built on demand by averaging 2x2
+     * pixels of the source level (whose tiles are loaded, and cached, as usual). `index` should not be used by any IFD
+     * in the file as it identifies the tiles of the level in the image cache.
+     */
+    IFD(TIFF* tiff, uint16_t index, std::shared_ptr<IFD> source_level);
     ~IFD() = default;
 
     static bool read_region_tiles(const TIFF* tiff,
@@ -49,6 +76,27 @@ public:
                                            const cucim::io::Device& out_device,
                                            cucim::loader::ThreadBatchDataLoader* loader);
 
+    /**
+     * @brief Read a region of a planar-separate (PLANARCONFIG_SEPARATE) image.
+     *
+     * Each channel plane is stored in its own set of tiles (or strips). Plane tiles are decoded and cached
+     * independently so reading a single channel doesn't touch the other planes.
+     *
+     * @param channel_first Write the output in CYX order (planes are copied as-is) instead of YXC (interleaved).
+     * @param channel_index Index of the channel to read (-1 to read all channels).
+     */
+    static bool read_region_tiles_separate(const TIFF* tiff,
+                                           const IFD* ifd,
+                                           const int64_t* location,
+                                           const int64_t location_index,
+                                           const int64_t w,
+                                           const int64_t h,
+                                           void* raster,
+                                           const cucim::io::Device& out_device,
+                                           cucim::loader::ThreadBatchDataLoader* loader,
+                                           const bool channel_first,
+                                           const int64_t channel_index);
+
     bool read(const TIFF* tiff,
               const cucim::io::format::ImageMetadataDesc* metadata,
               const cucim::io::format::ImageReaderRegionRequestDesc* request,
@@ -57,6 +105,12 @@ public:
 
     uint32_t index() const;
     ifd_offset_t offset() const;
+    /**
+     * @brief Return true if the IFD is a virtual level (not stored in the file).
+     *
+     * Offsets of the image pieces of a virtual level are tile indices, not file offsets.
+     */
+    bool is_virtual() const;
 
     std::string& software();
     std::string& model();
@@ -71,6 +125,7 @@ public:
     uint32_t rows_per_strip() const;
     uint32_t bits_per_sample() const;
     uint32_t samples_per_pixel() const;
+    uint16_t sample_format() const;
     uint64_t subfile_type() const;
     uint16_t planar_config() const;
     uint16_t photometric() const;
@@ -80,13 +135,51 @@ public:
     uint16_t subifd_count() const;
     std::vector<uint64_t>& subifd_offsets();
 
+    /**
+     * @brief Width of an image piece (tile or strip). A strip spans the whole image width.
+     */
+    uint32_t image_piece_width() const;
+    /**
+     * @brief Height of an image piece (tile or strip). For strips, this is the number of rows per strip.
+     */
+    uint32_t image_piece_height() const;
     uint32_t image_piece_count() const;
     const std::vector<uint64_t>& image_piece_offsets() const;
     const std::vector<uint64_t>& image_piece_bytecounts() const;
+    /**
+     * @brief Return the JPEGTABLES of the IFD (empty if the tiles are not abbreviated JPEG streams).
+     */
+    const std::vector<uint8_t>& jpegtable() const;
 
     size_t pixel_size_nbytes() const;
     size_t tile_raster_size_nbytes() const;
 
+    /**
+     * @brief Return DLPack data type of a sample in the raster produced by the fast path.
+     *
+     * Image loaded by the slow path (libtiff's TIFFRGBAImageGet()) is always 8-bit unsigned RGBA.
+     */
+    DLDataType dtype() const;
+
+    /**
+     * @brief Fill `nbytes` bytes (whole samples of dtype()) of CPU memory at `dest` with the background value.
+     *
+     * The background is 0, or the maximal value of the sample type (1.0 for floating-point samples) if the TIFF has a
+     * white background.
+     */
+    void fill_background(void* dest, size_t nbytes) const;
+    /**
+     * @brief Same as fill_background() for `height` rows of `width_nbytes` bytes, `pitch` bytes apart, in CUDA memory.
+     */
+    void fill_background_2d_cuda(void* dest, size_t pitch, size_t width_nbytes, size_t height) const;
+
+    /**
+     * @brief Check if the IFD can be read by the fast path (read_region_tiles()).
+     *
+     * Note: The output of this method could be changed if user set read configuration after opening TIFF file.
+     */
+    bool is_read_optimizable() const;
+
     // Hidden methods for benchmarking
     void write_offsets_(const char* file_path);
 
@@ -113,6 +206,7 @@ private:
     uint32_t rows_per_strip_ = 0;
     uint32_t bits_per_sample_ = 0;
     uint32_t samples_per_pixel_ = 0;
+    uint16_t sample_format_ = 1; // 1: unsigned integer, 2: signed integer, 3: IEEE floating point
     uint64_t subfile_type_ = 0;
     uint16_t planar_config_ = 0;
     uint16_t photometric_ = 0;
@@ -123,6 +217,7 @@ private:
     std::vector<uint64_t> subifd_offsets_;
 
     std::vector<uint8_t> jpegtable_;
+    std::shared_ptr<const cuslide::jpeg::JpegTables> jpeg_tables_; /// JPEGTABLES parsed once for all tiles
     int32_t jpeg_color_space_ = 0; /// 0: JCS_UNKNOWN, 2: JCS_RGB, 3: JCS_YCbCr
 
     uint32_t image_piece_count_ = 0;
@@ -131,19 +226,130 @@ private:
 
     uint64_t hash_value_ = 0; /// file hash including ifd index.
 
+    /// The large strip decoded last when the image cache is disabled (see load_tile()).
+    mutable std::mutex large_strip_mutex_;
+    mutable uint32_t large_strip_index_ = 0;
+    mutable std::shared_ptr<uint8_t> large_strip_;
+
+    /**
+     * @brief Split uncompressed strips larger than kLargeStripNbytes into strips of fewer rows.
+     *
+     * A region then reads (and caches) only the rows it needs instead of the whole strip, which is the whole image for
+     * a file written as a single strip.
+     */
+    void split_large_raw_strips();
+
+    std::shared_ptr<IFD> source_level_; /// finer level a virtual level is built from (nullptr if not virtual)
+
+    /**
+     * @brief Build tile `index` of a virtual level into `tile_data` from the 2x2 tiles' area of the source level.
+     */
+    static void build_virtual_tile(const IFD* ifd, uint32_t index, uint8_t** tile_data);
+
+    /**
+     * @brief Decode an image piece (tile or strip) into `tile_data` and undo the predictor if needed.
+     *
+     * @param row_nbytes The number of bytes of a row in the decoded image piece.
+     * @param samples_per_pixel The number of interleaved samples in the decoded image piece (1 for a plane tile).
+     */
+    static void decode_tile(const IFD* ifd,
+                            int fd,
+                            uint64_t offset,
+                            uint64_t size,
+                            uint8_t** tile_data,
+                            uint64_t decode_nbytes,
+                            uint32_t row_nbytes,
+                            uint32_t samples_per_pixel,
+                            const cucim::io::Device& out_device);
+
+    /**
+     * @brief Return the decoded image piece `index`, from the image cache if available.
+     *
+     * `samples_per_pixel` is the number of samples of a pixel in the piece (1 for a plane of a planar-separate image).
+     * The returned pointer keeps the tile data alive (the cache value or a temporary buffer).
+     */
+    static std::shared_ptr<uint8_t> load_tile(const IFD* ifd,
+                                              int fd,
+                                              uint32_t index,
+                                              uint64_t offset,
+                                              uint64_t size,
+                                              uint64_t decode_nbytes,
+                                              uint32_t row_nbytes,
+                                              uint32_t samples_per_pixel,
+                                              const cucim::io::Device& out_device);
+
+    /**
+     * @brief Return the decoded strip `index` of `raster_nbytes` bytes, decoding it only if it is not the strip decoded
+     * last (used for strips larger than kLargeStripNbytes when the image cache is disabled).
+     */
+    static std::shared_ptr<uint8_t> load_large_strip(const IFD* ifd,
+                                                     int fd,
+                                                     uint32_t index,
+                                                     uint64_t offset,
+                                                     uint64_t size,
+                                                     size_t raster_nbytes,
+                                                     uint64_t decode_nbytes,
+                                                     uint32_t row_nbytes,
+                                                     uint32_t samples_per_pixel,
+                                                     const cucim::io::Device& out_device);
+
+    /**
+     * @brief Let the byte source of a remote file fetch the image pieces of a region in parallel, before they are
+     * decoded.
+     *
+     * Pieces [tile_sx, tile_ex] x [tile_sy, tile_ey] (clipped to the piece grid) of each plane in
+     * [plane_begin, plane_end) are fetched, except the pieces that are in the image cache. Nothing is done for a local
+     * file or a virtual level.
+     */
+    static void prefetch_remote_pieces(const IFD* ifd,
+                                       int64_t tile_sx,
+                                       int64_t tile_ex,
+                                       int64_t tile_sy,
+                                       int64_t tile_ey,
+                                       uint32_t plane_begin = 0,
+                                       uint32_t plane_end = 1);
+
+    /**
+     * @brief Hint the byte source of the file that the image pieces of patches [location_begin, location_end) will be
+     * read soon (see `concurrency.readahead_batches`).
+     *
+     * A local file lets the kernel read the pieces ahead into the page cache, and a remote file fetches them
+     * asynchronously. Pieces of a virtual level (and, for a remote file, pieces in the image cache) are skipped. Return
+     * the number of bytes hinted.
+     */
+    static uint64_t readahead_patches(const IFD* ifd,
+                                      const int64_t* location,
+                                      uint64_t location_begin,
+                                      uint64_t location_end,
+                                      int64_t w,
+                                      int64_t h,
+                                      uint32_t plane_begin = 0,
+                                      uint32_t plane_end = 1);
+
+    /**
+     * @brief Append the byte ranges of pieces [tile_sx, tile_ex] x [tile_sy, tile_ey] (clipped to the piece grid) of
+     * each plane in [plane_begin, plane_end) to `ranges`. For remote files, pieces in the image cache are skipped
+     * (looked up without counting cache hits or misses).
+     */
+    static void append_piece_ranges(const IFD* ifd,
+                                    int64_t tile_sx,
+                                    int64_t tile_ex,
+                                    int64_t tile_sy,
+                                    int64_t tile_ey,
+                                    uint32_t plane_begin,
+                                    uint32_t plane_end,
+                                    std::vector<cucim::filesystem::ByteRange>& ranges);
+
     /**
      * @brief Check if the current compression method is supported or not.
      */
     bool is_compression_supported() const;
 
     /**
-     *
-     * Note: This method is called by the constructor of IFD and read() method so it is possible that the output of
-     *       'is_read_optimizable()' could be changed during read() method if user set read configuration
-     *       after opening TIFF file.
-     * @return
+     * @brief Check if the sample layout (bits per sample, sample format, photometric interpretation, byte order and
+     *        predictor) can be copied as-is by the fast path.
      */
-    bool is_read_optimizable() const;
+    bool is_sample_layout_supported() const;
 
     /**
      * @brief Check if the specified image format is supported or not.
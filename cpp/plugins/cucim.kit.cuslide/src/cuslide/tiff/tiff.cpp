@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -8,6 +8,7 @@
 #include <fcntl.h>
 
 #include <algorithm>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -17,6 +18,9 @@
 #include <tiffiop.h>
 
 #include <cucim/codec/base64.h>
+#include <cucim/codec/hash_function.h>
+#include <cucim/cuimage.h>
+#include <cucim/filesystem/byte_source.h>
 #include <cucim/logger/timer.h>
 #include <cucim/memory/memory_manager.h>
 #include <cucim/profiler/nvtx3.h>
@@ -244,6 +248,68 @@ static void parse_aperio_svs_metadata(std::shared_ptr<IFD>& first_ifd, json& met
     }
 }
 
+struct TIFF::ClientStream
+{
+    std::shared_ptr<cucim::filesystem::ByteSource> source;
+    uint64_t position = 0;
+    /// The error of the last failed read (libtiff only sees that the read failed).
+    std::string error;
+
+    static tmsize_t read(thandle_t handle, void* buf, tmsize_t size)
+    {
+        auto stream = static_cast<ClientStream*>(handle);
+        try
+        {
+            const size_t nread = stream->source->read(buf, size, stream->position);
+            stream->position += nread;
+            return static_cast<tmsize_t>(nread);
+        }
+        catch (const std::exception& e)
+        {
+            stream->error = e.what();
+            return -1;
+        }
+    }
+    static tmsize_t write(thandle_t, void*, tmsize_t)
+    {
+        return -1;
+    }
+    static toff_t seek(thandle_t handle, toff_t offset, int whence)
+    {
+        auto stream = static_cast<ClientStream*>(handle);
+        switch (whence)
+        {
+        case SEEK_SET:
+            stream->position = offset;
+            break;
+        case SEEK_CUR:
+            stream->position += offset;
+            break;
+        case SEEK_END:
+            stream->position = stream->source->size() + offset;
+            break;
+        default:
+            return static_cast<toff_t>(-1);
+        }
+        return stream->position;
+    }
+    static int close(thandle_t)
+    {
+        return 0;
+    }
+    static toff_t size(thandle_t handle)
+    {
+        return static_cast<ClientStream*>(handle)->source->size();
+    }
+    static int map(thandle_t, void**, toff_t*)
+    {
+        return 0;
+    }
+    static void unmap(thandle_t, void*, toff_t)
+    {
+    }
+};
+
 TIFF::~TIFF()
 {
     PROF_SCOPED_RANGE(PROF_EVENT(tiff__tiff));
@@ -258,19 +324,58 @@ TIFF::TIFF(const cucim::filesystem::Path& file_path, int mode) : file_path_(file
     memcpy(file_path_cstr, file_path.c_str(), file_path.size());
     file_path_cstr[file_path.size()] = '\0';
 
-    int fd = ::open(file_path_cstr, mode, 0666);
-    if (fd == -1)
+    if (cucim::filesystem::is_remote_path(file_path))
     {
-        cucim_free(file_path_cstr);
-        throw std::invalid_argument(fmt::format("Cannot open {}!", file_path));
+        // A remote file has no file descriptor: libtiff and the decoders read it through a (cached) byte source.
+        std::shared_ptr<cucim::filesystem::ByteSource> source;
+        try
+        {
+            source = cucim::filesystem::open_remote_byte_source(file_path);
+        }
+        catch (const std::exception& e)
+        {
+            cucim_free(file_path_cstr);
+            throw std::invalid_argument(fmt::format("Cannot open {}! ({})", file_path, e.what()));
+        }
+        client_stream_ = std::make_unique<ClientStream>();
+        client_stream_->source = source;
+        tiff_client_ = ::TIFFClientOpen(file_path_cstr, "rm", client_stream_.get(), ClientStream::read,
+                                        ClientStream::write, ClientStream::seek, ClientStream::close,
+                                        ClientStream::size, ClientStream::map, ClientStream::unmap);
+        if (tiff_client_ == nullptr)
+        {
+            cucim_free(file_path_cstr);
+            if (!client_stream_->error.empty())
+            {
+                throw std::invalid_argument(fmt::format("Cannot load {}! ({})", file_path, client_stream_->error));
+            }
+            throw std::invalid_argument(fmt::format("Cannot load {}!", file_path));
+        }
+        // The file is identified by its URL and the version of its content (for the tile cache).
+        file_handle_shared_ = std::make_shared<CuCIMFileHandle>(
+            -1, nullptr, FileHandleType::kUnknown, file_path_cstr, this, 0 /*dev*/,
+            cucim::codec::splitmix64(std::hash<std::string>{}(file_path)), static_cast<int64_t>(source->version()),
+            false /*own_fd*/);
+        file_handle_shared_->source = std::move(source);
     }
-    tiff_client_ = ::TIFFFdOpen(fd, file_path_cstr, "rm"); // Add 'm' to disable memory-mapped file
-    if (tiff_client_ == nullptr)
+    else
     {
-        cucim_free(file_path_cstr);
-        throw std::invalid_argument(fmt::format("Cannot load {}!", file_path));
+        int fd = ::open(file_path_cstr, mode, 0666);
+        if (fd == -1)
+        {
+            cucim_free(file_path_cstr);
+            throw std::invalid_argument(fmt::format("Cannot open {}!", file_path));
+        }
+        tiff_client_ = ::TIFFFdOpen(fd, file_path_cstr, "rm"); // Add 'm' to disable memory-mapped file
+        if (tiff_client_ == nullptr)
+        {
+            cucim_free(file_path_cstr);
+            throw std::invalid_argument(fmt::format("Cannot load {}!", file_path));
+        }
+        file_handle_shared_ =
+            std::make_shared<CuCIMFileHandle>(fd, nullptr, FileHandleType::kPosix, file_path_cstr, this);
+        file_handle_shared_->source = std::make_shared<cucim::filesystem::LocalByteSource>(fd);
     }
-    file_handle_shared_ = std::make_shared<CuCIMFileHandle>(fd, nullptr, FileHandleType::kPosix, file_path_cstr, this);
     file_handle_ = file_handle_shared_.get();
 
     // TODO: warning if the file is big endian
@@ -362,6 +467,53 @@ void TIFF::construct_ifds()
             return height_a > height_b;
         }
     });
+
+    virtual_level_ifds_.clear();
+    const auto& image_cache = cucim::CuImage::cache_manager().cache();
+    if (image_cache.config().virtual_pyramid)
+    {
+        // A tile of a virtual level is built from four tiles of the level above (built the same way), so without an
+        // image cache a tile of the k-th virtual level would decode 4^k tiles of the file.
+        if (image_cache.type() == cucim::cache::CacheType::kNoCache)
+        {
+            static std::once_flag no_cache_warning_flag;
+            std::call_once(no_cache_warning_flag, []() {
+                fmt::print(stderr,
+                           "[Warning] 'virtual_pyramid' requires an image cache; virtual levels are not added with "
+                           "the 'nocache' cache type!\n");
+            });
+        }
+        else
+        {
+            construct_virtual_levels();
+        }
+    }
+}
+
+void TIFF::construct_virtual_levels()
+{
+    if (level_to_ifd_idx_.size() != 1)
+    {
+        return;
+    }
+    std::shared_ptr<IFD> source = ifds_[level_to_ifd_idx_[0]];
+    if (!source->is_read_optimizable() || source->planar_config() != PLANARCONFIG_CONTIG ||
+        source->bits_per_sample() != 8 || source->sample_format() != SAMPLEFORMAT_UINT)
+    {
+        return;
+    }
+
+    const uint32_t tile_width = source->tile_width() ? source->tile_width() : kVirtualLevelTileSize;
+    const uint32_t tile_height = source->tile_height() ? source->tile_height() : kVirtualLevelTileSize;
+    // Indices after the IFDs in the file identify the virtual levels in the image cache.
+    uint16_t ifd_index = ifds_.size();
+    while ((source->width() > tile_width || source->height() > tile_height) && source->width() >= 2 &&
+           source->height() >= 2)
+    {
+        auto ifd = std::make_shared<cuslide::tiff::IFD>(this, ifd_index++, source);
+        virtual_level_ifds_.emplace_back(ifd);
+        source = std::move(ifd);
+    }
 }
 void TIFF::resolve_vendor_format()
 {
@@ -696,13 +848,13 @@ bool TIFF::read(const cucim::io::format::ImageMetadataDesc* metadata,
     const int32_t ndim = request->size_ndim;
     const uint64_t location_len = request->location_len;
 
-    if (request->level >= level_to_ifd_idx_.size())
+    if (request->level >= level_count())
     {
-        throw std::invalid_argument(fmt::format(
-            "Invalid level ({}) in the request! (Should be < {})", request->level, level_to_ifd_idx_.size()));
+        throw std::invalid_argument(
+            fmt::format("Invalid level ({}) in the request! (Should be < {})", request->level, level_count()));
     }
     auto main_ifd = ifds_[level_to_ifd_idx_[0]];
-    auto ifd = ifds_[level_to_ifd_idx_[request->level]];
+    auto ifd = level_ifd(request->level);
     auto original_img_width = main_ifd->width();
     auto original_img_height = main_ifd->height();
 
@@ -823,10 +975,18 @@ bool TIFF::read_associated_image(const cucim::io::format::ImageMetadataDesc* met
                     strip_nbytes = row_nbytes * (height - start_row);
                 }
 
+                // A remote file is read here and the strip is decoded in memory.
+                std::unique_ptr<uint8_t, decltype(cucim_free)*> piece_buf(nullptr, cucim_free);
+                if (file_handle_->fd < 0)
+                {
+                    piece_buf.reset(read_bytes(offset, size));
+                    offset = 0;
+                }
+
                 switch (compression_method)
                 {
                 case COMPRESSION_JPEG:
-                    if (!cuslide::jpeg::decode_libjpeg(file_handle_->fd, nullptr /*jpeg_buf*/, offset, size,
+                    if (!cuslide::jpeg::decode_libjpeg(file_handle_->fd, piece_buf.get(), offset, size,
                                                        jpegtable_data, jpegtable_count, &target_ptr, out_device,
                                                        jpeg_color_space))
                     {
@@ -836,7 +996,7 @@ bool TIFF::read_associated_image(const cucim::io::format::ImageMetadataDesc* met
                     }
                     break;
                 case COMPRESSION_LZW:
-                    if (!cuslide::lzw::decode_lzw(file_handle_->fd, nullptr /*jpeg_buf*/, offset, size, &target_ptr,
+                    if (!cuslide::lzw::decode_lzw(file_handle_->fd, piece_buf.get(), offset, size, &target_ptr,
                                                   strip_nbytes, out_device))
                     {
                         cucim_free(raster);
@@ -1045,6 +1205,27 @@ std::shared_ptr<CuCIMFileHandle>& TIFF::file_handle()
 {
     return tiff_client_;
 }
+uint8_t* TIFF::read_bytes(uint64_t offset, uint64_t size) const
+{
+    uint8_t* buf = static_cast<uint8_t*>(cucim_malloc(size));
+    if (buf == nullptr)
+    {
+        throw std::runtime_error(fmt::format("Unable to allocate {} bytes to read {}", size, file_path_));
+    }
+    try
+    {
+        if (file_handle_->source->read(buf, size, offset) != size)
+        {
+            throw std::runtime_error(fmt::format("Unable to read {} bytes at offset {} of {}", size, offset, file_path_));
+        }
+    }
+    catch (...)
+    {
+        cucim_free(buf);
+        throw;
+    }
+    return buf;
+}
 const std::vector<ifd_offset_t>& TIFF::ifd_offsets() const
 {
     return ifd_offsets_;
@@ -1055,7 +1236,11 @@ std::shared_ptr<IFD> TIFF::ifd(size_t index) const
 }
 std::shared_ptr<IFD> TIFF::level_ifd(size_t level_index) const
 {
-    return ifds_.at(level_to_ifd_idx_.at(level_index));
+    if (level_index >= level_to_ifd_idx_.size())
+    {
+        return virtual_level_ifds_.at(level_index - level_to_ifd_idx_.size());
+    }
+    return ifds_.at(level_to_ifd_idx_[level_index]);
 }
 size_t TIFF::ifd_count() const
 {
@@ -1063,7 +1248,7 @@ size_t TIFF::ifd_count() const
 }
 size_t TIFF::level_count() const
 {
-    return level_to_ifd_idx_.size();
+    return level_to_ifd_idx_.size() + virtual_level_ifds_.size();
 }
 const std::map<std::string, AssociatedImageBufferDesc>& TIFF::associated_images() const
 {
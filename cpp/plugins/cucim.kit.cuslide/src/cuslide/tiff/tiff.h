@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -47,6 +47,14 @@ public:
      * Resolve vendor format and fix values for `associated_image_descs_` and `level_to_ifd_idx_.
      */
     void resolve_vendor_format();
+
+    /**
+     * Synthesize virtual levels (2x, 4x, ... downsampled) for an image with a single level.
+     *
+     * Levels are added until a level fits in a tile. Only 8-bit unsigned, interleaved images that the fast path can
+     * read are supported. Virtual levels follow the levels stored in the file (see `level_ifd()`).
+     */
+    void construct_virtual_levels();
     bool read(const cucim::io::format::ImageMetadataDesc* metadata,
               const cucim::io::format::ImageReaderRegionRequestDesc* request,
               cucim::io::format::ImageDataDesc* out_image_data,
@@ -61,6 +69,13 @@ public:
     std::shared_ptr<CuCIMFileHandle>& file_handle(); /// used for moving the ownership of the file handle to the caller.
                                                      /// Do not use for the application -- it will return nullptr.
     ::TIFF* client() const;
+    /**
+     * Read `size` bytes at `offset` of the file into a buffer allocated with cucim_malloc().
+     *
+     * Used for files without a file descriptor (remote files, read through the byte source of the file handle). The
+     * decoders read local files directly. Throws std::runtime_error if the bytes cannot be read.
+     */
+    uint8_t* read_bytes(uint64_t offset, uint64_t size) const;
     const std::vector<ifd_offset_t>& ifd_offsets() const;
     std::shared_ptr<IFD> ifd(size_t index) const;
     std::shared_ptr<IFD> level_ifd(size_t level_index) const;
@@ -99,9 +114,13 @@ private:
     std::shared_ptr<CuCIMFileHandle> file_handle_shared_;
     CuCIMFileHandle* file_handle_ = nullptr;
     ::TIFF* tiff_client_ = nullptr;
+    /// Position of libtiff in a remote file (libtiff reads remote files through client procedures)
+    struct ClientStream;
+    std::unique_ptr<ClientStream> client_stream_;
     std::vector<ifd_offset_t> ifd_offsets_; /// IFD offset for an index (IFD index)
     std::vector<std::shared_ptr<IFD>> ifds_; /// IFD object for an index (IFD index)
     std::vector<size_t> level_to_ifd_idx_;
+    std::vector<std::shared_ptr<IFD>> virtual_level_ifds_; /// IFD object for a virtual level (after the stored levels)
     // note: we use std::map instead of std::unordered_map as # of associated_image would be usually less than 10.
     std::map<std::string, AssociatedImageBufferDesc> associated_images_;
     bool is_big_endian_ = false; /// if big endian
@@ -0,0 +1,726 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tiff_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <tiffio.h>
+
+#include <cucim/concurrent/threadpool.h>
+#include <cucim/filesystem/byte_source.h>
+#include <cucim/filesystem/file_handle.h>
+#include <cucim/profiler/nvtx3.h>
+
+#include "cuslide/deflate/deflate.h"
+#include "cuslide/jpeg/libjpeg_turbo.h"
+#include "cuslide/zstd/libzstd.h"
+#include "downsample.h"
+#include "ifd.h"
+#include "tiff.h"
+
+namespace cuslide::tiff
+{
+
+namespace
+{
+
+constexpr int kDeflateLevel = 6;
+constexpr int kZstdLevel = 3;
+
+// Field types of TIFF
+constexpr uint16_t kTypeShort = 3;
+constexpr uint16_t kTypeLong = 4;
+constexpr uint16_t kTypeRational = 5;
+constexpr uint16_t kTypeLong8 = 16;
+
+enum class TileCompression
+{
+    kRaw,
+    kJpeg,
+    kDeflate,
+    kZstd,
+};
+
+TileCompression lookup_tile_compression(const char* name)
+{
+    const std::string_view compression = name ? name : "jpeg";
+    if (compression == "jpeg")
+    {
+        return TileCompression::kJpeg;
+    }
+    if (compression == "deflate")
+    {
+        return TileCompression::kDeflate;
+    }
+    if (compression == "zstd")
+    {
+        return TileCompression::kZstd;
+    }
+    if (compression == "raw")
+    {
+        return TileCompression::kRaw;
+    }
+    throw std::invalid_argument(
+        fmt::format("Compression '{}' is not supported (use 'jpeg', 'deflate', 'zstd' or 'raw')!", compression));
+}
+
+uint16_t compression_tag(TileCompression compression)
+{
+    switch (compression)
+    {
+    case TileCompression::kJpeg:
+        return COMPRESSION_JPEG;
+    case TileCompression::kDeflate:
+        return COMPRESSION_ADOBE_DEFLATE;
+    case TileCompression::kZstd:
+        return cuslide::zstd::kCompressionZstd;
+    case TileCompression::kRaw:
+        break;
+    }
+    return COMPRESSION_NONE;
+}
+
+void write_at(int fd, const void* data, size_t nbytes, uint64_t offset)
+{
+    auto ptr = static_cast<const uint8_t*>(data);
+    while (nbytes > 0)
+    {
+        const ssize_t written = ::pwrite(fd, ptr, nbytes, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(fmt::format("Unable to write the TIFF file: {}", std::strerror(errno)));
+        }
+        ptr += written;
+        nbytes -= written;
+        offset += written;
+    }
+}
+
+void read_at(cucim::filesystem::ByteSource& source, void* data, size_t nbytes, uint64_t offset)
+{
+    if (source.read(data, nbytes, offset) != nbytes)
+    {
+        throw std::runtime_error("Unable to read the source TIFF file: unexpected end of file");
+    }
+}
+
+/**
+ * @brief Return true if the compressed tiles of the level can be copied to a JPEG-compressed TIFF file as they are.
+ */
+bool is_jpeg_copyable(const IFD& ifd)
+{
+    return !ifd.is_virtual() && ifd.compression() == COMPRESSION_JPEG && ifd.samples_per_pixel() == 3 &&
+           ifd.bits_per_sample() == 8 && ifd.planar_config() == PLANARCONFIG_CONTIG &&
+           (ifd.photometric() == PHOTOMETRIC_RGB || ifd.photometric() == PHOTOMETRIC_YCBCR) && ifd.tile_width() > 0 &&
+           ifd.tile_height() > 0 && ifd.tile_width() % 16 == 0 && ifd.tile_height() % 16 == 0;
+}
+
+/**
+ * @brief Make an abbreviated JPEG stream self-contained by inserting the tables (JPEGTABLES without SOI/EOI) after
+ * its SOI marker.
+ */
+void merge_jpeg_tables(const std::vector<uint8_t>& tables, std::vector<uint8_t>& tile)
+{
+    const bool has_tables = tables.size() > 4 && tables[0] == 0xFF && tables[1] == 0xD8 &&
+                            tables[tables.size() - 2] == 0xFF && tables[tables.size() - 1] == 0xD9;
+    if (has_tables && tile.size() >= 2 && tile[0] == 0xFF && tile[1] == 0xD8)
+    {
+        tile.insert(tile.begin() + 2, tables.begin() + 2, tables.end() - 2);
+    }
+}
+
+/**
+ * @brief Return the (horizontal, vertical) sampling factors of the first (luma) component of a JPEG stream.
+ *
+ * Returns (2, 2) if no frame header is found.
+ */
+std::vector<uint16_t> jpeg_subsampling(const std::vector<uint8_t>& data)
+{
+    size_t i = 2; // after SOI
+    while (i + 4 <= data.size() && data[i] == 0xFF)
+    {
+        const uint8_t marker = data[i + 1];
+        if (marker == 0xFF) // fill byte
+        {
+            ++i;
+            continue;
+        }
+        // SOFn (except DHT, JPG and DAC)
+        const bool is_frame_header = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+                                     marker != 0xCC;
+        if (is_frame_header && i + 12 <= data.size() && data[i + 9] > 0)
+        {
+            const uint8_t factors = data[i + 11];
+            return { static_cast<uint16_t>(factors >> 4), static_cast<uint16_t>(factors & 0xF) };
+        }
+        if (marker == 0xDA) // SOS
+        {
+            break;
+        }
+        i += 2 + ((data[i + 2] << 8) | data[i + 3]);
+    }
+    return { 2, 2 };
+}
+
+/**
+ * @brief An IFD of a BigTIFF file in the byte order of the host (little-endian).
+ *
+ * Values larger than 8 bytes are stored right after the IFD.
+ */
+class IfdBuilder
+{
+public:
+    void add(uint16_t tag, uint16_t type, uint64_t count, const void* values, size_t nbytes)
+    {
+        auto ptr = static_cast<const uint8_t*>(values);
+        entries_.push_back(Entry{ tag, type, count, std::vector<uint8_t>(ptr, ptr + nbytes) });
+    }
+    void add_shorts(uint16_t tag, const std::vector<uint16_t>& values)
+    {
+        add(tag, kTypeShort, values.size(), values.data(), values.size() * sizeof(uint16_t));
+    }
+    void add_long(uint16_t tag, uint32_t value)
+    {
+        add(tag, kTypeLong, 1, &value, sizeof(value));
+    }
+    void add_long8s(uint16_t tag, const std::vector<uint64_t>& values)
+    {
+        add(tag, kTypeLong8, values.size(), values.data(), values.size() * sizeof(uint64_t));
+    }
+    void add_rational(uint16_t tag, uint32_t numerator, uint32_t denominator)
+    {
+        const uint32_t values[2] = { numerator, denominator };
+        add(tag, kTypeRational, 1, values, sizeof(values));
+    }
+
+    uint64_t size() const
+    {
+        uint64_t nbytes = kHeaderSize + entries_.size() * kEntrySize + sizeof(uint64_t);
+        for (const auto& entry : entries_)
+        {
+            if (entry.data.size() > sizeof(uint64_t))
+            {
+                nbytes += align(entry.data.size());
+            }
+        }
+        return nbytes;
+    }
+
+    /**
+     * @brief Return the bytes of the IFD written at `offset` and followed by the IFD at `next_offset` (0 if last).
+     */
+    std::vector<uint8_t> serialize(uint64_t offset, uint64_t next_offset)
+    {
+        std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.tag < b.tag; });
+
+        std::vector<uint8_t> out(size(), 0);
+        const uint64_t entry_count = entries_.size();
+        memcpy(out.data(), &entry_count, sizeof(entry_count));
+        uint64_t data_offset = kHeaderSize + entries_.size() * kEntrySize + sizeof(uint64_t);
+        uint8_t* entry_ptr = out.data() + kHeaderSize;
+        for (const auto& entry : entries_)
+        {
+            memcpy(entry_ptr, &entry.tag, sizeof(entry.tag));
+            memcpy(entry_ptr + 2, &entry.type, sizeof(entry.type));
+            memcpy(entry_ptr + 4, &entry.count, sizeof(entry.count));
+            if (entry.data.size() <= sizeof(uint64_t))
+            {
+                memcpy(entry_ptr + 12, entry.data.data(), entry.data.size());
+            }
+            else
+            {
+                const uint64_t value_offset = offset + data_offset;
+                memcpy(entry_ptr + 12, &value_offset, sizeof(value_offset));
+                memcpy(out.data() + data_offset, entry.data.data(), entry.data.size());
+                data_offset += align(entry.data.size());
+            }
+            entry_ptr += kEntrySize;
+        }
+        memcpy(entry_ptr, &next_offset, sizeof(next_offset));
+        return out;
+    }
+
+private:
+    static constexpr uint64_t kHeaderSize = 8; // number of entries
+    static constexpr uint64_t kEntrySize = 20; // tag, type, count and value (or offset)
+
+    static uint64_t align(uint64_t nbytes)
+    {
+        return (nbytes + 7) & ~uint64_t{ 7 };
+    }
+
+    struct Entry
+    {
+        uint16_t tag;
+        uint16_t type;
+        uint64_t count;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Entry> entries_;
+};
+
+class PyramidWriter
+{
+public:
+    explicit PyramidWriter(const cucim::io::format::ImageWriterRequestDesc& request);
+    ~PyramidWriter();
+
+    void write();
+
+private:
+    struct Level
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t tile_width = 0;
+        uint32_t tile_height = 0;
+        uint32_t tiles_across = 0;
+        std::shared_ptr<IFD> source; /// Level of the source file whose compressed tiles are copied (if not nullptr)
+        uint16_t photometric = 0;
+        std::vector<uint16_t> ycbcr_subsampling; /// For JPEG compression
+        std::shared_ptr<uint8_t[]> band; /// `tile_height_` rows from `band_row`
+        uint32_t band_row = 0;
+        uint32_t band_rows = 0;
+        std::vector<uint64_t> tile_offsets;
+        std::vector<uint64_t> tile_bytecounts;
+    };
+
+    struct PendingTile
+    {
+        Level* level;
+        uint32_t index;
+        std::shared_ptr<std::vector<uint8_t>> data;
+        std::future<void> done;
+    };
+
+    void add_level(uint32_t width, uint32_t height, uint32_t tile_width, uint32_t tile_height);
+    std::shared_ptr<uint8_t[]> allocate_band(const Level& level) const;
+    // Copy the compressed tiles of the levels that have a source level.
+    void copy_tiles();
+    // Encode the tiles of the band of the level and downsample the band into the next level.
+    void flush_band(size_t level_index);
+    // Write encoded tiles (in order) until at most `max_pending` tiles are left.
+    void drain(size_t max_pending);
+    void write_ifds();
+
+    const cucim::io::format::ImageWriterRequestDesc& request_;
+    std::string file_path_;
+    TileCompression compression_;
+    uint32_t tile_width_;
+    uint32_t tile_height_;
+    uint32_t samples_per_pixel_;
+    std::vector<Level> levels_;
+    // Level read from the source (level 0 or the last copied level) and downsampled into the following levels
+    size_t base_level_ = 0;
+    std::shared_ptr<cucim::filesystem::ByteSource> source_;
+    std::deque<PendingTile> pending_tiles_;
+    size_t max_pending_tiles_ = 0;
+    int fd_ = -1;
+    uint64_t file_offset_ = 0;
+};
+
+PyramidWriter::PyramidWriter(const cucim::io::format::ImageWriterRequestDesc& request)
+    : request_(request),
+      file_path_(request.file_path ? request.file_path : ""),
+      compression_(lookup_tile_compression(request.compression)),
+      tile_width_(request.tile_width),
+      tile_height_(request.tile_height),
+      samples_per_pixel_(request.samples_per_pixel)
+{
+    if (file_path_.empty() || !request.read_rows)
+    {
+        throw std::invalid_argument("The file path and the source of the image should be given!");
+    }
+    if (request.width <= 0 || request.height <= 0 || request.width > UINT32_MAX || request.height > UINT32_MAX)
+    {
+        throw std::invalid_argument(
+            fmt::format("Invalid image size ({}x{}) to write a TIFF file!", request.width, request.height));
+    }
+    if (tile_width_ == 0 || tile_height_ == 0 || tile_width_ % 16 != 0 || tile_height_ % 16 != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Tile size ({}x{}) should be a positive multiple of 16!", tile_width_, tile_height_));
+    }
+    if (samples_per_pixel_ == 0)
+    {
+        throw std::invalid_argument("samples_per_pixel should be positive!");
+    }
+    if (compression_ == TileCompression::kJpeg && samples_per_pixel_ != 3)
+    {
+        throw std::invalid_argument(fmt::format(
+            "JPEG compression needs RGB pixels but {} samples per pixel are given (use 'deflate' or 'zstd')!",
+            samples_per_pixel_));
+    }
+    if (compression_ == TileCompression::kJpeg && (request.quality < 1 || request.quality > 100))
+    {
+        throw std::invalid_argument(fmt::format("JPEG quality ({}) should be in [1, 100]!", request.quality));
+    }
+
+    uint32_t width = static_cast<uint32_t>(request.width);
+    uint32_t height = static_cast<uint32_t>(request.height);
+
+    // Levels of the source file stored as JPEG tiles are copied without decoding. Only the levels below the last
+    // copied level are computed (from that level).
+    if (request.source_handle && compression_ == TileCompression::kJpeg)
+    {
+        auto handle = reinterpret_cast<CuCIMFileHandle*>(request.source_handle);
+        auto tif = static_cast<TIFF*>(handle->client_data);
+        source_ = handle->source;
+        for (size_t i = 0; i < tif->level_count(); ++i)
+        {
+            std::shared_ptr<IFD> ifd = tif->level_ifd(i);
+            const bool matches_source = i > 0 || (ifd->width() == width && ifd->height() == height);
+            if ((request.level_count && levels_.size() == request.level_count) || !matches_source ||
+                !is_jpeg_copyable(*ifd))
+            {
+                break;
+            }
+            add_level(ifd->width(), ifd->height(), ifd->tile_width(), ifd->tile_height());
+            levels_.back().source = ifd;
+            levels_.back().photometric = ifd->photometric();
+            levels_.back().ycbcr_subsampling.clear(); // taken from the tiles
+        }
+    }
+
+    if (levels_.empty())
+    {
+        add_level(width, height, tile_width_, tile_height_);
+    }
+    base_level_ = levels_.size() - 1;
+    width = levels_.back().width;
+    height = levels_.back().height;
+    while (true)
+    {
+        const bool has_next = request.level_count ? levels_.size() < request.level_count :
+                                                    (width > tile_width_ || height > tile_height_);
+        if (!has_next || width < 2 || height < 2)
+        {
+            break;
+        }
+        width /= 2;
+        height /= 2;
+        add_level(width, height, tile_width_, tile_height_);
+    }
+    for (size_t i = base_level_; i < levels_.size(); ++i)
+    {
+        levels_[i].band = allocate_band(levels_[i]);
+    }
+    // Tiles of two bands of the base level (and of the lower levels) can be in flight: one being encoded while the
+    // next band is read.
+    const size_t base_tiles_across = (levels_[base_level_].width + tile_width_ - 1) / tile_width_;
+    max_pending_tiles_ = 2 * base_tiles_across + levels_.size();
+
+    fd_ = ::open(file_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+    {
+        throw std::runtime_error(fmt::format("Unable to create '{}': {}", file_path_, std::strerror(errno)));
+    }
+}
+
+PyramidWriter::~PyramidWriter()
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+}
+
+void PyramidWriter::add_level(uint32_t width, uint32_t height, uint32_t tile_width, uint32_t tile_height)
+{
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.tile_width = tile_width;
+    level.tile_height = tile_height;
+    level.tiles_across = (width + tile_width - 1) / tile_width;
+    const uint32_t tile_count = level.tiles_across * ((height + tile_height - 1) / tile_height);
+    level.tile_offsets.resize(tile_count);
+    level.tile_bytecounts.resize(tile_count);
+    if (compression_ == TileCompression::kJpeg)
+    {
+        level.photometric = PHOTOMETRIC_YCBCR;
+        level.ycbcr_subsampling = { 2, 2 };
+    }
+    else
+    {
+        level.photometric = samples_per_pixel_ >= 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
+    }
+    levels_.emplace_back(std::move(level));
+}
+
+std::shared_ptr<uint8_t[]> PyramidWriter::allocate_band(const Level& level) const
+{
+    const size_t band_nbytes = static_cast<size_t>(tile_height_) * level.width * samples_per_pixel_;
+    return std::shared_ptr<uint8_t[]>(new uint8_t[band_nbytes]);
+}
+
+void PyramidWriter::write()
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(tiff_writer_write_pyramid));
+    // BigTIFF header (little-endian). The offset of the first IFD is written at the end.
+    const uint8_t header[16] = { 'I', 'I', 43, 0, 8, 0, 0, 0 };
+    write_at(fd_, header, sizeof(header), 0);
+    file_offset_ = sizeof(header);
+
+    copy_tiles();
+
+    // Nothing is decoded if all levels are copied.
+    Level& base = levels_[base_level_];
+    const bool needs_rows = !base.source || base_level_ + 1 < levels_.size();
+    for (uint32_t row = 0; needs_rows && row < base.height; row += tile_height_)
+    {
+        const uint32_t row_count = std::min(tile_height_, base.height - row);
+        if (!request_.read_rows(request_.context, base_level_, row, row_count, base.band.get()))
+        {
+            throw std::runtime_error(fmt::format(
+                "Unable to read rows {}-{} of level {} of the source image!", row, row + row_count - 1, base_level_));
+        }
+        base.band_rows = row_count;
+        flush_band(base_level_);
+        drain(max_pending_tiles_);
+    }
+    drain(0);
+    write_ifds();
+    if (::close(fd_) != 0)
+    {
+        fd_ = -1;
+        throw std::runtime_error(fmt::format("Unable to close '{}': {}", file_path_, std::strerror(errno)));
+    }
+    fd_ = -1;
+}
+
+void PyramidWriter::flush_band(size_t level_index)
+{
+    Level& level = levels_[level_index];
+    const uint32_t tile_row = level.band_row / tile_height_;
+    const size_t pixel_nbytes = samples_per_pixel_;
+    const size_t band_stride = level.width * pixel_nbytes;
+    std::shared_ptr<const uint8_t[]> band = std::move(level.band);
+
+    const bool is_worker_thread = cucim::concurrent::ThreadPool::is_worker_thread();
+    // Tiles of a copied level are already written.
+    for (uint32_t column = 0; !level.source && column < level.tiles_across; ++column)
+    {
+        const uint32_t x = column * tile_width_;
+        const size_t column_nbytes = std::min(tile_width_, level.width - x) * pixel_nbytes;
+        auto data = std::make_shared<std::vector<uint8_t>>();
+        auto encode = [=, tile_width = tile_width_, tile_height = tile_height_, band_rows = level.band_rows,
+                       compression = compression_, quality = request_.quality]() {
+            PROF_SCOPED_RANGE(PROF_EVENT(tiff_writer_encode_tile));
+            // Parts of the tile past the image are zero.
+            const size_t tile_stride = tile_width * pixel_nbytes;
+            std::vector<uint8_t> tile(tile_stride * tile_height, 0);
+            for (uint32_t y = 0; y < band_rows; ++y)
+            {
+                memcpy(tile.data() + y * tile_stride, band.get() + y * band_stride + x * pixel_nbytes, column_nbytes);
+            }
+            switch (compression)
+            {
+            case TileCompression::kJpeg:
+                cuslide::jpeg::encode_libjpeg(tile.data(), tile_width, tile_height, pixel_nbytes, quality, *data);
+                break;
+            case TileCompression::kDeflate:
+                cuslide::deflate::encode_deflate(tile.data(), tile.size(), kDeflateLevel, *data);
+                break;
+            case TileCompression::kZstd:
+                cuslide::zstd::encode_zstd(tile.data(), tile.size(), kZstdLevel, *data);
+                break;
+            case TileCompression::kRaw:
+                *data = std::move(tile);
+                break;
+            }
+        };
+
+        std::future<void> done;
+        if (is_worker_thread)
+        {
+            // A task on the executor shouldn't wait for other tasks of the executor.
+            std::promise<void> promise;
+            encode();
+            promise.set_value();
+            done = promise.get_future();
+        }
+        else
+        {
+            done = cucim::concurrent::ThreadPool::submit(std::move(encode));
+        }
+        pending_tiles_.push_back(
+            PendingTile{ &level, tile_row * level.tiles_across + column, std::move(data), std::move(done) });
+    }
+
+    // The last rows of a level are dropped if the next level is already complete (odd height).
+    if (level_index + 1 < levels_.size() && levels_[level_index + 1].band_row < levels_[level_index + 1].height)
+    {
+        Level& next = levels_[level_index + 1];
+        const uint32_t row_count = std::min(level.band_rows / 2, next.height - next.band_row - next.band_rows);
+        downsample_2x2(band.get(), band_stride, next.band.get() + next.band_rows * next.width * pixel_nbytes,
+                       next.width * pixel_nbytes, next.width, row_count, pixel_nbytes);
+        next.band_rows += row_count;
+        if (next.band_rows == tile_height_ || next.band_row + next.band_rows == next.height)
+        {
+            flush_band(level_index + 1);
+        }
+    }
+
+    level.band_row += level.band_rows;
+    level.band_rows = 0;
+    if (level.band_row < level.height)
+    {
+        level.band = allocate_band(level);
+    }
+}
+
+void PyramidWriter::copy_tiles()
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(tiff_writer_copy_tiles));
+    std::vector<uint8_t> tile;
+    for (auto& level : levels_)
+    {
+        if (!level.source)
+        {
+            continue;
+        }
+        const auto& offsets = level.source->image_piece_offsets();
+        const auto& bytecounts = level.source->image_piece_bytecounts();
+        const auto& tables = level.source->jpegtable();
+        for (size_t i = 0; i < level.tile_offsets.size() && i < offsets.size(); ++i)
+        {
+            // Missing tiles stay missing.
+            if (bytecounts[i] == 0)
+            {
+                continue;
+            }
+            tile.resize(bytecounts[i]);
+            read_at(*source_, tile.data(), tile.size(), offsets[i]);
+            merge_jpeg_tables(tables, tile);
+            if (level.photometric == PHOTOMETRIC_YCBCR && level.ycbcr_subsampling.empty())
+            {
+                level.ycbcr_subsampling = jpeg_subsampling(tile);
+            }
+            write_at(fd_, tile.data(), tile.size(), file_offset_);
+            level.tile_offsets[i] = file_offset_;
+            level.tile_bytecounts[i] = tile.size();
+            file_offset_ += (tile.size() + 1) & ~uint64_t{ 1 };
+        }
+        if (level.photometric == PHOTOMETRIC_YCBCR && level.ycbcr_subsampling.empty())
+        {
+            level.ycbcr_subsampling = { 2, 2 };
+        }
+    }
+}
+
+void PyramidWriter::drain(size_t max_pending)
+{
+    while (pending_tiles_.size() > max_pending)
+    {
+        PendingTile& tile = pending_tiles_.front();
+        tile.done.get(); // rethrows an encoding error
+        const std::vector<uint8_t>& data = *tile.data;
+        write_at(fd_, data.data(), data.size(), file_offset_);
+        tile.level->tile_offsets[tile.index] = file_offset_;
+        tile.level->tile_bytecounts[tile.index] = data.size();
+        // Keep tiles aligned to words as TIFF requires.
+        file_offset_ += (data.size() + 1) & ~uint64_t{ 1 };
+        pending_tiles_.pop_front();
+    }
+}
+
+void PyramidWriter::write_ifds()
+{
+    const auto& base = levels_[0];
+    const bool has_spacing = request_.spacing[0] > 0.0f && request_.spacing[1] > 0.0f;
+    const uint32_t color_samples = samples_per_pixel_ >= 3 ? 3 : 1;
+    const uint32_t extra_samples = samples_per_pixel_ - color_samples;
+
+    std::vector<IfdBuilder> ifds(levels_.size());
+    for (size_t i = 0; i < levels_.size(); ++i)
+    {
+        const Level& level = levels_[i];
+        IfdBuilder& ifd = ifds[i];
+        ifd.add_long(TIFFTAG_SUBFILETYPE, i == 0 ? 0 : FILETYPE_REDUCEDIMAGE);
+        ifd.add_long(TIFFTAG_IMAGEWIDTH, level.width);
+        ifd.add_long(TIFFTAG_IMAGELENGTH, level.height);
+        ifd.add_shorts(TIFFTAG_BITSPERSAMPLE, std::vector<uint16_t>(samples_per_pixel_, 8));
+        ifd.add_shorts(TIFFTAG_COMPRESSION, { compression_tag(compression_) });
+        ifd.add_shorts(TIFFTAG_PHOTOMETRIC, { level.photometric });
+        ifd.add_shorts(TIFFTAG_SAMPLESPERPIXEL, { static_cast<uint16_t>(samples_per_pixel_) });
+        ifd.add_shorts(TIFFTAG_PLANARCONFIG, { PLANARCONFIG_CONTIG });
+        if (has_spacing)
+        {
+            // Pixels per centimeter (with 3 decimal digits) at the level.
+            const double x_resolution = 1e4 * level.width / (request_.spacing[0] * base.width);
+            const double y_resolution = 1e4 * level.height / (request_.spacing[1] * base.height);
+            ifd.add_rational(TIFFTAG_XRESOLUTION, static_cast<uint32_t>(std::lround(x_resolution * 1000)), 1000);
+            ifd.add_rational(TIFFTAG_YRESOLUTION, static_cast<uint32_t>(std::lround(y_resolution * 1000)), 1000);
+            ifd.add_shorts(TIFFTAG_RESOLUTIONUNIT, { RESUNIT_CENTIMETER });
+        }
+        ifd.add_long(TIFFTAG_TILEWIDTH, level.tile_width);
+        ifd.add_long(TIFFTAG_TILELENGTH, level.tile_height);
+        ifd.add_long8s(TIFFTAG_TILEOFFSETS, level.tile_offsets);
+        ifd.add_long8s(TIFFTAG_TILEBYTECOUNTS, level.tile_bytecounts);
+        if (extra_samples)
+        {
+            // A single extra sample of gray or RGB pixels is taken as the alpha channel.
+            const uint16_t extra_sample = extra_samples == 1 ? EXTRASAMPLE_UNASSALPHA : EXTRASAMPLE_UNSPECIFIED;
+            ifd.add_shorts(TIFFTAG_EXTRASAMPLES, std::vector<uint16_t>(extra_samples, extra_sample));
+        }
+        ifd.add_shorts(TIFFTAG_SAMPLEFORMAT, std::vector<uint16_t>(samples_per_pixel_, SAMPLEFORMAT_UINT));
+        if (!level.ycbcr_subsampling.empty())
+        {
+            ifd.add_shorts(TIFFTAG_YCBCRSUBSAMPLING, level.ycbcr_subsampling);
+        }
+    }
+
+    // IFDs are written after the tiles.
+    std::vector<uint64_t> ifd_offsets(levels_.size() + 1, 0);
+    ifd_offsets[0] = file_offset_;
+    for (size_t i = 0; i < ifds.size(); ++i)
+    {
+        ifd_offsets[i + 1] = ifd_offsets[i] + ifds[i].size();
+    }
+    for (size_t i = 0; i < ifds.size(); ++i)
+    {
+        const uint64_t next_offset = i + 1 < ifds.size() ? ifd_offsets[i + 1] : 0;
+        const std::vector<uint8_t> data = ifds[i].serialize(ifd_offsets[i], next_offset);
+        write_at(fd_, data.data(), data.size(), ifd_offsets[i]);
+    }
+    write_at(fd_, &ifd_offsets[0], sizeof(uint64_t), 8);
+}
+
+} // namespace
+
+void write_pyramid(const cucim::io::format::ImageWriterRequestDesc& request)
+{
+    PyramidWriter writer(request);
+    try
+    {
+        writer.write();
+    }
+    catch (...)
+    {
+        ::unlink(request.file_path);
+        throw;
+    }
+}
+
+} // namespace cuslide::tiff
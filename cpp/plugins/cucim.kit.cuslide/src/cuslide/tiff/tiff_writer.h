@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUSLIDE_TIFF_WRITER_H
+#define CUSLIDE_TIFF_WRITER_H
+
+#include <cucim/io/format/image_format.h>
+
+namespace cuslide::tiff
+{
+
+/**
+ * @brief Write an image as a tiled, pyramidal BigTIFF file.
+ *
+ * Source rows are read (`request->read_rows`) one band of tiles at a time, so the image doesn't need to fit in
+ * memory. The tiles of a band are encoded in parallel on the process-wide executor while the next band is read, and
+ * the band is downsampled (2x2 average) into the band of the next level, so all levels are written in a single pass.
+ * Levels are stored in consecutive IFDs (level 0 first, then reduced-resolution images) that cuslide reads with its
+ * fast path.
+ *
+ * If `request.source_handle` is given and JPEG compression is requested, the source levels stored as JPEG tiles (from
+ * level 0) are copied without decoding (JPEGTABLES are merged into each tile), and only the levels below them are
+ * computed from the last copied level.
+ *
+ * Throws std::invalid_argument for an unsupported request and std::runtime_error if writing fails (the partial file
+ * is removed).
+ */
+void write_pyramid(const cucim::io::format::ImageWriterRequestDesc& request);
+
+} // namespace cuslide::tiff
+
+#endif // CUSLIDE_TIFF_WRITER_H
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Code below is using libwebp library which is under BSD-3-Clause License
+ * Please see LICENSE-3rdparty.md for the detail.
+ */
+
+#include "libwebp.h"
+
+#include <stdexcept>
+#include <unistd.h>
+
+#include <cucim/memory/memory_manager.h>
+#include <cucim/profiler/nvtx3.h>
+#include <fmt/format.h>
+
+#include <webp/decode.h>
+
+namespace cuslide::webp
+{
+
+bool decode_libwebp(int fd,
+                    unsigned char* webp_buf,
+                    uint64_t offset,
+                    uint64_t size,
+                    uint8_t** dest,
+                    uint64_t dest_nbytes,
+                    uint32_t row_nbytes,
+                    uint32_t samples_per_pixel,
+                    const cucim::io::Device& out_device)
+{
+    (void)out_device;
+
+    if (dest == nullptr)
+    {
+        throw std::runtime_error("'dest' shouldn't be nullptr in decode_libwebp()");
+    }
+    if (samples_per_pixel != 3 && samples_per_pixel != 4)
+    {
+        throw std::runtime_error(
+            fmt::format("WebP supports only RGB or RGBA pixels (samples per pixel: {})", samples_per_pixel));
+    }
+
+    // Allocate memory only when dest is not null
+    if (*dest == nullptr)
+    {
+        if ((*dest = (unsigned char*)cucim_malloc(dest_nbytes)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate uncompressed image buffer");
+        }
+    }
+
+    if (webp_buf == nullptr)
+    {
+        if ((webp_buf = (unsigned char*)cucim_malloc(size)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate buffer for libwebp!");
+        }
+
+        if (pread(fd, webp_buf, size, offset) < 1)
+        {
+            cucim_free(webp_buf);
+            throw std::runtime_error("Unable to read file for libwebp!");
+        }
+    }
+    else
+    {
+        fd = -1;
+        webp_buf += offset;
+    }
+
+    // WebP decodes directly into the tile buffer so no decoder state needs to be kept between tiles.
+    uint8_t* result;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(libwebp_decode));
+        if (samples_per_pixel == 3)
+        {
+            result = WebPDecodeRGBInto(webp_buf, size, *dest, dest_nbytes, row_nbytes);
+        }
+        else
+        {
+            result = WebPDecodeRGBAInto(webp_buf, size, *dest, dest_nbytes, row_nbytes);
+        }
+    }
+
+    if (fd != -1)
+    {
+        cucim_free(webp_buf);
+    }
+
+    if (result == nullptr)
+    {
+        throw std::runtime_error("Unable to decode WebP data!");
+    }
+    return true;
+}
+
+} // namespace cuslide::webp
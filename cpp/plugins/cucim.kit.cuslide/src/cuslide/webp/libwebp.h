@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CUSLIDE_LIBWEBP_H
+#define CUSLIDE_LIBWEBP_H
+
+#include <cucim/io/device.h>
+
+namespace cuslide::webp
+{
+constexpr uint32_t kCompressionWebp = 50001; // WebP (COMPRESSION_WEBP in libtiff)
+
+/**
+ * @brief Decode a WebP-compressed tile into 8-bit RGB (samples_per_pixel == 3) or RGBA (samples_per_pixel == 4).
+ */
+bool decode_libwebp(int fd,
+                    unsigned char* webp_buf,
+                    uint64_t offset,
+                    uint64_t size,
+                    uint8_t** dest,
+                    uint64_t dest_nbytes,
+                    uint32_t row_nbytes,
+                    uint32_t samples_per_pixel,
+                    const cucim::io::Device& out_device);
+
+} // namespace cuslide::webp
+
+#endif // CUSLIDE_LIBWEBP_H
@@ -0,0 +1,374 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "zarr_writer.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <cucim/concurrent/threadpool.h>
+#include <cucim/profiler/nvtx3.h>
+
+#include "cuslide/zstd/libzstd.h"
+
+using json = nlohmann::json;
+
+namespace cuslide::zarr
+{
+
+namespace
+{
+
+constexpr int kZstdLevel = 3;
+
+void write_file(const std::string& path, const void* data, size_t nbytes)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error(fmt::format("Unable to create '{}': {}", path, std::strerror(errno)));
+    }
+    auto ptr = static_cast<const uint8_t*>(data);
+    while (nbytes > 0)
+    {
+        const ssize_t written = ::write(fd, ptr, nbytes);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error(fmt::format("Unable to write '{}': {}", path, std::strerror(error)));
+        }
+        ptr += written;
+        nbytes -= written;
+    }
+    if (::close(fd) != 0)
+    {
+        throw std::runtime_error(fmt::format("Unable to close '{}': {}", path, std::strerror(errno)));
+    }
+}
+
+void write_json(const std::string& path, const json& value)
+{
+    const std::string text = value.dump(2);
+    write_file(path, text.data(), text.size());
+}
+
+void make_directory(const std::string& path)
+{
+    if (::mkdir(path.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        throw std::runtime_error(fmt::format("Unable to create directory '{}': {}", path, std::strerror(errno)));
+    }
+}
+
+class MultiscalesWriter
+{
+public:
+    explicit MultiscalesWriter(const cucim::io::format::ImageWriterRequestDesc& request);
+
+    void write();
+    // Wait for all chunks in flight, ignoring errors.
+    void abandon();
+
+private:
+    struct Level
+    {
+        int64_t width = 0;
+        int64_t height = 0;
+        float downsample = 1.0f;
+        uint32_t chunk_width = 0;
+        uint32_t chunk_height = 0;
+    };
+
+    void write_metadata();
+    void write_level(size_t level_index);
+    // Wait for written chunks (in order) until at most `max_pending` chunks are in flight.
+    void wait(size_t max_pending);
+
+    const cucim::io::format::ImageWriterRequestDesc& request_;
+    std::string path_;
+    bool compressed_ = true;
+    uint32_t samples_per_pixel_;
+    std::vector<Level> levels_;
+    std::deque<std::future<void>> pending_chunks_;
+};
+
+MultiscalesWriter::MultiscalesWriter(const cucim::io::format::ImageWriterRequestDesc& request)
+    : request_(request),
+      path_(request.file_path ? request.file_path : ""),
+      samples_per_pixel_(request.samples_per_pixel)
+{
+    if (path_.empty() || !request.read_rows)
+    {
+        throw std::invalid_argument("The directory path and the source of the image should be given!");
+    }
+    const std::string_view compression = request.compression ? request.compression : "zstd";
+    if (compression == "raw")
+    {
+        compressed_ = false;
+    }
+    else if (compression != "zstd")
+    {
+        throw std::invalid_argument(
+            fmt::format("Compression '{}' is not supported for Zarr (use 'zstd' or 'raw')!", compression));
+    }
+    if (samples_per_pixel_ == 0)
+    {
+        throw std::invalid_argument("samples_per_pixel should be positive!");
+    }
+    if (request.tile_width == 0 || request.tile_height == 0)
+    {
+        throw std::invalid_argument("Chunk size should be positive!");
+    }
+
+    const uint16_t source_level_count = std::max<uint16_t>(request.source_level_count, 1);
+    const uint16_t level_count =
+        request.level_count ? std::min(request.level_count, source_level_count) : source_level_count;
+    for (uint16_t i = 0; i < level_count; ++i)
+    {
+        Level level;
+        level.width = request.source_level_count ? request.source_level_dimensions[i * 2] : request.width;
+        level.height = request.source_level_count ? request.source_level_dimensions[i * 2 + 1] : request.height;
+        level.downsample = request.source_level_count ? request.source_level_downsamples[i] : 1.0f;
+        // Chunks are aligned to the tiles of the level.
+        const uint32_t* tile_size = request.source_level_count ? &request.source_level_tile_sizes[i * 2] : nullptr;
+        const bool is_tiled = tile_size && tile_size[0] > 0 && tile_size[1] > 0;
+        level.chunk_width = is_tiled ? tile_size[0] : request.tile_width;
+        level.chunk_height = is_tiled ? tile_size[1] : request.tile_height;
+        if (level.width <= 0 || level.height <= 0)
+        {
+            throw std::invalid_argument(
+                fmt::format("Invalid size ({}x{}) of level {} to write!", level.width, level.height, i));
+        }
+        levels_.push_back(level);
+    }
+
+    if (::mkdir(path_.c_str(), 0755) != 0)
+    {
+        if (errno == EEXIST)
+        {
+            throw std::invalid_argument(fmt::format("'{}' already exists!", path_));
+        }
+        throw std::runtime_error(fmt::format("Unable to create directory '{}': {}", path_, std::strerror(errno)));
+    }
+}
+
+void MultiscalesWriter::write()
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(zarr_writer_write_multiscales));
+    write_metadata();
+    for (size_t i = 0; i < levels_.size(); ++i)
+    {
+        write_level(i);
+    }
+    wait(0);
+}
+
+void MultiscalesWriter::abandon()
+{
+    while (!pending_chunks_.empty())
+    {
+        pending_chunks_.front().wait();
+        pending_chunks_.pop_front();
+    }
+}
+
+void MultiscalesWriter::write_metadata()
+{
+    const bool has_channels = samples_per_pixel_ > 1;
+    const bool has_spacing = request_.spacing[0] > 0.0f && request_.spacing[1] > 0.0f;
+
+    json axes = json::array();
+    if (has_channels)
+    {
+        axes.push_back({ { "name", "c" }, { "type", "channel" } });
+    }
+    for (const char* name : { "y", "x" })
+    {
+        json axis = { { "name", name }, { "type", "space" } };
+        if (has_spacing)
+        {
+            axis["unit"] = "micrometer";
+        }
+        axes.push_back(std::move(axis));
+    }
+
+    json datasets = json::array();
+    for (size_t i = 0; i < levels_.size(); ++i)
+    {
+        const Level& level = levels_[i];
+        json scale = json::array();
+        if (has_channels)
+        {
+            scale.push_back(1.0);
+        }
+        scale.push_back((has_spacing ? request_.spacing[1] : 1.0) * level.downsample);
+        scale.push_back((has_spacing ? request_.spacing[0] : 1.0) * level.downsample);
+        datasets.push_back({ { "path", std::to_string(i) },
+                             { "coordinateTransformations", { { { "type", "scale" }, { "scale", scale } } } } });
+
+        json shape = json::array();
+        json chunks = json::array();
+        if (has_channels)
+        {
+            shape.push_back(samples_per_pixel_);
+            chunks.push_back(samples_per_pixel_);
+        }
+        shape.push_back(level.height);
+        shape.push_back(level.width);
+        chunks.push_back(level.chunk_height);
+        chunks.push_back(level.chunk_width);
+        json zarray = { { "zarr_format", 2 },
+                        { "shape", shape },
+                        { "chunks", chunks },
+                        { "dtype", "|u1" },
+                        { "compressor", nullptr },
+                        { "fill_value", 0 },
+                        { "order", "C" },
+                        { "filters", nullptr },
+                        { "dimension_separator", "/" } };
+        if (compressed_)
+        {
+            zarray["compressor"] = { { "id", "zstd" }, { "level", kZstdLevel } };
+        }
+        const std::string level_path = fmt::format("{}/{}", path_, i);
+        make_directory(level_path);
+        write_json(level_path + "/.zarray", zarray);
+    }
+
+    const json multiscale = { { "version", "0.4" }, { "name", "image" }, { "axes", axes }, { "datasets", datasets } };
+    write_json(path_ + "/.zgroup", { { "zarr_format", 2 } });
+    write_json(path_ + "/.zattrs", { { "multiscales", json::array({ multiscale }) } });
+}
+
+void MultiscalesWriter::write_level(size_t level_index)
+{
+    const Level& level = levels_[level_index];
+    const bool has_channels = samples_per_pixel_ > 1;
+    const size_t pixel_nbytes = samples_per_pixel_;
+    const size_t band_stride = level.width * pixel_nbytes;
+    const uint32_t chunks_across = (level.width + level.chunk_width - 1) / level.chunk_width;
+    // Chunks of two bands can be in flight: one being written while the next band is read.
+    const size_t max_pending_chunks = 2 * static_cast<size_t>(chunks_across);
+
+    // Chunk keys are '<c>/<y>/<x>' ('<y>/<x>' without channels).
+    const std::string array_path = fmt::format("{}/{}", path_, level_index);
+    if (has_channels)
+    {
+        make_directory(array_path + "/0");
+    }
+    const std::string chunk_prefix = has_channels ? array_path + "/0" : array_path;
+
+    const bool is_worker_thread = cucim::concurrent::ThreadPool::is_worker_thread();
+    for (int64_t row = 0; row < level.height; row += level.chunk_height)
+    {
+        const uint32_t band_rows = static_cast<uint32_t>(std::min<int64_t>(level.chunk_height, level.height - row));
+        std::shared_ptr<uint8_t[]> band(new uint8_t[band_rows * band_stride]);
+        if (!request_.read_rows(request_.context, static_cast<uint16_t>(level_index), row, band_rows, band.get()))
+        {
+            throw std::runtime_error(fmt::format(
+                "Unable to read rows {}-{} of level {} of the source image!", row, row + band_rows - 1, level_index));
+        }
+        const std::string chunk_row_path = fmt::format("{}/{}", chunk_prefix, row / level.chunk_height);
+        make_directory(chunk_row_path);
+
+        for (uint32_t column = 0; column < chunks_across; ++column)
+        {
+            const int64_t x = static_cast<int64_t>(column) * level.chunk_width;
+            const uint32_t columns = static_cast<uint32_t>(std::min<int64_t>(level.chunk_width, level.width - x));
+            auto write_chunk = [band = std::shared_ptr<const uint8_t[]>(band), band_rows, band_stride, pixel_nbytes,
+                                x, columns, chunk_width = level.chunk_width, chunk_height = level.chunk_height,
+                                compressed = compressed_, path = fmt::format("{}/{}", chunk_row_path, column)]() {
+                PROF_SCOPED_RANGE(PROF_EVENT(zarr_writer_write_chunk));
+                // Interleaved samples are stored as planes. Parts of the chunk past the image are zero.
+                const size_t plane_nbytes = static_cast<size_t>(chunk_width) * chunk_height;
+                std::vector<uint8_t> chunk(plane_nbytes * pixel_nbytes, 0);
+                for (uint32_t y = 0; y < band_rows; ++y)
+                {
+                    const uint8_t* src = band.get() + y * band_stride + x * pixel_nbytes;
+                    for (size_t c = 0; c < pixel_nbytes; ++c)
+                    {
+                        uint8_t* dest = chunk.data() + c * plane_nbytes + y * chunk_width;
+                        for (uint32_t i = 0; i < columns; ++i)
+                        {
+                            dest[i] = src[i * pixel_nbytes + c];
+                        }
+                    }
+                }
+                if (compressed)
+                {
+                    std::vector<uint8_t> data;
+                    cuslide::zstd::encode_zstd(chunk.data(), chunk.size(), kZstdLevel, data);
+                    write_file(path, data.data(), data.size());
+                }
+                else
+                {
+                    write_file(path, chunk.data(), chunk.size());
+                }
+            };
+
+            if (is_worker_thread)
+            {
+                // A task on the executor shouldn't wait for other tasks of the executor.
+                write_chunk();
+            }
+            else
+            {
+                pending_chunks_.push_back(cucim::concurrent::ThreadPool::submit(std::move(write_chunk)));
+            }
+        }
+        wait(max_pending_chunks);
+    }
+}
+
+void MultiscalesWriter::wait(size_t max_pending)
+{
+    while (pending_chunks_.size() > max_pending)
+    {
+        std::future<void> chunk = std::move(pending_chunks_.front());
+        pending_chunks_.pop_front();
+        chunk.get(); // rethrows a writing error
+    }
+}
+
+} // namespace
+
+void write_multiscales(const cucim::io::format::ImageWriterRequestDesc& request)
+{
+    MultiscalesWriter writer(request);
+    try
+    {
+        writer.write();
+    }
+    catch (...)
+    {
+        writer.abandon();
+        std::error_code ec;
+        std::filesystem::remove_all(request.file_path, ec);
+        throw;
+    }
+}
+
+} // namespace cuslide::zarr
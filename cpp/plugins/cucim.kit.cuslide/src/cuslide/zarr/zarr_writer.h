@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CUSLIDE_ZARR_WRITER_H
+#define CUSLIDE_ZARR_WRITER_H
+
+#include <cucim/io/format/image_format.h>
+
+namespace cuslide::zarr
+{
+
+constexpr uint32_t kDefaultChunkSize = 256;
+
+/**
+ * @brief Write the levels of an image as an OME-NGFF (0.4) multiscale image in a Zarr (v2) directory.
+ *
+ * Each source level (`request->source_level_*`, or level 0 only) becomes an array ("0", "1", ...) in the 'cyx' (or
+ * 'yx') order. Chunks are the source tiles of the level (or `request->tile_width` x `request->tile_height` if the
+ * level is not tiled), so each level is read (`request->read_rows`) in bands of one chunk row and each source tile is
+ * decoded once. Chunks are compressed ('zstd' (default) or 'raw') and written in parallel on the process-wide executor,
+ * with a bounded number of chunks in flight.
+ *
+ * Throws std::invalid_argument for an unsupported request (or if the directory exists) and std::runtime_error if
+ * writing fails (the partial directory is removed).
+ */
+void write_multiscales(const cucim::io::format::ImageWriterRequestDesc& request);
+
+} // namespace cuslide::zarr
+
+#endif // CUSLIDE_ZARR_WRITER_H
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Code below is using zstd library which is under BSD License
+ * Please see LICENSE-3rdparty.md for the detail.
+ */
+
+#include "libzstd.h"
+
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+#include <cucim/memory/memory_manager.h>
+#include <cucim/profiler/nvtx3.h>
+#include <fmt/format.h>
+
+#include <zstd.h>
+
+namespace cuslide::zstd
+{
+
+/**
+ * @brief Return the decompression context of the current thread.
+ *
+ * A context keeps its internal buffers between frames so it is created once per worker thread and reused for all
+ * tiles decoded by the thread.
+ */
+static ZSTD_DCtx* thread_decompression_context()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(nullptr, ZSTD_freeDCtx);
+    if (!dctx)
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(zstd_create_dctx));
+        dctx.reset(ZSTD_createDCtx());
+        if (!dctx)
+        {
+            throw std::runtime_error("Unable to allocate decompression context for zstd!");
+        }
+    }
+    return dctx.get();
+}
+
+/**
+ * @brief Return the compression context of the current thread.
+ */
+static ZSTD_CCtx* thread_compression_context()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(nullptr, ZSTD_freeCCtx);
+    if (!cctx)
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(zstd_create_cctx));
+        cctx.reset(ZSTD_createCCtx());
+        if (!cctx)
+        {
+            throw std::runtime_error("Unable to allocate compression context for zstd!");
+        }
+    }
+    return cctx.get();
+}
+
+bool decode_zstd(int fd,
+                 unsigned char* zstd_buf,
+                 uint64_t offset,
+                 uint64_t size,
+                 uint8_t** dest,
+                 uint64_t dest_nbytes,
+                 const cucim::io::Device& out_device)
+{
+    (void)out_device;
+
+    if (dest == nullptr)
+    {
+        throw std::runtime_error("'dest' shouldn't be nullptr in decode_zstd()");
+    }
+
+    // Allocate memory only when dest is not null
+    if (*dest == nullptr)
+    {
+        if ((*dest = (unsigned char*)cucim_malloc(dest_nbytes)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate uncompressed image buffer");
+        }
+    }
+
+    if (zstd_buf == nullptr)
+    {
+        if ((zstd_buf = (unsigned char*)cucim_malloc(size)) == nullptr)
+        {
+            throw std::runtime_error("Unable to allocate buffer for zstd!");
+        }
+
+        if (pread(fd, zstd_buf, size, offset) < 1)
+        {
+            cucim_free(zstd_buf);
+            throw std::runtime_error("Unable to read file for zstd!");
+        }
+    }
+    else
+    {
+        fd = -1;
+        zstd_buf += offset;
+    }
+
+    size_t out_size;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(zstd_decompress));
+        out_size = ZSTD_decompressDCtx(thread_decompression_context(), *dest, dest_nbytes, zstd_buf, size);
+    }
+
+    if (fd != -1)
+    {
+        cucim_free(zstd_buf);
+    }
+
+    if (ZSTD_isError(out_size))
+    {
+        throw std::runtime_error(fmt::format("Unable to decompress zstd data: {}", ZSTD_getErrorName(out_size)));
+    }
+    return true;
+}
+
+void encode_zstd(const uint8_t* src, uint64_t src_nbytes, int level, std::vector<uint8_t>& dest)
+{
+    const size_t dest_offset = dest.size();
+    dest.resize(dest_offset + ZSTD_compressBound(src_nbytes));
+    size_t out_size;
+    {
+        PROF_SCOPED_RANGE(PROF_EVENT(zstd_compress));
+        out_size = ZSTD_compressCCtx(
+            thread_compression_context(), dest.data() + dest_offset, dest.size() - dest_offset, src, src_nbytes, level);
+    }
+    if (ZSTD_isError(out_size))
+    {
+        throw std::runtime_error(fmt::format("Unable to compress zstd data: {}", ZSTD_getErrorName(out_size)));
+    }
+    dest.resize(dest_offset + out_size);
+}
+
+} // namespace cuslide::zstd
@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef CUSLIDE_LIBZSTD_H
+#define CUSLIDE_LIBZSTD_H
+
+#include <vector>
+
+#include <cucim/io/device.h>
+
+namespace cuslide::zstd
+{
+constexpr uint32_t kCompressionZstd = 50000; // Zstandard (COMPRESSION_ZSTD in libtiff)
+
+bool decode_zstd(int fd,
+                 unsigned char* zstd_buf,
+                 uint64_t offset,
+                 uint64_t size,
+                 uint8_t** dest,
+                 uint64_t dest_nbytes,
+                 const cucim::io::Device& out_device);
+
+/**
+ * Compresses `src` into a zstd frame appended to `dest`.
+ *
+ * @param level compression level
+ */
+void encode_zstd(const uint8_t* src, uint64_t src_nbytes, int level, std::vector<uint8_t>& dest);
+}
+#endif // CUSLIDE_LIBZSTD_H
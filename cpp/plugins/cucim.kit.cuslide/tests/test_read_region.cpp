@@ -9,6 +9,7 @@
 #include <catch2/generators/catch_generators.hpp>
 #include <openslide/openslide.h>
 
+#include <cucim/memory/buffer_pool.h>
 #include <cucim/memory/memory_manager.h>
 
 #include "config.h"
@@ -91,7 +92,7 @@ TEST_CASE("Verify read_region()", "[test_read_region.cpp]")
             }
             INFO("cucim value count: " << cucim_count);
 
-            cucim_free(image_data.container.data);
+            cucim::memory::buffer_pool().release(image_data.container.data, cucim::io::DeviceType::kCPU);
             printf("\n");
         }
 
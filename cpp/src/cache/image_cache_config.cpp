@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -47,6 +47,10 @@ void ImageCacheConfig::load_config(const void* json_obj)
     {
         record_stat = cache_config.value("record_stat", kDefaultCacheRecordStat);
     }
+    if (cache_config.contains("virtual_pyramid") && cache_config["virtual_pyramid"].is_boolean())
+    {
+        virtual_pyramid = cache_config.value("virtual_pyramid", kDefaultCacheVirtualPyramid);
+    }
 }
 
 } // namespace cucim::cache
@@ -99,4 +99,9 @@ std::shared_ptr<ImageCacheValue> EmptyImageCache::find(const std::shared_ptr<Ima
     return std::shared_ptr<ImageCacheValue>();
 }
 
+bool EmptyImageCache::contains(const std::shared_ptr<ImageCacheKey>&) const
+{
+    return false;
+}
+
 } // namespace cucim::cache
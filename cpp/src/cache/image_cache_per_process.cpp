@@ -318,6 +318,11 @@ std::shared_ptr<ImageCacheValue> PerProcessImageCache::find(const std::shared_pt
     return std::shared_ptr<ImageCacheValue>();
 }
 
+bool PerProcessImageCache::contains(const std::shared_ptr<ImageCacheKey>& key) const
+{
+    return hashmap_.contains(key);
+}
+
 bool PerProcessImageCache::is_list_full() const
 {
     if (size() >= capacity_)
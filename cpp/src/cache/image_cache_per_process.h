@@ -90,6 +90,7 @@ public:
     void reserve(const ImageCacheConfig& config) override;
 
     std::shared_ptr<ImageCacheValue> find(const std::shared_ptr<ImageCacheKey>& key) override;
+    bool contains(const std::shared_ptr<ImageCacheKey>& key) const override;
 
 private:
     bool is_list_full() const;
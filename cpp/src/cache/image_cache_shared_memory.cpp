@@ -521,6 +521,12 @@ std::shared_ptr<ImageCacheValue> SharedMemoryImageCache::find(const std::shared_
     return std::shared_ptr<ImageCacheValue>();
 }
 
+bool SharedMemoryImageCache::contains(const std::shared_ptr<ImageCacheKey>& key) const
+{
+    auto key_impl = std::get_deleter<null_deleter<deleter_type<ImageCacheKey>>>(key)->get();
+    return hashmap_->contains(key_impl);
+}
+
 bool SharedMemoryImageCache::is_list_full() const
 {
     if (size() >= *capacity_)
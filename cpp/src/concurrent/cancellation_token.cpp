@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/concurrent/cancellation_token.h"
+
+namespace cucim::concurrent
+{
+
+CancellationToken::CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+void CancellationToken::cancel() const
+{
+    cancelled_->store(true, std::memory_order_release);
+}
+
+bool CancellationToken::is_cancelled() const
+{
+    return cancelled_->load(std::memory_order_acquire);
+}
+
+} // namespace cucim::concurrent
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/concurrent/concurrency_config.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace cucim::concurrent
+{
+
+void ConcurrencyConfig::load_config(const void* json_obj)
+{
+    const json& concurrency_config = *(static_cast<const json*>(json_obj));
+
+    if (concurrency_config.contains("num_workers") && concurrency_config["num_workers"].is_number_unsigned())
+    {
+        num_workers = concurrency_config.value("num_workers", kDefaultConcurrencyNumWorkers);
+    }
+    if (concurrency_config.contains("region_split_tile_count") &&
+        concurrency_config["region_split_tile_count"].is_number_unsigned())
+    {
+        region_split_tile_count =
+            concurrency_config.value("region_split_tile_count", kDefaultConcurrencyRegionSplitTileCount);
+    }
+    if (concurrency_config.contains("tile_schedule") && concurrency_config["tile_schedule"].is_string())
+    {
+        auto schedule = concurrency_config.value("tile_schedule", kDefaultConcurrencyTileScheduleStr);
+        tile_schedule = lookup_tile_schedule(schedule);
+    }
+    if (concurrency_config.contains("schedule_window") && concurrency_config["schedule_window"].is_number_unsigned())
+    {
+        schedule_window = std::max(1U, concurrency_config.value("schedule_window", kDefaultConcurrencyScheduleWindow));
+    }
+    if (concurrency_config.contains("adaptive_prefetch") && concurrency_config["adaptive_prefetch"].is_boolean())
+    {
+        adaptive_prefetch = concurrency_config.value("adaptive_prefetch", kDefaultConcurrencyAdaptivePrefetch);
+    }
+    if (concurrency_config.contains("min_prefetch_factor") &&
+        concurrency_config["min_prefetch_factor"].is_number_unsigned())
+    {
+        min_prefetch_factor = concurrency_config.value("min_prefetch_factor", kDefaultConcurrencyMinPrefetchFactor);
+    }
+    if (concurrency_config.contains("max_prefetch_factor") &&
+        concurrency_config["max_prefetch_factor"].is_number_unsigned())
+    {
+        max_prefetch_factor = concurrency_config.value("max_prefetch_factor", kDefaultConcurrencyMaxPrefetchFactor);
+    }
+    max_prefetch_factor = std::max(min_prefetch_factor, max_prefetch_factor);
+    if (concurrency_config.contains("readahead_batches") &&
+        concurrency_config["readahead_batches"].is_number_unsigned())
+    {
+        readahead_batches = concurrency_config.value("readahead_batches", kDefaultConcurrencyReadaheadBatches);
+    }
+    if (concurrency_config.contains("numa") && concurrency_config["numa"].is_boolean())
+    {
+        numa = concurrency_config.value("numa", kDefaultConcurrencyNuma);
+    }
+}
+
+} // namespace cucim::concurrent
@@ -1,14 +1,22 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2025, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "cucim/concurrent/threadpool.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <fmt/format.h>
 #include <taskflow/taskflow.hpp>
 
+#include "cucim/cuimage.h"
 #include "cucim/profiler/nvtx3.h"
+#include "cucim/util/numa.h"
 
 namespace cucim::concurrent
 {
@@ -17,24 +25,177 @@ struct ThreadPool::Executor : public tf::Executor
 {
     // inherits  Constructor
     using tf::Executor::Executor;
+
+    ~Executor()
+    {
+        // Runners use the queue below, which is destroyed before the base class.
+        wait_for_all();
+    }
+
+    /**
+     * @brief Queue a task by priority.
+     *
+     * Each queued task submits one runner to the executor (which is FIFO), and a runner runs the most urgent task
+     * queued when it starts.
+     */
+    std::future<void> post(std::function<void()> task, TaskPriority priority)
+    {
+        std::future<void> future;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            QueuedTask item{ priority, next_sequence_++, std::move(task), {} };
+            future = item.promise.get_future();
+            queue_.push_back(std::move(item));
+            std::push_heap(queue_.begin(), queue_.end(), is_less_urgent);
+        }
+        async([this]() { run_next(); });
+        return future;
+    }
+
+private:
+    struct QueuedTask
+    {
+        TaskPriority priority = TaskPriority::kNormal;
+        uint64_t sequence = 0;
+        std::function<void()> task;
+        std::promise<void> promise;
+    };
+
+    static bool is_less_urgent(const QueuedTask& lhs, const QueuedTask& rhs)
+    {
+        if (lhs.priority != rhs.priority)
+        {
+            return lhs.priority > rhs.priority;
+        }
+        return lhs.sequence > rhs.sequence;
+    }
+
+    void run_next()
+    {
+        QueuedTask item;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            std::pop_heap(queue_.begin(), queue_.end(), is_less_urgent);
+            item = std::move(queue_.back());
+            queue_.pop_back();
+        }
+        try
+        {
+            item.task();
+            item.promise.set_value();
+        }
+        catch (...)
+        {
+            item.promise.set_exception(std::current_exception());
+        }
+    }
+
+    std::mutex queue_mutex_;
+    std::vector<QueuedTask> queue_; // max-heap by urgency
+    uint64_t next_sequence_ = 0;
 };
 
+struct ThreadPool::TaskCounter
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t count = 0;
+};
+
+std::shared_ptr<ThreadPool::Executor> ThreadPool::shared_executor()
+{
+    // Thread pools hold a reference so the executor outlives every pool, even during static destruction.
+    static std::shared_ptr<Executor> executor = []() {
+        PROF_SCOPED_RANGE(PROF_EVENT(threadpool_create_executor));
+        cucim::config::Config* config = cucim::CuImage::get_config();
+        size_t num_workers = config ? config->concurrency().num_workers : 0;
+        if (num_workers == 0)
+        {
+            num_workers = std::max(1U, std::thread::hardware_concurrency());
+        }
+        return std::make_shared<Executor>(num_workers);
+    }();
+    return executor;
+}
+
+namespace
+{
+
+void throw_if_expired(TaskDeadline deadline)
+{
+    if (deadline != kNoTaskDeadline && std::chrono::steady_clock::now() > deadline)
+    {
+        throw TaskExpiredError("The task was dropped because its deadline passed before it started.");
+    }
+}
+
+// Pin the calling executor thread to its NUMA node when it runs its first task.
+void bind_worker_to_numa_node(int worker_id)
+{
+    thread_local bool is_bound = false;
+    if (is_bound || worker_id < 0)
+    {
+        return;
+    }
+    is_bound = true;
+    const auto& nodes = util::numa_nodes();
+    const int node = nodes[worker_id % nodes.size()];
+    if (!util::numa_bind_current_thread(node))
+    {
+        fmt::print(stderr, "[Warning] Failed to pin executor thread {} to NUMA node {}.\n", worker_id, node);
+    }
+}
+
+} // namespace
+
+bool ThreadPool::is_numa_enabled()
+{
+    static const bool enabled = []() {
+        cucim::config::Config* config = cucim::CuImage::get_config();
+        return config && config->concurrency().numa && util::numa_nodes().size() > 1;
+    }();
+    return enabled;
+}
+
+size_t ThreadPool::shared_worker_count()
+{
+    return shared_executor()->num_workers();
+}
+
+bool ThreadPool::is_worker_thread()
+{
+    return shared_executor()->this_worker_id() >= 0;
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task, TaskPriority priority, TaskDeadline deadline)
+{
+    auto executor = shared_executor();
+    const bool numa_enabled = is_numa_enabled();
+    return executor->post(
+        [task = std::move(task), executor = executor.get(), numa_enabled, deadline]() {
+            throw_if_expired(deadline);
+            if (numa_enabled)
+            {
+                bind_worker_to_numa_node(executor->this_worker_id());
+            }
+            task();
+        },
+        priority);
+}
 
 ThreadPool::ThreadPool(int32_t num_workers)
 {
-    num_workers_ = num_workers;
+    num_workers_ = num_workers > 0 ? num_workers : 0;
     if (num_workers > 0)
     {
-        executor_ = std::make_unique<Executor>(num_workers);
+        executor_ = shared_executor();
+        pending_tasks_ = std::make_shared<TaskCounter>();
     }
 }
 
 ThreadPool::~ThreadPool()
 {
-    if (executor_)
-    {
-        executor_->wait_for_all();
-    }
+    wait();
 }
 
 ThreadPool::operator bool() const
@@ -42,16 +203,44 @@ ThreadPool::operator bool() const
     return (num_workers_ > 0);
 }
 
-std::future<void> ThreadPool::enqueue(std::function<void()> task)
+std::future<void> ThreadPool::enqueue(std::function<void()> task, TaskPriority priority, TaskDeadline deadline)
 {
-    return executor_->async([task]() { task(); });
+    {
+        std::lock_guard<std::mutex> lock(pending_tasks_->mutex);
+        ++pending_tasks_->count;
+    }
+    const bool numa_enabled = is_numa_enabled();
+    auto queued_task = [task = std::move(task), pending_tasks = pending_tasks_, executor = executor_.get(),
+                        numa_enabled, deadline]() {
+        // Decrease the number of pending tasks even if the task throws.
+        struct Done
+        {
+            TaskCounter& counter;
+            ~Done()
+            {
+                std::lock_guard<std::mutex> lock(counter.mutex);
+                if (--counter.count == 0)
+                {
+                    counter.cv.notify_all();
+                }
+            }
+        } done{ *pending_tasks };
+        throw_if_expired(deadline);
+        if (numa_enabled)
+        {
+            bind_worker_to_numa_node(executor->this_worker_id());
+        }
+        task();
+    };
+    return executor_->post(std::move(queued_task), priority);
 }
 
 void ThreadPool::wait()
 {
-    if (executor_)
+    if (pending_tasks_)
     {
-        executor_->wait_for_all();
+        std::unique_lock<std::mutex> lock(pending_tasks_->mutex);
+        pending_tasks_->cv.wait(lock, [this]() { return pending_tasks_->count == 0; });
     }
 }
 
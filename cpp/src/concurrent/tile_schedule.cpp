@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/concurrent/tile_schedule.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cucim/cpp20/find_if.h"
+
+
+namespace cucim::concurrent
+{
+
+using namespace std::literals::string_view_literals;
+
+constexpr TileSchedule TileScheduleMap::at(const std::string_view& key) const
+{
+    const auto itr = cucim::cpp20::find_if(begin(data), end(data), [&key](const auto& v) { return v.first == key; });
+
+    if (itr != end(data))
+    {
+        return itr->second;
+    }
+    else
+    {
+        return TileSchedule::kNone;
+    }
+}
+
+constexpr std::string_view TileScheduleStrMap::at(const TileSchedule& key) const
+{
+    const auto itr = cucim::cpp20::find_if(begin(data), end(data), [&key](const auto& v) { return v.first == key; });
+
+    if (itr != end(data))
+    {
+        return itr->second;
+    }
+    else
+    {
+        return "none"sv;
+    }
+}
+
+static constexpr std::array<std::pair<std::string_view, TileSchedule>, kTileScheduleCount> tile_schedule_values{
+    { { "none"sv, TileSchedule::kNone }, { "hilbert"sv, TileSchedule::kHilbert }, { "offset"sv, TileSchedule::kOffset } }
+};
+
+TileSchedule lookup_tile_schedule(const std::string_view sv)
+{
+    static constexpr auto map = TileScheduleMap{ { tile_schedule_values } };
+    return map.at(sv);
+}
+
+static constexpr std::array<std::pair<TileSchedule, std::string_view>, kTileScheduleCount> tile_schedule_str_values{
+    { { TileSchedule::kNone, "none"sv }, { TileSchedule::kHilbert, "hilbert"sv }, { TileSchedule::kOffset, "offset"sv } }
+};
+
+std::string_view lookup_tile_schedule_str(const TileSchedule key)
+{
+    static constexpr auto map = TileScheduleStrMap{ { tile_schedule_str_values } };
+    return map.at(key);
+}
+
+uint64_t hilbert_curve_index(uint32_t x, uint32_t y)
+{
+    // Reference: https://en.wikipedia.org/wiki/Hilbert_curve (xy2d)
+    constexpr uint32_t n = 1U << 16;
+    x = std::min(x, n - 1);
+    y = std::min(y, n - 1);
+
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        const uint32_t rx = (x & s) > 0;
+        const uint32_t ry = (y & s) > 0;
+        d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+} // namespace cucim::concurrent
@@ -11,6 +11,7 @@
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -43,11 +44,21 @@ Config::Config()
     init_configs();
 }
 
+cucim::memory::BufferPoolConfig& Config::buffer_pool()
+{
+    return buffer_pool_;
+}
+
 cucim::cache::ImageCacheConfig& Config::cache()
 {
     return cache_;
 }
 
+cucim::concurrent::ConcurrencyConfig& Config::concurrency()
+{
+    return concurrency_;
+}
+
 cucim::plugin::PluginConfig& Config::plugin()
 {
     return plugin_;
@@ -117,12 +128,24 @@ bool Config::parse_config(std::string& path)
         std::ifstream ifs(path);
         json obj = json::parse(ifs, nullptr /*cb*/, true /*allow_exceptions*/, true /*ignore_comments*/);
 
+        json buffer_pool = obj["buffer_pool"];
+        if (buffer_pool.is_object())
+        {
+            buffer_pool_.load_config(&buffer_pool);
+        }
+
         json cache = obj["cache"];
         if (cache.is_object())
         {
             cache_.load_config(&cache);
         }
 
+        json concurrency = obj["concurrency"];
+        if (concurrency.is_object())
+        {
+            concurrency_.load_config(&concurrency);
+        }
+
         json plugin = obj["plugin"];
         if (plugin.is_object())
         {
@@ -167,6 +190,10 @@ void Config::override_from_envs()
             }
         }
     }
+    if (const char* env_p = std::getenv("CUCIM_NUM_WORKERS"))
+    {
+        concurrency_.num_workers = static_cast<uint32_t>(std::strtoul(env_p, nullptr, 10));
+    }
 }
 void Config::init_configs()
 {
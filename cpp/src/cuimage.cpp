@@ -1,12 +1,21 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2025, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "cucim/cuimage.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
 #include <cstring>
-#include <fstream>
+#include <exception>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 
@@ -15,9 +24,13 @@
 #endif
 #include <fmt/format.h>
 
+#include "cucim/concurrent/threadpool.h"
+#include "cucim/filesystem/cufile_driver.h"
+#include "cucim/memory/buffer_pool.h"
 #include "cucim/profiler/nvtx3.h"
 #include "cucim/util/cuda.h"
 #include "cucim/util/file.h"
+#include "cucim/util/resample.h"
 
 
 #define XSTR(x) STR(x)
@@ -146,6 +159,11 @@ DetectedFormat detect_format(filesystem::Path path)
 
 Framework* CuImage::framework_ = cucim::acquire_framework("cucim");
 std::unique_ptr<config::Config> CuImage::config_ = std::make_unique<config::Config>();
+// The file driver stages unaligned O_DIRECT reads and GPU transfers in bounce buffers sized by the configuration.
+static const bool s_bounce_buffers_configured = []() {
+    filesystem::set_bounce_buffer_config(CuImage::get_config()->buffer_pool());
+    return true;
+}();
 std::shared_ptr<profiler::Profiler> CuImage::profiler_ = std::make_shared<profiler::Profiler>(config_->profiler());
 std::unique_ptr<cache::ImageCacheManager> CuImage::cache_manager_ = std::make_unique<cache::ImageCacheManager>();
 std::unique_ptr<plugin::ImageFormat> CuImage::image_format_plugins_ = std::make_unique<plugin::ImageFormat>();
@@ -272,20 +290,15 @@ CuImage::~CuImage()
             switch (device_type)
             {
             case io::DeviceType::kCPU:
-                cucim_free(image_data_->container.data);
-                image_data_->container.data = nullptr;
-                break;
             case io::DeviceType::kCUDA:
-            {
-                // Always free CUDA memory allocated for this CuImage.
+                // Always release memory allocated for this CuImage.
                 // If a loader exists and transferred ownership (num_workers==0), CuImage owns the memory.
                 // If no loader exists, CuImage allocated the memory directly.
-                // Either way, CuImage is responsible for freeing it.
-                cudaError_t cuda_status;
-                CUDA_TRY(cudaFree(image_data_->container.data));
+                // Either way, CuImage is responsible for releasing it. The buffer pool recycles buffers it handed out
+                // and frees any other pointer.
+                cucim::memory::buffer_pool().release(image_data_->container.data, device_type);
                 image_data_->container.data = nullptr;
                 break;
-            }
             case io::DeviceType::kCUDAHost:
             case io::DeviceType::kCUDAManaged:
             case io::DeviceType::kCPUShared:
@@ -658,10 +671,10 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
                              const DimIndices& region_dim_indices,
                              const io::Device& device,
                              DLTensor* buf,
-                             const std::string& shm_name) const
+                             const std::string& shm_name,
+                             const std::string& dims) const
 {
     PROF_SCOPED_RANGE(PROF_EVENT(cuimage_read_region));
-    (void)region_dim_indices;
     (void)buf;
     (void)shm_name;
 
@@ -742,6 +755,18 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     request.shuffle = shuffle;
     request.seed = seed;
     request.device = device_name.data();
+    for (char dim_char = 'A'; dim_char <= 'Z'; ++dim_char)
+    {
+        request.region_dim_indices.indices[dim_char - 'A'] = region_dim_indices.index(dim_char);
+    }
+    std::string region_dims = dims.empty() ? std::string("YXC") : dims;
+    if (region_dims != "YXC" && region_dims != "CYX")
+    {
+        throw std::invalid_argument(fmt::format("[Error] Unsupported dimension order '{}' (should be 'YXC' or 'CYX')!",
+                                                region_dims));
+    }
+    request.dims = region_dims.data();
+    const int64_t channel_index = region_dim_indices.index('C');
 
     auto image_data = std::unique_ptr<io::format::ImageDataDesc, decltype(cucim_free)*>(
         reinterpret_cast<io::format::ImageDataDesc*>(cucim_malloc(sizeof(io::format::ImageDataDesc))), cucim_free);
@@ -769,6 +794,10 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
             {
                 throw std::runtime_error(fmt::format("[Error] The image is not in YXC format! ({})", dims_str));
             }
+            if (region_dims != "YXC" || channel_index >= 0)
+            {
+                throw std::invalid_argument("[Error] Cropping an image supports only the 'YXC' order of all channels!");
+            }
             if (image_data_->container.data == nullptr)
             {
                 throw std::runtime_error(
@@ -783,9 +812,19 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
         throw e;
     }
 
-    //
-    // Metadata Setup
-    //
+    return make_region_image(image_data.release(), request.size, request.size_ndim, region_dims, batch_size,
+                             channel_index, res_info.level_downsample(level));
+}
+
+CuImage CuImage::make_region_image(io::format::ImageDataDesc* region_data,
+                                   const int64_t* size,
+                                   uint32_t size_ndim,
+                                   const std::string& region_dims,
+                                   uint32_t batch_size,
+                                   int64_t channel_index,
+                                   float downsample) const
+{
+    auto image_data = std::unique_ptr<io::format::ImageDataDesc, decltype(cucim_free)*>(region_data, cucim_free);
 
     // TODO: fill correct metadata information
 
@@ -796,10 +835,10 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     const uint16_t ndim = image_container.ndim;
     auto& resource = out_metadata.get_resource();
 
-    std::string_view dims{ "YXC" };
+    std::string_view out_dims{ region_dims == "CYX" ? "CYX" : "YXC" };
     if (batch_size > 1)
     {
-        dims = { "NYXC" };
+        out_dims = { region_dims == "CYX" ? "NCYX" : "NYXC" };
     }
 
     // Information from image_data
@@ -809,20 +848,32 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
 
     DLDataType& dtype = image_container.dtype;
 
-    // TODO: Do not assume channel names as 'RGB' or 'RGBA'
-    uint8_t n_ch = image_container.shape[2];
+    uint16_t n_ch = image_container.shape[out_dims.find('C')];
     std::pmr::vector<std::string_view> channel_names(&resource);
     channel_names.reserve(n_ch);
-    if (n_ch == 3)
+    if (image_metadata_->channel_names &&
+        (channel_index >= 0 || image_metadata_->shape[dim_indices_.index('C')] == n_ch))
+    {
+        // Copy channel names of the source image because the new image could outlive it.
+        const int64_t first_channel = channel_index >= 0 ? channel_index : 0;
+        for (uint16_t i = 0; i < n_ch; ++i)
+        {
+            const char* name = image_metadata_->channel_names[first_channel + i];
+            const size_t name_len = strlen(name);
+            char* name_ptr = static_cast<char*>(out_metadata.allocate(name_len + 1));
+            memcpy(name_ptr, name, name_len + 1);
+            channel_names.emplace_back(std::string_view{ name_ptr, name_len });
+        }
+    }
+    else if (n_ch == 3)
     {
-        // std::pmr::vector<std::string_view> channel_names(
-        //     { std::string_view{ "R" }, std::string_view{ "G" }, std::string_view{ "B" } }, &resource);
         channel_names.emplace_back(std::string_view{ "R" });
         channel_names.emplace_back(std::string_view{ "G" });
         channel_names.emplace_back(std::string_view{ "B" });
     }
     else
     {
+        // Image loaded by a slow-path is RGBA
         channel_names.emplace_back(std::string_view{ "R" });
         channel_names.emplace_back(std::string_view{ "G" });
         channel_names.emplace_back(std::string_view{ "B" });
@@ -833,7 +884,6 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     std::pmr::vector<float> spacing(&resource);
     spacing.reserve(ndim);
     float* image_spacing = image_metadata_->spacing;
-    spacing.insert(spacing.end(), &image_spacing[0], &image_spacing[ndim]);
 
     std::pmr::vector<std::string_view> spacing_units(&resource);
     spacing_units.reserve(ndim);
@@ -843,16 +893,17 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     {
         index = 1;
         // The first dimension is for 'batch' ('N')
+        spacing.emplace_back(1.0f);
         spacing_units.emplace_back(std::string_view{ "batch" });
     }
-    const auto& level_downsample = res_info.level_downsample(level);
     for (; index < ndim; ++index)
     {
-        int64_t dim_index = dim_indices_.index(dims[index]);
+        int64_t dim_index = dim_indices_.index(out_dims[index]);
         if (dim_index < 0)
         {
-            throw std::runtime_error(fmt::format("[Error] Invalid dimension name: {}", dims[index]));
+            throw std::runtime_error(fmt::format("[Error] Invalid dimension name: {}", out_dims[index]));
         }
+        spacing.emplace_back(image_spacing[dim_index]);
 
         const char* str_ptr = image_metadata_->spacing_units[dim_index];
         if (!str_ptr)
@@ -874,7 +925,7 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
         {
         case 'X':
         case 'Y':
-            spacing[index] /= level_downsample;
+            spacing[index] /= downsample;
             break;
         default:
             break;
@@ -912,7 +963,7 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     const uint16_t level_ndim = 2;
     std::pmr::vector<int64_t> level_dimensions(&resource);
     level_dimensions.reserve(level_ndim * 1); // it has only one size
-    level_dimensions.insert(level_dimensions.end(), request.size, &request.size[request.size_ndim]);
+    level_dimensions.insert(level_dimensions.end(), size, &size[size_ndim]);
 
     std::pmr::vector<float> level_downsamples(&resource);
     level_downsamples.reserve(1);
@@ -920,8 +971,7 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
 
     std::pmr::vector<uint32_t> level_tile_sizes(&resource);
     level_tile_sizes.reserve(level_ndim * 1); // it has only one size
-    level_tile_sizes.insert(level_tile_sizes.end(), request.size, &request.size[request.size_ndim]); // same with
-                                                                                                     // level_dimension
+    level_tile_sizes.insert(level_tile_sizes.end(), size, &size[size_ndim]); // same with level_dimension
 
     // Empty associated images
     const size_t associated_image_count = 0;
@@ -933,7 +983,7 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     std::string_view json_data{ "" };
 
     out_metadata.ndim(ndim);
-    out_metadata.dims(std::move(dims));
+    out_metadata.dims(std::move(out_dims));
     out_metadata.shape(std::move(shape));
     out_metadata.dtype(dtype);
     out_metadata.channel_names(std::move(channel_names));
@@ -955,6 +1005,295 @@ CuImage CuImage::read_region(std::vector<int64_t>&& location,
     return CuImage(this, &out_metadata.desc(), image_data.release());
 }
 
+bool CuImage::read_region_to(const int64_t* location, const int64_t* size, uint16_t level, DLTensor& buf) const
+{
+    if (!file_handle_) // file_handle_ is not opened
+    {
+        throw std::runtime_error("[Error] The image file is closed!");
+    }
+
+    int64_t region_location[2]{ location[0], location[1] };
+    int64_t region_size[2]{ size[0], size[1] };
+    std::string device_name{ "cpu" };
+    std::string region_dims{ "YXC" };
+    cucim::io::format::ImageReaderRegionRequestDesc request{};
+    request.location = region_location;
+    request.size = region_size;
+    request.level = level;
+    request.device = device_name.data();
+    request.dims = region_dims.data();
+    request.buf = &buf;
+
+    io::format::ImageDataDesc image_data;
+    memset(&image_data, 0, sizeof(io::format::ImageDataDesc));
+    if (!image_format_->image_reader.read(
+            file_handle_.get(), image_metadata_, &request, &image_data, nullptr /*out_metadata*/))
+    {
+        return false;
+    }
+
+    DLTensor& container = image_data.container;
+    bool is_same_layout = container.ndim == buf.ndim && container.dtype == buf.dtype;
+    for (int32_t i = 0; is_same_layout && i < buf.ndim; ++i)
+    {
+        is_same_layout = container.shape[i] == buf.shape[i];
+    }
+    // A reader which doesn't write into `buf` returns its own raster.
+    if (container.data && container.data != buf.data)
+    {
+        if (is_same_layout)
+        {
+            memcpy(buf.data, container.data, memory::DLTContainer(&buf).size());
+        }
+        cucim::memory::buffer_pool().release(container.data, io::DeviceType::kCPU);
+    }
+    cucim_free(container.shape);
+    cucim_free(image_data.shm_name);
+    return is_same_layout;
+}
+
+CuImage CuImage::read_region_scaled(std::vector<int64_t>&& location,
+                                    std::vector<int64_t>&& size,
+                                    float downsample,
+                                    const DimIndices& region_dim_indices,
+                                    const io::Device& device) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(cuimage_read_region_scaled));
+
+    if (location.empty())
+    {
+        location = { 0, 0 };
+    }
+    if (location.size() != 2 || size.size() != 2 || size[0] <= 0 || size[1] <= 0)
+    {
+        throw std::invalid_argument("read_region_scaled() reads a single region ((x, y) location and (width, height) "
+                                    "size)!");
+    }
+    if (!(downsample >= 1.0f))
+    {
+        throw std::invalid_argument(
+            fmt::format("downsample should be >= 1 (upsampling is not supported) but {} is used.", downsample));
+    }
+
+    const ResolutionInfo& res_info = resolutions();
+    if (res_info.level_count() == 0)
+    {
+        throw std::runtime_error("[Error] No available resolutions in the image!");
+    }
+
+    // Use the coarsest level that is not coarser than the target (level downsamples are rounded in the file).
+    constexpr double kDownsampleTolerance = 1e-3;
+    uint16_t level = 0;
+    for (uint16_t i = 1; i < res_info.level_count(); ++i)
+    {
+        const float level_downsample = res_info.level_downsample(i);
+        if (level_downsample <= downsample * (1.0 + kDownsampleTolerance) &&
+            level_downsample > res_info.level_downsample(level))
+        {
+            level = i;
+        }
+    }
+    const double level_downsample = res_info.level_downsample(level);
+    const double scale = std::max(1.0, downsample / level_downsample);
+    if (scale - 1.0 <= kDownsampleTolerance)
+    {
+        return read_region(std::move(location), std::move(size), level, 0 /* num_workers */, 1 /* batch_size */,
+                           false, 2, false, 0, region_dim_indices, device);
+    }
+
+    // The region at the level starts at a fractional position.
+    const double source_x = location[0] / level_downsample;
+    const double source_y = location[1] / level_downsample;
+    const auto source_left = static_cast<int64_t>(std::floor(source_x));
+    const auto source_top = static_cast<int64_t>(std::floor(source_y));
+    const int64_t width = size[0];
+    const int64_t height = size[1];
+    const util::AreaResampler resampler(scale, source_x - source_left, source_y - source_top, width, height);
+    const int64_t source_width = resampler.source_width();
+    const int64_t base_x = loader::level_to_base(source_left, static_cast<float>(level_downsample));
+
+    // Source rows are read in bands of whole tile rows of the level (ending on tile boundaries), so that no tile is
+    // decoded for two bands and only a band of the region at the level is in memory at once. Source rows still needed
+    // by the next output rows are kept for the next band.
+    constexpr int64_t kBandSourceRows = 256;
+    const int64_t tile_height = std::max<int64_t>(1, res_info.level_tile_size(level)[1]);
+    const int64_t band_rows = std::max<int64_t>(1, kBandSourceRows / tile_height) * tile_height;
+    const int64_t source_height = resampler.source_rows(0, height).second;
+
+    uint8_t* raster = nullptr;
+    int64_t channels = 0;
+    try
+    {
+        std::vector<uint8_t> window; // source rows [window_begin, window_end)
+        int64_t window_begin = 0;
+        int64_t window_end = 0;
+        size_t source_stride = 0;
+        for (int64_t out_row = 0; out_row < height;)
+        {
+            // Floor division handles negative coordinates.
+            const int64_t band_top = source_top + window_end;
+            const int64_t band_index = (band_top >= 0 ? band_top : band_top - band_rows + 1) / band_rows;
+            const int64_t band_end = std::min(source_height, (band_index + 1) * band_rows - source_top);
+            const int64_t base_y = loader::level_to_base(band_top, static_cast<float>(level_downsample));
+            CuImage band = read_region({ base_x, base_y }, { source_width, band_end - window_end }, level,
+                                       0 /* num_workers */, 1 /* batch_size */, false, 2, false, 0, region_dim_indices,
+                                       "cpu");
+
+            const DLTensor* band_tensor = static_cast<DLTensor*>(band.container());
+            if (band_tensor->dtype.code != kDLUInt || band_tensor->dtype.bits != 8 || band_tensor->ndim != 3)
+            {
+                throw std::runtime_error("read_region_scaled() supports only 8-bit images in the 'YXC' order!");
+            }
+            if (raster == nullptr)
+            {
+                channels = band_tensor->shape[2];
+                source_stride = source_width * channels;
+                raster = static_cast<uint8_t*>(cucim_malloc(width * height * channels));
+            }
+            const auto band_data = static_cast<const uint8_t*>(band_tensor->data);
+            window.insert(window.end(), band_data, band_data + (band_end - window_end) * source_stride);
+            window_end = band_end;
+
+            // Resample the output rows whose source rows are all read.
+            int64_t out_end = out_row;
+            while (out_end < height && resampler.source_rows(out_end, out_end + 1).second <= window_end)
+            {
+                ++out_end;
+            }
+            const size_t out_stride = width * channels;
+            resampler.resample_rows(window.data(), window_begin, source_stride, raster + out_row * out_stride,
+                                    out_stride, out_row, out_end, channels);
+            out_row = out_end;
+            if (out_row < height)
+            {
+                const int64_t keep_begin = resampler.source_rows(out_row, out_row + 1).first;
+                window.erase(window.begin(), window.begin() + (keep_begin - window_begin) * source_stride);
+                window_begin = keep_begin;
+            }
+        }
+    }
+    catch (...)
+    {
+        cucim_free(raster);
+        throw;
+    }
+
+    const size_t raster_size = width * height * channels;
+    cucim::io::Device out_device(device);
+    cucim::memory::move_raster_from_host(reinterpret_cast<void**>(&raster), raster_size, out_device);
+
+    auto image_data = static_cast<io::format::ImageDataDesc*>(cucim_malloc(sizeof(io::format::ImageDataDesc)));
+    memset(image_data, 0, sizeof(io::format::ImageDataDesc));
+    DLTensor& container = image_data->container;
+    container.data = raster;
+    container.device = DLDevice{ static_cast<DLDeviceType>(out_device.type()), out_device.index() };
+    container.ndim = 3;
+    container.dtype = DLDataType{ kDLUInt, 8, 1 };
+    container.shape = static_cast<int64_t*>(cucim_malloc(sizeof(int64_t) * 3));
+    container.shape[0] = height;
+    container.shape[1] = width;
+    container.shape[2] = channels;
+    container.strides = nullptr; // Tensor is compact and row-majored
+    container.byte_offset = 0;
+
+    return make_region_image(image_data, size.data(), 2, "YXC", 1 /* batch_size */, region_dim_indices.index('C'),
+                             downsample);
+}
+
+float CuImage::mpp_to_downsample(float mpp) const
+{
+    if (!(mpp > 0.0f))
+    {
+        throw std::invalid_argument(fmt::format("mpp should be positive but {} is used.", mpp));
+    }
+    const std::vector<std::string> units = spacing_units("X");
+    if (units.empty() || units[0] != "micrometer")
+    {
+        throw std::runtime_error("The physical pixel size (micrometers per pixel) of the image is not known!");
+    }
+    return mpp / spacing("X")[0];
+}
+
+std::future<CuImage> CuImage::read_region_async(std::vector<int64_t>&& location,
+                                                std::vector<int64_t>&& size,
+                                                uint16_t level,
+                                                const DimIndices& region_dim_indices,
+                                                const io::Device& device,
+                                                const std::string& dims,
+                                                std::function<void()> on_ready,
+                                                concurrent::TaskPriority priority,
+                                                concurrent::TaskDeadline deadline) const
+{
+    if (device.type() != io::DeviceType::kCPU)
+    {
+        // A CUDA read uses a batch loader whose tasks would wait on the executor thread running this read.
+        throw std::invalid_argument("read_region_async() supports only 'cpu' device!");
+    }
+    if (!size.empty() && location.size() > size.size())
+    {
+        throw std::invalid_argument("read_region_async() reads a single region (one location)!");
+    }
+
+    // The read may run after the caller drops the image, so the task keeps its own reference to it.
+    std::shared_ptr<const CuImage> self = weak_from_this().lock();
+    if (!self)
+    {
+        throw std::invalid_argument(
+            "read_region_async() needs an image owned by a std::shared_ptr (e.g., std::make_shared<CuImage>(path))!");
+    }
+
+    auto promise = std::make_shared<std::promise<CuImage>>();
+    std::future<CuImage> future = promise->get_future();
+    auto read_task = [self = std::move(self), promise, location = std::move(location), size = std::move(size), level,
+                      region_dim_indices, device, dims, on_ready = std::move(on_ready), deadline]() mutable {
+        try
+        {
+            // The deadline is checked here rather than by the executor so that `on_ready` is always called.
+            if (deadline != concurrent::kNoTaskDeadline && std::chrono::steady_clock::now() > deadline)
+            {
+                throw concurrent::TaskExpiredError(
+                    "The read was dropped because its deadline passed before it started.");
+            }
+            promise->set_value(self->read_region(std::move(location), std::move(size), level, 0 /* num_workers */,
+                                                 1 /* batch_size */, false, 2, false, 0, region_dim_indices, device,
+                                                 nullptr, std::string{}, dims));
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+        if (on_ready)
+        {
+            on_ready();
+        }
+    };
+    concurrent::ThreadPool::submit(std::move(read_task), priority);
+    return future;
+}
+
+CuImage CuImage::read_grid(const loader::GridSampler& sampler,
+                           uint32_t num_workers,
+                           uint32_t batch_size,
+                           bool drop_last,
+                           uint32_t prefetch_factor,
+                           bool shuffle,
+                           uint64_t seed,
+                           const io::Device& device) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(cuimage_read_grid));
+
+    std::vector<int64_t> locations = sampler.locations();
+    if (locations.empty())
+    {
+        throw std::invalid_argument("The grid sampler generated no patch (no tissue found?)");
+    }
+    std::vector<int64_t> size = sampler.size();
+
+    // Always use a batch loader, even for a single patch, so that the result is iterable.
+    return read_region(std::move(locations), std::move(size), sampler.level(), std::max(num_workers, 1u), batch_size,
+                       drop_last, prefetch_factor, shuffle, seed, DimIndices{}, device);
+}
+
 std::set<std::string> CuImage::associated_images() const
 {
     return associated_images_;
@@ -963,7 +1302,7 @@ std::set<std::string> CuImage::associated_images() const
 CuImage CuImage::associated_image(const std::string& name, const io::Device& device) const
 {
     PROF_SCOPED_RANGE(PROF_EVENT(cuimage_associated_image));
-    if (file_handle_->fd < 0) // file_handle_ is not opened
+    if (file_handle_->fd < 0 && !file_handle_->source) // file_handle_ is not opened (a remote file has no fd)
     {
         throw std::runtime_error("[Error] The image file is closed!");
     }
@@ -992,56 +1331,382 @@ CuImage CuImage::associated_image(const std::string& name, const io::Device& dev
     return CuImage{};
 }
 
-void CuImage::save(std::string file_path) const
+namespace
 {
-    // Save ppm file for now.
-    if (image_data_)
+
+constexpr uint32_t kSaveBandHeight = 256;
+
+struct WriterContext
+{
+    const CuImage* image;
+    uint32_t samples_per_pixel;
+    size_t row_nbytes; // of level 0
+    const uint8_t* data; // image data in memory (nullptr if the image is read from its file)
+    bool is_cuda;
+    std::exception_ptr error;
+};
+
+bool CUCIM_ABI writer_read_rows(void* context, uint16_t level, int64_t row, int64_t row_count, uint8_t* buf)
+{
+    auto ctx = static_cast<WriterContext*>(context);
+    try
     {
-        std::fstream fs(file_path, std::fstream::out | std::fstream::binary);
+        if (ctx->data)
+        {
+            const size_t nbytes = ctx->row_nbytes * row_count;
+            const uint8_t* src = ctx->data + ctx->row_nbytes * row;
+            if (ctx->is_cuda)
+            {
+                cudaError_t cuda_status;
+                CUDA_TRY(cudaMemcpy(buf, src, nbytes, cudaMemcpyDeviceToHost));
+                if (cuda_status)
+                {
+                    throw std::runtime_error("Error during cudaMemcpy!");
+                }
+            }
+            else
+            {
+                memcpy(buf, src, nbytes);
+            }
+            return true;
+        }
+        // Rows of a level other than level 0 are requested only when the tiles of the upper levels are copied.
+        const int64_t width = ctx->image->resolutions().level_dimension(level)[0];
+        const int64_t base_y = loader::level_to_base(row, ctx->image->resolutions().level_downsample(level));
+        CuImage band = ctx->image->read_region({ 0, base_y }, { width, row_count }, level);
+        memcpy(buf, static_cast<DLTensor*>(band.container())->data, width * row_count * ctx->samples_per_pixel);
+        return true;
+    }
+    catch (...)
+    {
+        ctx->error = std::current_exception();
+        return false;
+    }
+}
 
-        if (fs.bad())
+void run_writer(cucim::io::format::ImageFormatDesc* image_format,
+                const cucim::io::format::ImageWriterRequestDesc& request,
+                const WriterContext& context)
+{
+    try
+    {
+        if (!image_format->image_writer.write(&request))
         {
-            CUCIM_ERROR("Opening file failed!");
+            throw std::runtime_error(fmt::format("[Error] Failed to write '{}'!", request.file_path));
         }
-        fs << "P6\n";
-        auto image_size = size("XY");
-        auto width = image_size[0];
-        auto height = image_size[1];
-        fs << width << "\n" << height << "\n" << 0xff << "\n";
-
-        uint8_t* data = static_cast<uint8_t*>(image_data_->container.data);
-        uint8_t* raster = nullptr;
-        size_t raster_size = width * height * 3;
-
-        const cucim::io::Device& in_device = device();
-        if (in_device.type() == cucim::io::DeviceType::kCUDA)
+    }
+    catch (...)
+    {
+        // Report the error of reading the image rather than the failure of the writer.
+        if (context.error)
         {
-            cudaError_t cuda_status;
-            raster = static_cast<uint8_t*>(cucim_malloc(raster_size));
-            CUDA_TRY(cudaMemcpy(raster, data, raster_size, cudaMemcpyDeviceToHost));
-            if (cuda_status)
-            {
-                cucim_free(raster);
-                throw std::runtime_error("Error during cudaMemcpy!");
-            }
-            data = raster;
+            std::rethrow_exception(context.error);
         }
+        throw;
+    }
+}
 
-        for (unsigned int i = 0; (i < raster_size) && fs.good(); ++i)
+/**
+ * Return the format ('ppm', 'png', 'jpeg' or 'tiff') to save an image with: `format` if given, or the format of the
+ * extension of `file_path` ('ppm' for other extensions).
+ */
+std::string save_format(const std::string& file_path, const std::string& format)
+{
+    std::string name = format;
+    if (name.empty())
+    {
+        name = std::filesystem::path(file_path).extension().string();
+        if (!name.empty())
         {
-            fs << data[i];
+            name.erase(0, 1); // '.'
         }
-        fs.flush();
-        if (fs.bad())
+    }
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (name == "jpg")
+    {
+        return "jpeg";
+    }
+    if (name == "tif")
+    {
+        return "tiff";
+    }
+    if (name == "png" || name == "jpeg" || name == "tiff" || name == "ppm" || name == "pgm")
+    {
+        return name == "pgm" ? "ppm" : name;
+    }
+    if (!format.empty())
+    {
+        throw std::invalid_argument(
+            fmt::format("Image format '{}' is not supported (use 'ppm', 'png', 'jpeg' or 'tiff')!", format));
+    }
+    return "ppm";
+}
+
+/**
+ * Write a binary PPM (or PGM) file.
+ *
+ * The file is sized up front and mapped, so that the rows of the image are copied (or read) into the mapping at once,
+ * without intermediate buffers.
+ */
+void write_ppm(const std::string& file_path, int64_t width, int64_t height, WriterContext& context)
+{
+    const std::string header =
+        fmt::format("{}\n{}\n{}\n255\n", context.samples_per_pixel == 1 ? "P5" : "P6", width, height);
+    const size_t file_size = header.size() + context.row_nbytes * height;
+
+    const int fd = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error(fmt::format("Unable to create '{}': {}", file_path, std::strerror(errno)));
+    }
+    void* mapped = MAP_FAILED;
+    try
+    {
+        if (::ftruncate(fd, file_size) != 0)
+        {
+            throw std::runtime_error(fmt::format("Unable to resize '{}': {}", file_path, std::strerror(errno)));
+        }
+        mapped = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
         {
-            if (in_device.type() == cucim::io::DeviceType::kCUDA)
+            throw std::runtime_error(fmt::format("Unable to map '{}': {}", file_path, std::strerror(errno)));
+        }
+        uint8_t* raster = static_cast<uint8_t*>(mapped);
+        memcpy(raster, header.data(), header.size());
+        raster += header.size();
+
+        // Image data in memory is copied at once. Otherwise, level 0 is read in bands.
+        const int64_t band_height = context.data ? height : kSaveBandHeight;
+        for (int64_t row = 0; row < height; row += band_height)
+        {
+            const int64_t row_count = std::min(band_height, height - row);
+            if (!writer_read_rows(&context, 0, row, row_count, raster + context.row_nbytes * row))
             {
-                cucim_free(raster);
+                std::rethrow_exception(context.error);
             }
-            CUCIM_ERROR("Writing data failed!");
         }
-        fs.close();
+        if (::munmap(mapped, file_size) != 0)
+        {
+            mapped = MAP_FAILED;
+            throw std::runtime_error(fmt::format("Unable to unmap '{}': {}", file_path, std::strerror(errno)));
+        }
+        mapped = MAP_FAILED;
+        if (::close(fd) != 0)
+        {
+            throw std::runtime_error(fmt::format("Unable to close '{}': {}", file_path, std::strerror(errno)));
+        }
+    }
+    catch (...)
+    {
+        if (mapped != MAP_FAILED)
+        {
+            ::munmap(mapped, file_size);
+        }
+        ::close(fd);
+        ::unlink(file_path.c_str());
+        throw;
+    }
+}
+
+} // namespace
+
+void CuImage::save(std::string file_path, const std::string& format, int32_t quality) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(cuimage_save));
+    const std::string image_dims = dims();
+    const DLDataType image_dtype = dtype();
+    if (image_dtype.code != kDLUInt || image_dtype.bits != 8 || (image_dims != "YXC" && image_dims != "YX"))
+    {
+        throw std::invalid_argument(
+            fmt::format("save() supports only 8-bit images in the 'YXC' or 'YX' order (dims: '{}')!", image_dims));
+    }
+    const std::string image_format = save_format(file_path, format);
+
+    const auto image_size = size("XYC");
+    const uint32_t samples_per_pixel = image_dims == "YX" ? 1 : static_cast<uint32_t>(image_size[2]);
+
+    WriterContext context{};
+    context.image = this;
+    context.samples_per_pixel = samples_per_pixel;
+    context.row_nbytes = static_cast<size_t>(image_size[0]) * samples_per_pixel;
+    if (image_data_)
+    {
+        context.data = static_cast<const uint8_t*>(image_data_->container.data);
+        context.is_cuda = device().type() == cucim::io::DeviceType::kCUDA;
+    }
+
+    if (image_format == "ppm")
+    {
+        if (samples_per_pixel != 1 && samples_per_pixel != 3)
+        {
+            throw std::invalid_argument(fmt::format(
+                "PPM files need 1 or 3 samples per pixel (samples per pixel: {})!", samples_per_pixel));
+        }
+        write_ppm(file_path, image_size[0], image_size[1], context);
+        return;
+    }
+
+    // Other formats are written by the image format plugin that writes files of the format.
+    ensure_init();
+    cucim::io::format::ImageFormatDesc* writer_format =
+        image_format_plugins_->detect_image_writer(fmt::format("image.{}", image_format));
+
+    // TIFF files have a single (deflate-compressed) level and the other formats have their own encoding.
+    const std::string compression = image_format == "tiff" ? "deflate" : image_format;
+    cucim::io::format::ImageWriterRequestDesc request{};
+    request.file_path = const_cast<char*>(file_path.c_str());
+    request.width = image_size[0];
+    request.height = image_size[1];
+    request.samples_per_pixel = samples_per_pixel;
+    request.read_rows = writer_read_rows;
+    request.context = &context;
+    request.level_count = 1;
+    request.compression = const_cast<char*>(compression.c_str());
+    request.quality = quality;
+    const auto units = spacing_units("XY");
+    if (units.size() == 2 && units[0] == "micrometer" && units[1] == "micrometer")
+    {
+        const auto image_spacing = spacing("XY");
+        request.spacing[0] = image_spacing[0];
+        request.spacing[1] = image_spacing[1];
+    }
+    run_writer(writer_format, request, context);
+}
+
+void CuImage::save_pyramid(const std::string& file_path,
+                           uint32_t tile_size,
+                           const std::string& compression,
+                           int32_t quality,
+                           uint16_t level_count,
+                           bool copy_tiles) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(cuimage_save_pyramid));
+    const std::string image_dims = dims();
+    const DLDataType image_dtype = dtype();
+    if (image_dtype.code != kDLUInt || image_dtype.bits != 8 || (image_dims != "YXC" && image_dims != "YX"))
+    {
+        throw std::invalid_argument(fmt::format(
+            "save_pyramid() supports only 8-bit images in the 'YXC' or 'YX' order (dims: '{}')!", image_dims));
+    }
+
+    const auto image_size = size("XYC");
+    const uint32_t samples_per_pixel = image_dims == "YX" ? 1 : static_cast<uint32_t>(image_size[2]);
+
+    WriterContext context{};
+    context.image = this;
+    context.samples_per_pixel = samples_per_pixel;
+    context.row_nbytes = static_cast<size_t>(image_size[0]) * samples_per_pixel;
+    if (image_data_)
+    {
+        context.data = static_cast<const uint8_t*>(image_data_->container.data);
+        context.is_cuda = device().type() == cucim::io::DeviceType::kCUDA;
+    }
+
+    ensure_init();
+    cucim::io::format::ImageFormatDesc* image_format = image_format_plugins_->detect_image_writer(file_path);
+
+    cucim::io::format::ImageWriterRequestDesc request{};
+    request.file_path = const_cast<char*>(file_path.c_str());
+    request.width = image_size[0];
+    request.height = image_size[1];
+    request.samples_per_pixel = samples_per_pixel;
+    request.read_rows = writer_read_rows;
+    request.context = &context;
+    // The writer can copy compressed tiles from a file of its own format.
+    if (copy_tiles && !image_data_ && file_handle_ && image_format == image_format_)
+    {
+        request.source_handle = file_handle_.get();
     }
+    request.tile_width = tile_size;
+    request.tile_height = tile_size;
+    request.level_count = level_count;
+    request.compression = const_cast<char*>(compression.c_str());
+    request.quality = quality;
+    const auto units = spacing_units("XY");
+    if (units.size() == 2 && units[0] == "micrometer" && units[1] == "micrometer")
+    {
+        const auto image_spacing = spacing("XY");
+        request.spacing[0] = image_spacing[0];
+        request.spacing[1] = image_spacing[1];
+    }
+
+    run_writer(image_format, request, context);
+}
+
+void CuImage::save_zarr(const std::string& dir_path,
+                        const std::string& compression,
+                        uint16_t level_count,
+                        uint32_t chunk_size) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(cuimage_save_zarr));
+    const std::string image_dims = dims();
+    const DLDataType image_dtype = dtype();
+    if (image_dtype.code != kDLUInt || image_dtype.bits != 8 || (image_dims != "YXC" && image_dims != "YX"))
+    {
+        throw std::invalid_argument(fmt::format(
+            "save_zarr() supports only 8-bit images in the 'YXC' or 'YX' order (dims: '{}')!", image_dims));
+    }
+
+    const auto image_size = size("XYC");
+    const uint32_t samples_per_pixel = image_dims == "YX" ? 1 : static_cast<uint32_t>(image_size[2]);
+
+    WriterContext context{};
+    context.image = this;
+    context.samples_per_pixel = samples_per_pixel;
+    context.row_nbytes = static_cast<size_t>(image_size[0]) * samples_per_pixel;
+    if (image_data_)
+    {
+        context.data = static_cast<const uint8_t*>(image_data_->container.data);
+        context.is_cuda = device().type() == cucim::io::DeviceType::kCUDA;
+    }
+
+    ensure_init();
+    cucim::io::format::ImageFormatDesc* image_format = image_format_plugins_->detect_image_writer(dir_path);
+
+    cucim::io::format::ImageWriterRequestDesc request{};
+    request.file_path = const_cast<char*>(dir_path.c_str());
+    request.width = image_size[0];
+    request.height = image_size[1];
+    request.samples_per_pixel = samples_per_pixel;
+    request.read_rows = writer_read_rows;
+    request.context = &context;
+
+    // The levels of the file are kept as they are (the image data in memory has only one level).
+    std::vector<int64_t> level_dimensions;
+    std::vector<float> level_downsamples;
+    std::vector<uint32_t> level_tile_sizes;
+    if (!image_data_)
+    {
+        const ResolutionInfo res = resolutions();
+        request.source_level_count = res.level_count();
+        for (uint16_t level = 0; level < res.level_count(); ++level)
+        {
+            const auto dimension = res.level_dimension(level);
+            const auto tile_size = res.level_tile_size(level);
+            level_dimensions.insert(level_dimensions.end(), { dimension[0], dimension[1] });
+            level_downsamples.push_back(res.level_downsample(level));
+            // Chunks follow the tiles of the level unless a chunk size is given (strips are not used as chunks).
+            const bool use_tiles = chunk_size == 0 && tile_size[0] < static_cast<uint32_t>(dimension[0]);
+            level_tile_sizes.insert(level_tile_sizes.end(),
+                                    { use_tiles ? tile_size[0] : 0u, use_tiles ? tile_size[1] : 0u });
+        }
+        request.source_level_dimensions = level_dimensions.data();
+        request.source_level_downsamples = level_downsamples.data();
+        request.source_level_tile_sizes = level_tile_sizes.data();
+    }
+    request.tile_width = chunk_size ? chunk_size : 256;
+    request.tile_height = request.tile_width;
+    request.level_count = level_count;
+    request.compression = const_cast<char*>(compression.c_str());
+    const auto units = spacing_units("XY");
+    if (units.size() == 2 && units[0] == "micrometer" && units[1] == "micrometer")
+    {
+        const auto image_spacing = spacing("XY");
+        request.spacing[0] = image_spacing[0];
+        request.spacing[1] = image_spacing[1];
+    }
+
+    run_writer(image_format, request, context);
 }
 
 void CuImage::close()
@@ -1049,7 +1714,7 @@ void CuImage::close()
     file_handle_ = nullptr;
 }
 
-void CuImage::ensure_init()
+void CuImage::ensure_init() const
 {
     PROF_SCOPED_RANGE(PROF_EVENT(cuimage_ensure_init));
     ScopedLock g(mutex_);
@@ -1110,6 +1775,7 @@ bool CuImage::crop_image(const io::format::ImageReaderRegionRequestDesc& request
     // TODO: consider other cases where samples_per_pixel is not same with # of channels
     //       (we cannot use `ifd->samples_per_pixel()` here)
     uint32_t samples_per_pixel = static_cast<uint32_t>(image_metadata_->shape[dim_indices_.index('C')]);
+    uint32_t pixel_nbytes = samples_per_pixel * ((image_metadata_->dtype.bits + 7) / 8);
 
     for (int32_t i = 0; i < ndim; ++i)
     {
@@ -1151,16 +1817,16 @@ bool CuImage::crop_image(const io::format::ImageReaderRegionRequestDesc& request
     uint64_t ey = sy + h - 1;
 
     uint8_t* src_ptr = static_cast<uint8_t*>(image_data_->container.data);
-    size_t raster_size = w * h * samples_per_pixel;
+    size_t raster_size = w * h * pixel_nbytes;
 
     void* raster = nullptr;
-    int64_t dest_stride_x_bytes = w * samples_per_pixel;
+    int64_t dest_stride_x_bytes = w * pixel_nbytes;
 
     int64_t src_stride_x = original_img_width;
-    int64_t src_stride_x_bytes = original_img_width * samples_per_pixel;
+    int64_t src_stride_x_bytes = original_img_width * pixel_nbytes;
 
-    int64_t start_offset = (sx + (sy * src_stride_x)) * samples_per_pixel;
-    int64_t end_offset = (ex + (ey * src_stride_x)) * samples_per_pixel;
+    int64_t start_offset = (sx + (sy * src_stride_x)) * pixel_nbytes;
+    int64_t end_offset = (ex + (ey * src_stride_x)) * pixel_nbytes;
 
     switch (in_device.type())
     {
@@ -1392,7 +2058,7 @@ template <typename DataType>
 int64_t CuImageIterator<DataType>::index()
 {
     auto loader = reinterpret_cast<cucim::loader::ThreadBatchDataLoader*>(loader_);
-    if (loader && (loader->size() > 1))
+    if (loader && (loader->size() > 1) && !loader->is_cancelled())
     {
         batch_index_ = loader->processed_batch_count();
     }
@@ -1405,6 +2071,28 @@ uint64_t CuImageIterator<DataType>::size() const
     return total_batch_count_;
 }
 
+template <typename DataType>
+void CuImageIterator<DataType>::cancel()
+{
+    auto loader = reinterpret_cast<cucim::loader::ThreadBatchDataLoader*>(loader_);
+    if (loader)
+    {
+        loader->cancel();
+    }
+    batch_index_ = total_batch_count_;
+}
+
+template <typename DataType>
+void CuImageIterator<DataType>::close()
+{
+    auto loader = reinterpret_cast<cucim::loader::ThreadBatchDataLoader*>(loader_);
+    if (loader)
+    {
+        loader->close();
+    }
+    batch_index_ = total_batch_count_;
+}
+
 template <typename DataType>
 void CuImageIterator<DataType>::increase_index_()
 {
@@ -1422,16 +2110,10 @@ void CuImageIterator<DataType>::increase_index_()
             switch (device_type)
             {
             case io::DeviceType::kCPU:
-                if (*image_data_ptr)
-                {
-                    cucim_free(*image_data_ptr);
-                }
-                break;
             case io::DeviceType::kCUDA:
                 if (*image_data_ptr)
                 {
-                    cudaError_t cuda_status;
-                    CUDA_ERROR(cudaFree(*image_data_ptr));
+                    cucim::memory::buffer_pool().release(*image_data_ptr, device_type);
                 }
                 break;
             case io::DeviceType::kCUDAHost:
@@ -1451,7 +2133,11 @@ void CuImageIterator<DataType>::increase_index_()
                 cuimg_->image_metadata_->shape[0] = loader->data_batch_size();
             }
         }
-        if (loader->size() > 1)
+        if (loader->is_cancelled())
+        {
+            batch_index_ = total_batch_count_;
+        }
+        else if (loader->size() > 1)
         {
             batch_index_ = loader->processed_batch_count();
         }
@@ -0,0 +1,312 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/filesystem/byte_source.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "cucim/concurrent/threadpool.h"
+
+namespace cucim::filesystem
+{
+
+LocalByteSource::LocalByteSource(int fd) : fd_(fd)
+{
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+    {
+        size_ = static_cast<uint64_t>(st.st_size);
+    }
+}
+
+size_t LocalByteSource::read(void* buf, size_t count, uint64_t offset)
+{
+    uint8_t* ptr = static_cast<uint8_t*>(buf);
+    size_t total_read = 0;
+    while (total_read < count)
+    {
+        const ssize_t nread = ::pread(fd_, ptr + total_read, count - total_read, offset + total_read);
+        if (nread < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(fmt::format("Unable to read {} bytes at offset {}: {}", count - total_read,
+                                                 offset + total_read, std::strerror(errno)));
+        }
+        if (nread == 0)
+        {
+            break;
+        }
+        total_read += nread;
+    }
+    return total_read;
+}
+
+uint64_t LocalByteSource::size() const
+{
+    return size_;
+}
+
+void LocalByteSource::prefetch(const std::vector<ByteRange>& ranges)
+{
+    if (ranges.empty())
+    {
+        return;
+    }
+    // Overlapping and adjacent ranges are hinted at once.
+    std::vector<ByteRange> sorted_ranges(ranges);
+    std::sort(sorted_ranges.begin(), sorted_ranges.end(),
+              [](const ByteRange& a, const ByteRange& b) { return a.offset < b.offset; });
+    ByteRange merged = sorted_ranges.front();
+    for (size_t i = 1; i <= sorted_ranges.size(); ++i)
+    {
+        if (i < sorted_ranges.size() && sorted_ranges[i].offset <= merged.offset + merged.size)
+        {
+            merged.size = std::max(merged.size, sorted_ranges[i].offset + sorted_ranges[i].size - merged.offset);
+            continue;
+        }
+        if (merged.size > 0)
+        {
+            // Only a hint: errors are ignored.
+            ::posix_fadvise(fd_, static_cast<off_t>(merged.offset), static_cast<off_t>(merged.size),
+                            POSIX_FADV_WILLNEED);
+        }
+        if (i < sorted_ranges.size())
+        {
+            merged = sorted_ranges[i];
+        }
+    }
+}
+
+/**
+ * @brief One read of the underlying source, covering consecutive blocks.
+ *
+ * The fetch is run by the first thread that calls run(): an executor thread, or a reader that needs the blocks
+ * before an executor thread started the fetch. So a reader never waits for a fetch that is still queued.
+ */
+struct CachedByteSource::Fetch
+{
+    Fetch(uint64_t first_block, uint64_t offset, uint64_t size)
+        : first_block(first_block), offset(offset), size(size), done_future(done.get_future().share())
+    {
+    }
+
+    void run(ByteSource& source)
+    {
+        if (started.exchange(true))
+        {
+            return;
+        }
+        try
+        {
+            data.resize(size);
+            data.resize(source.read(data.data(), size, offset));
+            done.set_value();
+        }
+        catch (...)
+        {
+            done.set_exception(std::current_exception());
+        }
+    }
+
+    const uint64_t first_block;
+    const uint64_t offset;
+    const uint64_t size;
+    std::atomic<bool> started{ false };
+    std::promise<void> done;
+    std::shared_future<void> done_future;
+    std::vector<uint8_t> data;
+};
+
+CachedByteSource::CachedByteSource(std::shared_ptr<ByteSource> source,
+                                   uint64_t block_size,
+                                   uint64_t capacity_blocks,
+                                   uint32_t readahead_blocks)
+    : source_(std::move(source)),
+      block_size_(std::max<uint64_t>(block_size, 1)),
+      capacity_blocks_(std::max<uint64_t>(capacity_blocks, 1)),
+      readahead_blocks_(readahead_blocks)
+{
+    block_count_ = (source_->size() + block_size_ - 1) / block_size_;
+}
+
+size_t CachedByteSource::read(void* buf, size_t count, uint64_t offset)
+{
+    const uint64_t source_size = source_->size();
+    if (offset >= source_size || count == 0)
+    {
+        return 0;
+    }
+    count = std::min<uint64_t>(count, source_size - offset);
+
+    const uint64_t first_block = offset / block_size_;
+    const uint64_t last_block = (offset + count - 1) / block_size_;
+
+    std::vector<std::shared_ptr<Fetch>> new_fetches;
+    std::vector<std::shared_ptr<Fetch>> fetches = acquire_blocks(first_block, last_block, new_fetches);
+
+    // Read ahead when this read continues the previous one.
+    const uint64_t expected_block = next_sequential_block_.exchange(last_block + 1);
+    if (readahead_blocks_ && (first_block == expected_block || first_block + 1 == expected_block) &&
+        last_block + 1 < block_count_)
+    {
+        const uint64_t readahead_last = std::min(last_block + readahead_blocks_, block_count_ - 1);
+        acquire_blocks(last_block + 1, readahead_last, new_fetches);
+    }
+    start_fetches(new_fetches);
+
+    uint8_t* out = static_cast<uint8_t*>(buf);
+    size_t total_read = 0;
+    for (uint64_t block = first_block; block <= last_block; ++block)
+    {
+        std::shared_ptr<Fetch>& fetch = fetches[block - first_block];
+        fetch->run(*source_); // if no thread started it yet
+        try
+        {
+            fetch->done_future.get();
+        }
+        catch (...)
+        {
+            // Let the next read fetch the blocks again.
+            forget_fetch(fetch);
+            throw;
+        }
+
+        const uint64_t block_offset = block * block_size_;
+        const uint64_t begin = std::max(offset, block_offset);
+        const uint64_t end = std::min(offset + count, block_offset + block_size_);
+        const uint64_t data_begin = begin - fetch->offset;
+        if (data_begin >= fetch->data.size())
+        {
+            break; // the source is shorter than its reported size
+        }
+        const size_t nbytes = std::min<uint64_t>(end - begin, fetch->data.size() - data_begin);
+        memcpy(out + (begin - offset), fetch->data.data() + data_begin, nbytes);
+        total_read += nbytes;
+        if (begin + nbytes < end)
+        {
+            break;
+        }
+    }
+    return total_read;
+}
+
+uint64_t CachedByteSource::size() const
+{
+    return source_->size();
+}
+
+uint64_t CachedByteSource::version() const
+{
+    return source_->version();
+}
+
+void CachedByteSource::prefetch(const std::vector<ByteRange>& ranges)
+{
+    const uint64_t source_size = source_->size();
+    std::vector<std::shared_ptr<Fetch>> new_fetches;
+    for (const ByteRange& range : ranges)
+    {
+        if (range.size == 0 || range.offset >= source_size)
+        {
+            continue;
+        }
+        const uint64_t end = std::min(range.offset + range.size, source_size);
+        acquire_blocks(range.offset / block_size_, (end - 1) / block_size_, new_fetches);
+    }
+    start_fetches(new_fetches);
+}
+
+std::vector<std::shared_ptr<CachedByteSource::Fetch>> CachedByteSource::acquire_blocks(
+    uint64_t first_block, uint64_t last_block, std::vector<std::shared_ptr<Fetch>>& new_fetches)
+{
+    std::vector<std::shared_ptr<Fetch>> fetches;
+    fetches.reserve(last_block - first_block + 1);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t block = first_block;
+    while (block <= last_block)
+    {
+        auto it = blocks_.find(block);
+        if (it != blocks_.end())
+        {
+            lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+            fetches.push_back(it->second.fetch);
+            ++block;
+            continue;
+        }
+
+        // Fetch the run of missing blocks that starts at this block.
+        uint64_t run_end = block + 1;
+        while (run_end <= last_block && run_end - block < kByteSourceMaxBlocksPerFetch && !blocks_.count(run_end))
+        {
+            ++run_end;
+        }
+        auto fetch = std::make_shared<Fetch>(block, block * block_size_, (run_end - block) * block_size_);
+        new_fetches.push_back(fetch);
+        for (; block < run_end; ++block)
+        {
+            lru_.push_front(block);
+            blocks_.emplace(block, Block{ fetch, lru_.begin() });
+            fetches.push_back(fetch);
+        }
+    }
+
+    // Fetches of evicted blocks stay alive while they are referenced.
+    while (blocks_.size() > capacity_blocks_)
+    {
+        blocks_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    return fetches;
+}
+
+void CachedByteSource::forget_fetch(const std::shared_ptr<Fetch>& fetch)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t block_count = (fetch->size + block_size_ - 1) / block_size_;
+    for (uint64_t block = fetch->first_block; block < fetch->first_block + block_count; ++block)
+    {
+        auto it = blocks_.find(block);
+        if (it != blocks_.end() && it->second.fetch == fetch)
+        {
+            lru_.erase(it->second.lru_pos);
+            blocks_.erase(it);
+        }
+    }
+}
+
+void CachedByteSource::start_fetches(const std::vector<std::shared_ptr<Fetch>>& fetches)
+{
+    for (const std::shared_ptr<Fetch>& fetch : fetches)
+    {
+        // The task doesn't refer to this object, which may be destroyed before the task runs.
+        concurrent::ThreadPool::submit([fetch, source = source_]() { fetch->run(*source); });
+    }
+}
+
+bool is_remote_path(const Path& path)
+{
+    return path.rfind("http://", 0) == 0 || path.rfind("https://", 0) == 0;
+}
+
+std::shared_ptr<ByteSource> open_remote_byte_source(const Path& url)
+{
+    return std::make_shared<CachedByteSource>(std::make_shared<HttpByteSource>(url));
+}
+
+} // namespace cucim::filesystem
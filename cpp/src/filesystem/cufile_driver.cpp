@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2022, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -13,7 +13,10 @@
 #include <sys/statvfs.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <vector>
 
 #include <cuda_runtime.h>
 #include <fmt/format.h>
@@ -35,6 +38,128 @@ static CuFileDriverInitializer s_cufile_initializer;
 thread_local static CuFileDriverCache s_cufile_cache;
 Mutex CuFileDriver::driver_mutex_;
 
+/**
+ * Pool of page-aligned host buffers of the same size, to stage reads and writes that can't use the caller's buffer
+ * directly (unaligned O_DIRECT reads and transfers from/to device memory).
+ *
+ * Each transfer leases its own buffer, so concurrent transfers don't share (or wait for) a staging buffer. Up to
+ * `max_idle_count` released buffers are kept for reuse.
+ */
+class BounceBufferPool
+{
+public:
+    class Lease
+    {
+    public:
+        Lease(BounceBufferPool* pool, uint8_t* data, size_t size) : pool_(pool), data_(data), size_(size)
+        {
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease()
+        {
+            pool_->release(data_, size_);
+        }
+
+        uint8_t* data() const
+        {
+            return data_;
+        }
+        size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        BounceBufferPool* pool_;
+        uint8_t* data_;
+        size_t size_;
+    };
+
+    BounceBufferPool(size_t buffer_size, size_t max_idle_count)
+    {
+        configure(buffer_size, max_idle_count);
+    }
+
+    // Buffers of the previous size are freed when they are released.
+    void configure(size_t buffer_size, size_t max_idle_count)
+    {
+        std::vector<uint8_t*> stale_buffers;
+        {
+            ScopedLock lock(mutex_);
+            const size_t aligned_size = std::max<size_t>(ALIGN_UP(buffer_size, PAGE_SIZE), PAGE_SIZE);
+            if (aligned_size != buffer_size_)
+            {
+                stale_buffers.swap(idle_buffers_);
+                buffer_size_ = aligned_size;
+            }
+            max_idle_count_ = max_idle_count;
+            while (idle_buffers_.size() > max_idle_count_)
+            {
+                stale_buffers.push_back(idle_buffers_.back());
+                idle_buffers_.pop_back();
+            }
+        }
+        for (uint8_t* data : stale_buffers)
+        {
+            free(data);
+        }
+    }
+
+    Lease acquire()
+    {
+        size_t buffer_size;
+        {
+            ScopedLock lock(mutex_);
+            buffer_size = buffer_size_;
+            if (!idle_buffers_.empty())
+            {
+                uint8_t* data = idle_buffers_.back();
+                idle_buffers_.pop_back();
+                return Lease(this, data, buffer_size);
+            }
+        }
+        void* data = nullptr;
+        if (posix_memalign(&data, PAGE_SIZE, buffer_size))
+        {
+            throw std::bad_alloc();
+        }
+        return Lease(this, static_cast<uint8_t*>(data), buffer_size);
+    }
+
+private:
+    void release(uint8_t* data, size_t size)
+    {
+        {
+            ScopedLock lock(mutex_);
+            if (size == buffer_size_ && idle_buffers_.size() < max_idle_count_)
+            {
+                idle_buffers_.push_back(data);
+                return;
+            }
+        }
+        free(data);
+    }
+
+    size_t buffer_size_ = 0;
+    size_t max_idle_count_ = 0;
+    Mutex mutex_;
+    std::vector<uint8_t*> idle_buffers_;
+};
+
+static BounceBufferPool& bounce_buffer_pool()
+{
+    // Intentionally leaked: files may be read or written during static destruction.
+    static BounceBufferPool* pool = new BounceBufferPool(
+        static_cast<size_t>(cucim::memory::kDefaultBounceBufferSize) << 10, cucim::memory::kDefaultBounceBufferCount);
+    return *pool;
+}
+
+void set_bounce_buffer_config(const cucim::memory::BufferPoolConfig& config)
+{
+    bounce_buffer_pool().configure(static_cast<size_t>(config.bounce_buffer_size) << 10, config.bounce_buffer_count);
+}
+
 
 static std::string get_fd_path(int fd)
 {
@@ -310,7 +435,6 @@ CuFileDriverInitializer::CuFileDriverInitializer()
         {
             // kb -> bytes
             max_device_cache_size_ = static_cast<uint64_t>(props.max_device_cache_size) << 10;
-            max_host_cache_size_ = static_cast<uint64_t>(props.max_device_cache_size) << 10;
         }
         else
         {
@@ -322,7 +446,6 @@ CuFileDriverInitializer::CuFileDriverInitializer()
     {
         is_available_ = false;
         max_device_cache_size_ = DEFAULT_MAX_CACHE_SIZE;
-        max_host_cache_size_ = DEFAULT_MAX_CACHE_SIZE;
 
         // fmt::print(stderr, "[Warning] CuFileDriver cannot be open. Falling back to use POSIX file IO APIs.\n");
     }
@@ -382,23 +505,6 @@ void* CuFileDriverCache::device_cache()
         return device_cache_aligned_;
     }
 }
-void* CuFileDriverCache::host_cache()
-{
-    if (host_cache_)
-    {
-        return host_cache_aligned_;
-    }
-    else
-    {
-        if (posix_memalign(&host_cache_, PAGE_SIZE, s_cufile_initializer.max_host_cache_size()))
-        {
-            throw std::bad_alloc();
-        }
-        host_cache_aligned_ = host_cache_;
-
-        return host_cache_aligned_;
-    }
-}
 CuFileDriverCache::~CuFileDriverCache()
 {
 
@@ -418,12 +524,6 @@ CuFileDriverCache::~CuFileDriverCache()
         device_cache_ = nullptr;
         device_cache_aligned_ = nullptr;
     }
-    if (host_cache_)
-    {
-        free(host_cache_);
-        host_cache_ = nullptr;
-        host_cache_aligned_ = nullptr;
-    }
 }
 ssize_t CuFileDriver::pread(void* buf, size_t count, off_t file_offset, off_t buf_offset) const
 {
@@ -464,10 +564,11 @@ ssize_t CuFileDriver::pread(void* buf, size_t count, off_t file_offset, off_t bu
     {
         if (memory_type != cudaMemoryTypeUnregistered)
         {
-            uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
+            BounceBufferPool::Lease bounce_buffer = bounce_buffer_pool().acquire();
+            uint64_t cache_size = bounce_buffer.size();
             uint64_t remaining_size = count;
             ssize_t read_cnt;
-            uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
+            uint8_t* cache_buf = bounce_buffer.data();
             uint8_t* output_buf = static_cast<uint8_t*>(buf) + buf_offset;
             off_t read_offset = file_offset;
             while (true)
@@ -479,6 +580,16 @@ ssize_t CuFileDriver::pread(void* buf, size_t count, off_t file_offset, off_t bu
                     break;
                 }
                 read_cnt = ::pread(handle_->fd, cache_buf, bytes_to_copy, read_offset);
+                if (read_cnt <= 0)
+                {
+                    if (read_cnt < 0)
+                    {
+                        fmt::print(stderr, "Cannot read the file content block! ({})\n", std::strerror(errno));
+                        return -1;
+                    }
+                    break;
+                }
+                bytes_to_copy = read_cnt;
                 CUDA_TRY(cudaMemcpy(output_buf, cache_buf, bytes_to_copy, cudaMemcpyHostToDevice));
                 if (cuda_status)
                 {
@@ -515,224 +626,78 @@ ssize_t CuFileDriver::pread(void* buf, size_t count, off_t file_offset, off_t bu
     }
     else if (memory_type == cudaMemoryTypeUnregistered || handle_->type == FileHandleType::kPosixODirect)
     {
-        uint64_t buf_align = (reinterpret_cast<uint64_t>(buf) + buf_offset) % PAGE_SIZE;
-        bool is_aligned = (buf_align == 0) && ((file_offset % PAGE_SIZE) == 0);
+        uint8_t* output_buf = static_cast<uint8_t*>(buf) + buf_offset;
+        bool is_aligned = (reinterpret_cast<uint64_t>(output_buf) % PAGE_SIZE == 0) && (file_offset % PAGE_SIZE == 0);
 
-        if (is_aligned)
+        // Whole pages are read into an aligned host buffer directly.
+        size_t direct_read_size = 0;
+        if (is_aligned && memory_type == cudaMemoryTypeUnregistered)
         {
-            ssize_t read_cnt;
-            size_t block_read_size = ALIGN_DOWN(count, PAGE_SIZE);
-            if (block_read_size > 0)
+            direct_read_size = ALIGN_DOWN(count, PAGE_SIZE);
+            if (direct_read_size > 0)
             {
-                if (memory_type == cudaMemoryTypeUnregistered)
-                {
-                    read_cnt =
-                        ::pread(handle_->fd, reinterpret_cast<char*>(buf) + buf_offset, block_read_size, file_offset);
-                    total_read_cnt += read_cnt;
-                }
-                else
-                {
-                    uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
-                    uint64_t remaining_size = block_read_size;
-                    ssize_t read_cnt;
-                    uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
-                    uint8_t* input_buf = static_cast<uint8_t*>(buf) + buf_offset;
-                    off_t read_offset = file_offset;
-                    while (true)
-                    {
-                        size_t bytes_to_copy = std::min(cache_size, remaining_size);
-
-                        if (bytes_to_copy == 0)
-                        {
-                            break;
-                        }
-
-                        read_cnt = ::pread(handle_->fd, cache_buf, bytes_to_copy, read_offset);
-                        CUDA_TRY(cudaMemcpy(input_buf, cache_buf, bytes_to_copy, cudaMemcpyHostToDevice));
-                        if (cuda_status)
-                        {
-                            return -1;
-                        }
-                        read_offset += read_cnt;
-                        input_buf += read_cnt;
-                        remaining_size -= read_cnt;
-
-                        total_read_cnt += bytes_to_copy;
-                    }
-                }
-            }
-
-            size_t remaining = count - block_read_size;
-            if (remaining)
-            {
-                uint8_t internal_buf[PAGE_SIZE * 2]; // no need to initialize for pread()
-                uint8_t* buf_pos = reinterpret_cast<uint8_t*>(ALIGN_UP(static_cast<uint8_t*>(internal_buf), PAGE_SIZE));
-
-                // Read the remaining block (size of PAGE_SIZE)
-                ssize_t read_cnt;
-                read_cnt = ::pread(handle_->fd, buf_pos, PAGE_SIZE, block_read_size);
+                ssize_t read_cnt = ::pread(handle_->fd, output_buf, direct_read_size, file_offset);
                 if (read_cnt < 0)
                 {
-                    fmt::print(stderr, "Cannot read the remaining file content block! ({})\n", std::strerror(errno));
+                    fmt::print(stderr, "Cannot read the file content block! ({})\n", std::strerror(errno));
                     return -1;
                 }
-                // Copy a buffer to read, from the intermediate remaining block (buf_pos)
-                if (memory_type == cudaMemoryTypeUnregistered)
+                total_read_cnt += read_cnt;
+                if (static_cast<size_t>(read_cnt) < direct_read_size) // end of file
                 {
-                    memcpy(reinterpret_cast<uint8_t*>(buf) + buf_offset + block_read_size, buf_pos, remaining);
+                    return total_read_cnt;
                 }
-                else
-                {
-                    CUDA_TRY(cudaMemcpy(reinterpret_cast<uint8_t*>(buf) + buf_offset + block_read_size, buf_pos,
-                                        remaining, cudaMemcpyHostToDevice));
-                    if (cuda_status)
-                    {
-                        return -1;
-                    }
-                }
-
-                total_read_cnt += remaining;
             }
         }
-        else
-        {
-            uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
-            uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
 
-            off_t file_start_offset = ALIGN_DOWN(file_offset, PAGE_SIZE);
-            off_t end_offset = count + file_offset;
-            off_t end_boundary_offset = ALIGN_UP(end_offset, PAGE_SIZE);
-            size_t large_block_size = end_boundary_offset - file_start_offset;
-            off_t page_offset = file_offset - file_start_offset;
-            uint8_t* output_buf = static_cast<uint8_t*>(buf) + buf_offset;
-
-            if (large_block_size <= cache_size) // Optimize if bytes to load is less than cache_size
+        // The rest is read through a bounce buffer, in page-aligned windows that cover the requested bytes: each window
+        // takes a single read and a single copy.
+        if (direct_read_size < count)
+        {
+            BounceBufferPool::Lease bounce_buffer = bounce_buffer_pool().acquire();
+            uint8_t* output_pos = output_buf + direct_read_size;
+            off_t read_offset = file_offset + direct_read_size;
+            size_t remaining_size = count - direct_read_size;
+            while (remaining_size > 0)
             {
-                ssize_t read_cnt = ::pread(handle_->fd, cache_buf, large_block_size, file_start_offset);
+                const off_t window_offset = ALIGN_DOWN(read_offset, PAGE_SIZE);
+                const size_t page_offset = read_offset - window_offset;
+                const size_t window_size =
+                    std::min<size_t>(ALIGN_UP(page_offset + remaining_size, PAGE_SIZE), bounce_buffer.size());
+
+                ssize_t read_cnt = ::pread(handle_->fd, bounce_buffer.data(), window_size, window_offset);
                 if (read_cnt < 0)
                 {
                     fmt::print(stderr, "Cannot read the file content block! ({})\n", std::strerror(errno));
                     return -1;
                 }
+                if (static_cast<size_t>(read_cnt) <= page_offset) // end of file
+                {
+                    break;
+                }
 
+                const size_t bytes_to_copy = std::min(static_cast<size_t>(read_cnt) - page_offset, remaining_size);
                 if (memory_type == cudaMemoryTypeUnregistered)
                 {
-                    memcpy(output_buf, cache_buf + page_offset, count);
+                    memcpy(output_pos, bounce_buffer.data() + page_offset, bytes_to_copy);
                 }
                 else
                 {
-                    CUDA_TRY(cudaMemcpy(output_buf, cache_buf + page_offset, count, cudaMemcpyHostToDevice));
+                    CUDA_TRY(cudaMemcpy(
+                        output_pos, bounce_buffer.data() + page_offset, bytes_to_copy, cudaMemcpyHostToDevice));
                     if (cuda_status)
                     {
                         return -1;
                     }
                 }
-                total_read_cnt += std::min(static_cast<size_t>(read_cnt - page_offset), count);
-            }
-            else
-            {
-                off_t overflow_offset = page_offset + count;
-                size_t header_size = (overflow_offset > PAGE_SIZE) ? PAGE_SIZE - page_offset : count;
-                size_t tail_size = (overflow_offset > PAGE_SIZE) ? end_offset - ALIGN_DOWN(end_offset, PAGE_SIZE) : 0;
-                uint64_t body_remaining_size = count - header_size - tail_size;
-                off_t read_offset = file_start_offset;
-
-                size_t bytes_to_copy;
-                ssize_t read_cnt;
-
-                uint8_t internal_buf[PAGE_SIZE * 2]; // no need to initialize for pread()
-                uint8_t* internal_buf_pos =
-                    reinterpret_cast<uint8_t*>(ALIGN_UP(static_cast<uint8_t*>(internal_buf), PAGE_SIZE));
-
-
-                // Handle the head part of the file content
-                if (header_size)
-                {
-                    read_cnt = ::pread(handle_->fd, internal_buf_pos, PAGE_SIZE, read_offset);
-                    if (read_cnt < 0)
-                    {
-                        fmt::print(stderr, "Cannot read the head part of the file content block! ({})\n",
-                                   std::strerror(errno));
-                        return -1;
-                    }
-
-                    bytes_to_copy = header_size;
-                    if (memory_type == cudaMemoryTypeUnregistered)
-                    {
-                        memcpy(output_buf, internal_buf_pos + page_offset, bytes_to_copy);
-                    }
-                    else
-                    {
-                        CUDA_TRY(cudaMemcpy(
-                            output_buf, internal_buf_pos + page_offset, bytes_to_copy, cudaMemcpyHostToDevice));
-                        if (cuda_status)
-                        {
-                            return -1;
-                        }
-                    }
-
-                    output_buf += bytes_to_copy;
-                    read_offset += read_cnt;
-
-                    total_read_cnt += bytes_to_copy;
-                }
-
-                // Copy n * PAGE_SIZE bytes
-                while (true)
-                {
-                    size_t bytes_to_copy = std::min(cache_size, body_remaining_size);
-
-                    if (bytes_to_copy == 0)
-                    {
-                        break;
-                    }
-
-                    read_cnt = ::pread(handle_->fd, cache_buf, bytes_to_copy, read_offset);
-                    if (memory_type == cudaMemoryTypeUnregistered)
-                    {
-                        memcpy(output_buf, cache_buf, bytes_to_copy);
-                    }
-                    else
-                    {
-                        CUDA_TRY(cudaMemcpy(output_buf, cache_buf, bytes_to_copy, cudaMemcpyHostToDevice));
-                        if (cuda_status)
-                        {
-                            return -1;
-                        }
-                    }
-                    read_offset += read_cnt;
-                    output_buf += read_cnt;
-                    body_remaining_size -= read_cnt;
-
-                    total_read_cnt += bytes_to_copy;
-                }
+                output_pos += bytes_to_copy;
+                read_offset += bytes_to_copy;
+                remaining_size -= bytes_to_copy;
+                total_read_cnt += bytes_to_copy;
 
-                // Handle the tail part of the file content
-                if (tail_size)
+                if (static_cast<size_t>(read_cnt) < window_size) // end of file
                 {
-                    //                memset(internal_buf_pos, 0, PAGE_SIZE); // no need to initialize for pread()
-                    read_cnt = ::pread(handle_->fd, internal_buf_pos, PAGE_SIZE, read_offset);
-                    if (read_cnt < 0)
-                    {
-                        fmt::print(stderr, "Cannot read the tail part of the file content block! ({})\n",
-                                   std::strerror(errno));
-                        return -1;
-                    }
-                    // Copy the region
-                    bytes_to_copy = tail_size;
-                    if (memory_type == cudaMemoryTypeUnregistered)
-                    {
-                        memcpy(output_buf, internal_buf_pos, bytes_to_copy);
-                    }
-                    else
-                    {
-                        CUDA_TRY(cudaMemcpy(output_buf, internal_buf_pos, bytes_to_copy, cudaMemcpyHostToDevice));
-                        if (cuda_status)
-                        {
-                            return -1;
-                        }
-                    }
-                    total_read_cnt += tail_size;
+                    break;
                 }
             }
         }
@@ -784,10 +749,11 @@ ssize_t CuFileDriver::pwrite(const void* buf, size_t count, off_t file_offset, o
     {
         if (memory_type != cudaMemoryTypeUnregistered)
         {
-            uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
+            BounceBufferPool::Lease bounce_buffer = bounce_buffer_pool().acquire();
+            uint64_t cache_size = bounce_buffer.size();
             uint64_t remaining_size = count;
             ssize_t write_cnt;
-            uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
+            uint8_t* cache_buf = bounce_buffer.data();
             const uint8_t* input_buf = static_cast<const uint8_t*>(buf) + buf_offset;
             off_t write_offset = file_offset;
             while (true)
@@ -842,10 +808,11 @@ ssize_t CuFileDriver::pwrite(const void* buf, size_t count, off_t file_offset, o
                 }
                 else
                 {
-                    uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
+                    BounceBufferPool::Lease bounce_buffer = bounce_buffer_pool().acquire();
+                    uint64_t cache_size = bounce_buffer.size();
                     uint64_t remaining_size = block_write_size;
                     ssize_t write_cnt;
-                    uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
+                    uint8_t* cache_buf = bounce_buffer.data();
                     const uint8_t* input_buf = static_cast<const uint8_t*>(buf) + buf_offset;
                     off_t write_offset = file_offset;
                     while (true)
@@ -881,7 +848,7 @@ ssize_t CuFileDriver::pwrite(const void* buf, size_t count, off_t file_offset, o
 
                 // Read the remaining block (size of PAGE_SIZE)
                 ssize_t read_cnt;
-                read_cnt = ::pread(handle_->fd, internal_buf_pos, PAGE_SIZE, block_write_size);
+                read_cnt = ::pread(handle_->fd, internal_buf_pos, PAGE_SIZE, file_offset + block_write_size);
                 if (read_cnt < 0)
                 {
                     fmt::print(stderr, "Cannot read the remaining file content block! ({})\n", std::strerror(errno));
@@ -904,7 +871,7 @@ ssize_t CuFileDriver::pwrite(const void* buf, size_t count, off_t file_offset, o
                     }
                 }
                 // Write the constructed block
-                write_cnt = ::pwrite(handle_->fd, internal_buf_pos, PAGE_SIZE, block_write_size);
+                write_cnt = ::pwrite(handle_->fd, internal_buf_pos, PAGE_SIZE, file_offset + block_write_size);
                 if (write_cnt < 0)
                 {
                     fmt::print(stderr, "Cannot write the remaining file content! ({})\n", std::strerror(errno));
@@ -916,8 +883,9 @@ ssize_t CuFileDriver::pwrite(const void* buf, size_t count, off_t file_offset, o
         }
         else
         {
-            uint64_t cache_size = s_cufile_initializer.max_host_cache_size();
-            uint8_t* cache_buf = static_cast<uint8_t*>(s_cufile_cache.host_cache());
+            BounceBufferPool::Lease bounce_buffer = bounce_buffer_pool().acquire();
+            uint64_t cache_size = bounce_buffer.size();
+            uint8_t* cache_buf = bounce_buffer.data();
 
             off_t file_start_offset = ALIGN_DOWN(file_offset, PAGE_SIZE);
             off_t end_offset = count + file_offset;
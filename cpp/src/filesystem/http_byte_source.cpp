@@ -0,0 +1,480 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/filesystem/byte_source.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace cucim::filesystem
+{
+
+namespace
+{
+
+constexpr int kSocketTimeoutSeconds = 30;
+constexpr size_t kMaxHeaderSize = 64 * 1024;
+constexpr size_t kMaxIdleConnections = 32;
+/// Number of attempts of a request (a kept-alive connection may have been closed by the server).
+constexpr int kRequestAttempts = 3;
+
+/// Error of the connection (as opposed to an error response), after which the request can be retried.
+class ConnectionError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+void send_all(int connection, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        const ssize_t nsent = ::send(connection, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (nsent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ConnectionError(fmt::format("Unable to send the request: {}", std::strerror(errno)));
+        }
+        sent += nsent;
+    }
+}
+
+size_t recv_some(int connection, void* buf, size_t count)
+{
+    while (true)
+    {
+        const ssize_t nread = ::recv(connection, buf, count, 0);
+        if (nread < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ConnectionError(fmt::format("Unable to receive the response: {}", std::strerror(errno)));
+        }
+        if (nread == 0)
+        {
+            throw ConnectionError("The connection was closed by the server");
+        }
+        return nread;
+    }
+}
+
+/// Closes a connection when it goes out of scope, unless it is released.
+class ConnectionGuard
+{
+public:
+    explicit ConnectionGuard(int connection) : connection_(connection)
+    {
+    }
+    ConnectionGuard(const ConnectionGuard&) = delete;
+    ConnectionGuard& operator=(const ConnectionGuard&) = delete;
+    ~ConnectionGuard()
+    {
+        if (connection_ >= 0)
+        {
+            ::close(connection_);
+        }
+    }
+
+    int get() const
+    {
+        return connection_;
+    }
+    int release()
+    {
+        const int connection = connection_;
+        connection_ = -1;
+        return connection;
+    }
+
+private:
+    int connection_ = -1;
+};
+
+/// Parse the unsigned decimal number at the start of the value of header field `name`.
+uint64_t parse_number(const std::string& value, const char* name, const std::string& url)
+{
+    if (!value.empty() && std::isdigit(static_cast<unsigned char>(value[0])))
+    {
+        try
+        {
+            return std::stoull(value);
+        }
+        catch (const std::logic_error&) // out of range
+        {
+        }
+    }
+    throw std::runtime_error(fmt::format("Invalid {} '{}' in the response from '{}'", name, value, url));
+}
+
+std::string to_lower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
+}
+
+} // namespace
+
+struct HttpByteSource::Response
+{
+    int status = 0;
+    bool keep_alive = true;
+    int64_t content_length = -1;
+    uint64_t range_first = 0;
+    uint64_t total_size = 0;
+    bool has_total_size = false;
+    std::string etag;
+};
+
+HttpByteSource::HttpByteSource(const std::string& url) : url_(url)
+{
+    constexpr std::string_view kScheme = "http://";
+    if (url.rfind(kScheme, 0) != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Unsupported URL '{}' (only 'http://' URLs can be read, use a local proxy for HTTPS)", url));
+    }
+    const size_t authority_end = url.find_first_of("/?", kScheme.size());
+    const std::string authority = url.substr(kScheme.size(), authority_end - kScheme.size());
+    target_ = authority_end == std::string::npos ? "/" : url.substr(authority_end);
+    if (target_[0] == '?')
+    {
+        target_.insert(0, "/");
+    }
+    const size_t port_pos = authority.rfind(':');
+    if (port_pos != std::string::npos && authority.find(']', port_pos) == std::string::npos)
+    {
+        host_ = authority.substr(0, port_pos);
+        port_ = authority.substr(port_pos + 1);
+    }
+    else
+    {
+        host_ = authority;
+        port_ = "80";
+    }
+    if (host_.size() > 2 && host_.front() == '[' && host_.back() == ']') // IPv6 literal
+    {
+        host_ = host_.substr(1, host_.size() - 2);
+    }
+    if (host_.empty() || port_.empty())
+    {
+        throw std::invalid_argument(fmt::format("Invalid URL '{}'", url));
+    }
+
+    // Get the size (and the entity tag) of the object with a request of its first byte.
+    int connection = -1;
+    std::vector<uint8_t> body;
+    Response response = request(0, 0, connection, body);
+    ConnectionGuard guard(connection);
+    if (response.status == 416 && response.has_total_size) // empty object
+    {
+        size_ = 0;
+    }
+    else if (response.status == 206 && response.has_total_size)
+    {
+        size_ = response.total_size;
+    }
+    else
+    {
+        if (response.status >= 400)
+        {
+            throw std::runtime_error(fmt::format("Cannot access '{}' (status: {})", url, response.status));
+        }
+        throw std::runtime_error(
+            fmt::format("The server of '{}' doesn't support range requests (status: {})", url, response.status));
+    }
+    // Discard the body.
+    int64_t remaining = std::max<int64_t>(response.content_length, 0) - static_cast<int64_t>(body.size());
+    uint8_t discard[256];
+    try
+    {
+        while (remaining > 0)
+        {
+            remaining -= recv_some(guard.get(), discard, std::min<int64_t>(remaining, sizeof(discard)));
+        }
+    }
+    catch (const ConnectionError& e)
+    {
+        throw std::runtime_error(fmt::format("Unable to request '{}': {}", url, e.what()));
+    }
+    // Bytes received beyond the body would be parsed as the next response, so the connection isn't reused then.
+    release_connection(guard.release(), response.keep_alive && remaining == 0);
+    etag_ = response.etag;
+    version_ = etag_.empty() ? 0 : std::hash<std::string>{}(etag_);
+}
+
+HttpByteSource::~HttpByteSource()
+{
+    for (int connection : idle_connections_)
+    {
+        ::close(connection);
+    }
+}
+
+size_t HttpByteSource::read(void* buf, size_t count, uint64_t offset)
+{
+    if (offset >= size_ || count == 0)
+    {
+        return 0;
+    }
+    count = std::min<uint64_t>(count, size_ - offset);
+
+    int connection = -1;
+    std::vector<uint8_t> body_prefix;
+    Response response = request(offset, offset + count - 1, connection, body_prefix);
+    ConnectionGuard guard(connection);
+    if (response.status != 206 || response.range_first != offset ||
+        response.content_length != static_cast<int64_t>(count))
+    {
+        throw std::runtime_error(fmt::format("Unexpected response for bytes {}-{} of '{}' (status: {})", offset,
+                                             offset + count - 1, url_, response.status));
+    }
+    if (!etag_.empty() && !response.etag.empty() && response.etag != etag_)
+    {
+        throw std::runtime_error(fmt::format("'{}' was modified while it is open", url_));
+    }
+
+    uint8_t* out = static_cast<uint8_t*>(buf);
+    size_t total_read = std::min(body_prefix.size(), count);
+    if (total_read > 0)
+    {
+        memcpy(out, body_prefix.data(), total_read);
+    }
+    try
+    {
+        while (total_read < count)
+        {
+            total_read += recv_some(guard.get(), out + total_read, count - total_read);
+        }
+    }
+    catch (const ConnectionError& e)
+    {
+        throw std::runtime_error(fmt::format("Unable to read bytes {}-{} of '{}': {}", offset, offset + count - 1,
+                                             url_, e.what()));
+    }
+    // Bytes received beyond the body would be parsed as the next response, so the connection isn't reused then.
+    release_connection(guard.release(), response.keep_alive && body_prefix.size() <= count);
+    return total_read;
+}
+
+uint64_t HttpByteSource::size() const
+{
+    return size_;
+}
+
+uint64_t HttpByteSource::version() const
+{
+    return version_;
+}
+
+int HttpByteSource::connect() const
+{
+    struct addrinfo hints
+    {
+    };
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    const int status = ::getaddrinfo(host_.c_str(), port_.c_str(), &hints, &addresses);
+    if (status != 0)
+    {
+        throw std::runtime_error(fmt::format("Unable to resolve '{}': {}", host_, gai_strerror(status)));
+    }
+
+    int connection = -1;
+    int error = 0;
+    for (struct addrinfo* address = addresses; address; address = address->ai_next)
+    {
+        connection = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (connection < 0)
+        {
+            error = errno;
+            continue;
+        }
+        struct timeval timeout
+        {
+        };
+        timeout.tv_sec = kSocketTimeoutSeconds;
+        setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        int enable = 1;
+        setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        if (::connect(connection, address->ai_addr, address->ai_addrlen) == 0)
+        {
+            break;
+        }
+        error = errno;
+        ::close(connection);
+        connection = -1;
+    }
+    freeaddrinfo(addresses);
+    if (connection < 0)
+    {
+        throw std::runtime_error(
+            fmt::format("Unable to connect to '{}:{}': {}", host_, port_, std::strerror(error)));
+    }
+    return connection;
+}
+
+HttpByteSource::Response HttpByteSource::request(uint64_t first,
+                                                 uint64_t last,
+                                                 int& connection,
+                                                 std::vector<uint8_t>& body_prefix)
+{
+    const std::string host = host_.find(':') == std::string::npos ? host_ : fmt::format("[{}]", host_); // IPv6
+    const std::string request_message = fmt::format(
+        "GET {} HTTP/1.1\r\nHost: {}{}\r\nRange: bytes={}-{}\r\nUser-Agent: cucim\r\nConnection: keep-alive\r\n\r\n",
+        target_, host, port_ == "80" ? "" : ":" + port_, first, last);
+
+    connection = -1;
+    for (int attempt = 1;; ++attempt)
+    {
+        int new_connection = -1;
+        {
+            std::lock_guard<std::mutex> lock(connection_mutex_);
+            if (!idle_connections_.empty())
+            {
+                new_connection = idle_connections_.back();
+                idle_connections_.pop_back();
+            }
+        }
+        // The connection is closed on errors (and before a retry).
+        ConnectionGuard guard(new_connection < 0 ? connect() : new_connection);
+
+        std::string header;
+        try
+        {
+            send_all(guard.get(), request_message);
+            char buf[4096];
+            size_t header_end = std::string::npos;
+            while (header_end == std::string::npos)
+            {
+                if (header.size() > kMaxHeaderSize)
+                {
+                    throw std::runtime_error(fmt::format("The response header of '{}' is too large", url_));
+                }
+                const size_t search_start = header.size() < 3 ? 0 : header.size() - 3;
+                header.append(buf, recv_some(guard.get(), buf, sizeof(buf)));
+                header_end = header.find("\r\n\r\n", search_start);
+            }
+            body_prefix.assign(header.begin() + header_end + 4, header.end());
+            header.resize(header_end + 2);
+        }
+        catch (const ConnectionError& e)
+        {
+            if (attempt < kRequestAttempts)
+            {
+                continue;
+            }
+            throw std::runtime_error(fmt::format("Unable to request '{}': {}", url_, e.what()));
+        }
+
+        // Parse the status line and the header fields.
+        Response response;
+        size_t line_start = 0;
+        size_t line_end = header.find("\r\n");
+        const std::string status_line = header.substr(0, line_end);
+        if (status_line.rfind("HTTP/1.", 0) != 0 || status_line.size() < 12)
+        {
+            throw std::runtime_error(fmt::format("Invalid response from '{}': '{}'", url_, status_line));
+        }
+        response.keep_alive = status_line[7] != '0';
+        response.status = std::atoi(status_line.c_str() + 9);
+        while ((line_start = line_end + 2) < header.size())
+        {
+            line_end = header.find("\r\n", line_start);
+            const std::string line = header.substr(line_start, line_end - line_start);
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos)
+            {
+                continue;
+            }
+            const std::string name = to_lower(line.substr(0, colon));
+            const size_t value_start = line.find_first_not_of(" \t", colon + 1);
+            const std::string value = value_start == std::string::npos ? "" : line.substr(value_start);
+            if (name == "content-length")
+            {
+                response.content_length = static_cast<int64_t>(parse_number(value, "content length", url_));
+            }
+            else if (name == "content-range") // "bytes first-last/total" or "bytes */total"
+            {
+                const size_t slash = value.find('/');
+                if (slash != std::string::npos && value[slash + 1] != '*')
+                {
+                    response.total_size = parse_number(value.substr(slash + 1), "content range", url_);
+                    response.has_total_size = true;
+                }
+                const size_t first_pos = value.find_first_of("0123456789");
+                if (first_pos != std::string::npos && first_pos < slash)
+                {
+                    response.range_first = parse_number(value.substr(first_pos), "content range", url_);
+                }
+            }
+            else if (name == "connection")
+            {
+                const std::string option = to_lower(value);
+                if (option == "close")
+                {
+                    response.keep_alive = false;
+                }
+                else if (option == "keep-alive")
+                {
+                    response.keep_alive = true;
+                }
+            }
+            else if (name == "etag")
+            {
+                response.etag = value;
+            }
+            else if (name == "transfer-encoding" && to_lower(value) != "identity")
+            {
+                throw std::runtime_error(
+                    fmt::format("Unsupported transfer encoding '{}' in the response from '{}'", value, url_));
+            }
+        }
+        if (response.content_length < 0 && response.status != 416)
+        {
+            throw std::runtime_error(fmt::format("The response from '{}' has no content length", url_));
+        }
+        connection = guard.release();
+        return response;
+    }
+}
+
+void HttpByteSource::release_connection(int connection, bool keep_alive)
+{
+    if (keep_alive)
+    {
+        std::lock_guard<std::mutex> lock(connection_mutex_);
+        if (idle_connections_.size() < kMaxIdleConnections)
+        {
+            idle_connections_.push_back(connection);
+            return;
+        }
+    }
+    ::close(connection);
+}
+
+} // namespace cucim::filesystem
@@ -0,0 +1,361 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/loader/dataset_loader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "cucim/cuimage.h"
+#include "cucim/io/format/image_format.h"
+#include "cucim/loader/thread_batch_data_loader.h"
+#include "cucim/memory/buffer_pool.h"
+#include "cucim/memory/memory_manager.h"
+#include "cucim/profiler/nvtx3.h"
+#include "cucim/util/cuda.h"
+
+namespace cucim::loader
+{
+
+class DatasetLoader::FileCache
+{
+public:
+    FileCache(std::vector<std::string> paths, uint32_t capacity) : paths_(std::move(paths)), capacity_(capacity)
+    {
+    }
+
+    const std::vector<std::string>& paths() const
+    {
+        return paths_;
+    }
+
+    uint32_t capacity() const
+    {
+        return capacity_;
+    }
+
+    size_t open_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lru_.size();
+    }
+
+    std::shared_ptr<CuImage> open(uint32_t file_index)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(file_index);
+            if (it != index_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                return it->second->second;
+            }
+        }
+
+        // Open the file without holding the lock so that other files can be read meanwhile.
+        PROF_SCOPED_RANGE(PROF_EVENT_P(dataset_loader_open_file, file_index));
+        auto image = std::make_shared<CuImage>(paths_.at(file_index));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(file_index);
+        if (it != index_.end()) // opened by another thread meanwhile
+        {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->second;
+        }
+        lru_.emplace_front(file_index, image);
+        index_.emplace(file_index, lru_.begin());
+        // An evicted file is closed when the last read using it finishes.
+        while (lru_.size() > capacity_)
+        {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+        return image;
+    }
+
+private:
+    using Entry = std::pair<uint32_t, std::shared_ptr<CuImage>>;
+
+    std::vector<std::string> paths_;
+    uint32_t capacity_ = 0;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_; // the most recently used file first
+    std::unordered_map<uint32_t, std::list<Entry>::iterator> index_;
+};
+
+namespace
+{
+
+/**
+ * @brief Create the metadata of batches of patches of `size` (width, height) at the level of `image`.
+ */
+io::format::ImageMetadata& create_batch_metadata(const CuImage& image,
+                                                 uint16_t level,
+                                                 const std::vector<int64_t>& size,
+                                                 uint32_t batch_size)
+{
+    io::format::ImageMetadata& out_metadata = *(new io::format::ImageMetadata{});
+    auto& resource = out_metadata.get_resource();
+
+    const uint16_t ndim = batch_size > 1 ? 4 : 3;
+    std::pmr::vector<int64_t> shape(&resource);
+    std::pmr::vector<float> spacing(&resource);
+    std::pmr::vector<std::string_view> spacing_units(&resource);
+    if (batch_size > 1)
+    {
+        shape.emplace_back(batch_size);
+        spacing.emplace_back(1.0f);
+        spacing_units.emplace_back(std::string_view{ "batch" });
+    }
+    shape.insert(shape.end(), { size[1], size[0], image.size("C")[0] });
+    // Spacing of a level is that of the image scaled by the downsample factor of the level.
+    const float downsample = image.resolutions().level_downsample(level);
+    const auto image_spacing = image.spacing("YXC");
+    spacing.insert(spacing.end(), { image_spacing[0] / downsample, image_spacing[1] / downsample, image_spacing[2] });
+
+    auto copy_string = [&out_metadata](const std::string& str) {
+        char* str_ptr = static_cast<char*>(out_metadata.allocate(str.size() + 1));
+        memcpy(str_ptr, str.c_str(), str.size() + 1);
+        return std::string_view{ str_ptr, str.size() };
+    };
+    for (const auto& unit : image.spacing_units("YXC"))
+    {
+        spacing_units.emplace_back(copy_string(unit));
+    }
+    std::pmr::vector<std::string_view> channel_names(&resource);
+    for (const auto& name : image.channel_names())
+    {
+        channel_names.emplace_back(copy_string(name));
+    }
+
+    std::pmr::vector<float> origin(&resource);
+    const auto image_origin = image.origin();
+    origin.insert(origin.end(), image_origin.begin(), image_origin.end());
+    std::pmr::vector<float> direction(&resource);
+    for (const auto& row : image.direction())
+    {
+        direction.insert(direction.end(), row.begin(), row.end());
+    }
+    std::string_view coord_sys = copy_string(image.coord_sys());
+
+    std::pmr::vector<int64_t> level_dimensions(&resource);
+    level_dimensions.insert(level_dimensions.end(), size.begin(), size.end());
+    std::pmr::vector<float> level_downsamples(&resource);
+    level_downsamples.emplace_back(1.0f);
+    std::pmr::vector<uint32_t> level_tile_sizes(&resource);
+    level_tile_sizes.insert(level_tile_sizes.end(), size.begin(), size.end());
+
+    out_metadata.ndim(ndim);
+    out_metadata.dims(batch_size > 1 ? std::string_view{ "NYXC" } : std::string_view{ "YXC" });
+    out_metadata.shape(std::move(shape));
+    out_metadata.dtype(image.dtype());
+    out_metadata.channel_names(std::move(channel_names));
+    out_metadata.spacing(std::move(spacing));
+    out_metadata.spacing_units(std::move(spacing_units));
+    out_metadata.origin(std::move(origin));
+    out_metadata.direction(std::move(direction));
+    out_metadata.coord_sys(std::move(coord_sys));
+    out_metadata.level_count(1);
+    out_metadata.level_ndim(2);
+    out_metadata.level_dimensions(std::move(level_dimensions));
+    out_metadata.level_downsamples(std::move(level_downsamples));
+    out_metadata.level_tile_sizes(std::move(level_tile_sizes));
+    out_metadata.image_count(0);
+    out_metadata.image_names(std::pmr::vector<std::string_view>(&resource));
+    out_metadata.raw_data(std::string_view{ "" });
+    out_metadata.json_data(std::string_view{ "" });
+    return out_metadata;
+}
+
+} // namespace
+
+DatasetLoader::DatasetLoader(std::vector<std::string> paths, uint32_t max_open_files)
+    : files_(std::make_shared<FileCache>(std::move(paths), std::max(1U, max_open_files)))
+{
+}
+
+DatasetLoader::~DatasetLoader()
+{
+}
+
+const std::vector<std::string>& DatasetLoader::paths() const
+{
+    return files_->paths();
+}
+
+uint32_t DatasetLoader::max_open_files() const
+{
+    return files_->capacity();
+}
+
+size_t DatasetLoader::open_file_count() const
+{
+    return files_->open_count();
+}
+
+std::shared_ptr<CuImage> DatasetLoader::read(std::vector<DatasetSample> samples,
+                                             const std::vector<int64_t>& size,
+                                             uint32_t batch_size,
+                                             uint32_t num_workers,
+                                             bool drop_last,
+                                             uint32_t prefetch_factor,
+                                             bool shuffle,
+                                             uint64_t seed,
+                                             const io::Device& device) const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(dataset_loader_read));
+    if (samples.empty())
+    {
+        throw std::invalid_argument("[Error] No samples to read!");
+    }
+    if (size.size() != 2 || size[0] <= 0 || size[1] <= 0)
+    {
+        throw std::invalid_argument("[Error] The patch size should be (width, height)!");
+    }
+    const size_t file_count = files_->paths().size();
+    for (const auto& sample : samples)
+    {
+        if (sample.file_index >= file_count)
+        {
+            throw std::out_of_range(
+                fmt::format("[Error] File index {} is out of range (file count: {})!", sample.file_index, file_count));
+        }
+    }
+    if (device.type() != io::DeviceType::kCPU && device.type() != io::DeviceType::kCUDA)
+    {
+        throw std::invalid_argument(fmt::format("[Error] Device '{}' is not supported!", std::string(device)));
+    }
+    batch_size = std::max(1U, batch_size);
+    // Batches are delivered by the loader's iterator, which needs workers.
+    num_workers = std::max(1U, num_workers);
+
+    if (shuffle)
+    {
+        auto rng = std::default_random_engine{ seed };
+        std::shuffle(samples.begin(), samples.end(), rng);
+    }
+    uint64_t location_len = samples.size();
+    if (drop_last)
+    {
+        location_len -= location_len % batch_size;
+        if (location_len == 0)
+        {
+            throw std::invalid_argument("[Error] No samples left after dropping the last incomplete batch!");
+        }
+        samples.resize(location_len);
+    }
+    if (1 + prefetch_factor > location_len)
+    {
+        prefetch_factor = static_cast<uint32_t>(location_len - 1);
+    }
+
+    // The metadata of the first file determines the shape and data type of every patch (no patch is decoded here).
+    const std::shared_ptr<CuImage> first_image = files_->open(samples[0].file_index);
+    const uint16_t first_level = samples[0].level;
+    if (first_level >= first_image->resolutions().level_count())
+    {
+        throw std::invalid_argument(fmt::format(
+            "[Error] Level {} is out of range (file: {})!", first_level, files_->paths()[samples[0].file_index]));
+    }
+    const int64_t channel_count = first_image->size("C")[0];
+    const DLDataType patch_dtype = first_image->dtype();
+    const std::array<int64_t, 3> patch_shape{ size[1], size[0], channel_count };
+    const size_t one_raster_size =
+        static_cast<size_t>(size[0]) * size[1] * channel_count * ((patch_dtype.bits * patch_dtype.lanes + 7) / 8);
+
+    auto location = std::make_unique<std::vector<int64_t>>();
+    location->reserve(location_len * 2);
+    for (const auto& sample : samples)
+    {
+        location->insert(location->end(), { sample.x, sample.y });
+    }
+
+    auto load_func = [files = files_, samples = std::make_shared<const std::vector<DatasetSample>>(std::move(samples)),
+                      size, patch_shape, patch_dtype, one_raster_size,
+                      device_type = device.type()](ThreadBatchDataLoader* loader_ptr, uint64_t location_index) {
+        uint8_t* raster_ptr = loader_ptr->raster_pointer(location_index);
+        auto read_func = [files, samples, size, patch_shape, patch_dtype, one_raster_size, device_type, raster_ptr,
+                          location_index]() {
+            const DatasetSample& sample = (*samples)[location_index];
+            void* host_raster = nullptr;
+            try
+            {
+                std::shared_ptr<CuImage> image = files->open(sample.file_index);
+                if (image->size("C")[0] != patch_shape[2] || image->dtype() != patch_dtype)
+                {
+                    throw std::runtime_error("the number of channels or data type differs from the first file");
+                }
+
+                // Patches are decoded by the file's reader (through its tile cache) straight into the batch buffer,
+                // or into a host buffer copied to the batch buffer for CUDA.
+                host_raster = device_type == io::DeviceType::kCUDA ?
+                                  memory::buffer_pool().allocate(one_raster_size, io::DeviceType::kCPU) :
+                                  raster_ptr;
+                int64_t shape[3]{ patch_shape[0], patch_shape[1], patch_shape[2] };
+                DLTensor buf{};
+                buf.data = host_raster;
+                buf.device = DLDevice{ kDLCPU, 0 };
+                buf.ndim = 3;
+                buf.dtype = patch_dtype;
+                buf.shape = shape;
+                const int64_t location[2]{ sample.x, sample.y };
+                if (!image->read_region_to(location, size.data(), sample.level, buf))
+                {
+                    throw std::runtime_error("the reader failed or returned a patch unlike the first one");
+                }
+                if (device_type == io::DeviceType::kCUDA)
+                {
+                    cudaError_t cuda_status;
+                    CUDA_TRY(cudaMemcpy(raster_ptr, host_raster, one_raster_size, cudaMemcpyHostToDevice));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                fmt::print(stderr, "[Error] Failed to read the sample {} (file: {}, level: {}, x: {}, y: {}): {}\n",
+                           location_index, files->paths()[sample.file_index], sample.level, sample.x, sample.y,
+                           e.what());
+            }
+            if (host_raster && host_raster != raster_ptr)
+            {
+                memory::buffer_pool().release(host_raster, io::DeviceType::kCPU);
+            }
+        };
+        loader_ptr->enqueue(std::move(read_func), TileInfo{ static_cast<int64_t>(location_index), 0, 0, 0 });
+    };
+
+    auto loader = std::make_unique<ThreadBatchDataLoader>(
+        load_func, nullptr, device, std::move(location), std::make_unique<std::vector<int64_t>>(size), location_len,
+        one_raster_size, batch_size, prefetch_factor, num_workers);
+    const uint32_t load_size =
+        std::min(static_cast<uint64_t>(batch_size) * (1 + loader->prefetch_factor()), location_len);
+    loader->request(load_size);
+
+    // The batch image has no data until its iterator is advanced.
+    io::format::ImageMetadata& out_metadata = create_batch_metadata(*first_image, first_level, size, batch_size);
+    auto* out_image_data =
+        static_cast<io::format::ImageDataDesc*>(cucim_malloc(sizeof(io::format::ImageDataDesc)));
+    memset(out_image_data, 0, sizeof(io::format::ImageDataDesc));
+    auto& out_container = out_image_data->container;
+    const uint16_t ndim = out_metadata.desc().ndim;
+    out_container.ndim = ndim;
+    out_container.shape = static_cast<int64_t*>(cucim_malloc(sizeof(int64_t) * ndim));
+    memcpy(out_container.shape, out_metadata.desc().shape, sizeof(int64_t) * ndim);
+    out_container.dtype = patch_dtype;
+    out_container.device = DLDevice{ static_cast<DLDeviceType>(device.type()), device.index() };
+    out_image_data->loader = loader.release();
+
+    return std::make_shared<CuImage>(first_image.get(), &out_metadata.desc(), out_image_data);
+}
+
+} // namespace cucim::loader
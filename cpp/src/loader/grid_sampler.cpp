@@ -0,0 +1,332 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/loader/grid_sampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "cucim/cuimage.h"
+#include "cucim/profiler/nvtx3.h"
+
+namespace cucim::loader
+{
+
+namespace
+{
+
+uint8_t otsu_threshold(const std::array<uint64_t, 256>& histogram)
+{
+    uint64_t total = 0;
+    double total_sum = 0;
+    for (int i = 0; i < 256; ++i)
+    {
+        total += histogram[i];
+        total_sum += static_cast<double>(i) * histogram[i];
+    }
+
+    uint64_t background_weight = 0;
+    double background_sum = 0;
+    double max_variance = -1.0;
+    uint8_t threshold = 0;
+    for (int i = 0; i < 256; ++i)
+    {
+        background_weight += histogram[i];
+        if (background_weight == 0)
+        {
+            continue;
+        }
+        const uint64_t foreground_weight = total - background_weight;
+        if (foreground_weight == 0)
+        {
+            break;
+        }
+        background_sum += static_cast<double>(i) * histogram[i];
+        const double background_mean = background_sum / background_weight;
+        const double foreground_mean = (total_sum - background_sum) / foreground_weight;
+        const double mean_diff = background_mean - foreground_mean;
+        // Between-class variance
+        const double variance =
+            static_cast<double>(background_weight) * static_cast<double>(foreground_weight) * mean_diff * mean_diff;
+        if (variance > max_variance)
+        {
+            max_variance = variance;
+            threshold = static_cast<uint8_t>(i);
+        }
+    }
+    return threshold;
+}
+
+// Return the number of patches needed to cover `length` pixels.
+uint64_t grid_cell_count(int64_t length, int64_t size, int64_t stride)
+{
+    if (length <= size)
+    {
+        return 1;
+    }
+    return (length - size + stride - 1) / stride + 1;
+}
+
+} // namespace
+
+int64_t level_to_base(int64_t value, float downsample)
+{
+    // TIFF::read() maps level-0 locations to the level with `location /= downsample`, truncating the float result.
+    auto base = static_cast<int64_t>(std::ceil(static_cast<double>(value) * downsample));
+    while (base > 0 && static_cast<int64_t>((base - 1) / downsample) >= value)
+    {
+        --base;
+    }
+    while (static_cast<int64_t>(base / downsample) < value)
+    {
+        ++base;
+    }
+    return base;
+}
+
+TissueMask::TissueMask(std::vector<uint8_t> data, uint32_t width, uint32_t height)
+    : data_(std::move(data)), width_(width), height_(height)
+{
+    if (width_ == 0 || height_ == 0)
+    {
+        throw std::invalid_argument("The tissue mask should not be empty!");
+    }
+    if (data_.size() != static_cast<size_t>(width_) * height_)
+    {
+        throw std::invalid_argument(
+            fmt::format("The tissue mask has {} values but {}x{} are expected!", data_.size(), width_, height_));
+    }
+
+    const size_t stride = width_ + 1;
+    integral_.assign(stride * (height_ + 1), 0);
+    for (uint32_t y = 0; y < height_; ++y)
+    {
+        uint32_t row_sum = 0;
+        const uint8_t* row = &data_[static_cast<size_t>(y) * width_];
+        uint32_t* integral_row = &integral_[(y + 1) * stride];
+        const uint32_t* prev_integral_row = &integral_[y * stride];
+        for (uint32_t x = 0; x < width_; ++x)
+        {
+            row_sum += row[x] != 0;
+            integral_row[x + 1] = prev_integral_row[x + 1] + row_sum;
+        }
+    }
+}
+
+std::shared_ptr<TissueMask> TissueMask::from_image(const CuImage& image)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(tissue_mask_from_image));
+
+    const ResolutionInfo& res_info = image.resolutions();
+    const uint16_t level = res_info.level_count() - 1;
+    const auto level_dimension = res_info.level_dimension(level);
+    const int64_t width = level_dimension[0];
+    const int64_t height = level_dimension[1];
+
+    CuImage thumbnail = image.read_region({ 0, 0 }, { width, height }, level);
+    const DLDataType dtype = thumbnail.dtype();
+    const Shape shape = thumbnail.shape();
+    if (dtype.code != kDLUInt || dtype.bits != 8 || shape.size() != 3)
+    {
+        throw std::runtime_error("A tissue mask can only be computed from an 8-bit image with channels!");
+    }
+    const int64_t channels = shape[2];
+    const uint8_t* pixels = static_cast<const uint8_t*>(static_cast<DLTensor*>(thumbnail.container())->data);
+
+    // Tissue is saturated (stained) while the background is white or gray. For grayscale images, darkness is used.
+    const size_t pixel_count = static_cast<size_t>(width) * height;
+    std::vector<uint8_t> scores(pixel_count);
+    std::array<uint64_t, 256> histogram{};
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        const uint8_t* pixel = &pixels[i * channels];
+        uint8_t score;
+        if (channels >= 3)
+        {
+            const uint8_t max_value = std::max({ pixel[0], pixel[1], pixel[2] });
+            const uint8_t min_value = std::min({ pixel[0], pixel[1], pixel[2] });
+            score = max_value == 0 ? 0 : static_cast<uint8_t>((max_value - min_value) * 255 / max_value);
+        }
+        else
+        {
+            score = 255 - pixel[0];
+        }
+        scores[i] = score;
+        ++histogram[score];
+    }
+
+    const uint8_t threshold = otsu_threshold(histogram);
+    for (auto& score : scores)
+    {
+        score = score > threshold ? 1 : 0;
+    }
+    return std::make_shared<TissueMask>(std::move(scores), static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+}
+
+uint32_t TissueMask::width() const
+{
+    return width_;
+}
+
+uint32_t TissueMask::height() const
+{
+    return height_;
+}
+
+const std::vector<uint8_t>& TissueMask::data() const
+{
+    return data_;
+}
+
+double TissueMask::tissue_fraction(double left, double top, double right, double bottom) const
+{
+    if (right <= left || bottom <= top)
+    {
+        return 0.0;
+    }
+
+    // Mask pixels touched by the rectangle. Parts of the rectangle outside of the image count as background.
+    const double scale = std::clamp((std::min(right, 1.0) - std::max(left, 0.0)) / (right - left), 0.0, 1.0) *
+                         std::clamp((std::min(bottom, 1.0) - std::max(top, 0.0)) / (bottom - top), 0.0, 1.0);
+    if (scale <= 0.0)
+    {
+        return 0.0;
+    }
+    // (Bounds are rounded with a small tolerance so that rectangles aligned to mask pixels are not widened.)
+    constexpr double kEpsilon = 1e-6;
+    const auto x0 = static_cast<uint32_t>(std::clamp(std::floor(left * width_ + kEpsilon), 0.0, width_ - 1.0));
+    const auto y0 = static_cast<uint32_t>(std::clamp(std::floor(top * height_ + kEpsilon), 0.0, height_ - 1.0));
+    const auto x1 = std::max(
+        x0 + 1, static_cast<uint32_t>(std::clamp(std::ceil(right * width_ - kEpsilon), 0.0, 1.0 * width_)));
+    const auto y1 = std::max(
+        y0 + 1, static_cast<uint32_t>(std::clamp(std::ceil(bottom * height_ - kEpsilon), 0.0, 1.0 * height_)));
+
+    const size_t stride = width_ + 1;
+    const uint64_t tissue_count = static_cast<uint64_t>(integral_[y1 * stride + x1]) + integral_[y0 * stride + x0] -
+                                  integral_[y0 * stride + x1] - integral_[y1 * stride + x0];
+    const uint64_t area = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+    return scale * static_cast<double>(tissue_count) / static_cast<double>(area);
+}
+
+GridSampler::GridSampler(const CuImage& image,
+                         std::vector<int64_t> size,
+                         uint16_t level,
+                         std::vector<int64_t> stride,
+                         std::shared_ptr<const TissueMask> tissue_mask,
+                         float min_tissue_fraction)
+    : size_(std::move(size)),
+      level_(level),
+      stride_(std::move(stride)),
+      tissue_mask_(std::move(tissue_mask)),
+      min_tissue_fraction_(min_tissue_fraction)
+{
+    if (size_.size() != 2 || size_[0] <= 0 || size_[1] <= 0)
+    {
+        throw std::invalid_argument("size (patch size) should be two positive values!");
+    }
+    if (stride_.empty())
+    {
+        stride_ = size_;
+    }
+    if (stride_.size() != 2 || stride_[0] <= 0 || stride_[1] <= 0)
+    {
+        throw std::invalid_argument("stride should be two positive values!");
+    }
+    if (min_tissue_fraction_ < 0.0f || min_tissue_fraction_ > 1.0f)
+    {
+        throw std::invalid_argument("min_tissue_fraction should be in [0, 1]!");
+    }
+
+    const ResolutionInfo& res_info = image.resolutions();
+    if (level_ >= res_info.level_count())
+    {
+        throw std::invalid_argument(fmt::format("'level' should be less than {}", res_info.level_count()));
+    }
+    level_dimension_ = res_info.level_dimension(level_);
+    base_dimension_ = res_info.level_dimension(0);
+    level_downsample_ = res_info.level_downsample(level_);
+}
+
+const std::vector<int64_t>& GridSampler::size() const
+{
+    return size_;
+}
+
+uint16_t GridSampler::level() const
+{
+    return level_;
+}
+
+const std::vector<int64_t>& GridSampler::stride() const
+{
+    return stride_;
+}
+
+const std::shared_ptr<const TissueMask>& GridSampler::tissue_mask() const
+{
+    return tissue_mask_;
+}
+
+float GridSampler::min_tissue_fraction() const
+{
+    return min_tissue_fraction_;
+}
+
+uint64_t GridSampler::grid_count() const
+{
+    return grid_cell_count(level_dimension_[0], size_[0], stride_[0]) *
+           grid_cell_count(level_dimension_[1], size_[1], stride_[1]);
+}
+
+std::vector<int64_t> GridSampler::locations() const
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(grid_sampler_locations));
+
+    const int64_t level_width = level_dimension_[0];
+    const int64_t level_height = level_dimension_[1];
+    const uint64_t columns = grid_cell_count(level_width, size_[0], stride_[0]);
+    const uint64_t rows = grid_cell_count(level_height, size_[1], stride_[1]);
+
+    // Level-0 x coordinates are the same for every row.
+    std::vector<int64_t> base_xs(columns);
+    for (uint64_t column = 0; column < columns; ++column)
+    {
+        base_xs[column] = level_to_base(column * stride_[0], level_downsample_);
+    }
+
+    std::vector<int64_t> locations;
+    if (!tissue_mask_)
+    {
+        locations.reserve(columns * rows * 2);
+    }
+    for (uint64_t row = 0; row < rows; ++row)
+    {
+        const int64_t y = row * stride_[1];
+        const int64_t base_y = level_to_base(y, level_downsample_);
+        for (uint64_t column = 0; column < columns; ++column)
+        {
+            if (tissue_mask_)
+            {
+                const int64_t x = column * stride_[0];
+                const double fraction = tissue_mask_->tissue_fraction(
+                    static_cast<double>(x) / level_width, static_cast<double>(y) / level_height,
+                    static_cast<double>(x + size_[0]) / level_width, static_cast<double>(y + size_[1]) / level_height);
+                if (fraction < min_tissue_fraction_)
+                {
+                    continue;
+                }
+            }
+            locations.emplace_back(base_xs[column]);
+            locations.emplace_back(base_y);
+        }
+    }
+    return locations;
+}
+
+} // namespace cucim::loader
@@ -1,20 +1,33 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2025, NVIDIA CORPORATION
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "cucim/loader/thread_batch_data_loader.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include <fmt/format.h>
 
+#include "cucim/cuimage.h"
+#include "cucim/memory/buffer_pool.h"
 #include "cucim/profiler/nvtx3.h"
 #include "cucim/util/cuda.h"
 
 namespace cucim::loader
 {
 
+namespace
+{
+// A batch is considered ready if next_data() waited less than this for it.
+constexpr uint64_t kReadyBatchStallNs = 50'000;
+// The prefetch factor grows if the consumer waited for more than 1/kGrowStallRatio of the batch interval.
+constexpr uint64_t kGrowStallRatio = 10;
+// The prefetch factor shrinks after this many consecutive ready batches.
+constexpr uint32_t kShrinkReadyBatchCount = 4;
+} // namespace
+
 ThreadBatchDataLoader::ThreadBatchDataLoader(LoadFunc load_func,
                                              std::unique_ptr<BatchDataProcessor> batch_data_processor,
                                              const cucim::io::Device out_device,
@@ -44,38 +57,81 @@ ThreadBatchDataLoader::ThreadBatchDataLoader(LoadFunc load_func,
       current_data_(nullptr),
       current_data_batch_size_(0)
 {
-    buffer_item_len_ = std::min(static_cast<uint64_t>(location_len_), static_cast<uint64_t>(1 + prefetch_factor_)),
-
-    raster_data_.reserve(buffer_item_len_);
-    cucim::io::DeviceType device_type = out_device_.type();
-    for (size_t i = 0; i < buffer_item_len_; ++i)
+    // Prefetching adapts only when the workers of this loader load batches into its buffers (a batch data processor
+    // manages its own prefetching).
+    const auto& concurrency = cucim::CuImage::get_config()->concurrency();
+    adaptive_prefetch_ = num_workers_ > 0 && !batch_data_processor_ && concurrency.adaptive_prefetch;
+    if (adaptive_prefetch_)
     {
-        switch (device_type)
-        {
-        case io::DeviceType::kCPU:
-            raster_data_.emplace_back(static_cast<uint8_t*>(cucim_malloc(buffer_size_)));
-            break;
-        case io::DeviceType::kCUDA: {
-            cudaError_t cuda_status;
-            void* image_data_ptr = nullptr;
-            CUDA_ERROR(cudaMalloc(&image_data_ptr, buffer_size_));
-            raster_data_.emplace_back(static_cast<uint8_t*>(image_data_ptr));
-            break;
-        }
-        case io::DeviceType::kCUDAHost:
-        case io::DeviceType::kCUDAManaged:
-        case io::DeviceType::kCPUShared:
-        case io::DeviceType::kCUDAShared:
-            fmt::print(stderr, "Device type {} is not supported!\n", static_cast<int>(device_type));
-            break;
-        }
+        min_prefetch_factor_ = concurrency.min_prefetch_factor;
+        max_prefetch_factor_ = concurrency.max_prefetch_factor;
+        prefetch_factor_ = std::clamp(prefetch_factor_, min_prefetch_factor_, max_prefetch_factor_);
+    }
+    else
+    {
+        min_prefetch_factor_ = prefetch_factor_;
+        max_prefetch_factor_ = prefetch_factor_;
+    }
+    buffer_item_len_ =
+        std::min(static_cast<uint64_t>(location_len_), static_cast<uint64_t>(1 + max_prefetch_factor_));
+    // The ring of batch buffers bounds the number of batches in flight.
+    const uint32_t max_ring_prefetch_factor = static_cast<uint32_t>(buffer_item_len_ > 0 ? buffer_item_len_ - 1 : 0);
+    max_prefetch_factor_ = std::min(max_prefetch_factor_, max_ring_prefetch_factor);
+    min_prefetch_factor_ = std::min(min_prefetch_factor_, max_prefetch_factor_);
+    prefetch_factor_ = std::min(prefetch_factor_, max_prefetch_factor_);
+    stats_.prefetch_factor = prefetch_factor_;
+    stats_.peak_prefetch_factor = prefetch_factor_;
+    readahead_batches_ = concurrency.readahead_batches;
+
+    // Schedule windows only apply to tile plans and can't be larger than the number of batch buffers.
+    schedule_window_ = is_tile_plan_enabled() ? static_cast<uint32_t>(std::clamp(
+                                                    static_cast<size_t>(concurrency.schedule_window), size_t{ 1 },
+                                                    std::max(buffer_item_len_, size_t{ 1 }))) :
+                                                1;
+
+    // Buffers of the batches requested first are allocated here. Others are allocated when a batch is requested into
+    // their slot (see ensure_raster()).
+    raster_data_.resize(buffer_item_len_, nullptr);
+    const size_t initial_buffer_count = std::min(buffer_item_len_, static_cast<size_t>(1 + prefetch_factor_));
+    for (size_t i = 0; i < initial_buffer_count; ++i)
+    {
+        ensure_raster(i);
     }
 }
 
 ThreadBatchDataLoader::~ThreadBatchDataLoader()
 {
-    // Wait until all tasks are done.
-    while (wait_batch() > 0);
+    close();
+}
+
+void ThreadBatchDataLoader::cancel()
+{
+    if (cancellation_token_.is_cancelled())
+    {
+        return;
+    }
+    cancellation_token_.cancel();
+    tile_plan_.clear();
+    tile_plan_index_.clear();
+    // Wake up tasks waiting for tiles processed by the batch data processor.
+    if (batch_data_processor_)
+    {
+        stopped_ = true;
+        batch_data_processor_->shutdown();
+    }
+}
+
+void ThreadBatchDataLoader::close()
+{
+    cancel();
+
+    // Queued tasks return without loading once cancelled, so this only waits for the tasks that are running.
+    for (auto& task : tasks_)
+    {
+        task.wait();
+    }
+    tasks_.clear();
+    batch_item_counts_.clear();
 
     cucim::io::DeviceType device_type = out_device_.type();
     for (auto& raster_ptr : raster_data_)
@@ -83,17 +139,10 @@ ThreadBatchDataLoader::~ThreadBatchDataLoader()
         switch (device_type)
         {
         case io::DeviceType::kCPU:
-            if (raster_ptr)
-            {
-                cucim_free(raster_ptr);
-            }
-            break;
         case io::DeviceType::kCUDA:
-            cudaError_t cuda_status;
             if (raster_ptr)
             {
-                cuda_status = cudaSuccess;
-                CUDA_TRY(cudaFree(raster_ptr));
+                cucim::memory::buffer_pool().release(raster_ptr, device_type);
             }
             break;
         case io::DeviceType::kCUDAHost:
@@ -105,11 +154,11 @@ ThreadBatchDataLoader::~ThreadBatchDataLoader()
         }
         raster_ptr = nullptr;
     }
-    if (batch_data_processor_)
-    {
-        stopped_ = true;
-        batch_data_processor_->shutdown();
-    }
+}
+
+bool ThreadBatchDataLoader::is_cancelled() const
+{
+    return cancellation_token_.is_cancelled();
 }
 
 ThreadBatchDataLoader::operator bool() const
@@ -136,10 +185,10 @@ uint32_t ThreadBatchDataLoader::request(uint32_t load_size)
               num_workers_, load_size, queued_item_count_);
 #endif // DEBUG
 
-    if (num_workers_ == 0)
+    if (num_workers_ == 0 || cancellation_token_.is_cancelled())
     {
 #ifdef DEBUG
-        fmt::print("🔍 request(): num_workers==0, returning 0\n");
+        fmt::print("🔍 request(): num_workers==0 or cancelled, returning 0\n");
 #endif // DEBUG
         return 0;
     }
@@ -154,6 +203,10 @@ uint32_t ThreadBatchDataLoader::request(uint32_t load_size)
     fmt::print("🔍 request(): Will request {} items\n", num_items_to_request);
 #endif // DEBUG
 
+    // Hint the data of the requested batches and of the batches after them before their tasks are enqueued.
+    readahead(queued_item_count_ + num_items_to_request + static_cast<uint64_t>(readahead_batches_) * batch_size_);
+
+    uint32_t window_item_count = 0;
     for (uint32_t i = 0; i < num_items_to_request; ++i)
     {
         uint32_t last_item_count = 0;
@@ -164,6 +217,7 @@ uint32_t ThreadBatchDataLoader::request(uint32_t load_size)
 #ifdef DEBUG
         fmt::print("🔍 request(): Calling load_func for item {} (location_index={})\n", i, queued_item_count_);
 #endif // DEBUG
+        ensure_raster((queued_item_count_ / batch_size_) % buffer_item_len_);
         load_func_(this, queued_item_count_);
 #ifdef DEBUG
         fmt::print("🔍 request(): load_func returned, tasks added: {}\n", tasks_.size() - last_item_count);
@@ -172,6 +226,23 @@ uint32_t ThreadBatchDataLoader::request(uint32_t load_size)
         buffer_item_tail_index_ = queued_item_count_ % buffer_item_len_;
         // Append the number of added tasks to the batch count list.
         batch_item_counts_.emplace_back(tasks_.size() - last_item_count);
+
+        ++window_item_count;
+        if (window_item_count == batch_size_ * schedule_window_ || queued_item_count_ == location_len_ ||
+            i + 1 == num_items_to_request)
+        {
+            // All tasks of the schedule window are counted as the tasks of its first item so that the first batch
+            // of the window waits for all tiles of the window.
+            uint32_t window_task_count = flush_tile_plan();
+            const size_t window_start = batch_item_counts_.size() - window_item_count;
+            for (size_t item = window_start; item < batch_item_counts_.size(); ++item)
+            {
+                window_task_count += batch_item_counts_[item];
+                batch_item_counts_[item] = 0;
+            }
+            batch_item_counts_[window_start] = window_task_count;
+            window_item_count = 0;
+        }
     }
 
     if (batch_data_processor_)
@@ -258,12 +329,12 @@ uint8_t* ThreadBatchDataLoader::next_data()
         return batch_raster_ptr;
     }
 
-    if (processed_batch_count_ * batch_size_ >= location_len_)
+    if (processed_batch_count_ * batch_size_ >= location_len_ || cancellation_token_.is_cancelled())
     {
 #ifdef DEBUG
-        fmt::print("🔍 next_data(): All batches processed, returning nullptr\n");
+        fmt::print("🔍 next_data(): All batches processed or cancelled, returning nullptr\n");
 #endif // DEBUG
-        // If all batches are processed, return nullptr.
+        // If all batches are processed or loading is cancelled, return nullptr.
         return nullptr;
     }
 
@@ -271,24 +342,74 @@ uint8_t* ThreadBatchDataLoader::next_data()
 #ifdef DEBUG
     fmt::print("🔍 next_data(): About to call wait_batch()\n");
 #endif // DEBUG
+    const auto wait_start = std::chrono::steady_clock::now();
     wait_batch();
+    const auto wait_end = std::chrono::steady_clock::now();
 #ifdef DEBUG
     fmt::print("🔍 next_data(): wait_batch() completed\n");
 #endif // DEBUG
 
+    const uint64_t stall_ns =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait_end - wait_start).count());
+    if (stall_ns > kReadyBatchStallNs)
+    {
+        ++stats_.stall_count;
+        stats_.stall_time_ns += stall_ns;
+    }
+    // The time the consumer spent on the previous batch is unknown for the first batch.
+    if (adaptive_prefetch_ && stats_.batch_count > 0)
+    {
+        const uint64_t consume_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wait_start - last_delivery_time_).count());
+        adapt_prefetch_factor(stall_ns, consume_ns);
+    }
+    ++stats_.batch_count;
+
     uint8_t* batch_raster_ptr = raster_data_[buffer_item_head_index_];
 
+    // The ownership of the buffer is passed to the caller. A new buffer is allocated for the slot when a later batch
+    // is requested into it.
+    raster_data_[buffer_item_head_index_] = nullptr;
+
+    buffer_item_head_index_ = (buffer_item_head_index_ + 1) % buffer_item_len_;
+
+    current_data_ = batch_raster_ptr;
+    current_data_batch_size_ =
+        std::min(location_len_ - (processed_batch_count_ * batch_size_), static_cast<uint64_t>(batch_size_));
+
+    ++processed_batch_count_;
+
+    // Prepare the next batches. Batches of a schedule window are requested together once enough buffers are free.
+    // The number of batches in flight may exceed the target if the prefetch factor just shrank.
+    const uint64_t queued_batch_count = (queued_item_count_ + batch_size_ - 1) / batch_size_;
+    const uint64_t in_flight_batch_count = queued_batch_count - processed_batch_count_;
+    const uint64_t target_batch_count = std::min<uint64_t>(1 + prefetch_factor_, buffer_item_len_);
+    const uint64_t free_buffer_count =
+        target_batch_count > in_flight_batch_count ? target_batch_count - in_flight_batch_count : 0;
+    const uint64_t remaining_batch_count = total_batch_count() - queued_batch_count;
+    const uint64_t schedule_window = std::min<uint64_t>(schedule_window_, target_batch_count);
+    if (remaining_batch_count == 0 || free_buffer_count >= std::min(schedule_window, remaining_batch_count))
+    {
+        request(static_cast<uint32_t>(batch_size_ * free_buffer_count));
+    }
+    last_delivery_time_ = std::chrono::steady_clock::now();
+    return batch_raster_ptr;
+}
+
+void ThreadBatchDataLoader::ensure_raster(const size_t buffer_item_index)
+{
+    if (raster_data_[buffer_item_index])
+    {
+        return;
+    }
     cucim::io::DeviceType device_type = out_device_.type();
     switch (device_type)
     {
     case io::DeviceType::kCPU:
-        raster_data_[buffer_item_head_index_] = static_cast<uint8_t*>(cucim_malloc(buffer_size_));
+    case io::DeviceType::kCUDA:
+        raster_data_[buffer_item_index] =
+            static_cast<uint8_t*>(cucim::memory::buffer_pool().allocate(buffer_size_, device_type));
         break;
-    case io::DeviceType::kCUDA: {
-        cudaError_t cuda_status;
-        CUDA_ERROR(cudaMalloc(&raster_data_[buffer_item_head_index_], buffer_size_));
-        break;
-    }
     case io::DeviceType::kCUDAHost:
     case io::DeviceType::kCUDAManaged:
     case io::DeviceType::kCPUShared:
@@ -296,18 +417,99 @@ uint8_t* ThreadBatchDataLoader::next_data()
         fmt::print(stderr, "Device type {} is not supported!\n", static_cast<int>(device_type));
         break;
     }
+}
 
-    buffer_item_head_index_ = (buffer_item_head_index_ + 1) % buffer_item_len_;
+void ThreadBatchDataLoader::adapt_prefetch_factor(const uint64_t stall_ns, const uint64_t consume_ns)
+{
+    // The batch interval seen by the consumer is the time it spent on the previous batch plus the time it waited for
+    // this one. If waiting takes a noticeable share of the interval, the workers deliver batches slower than they are
+    // consumed, so more batches are loaded ahead. If batches are ready several times in a row, the consumer is the
+    // bottleneck and fewer batch buffers are held.
+    const uint64_t interval_ns = stall_ns + consume_ns;
+    if (stall_ns > kReadyBatchStallNs && stall_ns * kGrowStallRatio > interval_ns)
+    {
+        ready_batch_streak_ = 0;
+        if (prefetch_factor_ < max_prefetch_factor_)
+        {
+            ++prefetch_factor_;
+        }
+    }
+    else if (stall_ns <= kReadyBatchStallNs)
+    {
+        if (++ready_batch_streak_ >= kShrinkReadyBatchCount && prefetch_factor_ > min_prefetch_factor_)
+        {
+            --prefetch_factor_;
+            ready_batch_streak_ = 0;
+        }
+    }
+    else
+    {
+        ready_batch_streak_ = 0;
+    }
+    stats_.prefetch_factor = prefetch_factor_;
+    stats_.peak_prefetch_factor = std::max(stats_.peak_prefetch_factor, prefetch_factor_);
+}
 
-    current_data_ = batch_raster_ptr;
-    current_data_batch_size_ =
-        std::min(location_len_ - (processed_batch_count_ * batch_size_), static_cast<uint64_t>(batch_size_));
+bool ThreadBatchDataLoader::is_tile_plan_enabled() const
+{
+    return num_workers_ > 0 && !batch_data_processor_ && out_device_.type() == io::DeviceType::kCPU;
+}
 
-    ++processed_batch_count_;
+void ThreadBatchDataLoader::plan_tile(const uint64_t tile_index,
+                                      TileLoadFunc load_func,
+                                      TileCopyFunc copy_func,
+                                      const uint64_t order_key)
+{
+    auto [it, inserted] = tile_plan_index_.try_emplace(tile_index, tile_plan_.size());
+    if (inserted)
+    {
+        tile_plan_.push_back(PlannedTile{ order_key, std::move(load_func), {} });
+    }
+    tile_plan_[it->second].copy_funcs.emplace_back(std::move(copy_func));
+}
 
-    // Prepare the next batch
-    request(batch_size_);
-    return batch_raster_ptr;
+void ThreadBatchDataLoader::set_readahead_func(ReadaheadFunc func)
+{
+    readahead_func_ = std::move(func);
+}
+
+void ThreadBatchDataLoader::readahead(uint64_t location_end)
+{
+    location_end = std::min(location_end, location_len_);
+    if (!readahead_func_ || readahead_batches_ == 0 || location_end <= readahead_item_count_)
+    {
+        return;
+    }
+    stats_.readahead_bytes += readahead_func_(readahead_item_count_, location_end);
+    stats_.readahead_count += location_end - readahead_item_count_;
+    readahead_item_count_ = location_end;
+}
+
+uint32_t ThreadBatchDataLoader::flush_tile_plan()
+{
+    PROF_SCOPED_RANGE(PROF_EVENT(thread_batch_data_loader_flush_tile_plan));
+    const uint32_t task_count = static_cast<uint32_t>(tile_plan_.size());
+    // Tiles with the same key keep the order of the patches.
+    std::stable_sort(tile_plan_.begin(), tile_plan_.end(),
+                     [](const PlannedTile& a, const PlannedTile& b) { return a.order_key < b.order_key; });
+    for (auto& planned_tile : tile_plan_)
+    {
+        auto task = [planned_tile = std::move(planned_tile), token = cancellation_token_]() {
+            if (token.is_cancelled())
+            {
+                return;
+            }
+            std::shared_ptr<uint8_t> tile_data = planned_tile.load_func();
+            for (auto& copy_func : planned_tile.copy_funcs)
+            {
+                copy_func(tile_data.get());
+            }
+        };
+        tasks_.emplace_back(thread_pool_.enqueue(std::move(task), cucim::concurrent::TaskPriority::kLow));
+    }
+    tile_plan_.clear();
+    tile_plan_index_.clear();
+    return task_count;
 }
 
 BatchDataProcessor* ThreadBatchDataLoader::batch_data_processor()
@@ -355,6 +557,16 @@ uint32_t ThreadBatchDataLoader::data_batch_size() const
     return current_data_batch_size_;
 }
 
+uint32_t ThreadBatchDataLoader::prefetch_factor() const
+{
+    return prefetch_factor_;
+}
+
+LoaderStats ThreadBatchDataLoader::stats() const
+{
+    return stats_;
+}
+
 bool ThreadBatchDataLoader::enqueue(std::function<void()> task, const TileInfo& tile)
 {
 #ifdef DEBUG
@@ -369,7 +581,16 @@ bool ThreadBatchDataLoader::enqueue(std::function<void()> task, const TileInfo&
         fmt::print("🔍 enqueue(): About to enqueue task to thread pool\n");
         fflush(stdout);
 #endif // DEBUG
-        auto future = thread_pool_.enqueue(task);
+        // Loader work is background work: interactive reads sharing the executor are started first.
+        auto future = thread_pool_.enqueue(
+            [task = std::move(task), token = cancellation_token_]() {
+                if (token.is_cancelled())
+                {
+                    return;
+                }
+                task();
+            },
+            cucim::concurrent::TaskPriority::kLow);
 #ifdef DEBUG
         fmt::print("🔍 enqueue(): Task enqueued, adding future to tasks_\n");
         fflush(stdout);
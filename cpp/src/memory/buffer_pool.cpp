@@ -0,0 +1,271 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/memory/buffer_pool.h"
+
+#include <new>
+
+#include <cuda_runtime.h>
+#include <fmt/format.h>
+
+#include "cucim/cache/image_cache_config.h"
+#include "cucim/concurrent/threadpool.h"
+#include "cucim/cuimage.h"
+#include "cucim/memory/memory_manager.h"
+#include "cucim/profiler/nvtx3.h"
+#include "cucim/util/cuda.h"
+#include "cucim/util/numa.h"
+
+namespace cucim::memory
+{
+
+BufferPool::BufferPool(uint64_t capacity_nbytes) : capacity_nbytes_(capacity_nbytes)
+{
+}
+
+BufferPool::~BufferPool()
+{
+    clear();
+}
+
+size_t BufferPool::bucket_size(size_t size)
+{
+    constexpr size_t kMinBucketSize = 4096;
+    if (size <= kMinBucketSize)
+    {
+        return kMinBucketSize;
+    }
+    // Round up to a multiple of 1/8 of the largest power of two not greater than `size`.
+    const size_t step = (size_t{ 1 } << (63 - __builtin_clzll(size))) >> 3;
+    return (size + step - 1) & ~(step - 1);
+}
+
+void* BufferPool::allocate(size_t size, cucim::io::DeviceType device_type)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT_P(buffer_pool_allocate, size));
+    int device_index = -1;
+    switch (device_type)
+    {
+    case cucim::io::DeviceType::kCPU:
+        break;
+    case cucim::io::DeviceType::kCUDA: {
+        cudaError_t cuda_status;
+        CUDA_ERROR(cudaGetDevice(&device_index));
+        break;
+    }
+    default:
+        throw std::invalid_argument(
+            fmt::format("Device type {} is not supported by the buffer pool!", static_cast<int>(device_type)));
+    }
+
+    BucketKey key{ bucket_size(size), device_index };
+    if (device_index < 0 && cucim::concurrent::ThreadPool::is_numa_enabled())
+    {
+        key.numa_node = cucim::util::numa_current_node();
+    }
+    return allocate_buffer(key);
+}
+
+void* BufferPool::allocate_on_node(size_t size, int numa_node)
+{
+    PROF_SCOPED_RANGE(PROF_EVENT_P(buffer_pool_allocate, size));
+    return allocate_buffer(BucketKey{ bucket_size(size), -1, numa_node < 0 ? -1 : numa_node });
+}
+
+void* BufferPool::allocate_buffer(const BucketKey& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = idle_buffers_.find(key);
+        if (it != idle_buffers_.end() && !it->second.empty())
+        {
+            void* ptr = it->second.back();
+            it->second.pop_back();
+            idle_nbytes_ -= key.size;
+            used_buffers_.emplace(ptr, key);
+            ++hit_count_;
+            return ptr;
+        }
+        ++miss_count_;
+    }
+
+    void* ptr = nullptr;
+    if (key.device_index < 0)
+    {
+        ptr = cucim_malloc(key.size);
+        if (!ptr)
+        {
+            throw std::bad_alloc();
+        }
+        if (key.numa_node >= 0)
+        {
+            // Pages are placed on first touch, which is usually done by loader workers on other nodes.
+            cucim::util::numa_prefer_memory(ptr, key.size, key.numa_node);
+        }
+    }
+    else
+    {
+        cudaError_t cuda_status;
+        CUDA_ERROR(cudaMalloc(&ptr, key.size));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    used_buffers_.emplace(ptr, key);
+    return ptr;
+}
+
+void BufferPool::release(void* ptr, cucim::io::DeviceType device_type)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    PROF_SCOPED_RANGE(PROF_EVENT(buffer_pool_release));
+    int device_index = -1;
+    bool is_pool_buffer = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = used_buffers_.find(ptr);
+        if (it != used_buffers_.end())
+        {
+            const BucketKey key = it->second;
+            used_buffers_.erase(it);
+            if (idle_nbytes_ + key.size <= capacity_nbytes_)
+            {
+                idle_buffers_[key].push_back(ptr);
+                idle_nbytes_ += key.size;
+                return;
+            }
+            // Free it outside of the lock
+            device_index = key.device_index;
+            is_pool_buffer = true;
+        }
+    }
+
+    if (!is_pool_buffer && device_type == cucim::io::DeviceType::kCUDA)
+    {
+        // The pointer was not allocated by the pool: free it on the device that owns it.
+        device_index = cuda_device_of(ptr);
+        if (device_index < 0)
+        {
+            fmt::print(stderr, "[Error] Cannot release {} which is not CUDA device memory!\n", ptr);
+            return;
+        }
+    }
+    free_buffer(ptr, device_index);
+}
+
+void BufferPool::clear()
+{
+    trim(0);
+}
+
+uint64_t BufferPool::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_nbytes_;
+}
+
+void BufferPool::capacity(uint64_t capacity_nbytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_nbytes_ = capacity_nbytes;
+    }
+    trim(capacity_nbytes);
+}
+
+uint64_t BufferPool::idle_nbytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_nbytes_;
+}
+
+uint64_t BufferPool::hit_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hit_count_;
+}
+
+uint64_t BufferPool::miss_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return miss_count_;
+}
+
+void BufferPool::trim(uint64_t capacity_nbytes)
+{
+    std::vector<std::pair<void*, int>> buffers_to_free;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Free larger buffers first
+        for (auto it = idle_buffers_.rbegin(); it != idle_buffers_.rend() && idle_nbytes_ > capacity_nbytes; ++it)
+        {
+            auto& buffers = it->second;
+            while (!buffers.empty() && idle_nbytes_ > capacity_nbytes)
+            {
+                buffers_to_free.emplace_back(buffers.back(), it->first.device_index);
+                buffers.pop_back();
+                idle_nbytes_ -= it->first.size;
+            }
+        }
+    }
+    for (auto& [ptr, device_index] : buffers_to_free)
+    {
+        free_buffer(ptr, device_index);
+    }
+}
+
+int BufferPool::cuda_device_of(const void* ptr)
+{
+    cudaPointerAttributes attributes{};
+    if (cudaPointerGetAttributes(&attributes, ptr) != cudaSuccess)
+    {
+        cudaGetLastError(); // Reset the error of an unknown pointer.
+        return -1;
+    }
+    if (attributes.type != cudaMemoryTypeDevice && attributes.type != cudaMemoryTypeManaged)
+    {
+        return -1;
+    }
+    return attributes.device;
+}
+
+void BufferPool::free_buffer(void* ptr, int device_index)
+{
+    if (device_index < 0)
+    {
+        cucim_free(ptr);
+    }
+    else
+    {
+        cudaError_t cuda_status;
+        int current_device = device_index;
+        CUDA_TRY(cudaGetDevice(&current_device));
+        if (current_device != device_index)
+        {
+            CUDA_TRY(cudaSetDevice(device_index));
+        }
+        CUDA_TRY(cudaFree(ptr));
+        if (current_device != device_index)
+        {
+            CUDA_TRY(cudaSetDevice(current_device));
+        }
+    }
+}
+
+BufferPool& buffer_pool()
+{
+    // Intentionally leaked: buffers may be released by objects destroyed after static destruction of the pool.
+    static BufferPool* pool = []() {
+        cucim::config::Config* config = cucim::CuImage::get_config();
+        const uint64_t memory_capacity =
+            config ? config->buffer_pool().memory_capacity : kDefaultBufferPoolMemoryCapacity;
+        return new BufferPool(memory_capacity * cucim::cache::kOneMiB);
+    }();
+    return *pool;
+}
+
+} // namespace cucim::memory
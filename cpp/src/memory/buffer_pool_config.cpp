@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/memory/buffer_pool_config.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace cucim::memory
+{
+
+void BufferPoolConfig::load_config(const void* json_obj)
+{
+    const json& buffer_pool_config = *(static_cast<const json*>(json_obj));
+
+    if (buffer_pool_config.contains("memory_capacity") && buffer_pool_config["memory_capacity"].is_number_unsigned())
+    {
+        memory_capacity = buffer_pool_config.value("memory_capacity", kDefaultBufferPoolMemoryCapacity);
+    }
+    if (buffer_pool_config.contains("bounce_buffer_size") &&
+        buffer_pool_config["bounce_buffer_size"].is_number_unsigned())
+    {
+        bounce_buffer_size = buffer_pool_config.value("bounce_buffer_size", kDefaultBounceBufferSize);
+    }
+    if (buffer_pool_config.contains("bounce_buffer_count") &&
+        buffer_pool_config["bounce_buffer_count"].is_number_unsigned())
+    {
+        bounce_buffer_count = buffer_pool_config.value("bounce_buffer_count", kDefaultBounceBufferCount);
+    }
+}
+
+} // namespace cucim::memory
@@ -13,6 +13,7 @@
 #include <fmt/format.h>
 
 #include "cucim/io/device_type.h"
+#include "cucim/memory/buffer_pool.h"
 #include "cucim/profiler/nvtx3.h"
 #include "cucim/util/cuda.h"
 
@@ -84,7 +85,7 @@ CUCIM_API bool move_raster_from_host(void** target, size_t size, const cucim::io
         {
             throw std::bad_alloc();
         }
-        cucim_free(host_mem);
+        cucim::memory::buffer_pool().release(host_mem, cucim::io::DeviceType::kCPU);
         *target = cuda_mem;
         break;
     }
@@ -107,7 +108,7 @@ CUCIM_API bool move_raster_from_device(void** target, size_t size, const cucim::
         {
             throw std::bad_alloc();
         }
-        cudaFree(cuda_mem);
+        cucim::memory::buffer_pool().release(cuda_mem, cucim::io::DeviceType::kCUDA);
         *target = host_mem;
         break;
     }
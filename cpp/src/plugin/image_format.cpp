@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -36,7 +36,8 @@ cucim::io::format::ImageFormatDesc* ImageFormat::detect_image_format(const cucim
     PROF_SCOPED_RANGE(PROF_EVENT(cucim_plugin_detect_image_format));
     for (auto& format : image_formats_)
     {
-        if (format->image_checker.is_valid(path.c_str(), nullptr, 0))
+        // Formats that can only be written are skipped.
+        if (format->image_parser.open && format->image_checker.is_valid(path.c_str(), nullptr, 0))
         {
             return format;
         }
@@ -44,4 +45,16 @@ cucim::io::format::ImageFormatDesc* ImageFormat::detect_image_format(const cucim
     throw std::invalid_argument(fmt::format("Cannot find a plugin to handle '{}'!", path));
 }
 
+cucim::io::format::ImageFormatDesc* ImageFormat::detect_image_writer(const cucim::filesystem::Path& path)
+{
+    for (auto& format : image_formats_)
+    {
+        if (format->image_writer.write && format->image_checker.is_valid(path.c_str(), nullptr, 0))
+        {
+            return format;
+        }
+    }
+    throw std::invalid_argument(fmt::format("Cannot find a plugin to write '{}'!", path));
+}
+
 } // namespace cucim::plugin
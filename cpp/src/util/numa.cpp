@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/util/numa.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace cucim::util
+{
+
+namespace
+{
+
+std::vector<int> read_id_list(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string list;
+    if (!file || !std::getline(file, list))
+    {
+        return {};
+    }
+    return parse_numa_id_list(list);
+}
+
+} // namespace
+
+std::vector<int> parse_numa_id_list(const std::string& list)
+{
+    std::vector<int> ids;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        try
+        {
+            const size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+            for (int id = first; id <= last; ++id)
+            {
+                ids.push_back(id);
+            }
+        }
+        catch (const std::exception&)
+        {
+            return {};
+        }
+    }
+    return ids;
+}
+
+const std::vector<int>& numa_nodes()
+{
+    static const std::vector<int> nodes = []() {
+        std::vector<int> online = read_id_list("/sys/devices/system/node/online");
+        if (online.empty())
+        {
+            online.push_back(0);
+        }
+        return online;
+    }();
+    return nodes;
+}
+
+int numa_current_node()
+{
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+bool numa_bind_current_thread(int node)
+{
+    const std::vector<int> cpus = read_id_list(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    if (cpus.empty())
+    {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+}
+
+bool numa_prefer_memory(void* ptr, size_t size, int node)
+{
+    constexpr unsigned long kNodeMaskBits = sizeof(unsigned long) * 8;
+    if (!ptr || size == 0 || node < 0 || static_cast<unsigned long>(node) >= kNodeMaskBits)
+    {
+        return false;
+    }
+    // mbind() needs a page-aligned start address.
+    const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto start = reinterpret_cast<uintptr_t>(ptr);
+    const uintptr_t aligned_start = (start + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = start + size;
+    if (aligned_start >= end)
+    {
+        return false;
+    }
+    // The kernel reads `maxnode - 1` bits of the mask, so one bit more than the nodes of the first word is passed (the
+    // second word is zero).
+    const unsigned long node_mask[2] = { 1UL << node, 0 };
+    return syscall(SYS_mbind, aligned_start, end - aligned_start, MPOL_PREFERRED, node_mask, kNodeMaskBits + 1, 0) == 0;
+}
+
+} // namespace cucim::util
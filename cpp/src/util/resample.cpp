@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cucim/util/resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace cucim::util
+{
+
+AreaResampler::AreaResampler(double scale, double offset_x, double offset_y, int64_t out_width, int64_t out_height)
+{
+    if (!(scale >= 1.0))
+    {
+        throw std::invalid_argument(fmt::format("The resampling scale should be >= 1 but {} is used.", scale));
+    }
+    if (offset_x < 0.0 || offset_y < 0.0 || out_width <= 0 || out_height <= 0)
+    {
+        throw std::invalid_argument("Invalid resampling offset or output size!");
+    }
+    build_spans(scale, offset_x, out_width, column_spans_, column_weights_);
+    build_spans(scale, offset_y, out_height, row_spans_, row_weights_);
+}
+
+void AreaResampler::build_spans(
+    double scale, double offset, int64_t count, std::vector<Span>& spans, std::vector<float>& weights)
+{
+    // (Bounds are rounded with a small tolerance so that pixels covered by a rounding error are not used.)
+    constexpr double kEpsilon = 1e-6;
+    spans.resize(count);
+    weights.clear();
+    weights.reserve(static_cast<size_t>(count * (std::ceil(scale) + 1)));
+    for (int64_t i = 0; i < count; ++i)
+    {
+        const double start = offset + i * scale;
+        const double end = start + scale;
+        Span& span = spans[i];
+        span.begin = static_cast<int64_t>(std::floor(start + kEpsilon));
+        span.end = std::max(span.begin + 1, static_cast<int64_t>(std::ceil(end - kEpsilon)));
+        span.weight_offset = weights.size();
+        for (int64_t pixel = span.begin; pixel < span.end; ++pixel)
+        {
+            const double coverage = std::min<double>(pixel + 1, end) - std::max<double>(pixel, start);
+            weights.push_back(static_cast<float>(std::max(coverage, 0.0) / scale));
+        }
+    }
+}
+
+int64_t AreaResampler::out_width() const
+{
+    return static_cast<int64_t>(column_spans_.size());
+}
+
+int64_t AreaResampler::out_height() const
+{
+    return static_cast<int64_t>(row_spans_.size());
+}
+
+int64_t AreaResampler::source_width() const
+{
+    return column_spans_.back().end;
+}
+
+std::pair<int64_t, int64_t> AreaResampler::source_rows(int64_t out_row_begin, int64_t out_row_end) const
+{
+    return { row_spans_[out_row_begin].begin, row_spans_[out_row_end - 1].end };
+}
+
+void AreaResampler::resample_rows(const uint8_t* src,
+                                  int64_t src_row_begin,
+                                  size_t src_stride,
+                                  uint8_t* out,
+                                  size_t out_stride,
+                                  int64_t out_row_begin,
+                                  int64_t out_row_end,
+                                  int64_t channels) const
+{
+    const size_t row_length = static_cast<size_t>(source_width()) * channels;
+    const int64_t width = out_width();
+    std::vector<float> row_sum(row_length);
+    std::vector<float> pixel(channels);
+
+    for (int64_t out_row = out_row_begin; out_row < out_row_end; ++out_row, out += out_stride)
+    {
+        // Vertical pass: weighted sum of the source rows of the output row.
+        const Span& row_span = row_spans_[out_row];
+        std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+        float* __restrict sum = row_sum.data();
+        for (int64_t row = row_span.begin; row < row_span.end; ++row)
+        {
+            const float weight = row_weights_[row_span.weight_offset + (row - row_span.begin)];
+            const uint8_t* __restrict src_row = src + (row - src_row_begin) * src_stride;
+            for (size_t i = 0; i < row_length; ++i)
+            {
+                sum[i] += weight * src_row[i];
+            }
+        }
+
+        // Horizontal pass: weighted sum of the columns of each output pixel.
+        for (int64_t x = 0; x < width; ++x)
+        {
+            const Span& column_span = column_spans_[x];
+            const float* column_weight = &column_weights_[column_span.weight_offset];
+            std::fill(pixel.begin(), pixel.end(), 0.0f);
+            for (int64_t column = column_span.begin; column < column_span.end; ++column, ++column_weight)
+            {
+                const float* value = &sum[column * channels];
+                for (int64_t c = 0; c < channels; ++c)
+                {
+                    pixel[c] += *column_weight * value[c];
+                }
+            }
+            uint8_t* out_pixel = &out[x * channels];
+            for (int64_t c = 0; c < channels; ++c)
+            {
+                out_pixel[c] = static_cast<uint8_t>(std::min(pixel[c] + 0.5f, 255.0f));
+            }
+        }
+    }
+}
+
+} // namespace cucim::util
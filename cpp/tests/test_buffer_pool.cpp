@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cuda_runtime.h>
+#include <fmt/format.h>
+
+#include "cucim/memory/buffer_pool.h"
+#include "cucim/util/cuda.h"
+
+TEST_CASE("Buffer pool rounds sizes up to buckets", "[test_buffer_pool.cpp]")
+{
+    REQUIRE(cucim::memory::BufferPool::bucket_size(1) == 4096);
+    REQUIRE(cucim::memory::BufferPool::bucket_size(4096) == 4096);
+
+    const size_t size = 3 * 1024 * 1024 + 1;
+    const size_t bucket = cucim::memory::BufferPool::bucket_size(size);
+    REQUIRE(bucket >= size);
+    REQUIRE(bucket <= size + size / 8);
+}
+
+TEST_CASE("Buffer pool reuses released CPU buffers", "[test_buffer_pool.cpp]")
+{
+    cucim::memory::BufferPool pool(64 * 1024 * 1024);
+
+    void* first = pool.allocate(1000000, cucim::io::DeviceType::kCPU);
+    REQUIRE(first != nullptr);
+    REQUIRE(pool.miss_count() == 1);
+
+    pool.release(first, cucim::io::DeviceType::kCPU);
+    REQUIRE(pool.idle_nbytes() == cucim::memory::BufferPool::bucket_size(1000000));
+
+    // A request in the same bucket reuses the idle buffer.
+    void* second = pool.allocate(999999, cucim::io::DeviceType::kCPU);
+    REQUIRE(second == first);
+    REQUIRE(pool.hit_count() == 1);
+    REQUIRE(pool.idle_nbytes() == 0);
+
+    pool.release(second, cucim::io::DeviceType::kCPU);
+    pool.capacity(0);
+    REQUIRE(pool.idle_nbytes() == 0);
+}
+
+TEST_CASE("Buffer pool reuses CPU buffers of the same NUMA node", "[test_buffer_pool.cpp]")
+{
+    cucim::memory::BufferPool pool(64 * 1024 * 1024);
+
+    void* node0 = pool.allocate_on_node(1000000, 0);
+    pool.release(node0, cucim::io::DeviceType::kCPU);
+
+    // An idle buffer of another node is not reused.
+    void* node1 = pool.allocate_on_node(1000000, 1);
+    REQUIRE(node1 != node0);
+    REQUIRE(pool.hit_count() == 0);
+    REQUIRE(pool.miss_count() == 2);
+
+    void* reused = pool.allocate_on_node(999999, 0);
+    REQUIRE(reused == node0);
+    REQUIRE(pool.hit_count() == 1);
+
+    pool.release(reused, cucim::io::DeviceType::kCPU);
+    pool.release(node1, cucim::io::DeviceType::kCPU);
+    REQUIRE(pool.idle_nbytes() == 2 * cucim::memory::BufferPool::bucket_size(1000000));
+    pool.capacity(0);
+    REQUIRE(pool.idle_nbytes() == 0);
+}
+
+TEST_CASE("Buffer pool frees buffers beyond its capacity", "[test_buffer_pool.cpp]")
+{
+    cucim::memory::BufferPool pool(0);
+
+    void* ptr = pool.allocate(8192, cucim::io::DeviceType::kCPU);
+    pool.release(ptr, cucim::io::DeviceType::kCPU);
+    REQUIRE(pool.idle_nbytes() == 0);
+}
+
+TEST_CASE("Buffer pool frees unknown CUDA memory on the device owning it", "[test_buffer_pool.cpp]")
+{
+    cucim::memory::BufferPool pool(0);
+    cudaError_t cuda_status;
+    int device_count = 0;
+    CUDA_ERROR(cudaGetDeviceCount(&device_count));
+    const int owner_device = device_count > 1 ? 1 : 0;
+
+    void* ptr = nullptr;
+    CUDA_ERROR(cudaSetDevice(owner_device));
+    CUDA_ERROR(cudaMalloc(&ptr, 4096));
+    CUDA_ERROR(cudaSetDevice(0));
+
+    pool.release(ptr, cucim::io::DeviceType::kCUDA);
+    int current_device = -1;
+    CUDA_ERROR(cudaGetDevice(&current_device));
+    REQUIRE(current_device == 0);
+    cudaPointerAttributes attributes{};
+    CUDA_ERROR(cudaPointerGetAttributes(&attributes, ptr));
+    REQUIRE(attributes.type == cudaMemoryTypeUnregistered);
+
+    // Host memory released as CUDA memory is rejected instead of being passed to cudaFree().
+    std::vector<uint8_t> host_buffer(4096);
+    pool.release(host_buffer.data(), cucim::io::DeviceType::kCUDA);
+    REQUIRE(cudaGetLastError() == cudaSuccess);
+}
@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cucim/filesystem/byte_source.h"
+
+using cucim::filesystem::ByteRange;
+using cucim::filesystem::CachedByteSource;
+using cucim::filesystem::HttpByteSource;
+using cucim::filesystem::LocalByteSource;
+
+namespace
+{
+
+// A keep-alive HTTP server on a loopback port serving `data` with range requests. Each response is followed by
+// `trailing_bytes` (in the same packet), as sent by a broken server or proxy.
+class RangeServer
+{
+public:
+    RangeServer(std::vector<uint8_t> data, std::string trailing_bytes)
+        : data_(std::move(data)), trailing_bytes_(std::move(trailing_bytes))
+    {
+        listener_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t address_len = sizeof(address);
+        ::bind(listener_, reinterpret_cast<sockaddr*>(&address), address_len);
+        ::listen(listener_, 8);
+        ::getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &address_len);
+        port_ = ntohs(address.sin_port);
+        thread_ = std::thread([this]() { serve(); });
+    }
+    ~RangeServer()
+    {
+        ::shutdown(listener_, SHUT_RDWR);
+        ::close(listener_);
+        thread_.join();
+    }
+
+    std::string url() const
+    {
+        return fmt::format("http://127.0.0.1:{}/data", port_);
+    }
+    int connection_count() const
+    {
+        return connection_count_;
+    }
+
+private:
+    void serve()
+    {
+        std::vector<std::thread> connections;
+        int connection;
+        while ((connection = ::accept(listener_, nullptr, nullptr)) >= 0)
+        {
+            ++connection_count_;
+            connections.emplace_back([this, connection]() { respond(connection); });
+        }
+        for (auto& thread : connections)
+        {
+            thread.join();
+        }
+    }
+    void respond(int connection)
+    {
+        std::string request;
+        char buf[1024];
+        ssize_t nread;
+        while ((nread = ::recv(connection, buf, sizeof(buf), 0)) > 0)
+        {
+            request.append(buf, nread);
+            size_t header_end;
+            while ((header_end = request.find("\r\n\r\n")) != std::string::npos)
+            {
+                unsigned long long first = 0;
+                unsigned long long last = 0;
+                const size_t range = request.find("Range: bytes=");
+                sscanf(request.c_str() + range, "Range: bytes=%llu-%llu", &first, &last);
+                request.erase(0, header_end + 4);
+                last = std::min<unsigned long long>(last, data_.size() - 1);
+                std::string response = fmt::format(
+                    "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes {}-{}/{}\r\nContent-Length: {}\r\n\r\n",
+                    first, last, data_.size(), last - first + 1);
+                response.append(data_.begin() + first, data_.begin() + last + 1);
+                response += trailing_bytes_;
+                ::send(connection, response.data(), response.size(), MSG_NOSIGNAL);
+            }
+        }
+        ::close(connection);
+    }
+
+    std::vector<uint8_t> data_;
+    std::string trailing_bytes_;
+    int listener_ = -1;
+    int port_ = 0;
+    std::atomic<int> connection_count_{ 0 };
+    std::thread thread_;
+};
+
+} // namespace
+
+TEST_CASE("Cached byte source returns the bytes of the source", "[test_byte_source.cpp]")
+{
+    char file_path[] = "/tmp/cucim_byte_source_XXXXXX";
+    const int fd = mkstemp(file_path);
+    REQUIRE(fd >= 0);
+    unlink(file_path);
+
+    std::vector<uint8_t> data(1000 * 1000 + 17);
+    std::mt19937 rng(0);
+    for (auto& value : data)
+    {
+        value = static_cast<uint8_t>(rng());
+    }
+    REQUIRE(pwrite(fd, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size()));
+
+    // Small blocks and capacity so that reads span blocks and evict them.
+    auto source = std::make_shared<CachedByteSource>(std::make_shared<LocalByteSource>(fd), 4096, 32, 4);
+    REQUIRE(source->size() == data.size());
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> mismatch_counts(4);
+    for (size_t t = 0; t < mismatch_counts.size(); ++t)
+    {
+        threads.emplace_back([&, t]() {
+            std::mt19937 thread_rng(static_cast<uint32_t>(t));
+            std::vector<uint8_t> buf(50000);
+            for (int i = 0; i < 500; ++i)
+            {
+                const uint64_t offset = thread_rng() % (data.size() + 100);
+                const size_t count = thread_rng() % buf.size();
+                if (i % 8 == 0)
+                {
+                    source->prefetch({ ByteRange{ offset, count }, ByteRange{ offset / 2, 1000 } });
+                }
+                const size_t expected = offset < data.size() ? std::min<size_t>(count, data.size() - offset) : 0;
+                const size_t nread = source->read(buf.data(), count, offset);
+                if (nread != expected || (nread && memcmp(buf.data(), data.data() + offset, nread) != 0))
+                {
+                    ++mismatch_counts[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t mismatch_count : mismatch_counts)
+    {
+        REQUIRE(mismatch_count == 0);
+    }
+
+    // Sequential reads (with read-ahead)
+    std::vector<uint8_t> out(data.size());
+    size_t position = 0;
+    while (size_t nread = source->read(out.data() + position, 3000, position))
+    {
+        position += nread;
+    }
+    REQUIRE(position == data.size());
+    REQUIRE(out == data);
+
+    close(fd);
+}
+
+TEST_CASE("HTTP byte source doesn't reuse a connection with bytes past the response", "[test_byte_source.cpp]")
+{
+    std::vector<uint8_t> data(100);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    RangeServer server(data, "garbage!");
+
+    HttpByteSource source(server.url());
+    REQUIRE(source.size() == data.size());
+    for (uint64_t offset = 0; offset < data.size(); offset += 10)
+    {
+        uint8_t buf[8];
+        REQUIRE(source.read(buf, sizeof(buf), offset) == sizeof(buf));
+        REQUIRE(memcmp(buf, data.data() + offset, sizeof(buf)) == 0);
+    }
+    // The size request and each read were sent on a new connection.
+    REQUIRE(server.connection_count() == 11);
+}
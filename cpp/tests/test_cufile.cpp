@@ -9,6 +9,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <fmt/format.h>
 #include <cucim/filesystem/cufile_driver.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <fcntl.h>
@@ -19,6 +20,8 @@
 #include <fstream>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <thread>
+#include <vector>
 #include <cuda_runtime.h>
 
 #define ALIGN_UP(x, align_to) (((uint64_t)(x) + ((uint64_t)(align_to)-1)) & ~((uint64_t)(align_to)-1))
@@ -619,3 +622,106 @@ TEST_CASE("Verify libcufile usage", "[test_cufile.cpp]")
         free(unaligned_host);
     }
 }
+
+namespace
+{
+
+// Stage reads in bounce buffers of `size_kib` KiB for the scope of a test.
+class BounceBufferScope
+{
+public:
+    explicit BounceBufferScope(uint32_t size_kib)
+    {
+        cucim::memory::BufferPoolConfig config;
+        config.bounce_buffer_size = size_kib;
+        cucim::filesystem::set_bounce_buffer_config(config);
+    }
+    ~BounceBufferScope()
+    {
+        cucim::filesystem::set_bounce_buffer_config(cucim::memory::BufferPoolConfig{});
+    }
+};
+
+std::vector<uint8_t> create_pattern_file(const std::string& file_path, size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>((i * 7 + i / 4096) % 251);
+    }
+    std::ofstream(file_path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), size);
+    return data;
+}
+
+} // namespace
+
+TEST_CASE("Verify O_DIRECT reads through bounce buffers", "[test_cufile.cpp]")
+{
+    constexpr size_t kPageSize = 4096;
+    BounceBufferScope scope(4); // a single page per window
+
+    const std::string file_path = fmt::format("{}/test_cufile_bounce.raw", g_config.temp_folder);
+    const size_t file_size = 5 * kPageSize + 123;
+    const std::vector<uint8_t> data = create_pattern_file(file_path, file_size);
+    auto fd = cucim::filesystem::open(file_path.c_str(), "rp");
+    REQUIRE(fd);
+
+    std::vector<uint8_t> unaligned(4 * kPageSize + 1);
+    uint8_t* aligned = nullptr;
+    REQUIRE(posix_memalign(reinterpret_cast<void**>(&aligned), kPageSize, 4 * kPageSize) == 0);
+
+    SECTION("An unaligned read spans several windows")
+    {
+        const size_t count = 3 * kPageSize + 1000;
+        REQUIRE(fd->pread(unaligned.data(), count, 100, 1) == static_cast<ssize_t>(count));
+        REQUIRE(std::equal(&unaligned[1], &unaligned[1 + count], &data[100]));
+    }
+    SECTION("An aligned read takes whole pages directly and bounces the tail")
+    {
+        const size_t count = 2 * kPageSize + 300;
+        REQUIRE(fd->pread(aligned, count, kPageSize) == static_cast<ssize_t>(count));
+        REQUIRE(std::equal(aligned, aligned + count, &data[kPageSize]));
+    }
+    SECTION("A read past the end of the file is short")
+    {
+        const off_t offset = 3 * kPageSize + 100;
+        REQUIRE(fd->pread(unaligned.data(), 3 * kPageSize, offset) == static_cast<ssize_t>(file_size - offset));
+        REQUIRE(std::equal(&unaligned[0], &unaligned[file_size - offset], &data[offset]));
+
+        REQUIRE(fd->pread(aligned, 4 * kPageSize, 2 * kPageSize) == static_cast<ssize_t>(file_size - 2 * kPageSize));
+        REQUIRE(std::equal(aligned, aligned + file_size - 2 * kPageSize, &data[2 * kPageSize]));
+
+        REQUIRE(fd->pread(unaligned.data(), 100, file_size + 10) == 0);
+    }
+    SECTION("Concurrent readers lease their own bounce buffers")
+    {
+        constexpr int kThreadCount = 8;
+        constexpr int kReadCount = 50;
+        std::vector<int> mismatch_counts(kThreadCount, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                std::vector<uint8_t> buf(3 * kPageSize);
+                for (int i = 0; i < kReadCount; ++i)
+                {
+                    const off_t offset = (t * 977 + i * 331) % (file_size - buf.size());
+                    const size_t count = buf.size() - (t * 131 + i * 17) % kPageSize;
+                    if (fd->pread(buf.data(), count, offset) != static_cast<ssize_t>(count) ||
+                        !std::equal(buf.data(), buf.data() + count, &data[offset]))
+                    {
+                        ++mismatch_counts[t];
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(mismatch_counts == std::vector<int>(kThreadCount, 0));
+    }
+
+    free(aligned);
+    REQUIRE(cucim::filesystem::close(fd));
+}
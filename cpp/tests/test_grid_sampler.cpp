@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cucim/loader/grid_sampler.h"
+
+TEST_CASE("Tissue mask computes tissue fractions of rectangles", "[test_grid_sampler.cpp]")
+{
+    // 4x2 mask whose right half is tissue.
+    cucim::loader::TissueMask mask({ 0, 0, 1, 1, 0, 0, 255, 1 }, 4, 2);
+    REQUIRE(mask.width() == 4);
+    REQUIRE(mask.height() == 2);
+
+    REQUIRE(mask.tissue_fraction(0.0, 0.0, 1.0, 1.0) == Catch::Approx(0.5));
+    REQUIRE(mask.tissue_fraction(0.5, 0.0, 1.0, 1.0) == Catch::Approx(1.0));
+    REQUIRE(mask.tissue_fraction(0.0, 0.0, 0.5, 1.0) == Catch::Approx(0.0));
+    // A rectangle smaller than a mask pixel uses the pixel containing it.
+    REQUIRE(mask.tissue_fraction(0.6, 0.1, 0.61, 0.11) == Catch::Approx(1.0));
+    // Parts outside of the image count as background.
+    REQUIRE(mask.tissue_fraction(0.5, 0.0, 1.5, 1.0) == Catch::Approx(0.5));
+    REQUIRE(mask.tissue_fraction(1.0, 0.0, 2.0, 1.0) == Catch::Approx(0.0));
+}
+
+TEST_CASE("Tissue mask rejects mismatched data", "[test_grid_sampler.cpp]")
+{
+    REQUIRE_THROWS_AS(cucim::loader::TissueMask({ 0, 1, 1 }, 2, 2), std::invalid_argument);
+    REQUIRE_THROWS_AS(cucim::loader::TissueMask({}, 0, 0), std::invalid_argument);
+}
@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include "cucim/concurrent/concurrency_config.h"
+#include "cucim/util/numa.h"
+
+TEST_CASE("NUMA ID lists are parsed like sysfs lists", "[test_numa.cpp]")
+{
+    REQUIRE(cucim::util::parse_numa_id_list("0") == std::vector<int>{ 0 });
+    REQUIRE(cucim::util::parse_numa_id_list("0-3,8,10-11") == std::vector<int>{ 0, 1, 2, 3, 8, 10, 11 });
+    REQUIRE(cucim::util::parse_numa_id_list("").empty());
+    // An invalid list yields no IDs (instead of a partial list).
+    REQUIRE(cucim::util::parse_numa_id_list("0-1,a-b").empty());
+}
+
+TEST_CASE("NUMA nodes are known", "[test_numa.cpp]")
+{
+    const std::vector<int>& nodes = cucim::util::numa_nodes();
+    REQUIRE(!nodes.empty());
+    const int node = cucim::util::numa_current_node();
+    REQUIRE(node >= 0);
+}
+
+TEST_CASE("concurrency.numa is parsed from the configuration", "[test_numa.cpp]")
+{
+    cucim::concurrent::ConcurrencyConfig config;
+    REQUIRE(config.numa == cucim::concurrent::kDefaultConcurrencyNuma);
+
+    nlohmann::json json_obj = { { "numa", true } };
+    config.load_config(&json_obj);
+    REQUIRE(config.numa);
+
+    // A value that is not a boolean is ignored.
+    json_obj = { { "numa", "false" } };
+    config.load_config(&json_obj);
+    REQUIRE(config.numa);
+
+    json_obj = { { "numa", false } };
+    config.load_config(&json_obj);
+    REQUIRE(!config.numa);
+}
@@ -14,6 +14,7 @@
 #include "cucim/core/framework.h"
 #include "cucim/io/device.h"
 #include "cucim/io/format/image_format.h"
+#include "cucim/memory/buffer_pool.h"
 #include "cucim/memory/memory_manager.h"
 
 
@@ -108,7 +109,7 @@ SCENARIO("Verify read_region()", "[test_read_region.cpp]")
         //            printf("%d %d %d ", out_image[i], out_image[i + 1], out_image[i + 2]);
         //        }
         printf("\ncucim count: %d\n", hash);
-        cucim_free(image_data.container.data);
+        cucim::memory::buffer_pool().release(image_data.container.data, cucim::io::DeviceType::kCPU);
         if (image_data.container.shape)
         {
             cucim_free(image_data.container.shape);
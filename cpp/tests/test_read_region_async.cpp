@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "config.h"
+#include "cucim/concurrent/threadpool.h"
+#include "cucim/cuimage.h"
+
+using cucim::concurrent::ThreadPool;
+
+TEST_CASE("read_region_async() keeps the image alive until the read completes", "[test_read_region_async.cpp]")
+{
+    const std::string input_path = g_config.get_input_path();
+    cucim::CuImage expected = cucim::CuImage{ input_path }.read_region({ 100, 200 }, { 64, 32 });
+
+    // Keep every executor thread busy so that the read is still queued when the image is released.
+    const size_t worker_count = ThreadPool::shared_worker_count();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<size_t> started_blockers{ 0 };
+    std::vector<std::future<void>> blockers;
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        blockers.emplace_back(ThreadPool::submit([&started_blockers, released]() {
+            ++started_blockers;
+            released.wait();
+        }));
+    }
+    while (started_blockers < worker_count)
+    {
+        std::this_thread::yield();
+    }
+
+    auto image = std::make_shared<cucim::CuImage>(input_path);
+    std::future<cucim::CuImage> future = image->read_region_async({ 100, 200 }, { 64, 32 });
+    image.reset();
+    release.set_value();
+    for (auto& blocker : blockers)
+    {
+        blocker.get();
+    }
+
+    cucim::CuImage region = future.get();
+    REQUIRE(region.size("YXC") == expected.size("YXC"));
+    const DLTensor* region_tensor = region.container();
+    const DLTensor* expected_tensor = expected.container();
+    REQUIRE(std::memcmp(region_tensor->data, expected_tensor->data, expected.container().size()) == 0);
+}
+
+TEST_CASE("read_region_async() rejects an image not owned by a std::shared_ptr", "[test_read_region_async.cpp]")
+{
+    cucim::CuImage image{ g_config.get_input_path() };
+    bool thrown = false;
+    try
+    {
+        image.read_region_async({ 0, 0 }, { 16, 16 });
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    REQUIRE(thrown);
+}
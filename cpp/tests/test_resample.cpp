@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "cucim/util/resample.h"
+
+TEST_CASE("Area resampler averages source pixels", "[test_resample.cpp]")
+{
+    // 4x2 single-channel image downsampled by 2.
+    const std::vector<uint8_t> src{ 10, 20, 30, 40, 50, 60, 70, 80 };
+    cucim::util::AreaResampler resampler(2.0, 0.0, 0.0, 2, 1);
+    REQUIRE(resampler.source_width() == 4);
+    REQUIRE(resampler.source_rows(0, 1) == std::pair<int64_t, int64_t>{ 0, 2 });
+
+    std::vector<uint8_t> out(2);
+    resampler.resample_rows(src.data(), 0, 4, out.data(), 2, 0, 1, 1);
+    REQUIRE(out == std::vector<uint8_t>{ 35, 55 });
+}
+
+TEST_CASE("Area resampler weights partially covered pixels", "[test_resample.cpp]")
+{
+    // Output pixels cover source pixels [0.5, 2) and [2, 3.5) of a 2-channel image (whose two rows are the same).
+    const std::vector<uint8_t> src{ 0, 100, 30, 100, 60, 100, 90, 100, 0, 100, 30, 100, 60, 100, 90, 100 };
+    cucim::util::AreaResampler resampler(1.5, 0.5, 0.0, 2, 1);
+    REQUIRE(resampler.source_width() == 4);
+    REQUIRE(resampler.source_rows(0, 1) == std::pair<int64_t, int64_t>{ 0, 2 });
+
+    std::vector<uint8_t> out(4);
+    resampler.resample_rows(src.data(), 0, 8, out.data(), 4, 0, 1, 2);
+    // (0 * 0.5 + 30 + 60 * 0) / 1.5 = 20, (60 + 90 * 0.5) / 1.5 = 70
+    REQUIRE(out == std::vector<uint8_t>{ 20, 100, 70, 100 });
+}
+
+TEST_CASE("Area resampler resamples output rows in bands", "[test_resample.cpp]")
+{
+    const int64_t width = 37;
+    const int64_t height = 29;
+    std::vector<uint8_t> src(width * height * 3);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        src[i] = static_cast<uint8_t>((i * 7919) % 251);
+    }
+    cucim::util::AreaResampler resampler(2.3, 0.25, 0.75, 15, 12);
+
+    std::vector<uint8_t> whole(15 * 12 * 3);
+    resampler.resample_rows(src.data(), 0, width * 3, whole.data(), 15 * 3, 0, 12, 3);
+
+    std::vector<uint8_t> banded(whole.size());
+    for (int64_t row = 0; row < 12; row += 5)
+    {
+        const int64_t row_end = std::min<int64_t>(row + 5, 12);
+        const auto [src_row_begin, src_row_end] = resampler.source_rows(row, row_end);
+        REQUIRE(src_row_end <= height);
+        resampler.resample_rows(&src[src_row_begin * width * 3], src_row_begin, width * 3, &banded[row * 15 * 3],
+                                15 * 3, row, row_end, 3);
+    }
+    REQUIRE(banded == whole);
+}
+
+TEST_CASE("Area resampler rejects upsampling", "[test_resample.cpp]")
+{
+    REQUIRE_THROWS_AS(cucim::util::AreaResampler(0.5, 0.0, 0.0, 4, 4), std::invalid_argument);
+}
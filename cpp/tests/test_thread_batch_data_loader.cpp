@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cucim/cuimage.h"
+#include "cucim/loader/thread_batch_data_loader.h"
+#include "cucim/memory/buffer_pool.h"
+
+using cucim::loader::ThreadBatchDataLoader;
+
+namespace
+{
+
+// Enables `concurrency.adaptive_prefetch` for the scope of a test.
+class AdaptivePrefetchScope
+{
+public:
+    AdaptivePrefetchScope(uint32_t min_prefetch_factor, uint32_t max_prefetch_factor)
+        : concurrency_(cucim::CuImage::get_config()->concurrency()), saved_(concurrency_)
+    {
+        concurrency_.adaptive_prefetch = true;
+        concurrency_.min_prefetch_factor = min_prefetch_factor;
+        concurrency_.max_prefetch_factor = max_prefetch_factor;
+    }
+    ~AdaptivePrefetchScope()
+    {
+        concurrency_ = saved_;
+    }
+
+private:
+    cucim::concurrent::ConcurrencyConfig& concurrency_;
+    cucim::concurrent::ConcurrencyConfig saved_;
+};
+
+// Load `location_len` one-byte patches (taking `load_time` each) with two workers and consume each batch in
+// `consume_time`. Return the loader statistics.
+cucim::loader::LoaderStats run_loader(uint64_t location_len,
+                                      uint32_t batch_size,
+                                      uint32_t prefetch_factor,
+                                      std::chrono::microseconds load_time,
+                                      std::chrono::microseconds consume_time)
+{
+    auto load_func = [load_time](ThreadBatchDataLoader* loader_ptr, uint64_t location_index) {
+        uint8_t* raster = loader_ptr->raster_pointer(location_index);
+        loader_ptr->enqueue(
+            [raster, location_index, load_time]() {
+                std::this_thread::sleep_for(load_time);
+                *raster = static_cast<uint8_t>(location_index);
+            },
+            cucim::loader::TileInfo{ static_cast<int64_t>(location_index), 0, 0, 0 });
+    };
+    ThreadBatchDataLoader loader(load_func, nullptr, cucim::io::Device("cpu"),
+                                 std::make_unique<std::vector<int64_t>>(location_len * 2, 0),
+                                 std::make_unique<std::vector<int64_t>>(std::vector<int64_t>{ 1, 1 }), location_len, 1,
+                                 batch_size, prefetch_factor, 2);
+    loader.request(batch_size * (1 + loader.prefetch_factor()));
+
+    uint64_t location_index = 0;
+    while (uint8_t* batch = loader.next_data())
+    {
+        for (uint32_t i = 0; i < loader.data_batch_size(); ++i, ++location_index)
+        {
+            REQUIRE(batch[i] == static_cast<uint8_t>(location_index));
+        }
+        std::this_thread::sleep_for(consume_time);
+        cucim::memory::buffer_pool().release(batch, cucim::io::DeviceType::kCPU);
+    }
+    REQUIRE(location_index == location_len);
+    return loader.stats();
+}
+
+} // namespace
+
+TEST_CASE("Adaptive prefetch grows for a consumer outrunning the workers", "[test_thread_batch_data_loader.cpp]")
+{
+    AdaptivePrefetchScope scope(1, 6);
+
+    const auto stats = run_loader(40, 2, 2, std::chrono::milliseconds(4), std::chrono::microseconds(0));
+    REQUIRE(stats.batch_count == 20);
+    REQUIRE(stats.stall_count > 0);
+    REQUIRE(stats.peak_prefetch_factor > 2);
+    REQUIRE(stats.peak_prefetch_factor <= 6);
+}
+
+TEST_CASE("Adaptive prefetch stays put for a slow consumer", "[test_thread_batch_data_loader.cpp]")
+{
+    // The minimum is the initial prefetch factor so that batches being ready does not shrink it either.
+    AdaptivePrefetchScope scope(2, 6);
+
+    const auto stats = run_loader(40, 2, 2, std::chrono::microseconds(0), std::chrono::milliseconds(5));
+    REQUIRE(stats.batch_count == 20);
+    REQUIRE(stats.prefetch_factor == 2);
+    REQUIRE(stats.peak_prefetch_factor == 2);
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cucim/concurrent/threadpool.h"
+
+using cucim::concurrent::TaskPriority;
+using cucim::concurrent::ThreadPool;
+
+TEST_CASE("Queued high priority tasks start before low priority tasks", "[test_threadpool.cpp]")
+{
+    const size_t worker_count = ThreadPool::shared_worker_count();
+
+    // Keep every executor thread busy so that the tasks below are queued.
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<size_t> started_blockers{ 0 };
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        futures.emplace_back(ThreadPool::submit([&started_blockers, released]() {
+            ++started_blockers;
+            released.wait();
+        }));
+    }
+    while (started_blockers < worker_count)
+    {
+        std::this_thread::yield();
+    }
+
+    std::mutex order_mutex;
+    std::vector<TaskPriority> order;
+    auto record = [&order_mutex, &order](TaskPriority priority) {
+        return [&order_mutex, &order, priority]() {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(priority);
+        };
+    };
+    const size_t low_count = worker_count * 8;
+    for (size_t i = 0; i < low_count; ++i)
+    {
+        futures.emplace_back(ThreadPool::submit(record(TaskPriority::kLow), TaskPriority::kLow));
+    }
+    futures.emplace_back(ThreadPool::submit(record(TaskPriority::kHigh), TaskPriority::kHigh));
+
+    release.set_value();
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+    REQUIRE(order.size() == low_count + 1);
+    REQUIRE(order.back() == TaskPriority::kLow);
+}
+
+TEST_CASE("Tasks are dropped if their deadline passed before they start", "[test_threadpool.cpp]")
+{
+    bool ran = false;
+    auto expired = ThreadPool::submit(
+        [&ran]() { ran = true; }, TaskPriority::kNormal, std::chrono::steady_clock::now() - std::chrono::seconds(1));
+    REQUIRE_THROWS_AS(expired.get(), cucim::concurrent::TaskExpiredError);
+    REQUIRE_FALSE(ran);
+
+    ThreadPool pool(1);
+    ran = false;
+    auto on_time = pool.enqueue(
+        [&ran]() { ran = true; }, TaskPriority::kNormal, std::chrono::steady_clock::now() + std::chrono::hours(1));
+    on_time.get();
+    REQUIRE(ran);
+}
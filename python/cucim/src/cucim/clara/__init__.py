@@ -1,5 +1,5 @@
 #
-# SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+# SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
 # SPDX-License-Identifier: Apache-2.0
 #
 
@@ -8,13 +8,26 @@ import os
 from . import cli, converter
 
 # import hidden methods
-from ._cucim import CuImage, DLDataType, DLDataTypeCode, cache, filesystem, io
+from ._cucim import (
+    CuImage,
+    DatasetLoader,
+    DLDataType,
+    DLDataTypeCode,
+    RegionFuture,
+    TaskExpiredError,
+    cache,
+    filesystem,
+    io,
+)
 
 __all__ = [
     "cli",
     "CuImage",
+    "DatasetLoader",
     "DLDataType",
     "DLDataTypeCode",
+    "RegionFuture",
+    "TaskExpiredError",
     "filesystem",
     "io",
     "cache",
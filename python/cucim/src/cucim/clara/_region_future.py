@@ -0,0 +1,29 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import asyncio
+
+
+async def wait(future):
+    """Wait for a RegionFuture without blocking the running event loop.
+
+    The future's eventfd stays readable once the read is finished, so the
+    reader callback also fires if the read finishes before it is added.
+    """
+    if not future.done():
+        loop = asyncio.get_running_loop()
+        waiter = loop.create_future()
+
+        def _on_ready():
+            if not waiter.done():
+                waiter.set_result(None)
+
+        fd = future.fileno()
+        loop.add_reader(fd, _on_ready)
+        try:
+            await waiter
+        finally:
+            loop.remove_reader(fd)
+    return future.result()
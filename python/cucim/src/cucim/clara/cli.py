@@ -1,5 +1,5 @@
 #
-# SPDX-FileCopyrightText: Copyright (c) 2020-2025, NVIDIA CORPORATION.
+# SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
 # SPDX-License-Identifier: Apache-2.0
 #
 
@@ -45,6 +45,13 @@ def main():
 @click.option("--num-workers", type=int, default=os.cpu_count())
 @click.option("--compression", type=str, default="jpeg")
 @click.option("--output-filename", type=str, default="image.tif")
+@click.option(
+    "--copy-tiles",
+    is_flag=True,
+    default=False,
+    help="Write the pyramid with cuCIM, copying the JPEG tiles of the source "
+    "levels without re-encoding them.",
+)
 def convert(
     src_file,
     dest_folder,
@@ -53,13 +60,34 @@ def convert(
     num_workers,
     compression,
     output_filename,
+    copy_tiles,
 ):
     """Convert file format"""
-    from .converter import tiff
-
     logging.basicConfig(level=logging.INFO)
 
     compression = compression.lower()
+    if copy_tiles:
+        from cucim import CuImage
+
+        if overlap != 0:
+            raise click.BadParameter(
+                "overlap is not supported with --copy-tiles",
+                param_hint="--overlap",
+            )
+        if compression == "none":
+            compression = "raw"
+        # Tiles are encoded (if not copied) on cuCIM's executor.
+        with CuImage(str(src_file)) as image:
+            image.save_pyramid(
+                str(Path(dest_folder) / output_filename),
+                tile_size=tile_size,
+                compression=compression,
+                copy_tiles=True,
+            )
+        return
+
+    from .converter import tiff
+
     if compression in ["raw", "none"]:
         compression = None
 
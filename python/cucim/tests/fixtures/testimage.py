@@ -1,10 +1,11 @@
 #
-# SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION.
+# SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
 # SPDX-License-Identifier: Apache-2.0
 #
 
 import shutil
 
+import numpy as np
 import pytest
 from pytest_lazy_fixtures import lf as lazy_fixture
 
@@ -197,3 +198,83 @@ def testimg_tiff_stripe_4096_4096_256_jpeg_resolution_9_1_none(tmpdir_factory):
 )
 def testimg_tiff_stripe_4096_4096_256_jpeg_resolution(request):
     return request.param
+
+
+# TIFF images written with tifffile
+def random_image(shape, dtype=np.uint8, seed=0):
+    """Return an image of random samples covering the range of `dtype`
+    (`[0, 1)` for floating-point types).
+    """
+    rng = np.random.default_rng(seed)
+    if np.issubdtype(dtype, np.floating):
+        return rng.random(shape, dtype=dtype)
+    info = np.iinfo(dtype)
+    return rng.integers(info.min, info.max, shape, dtype=dtype, endpoint=True)
+
+
+@pytest.fixture
+def make_tiff(tmp_path):
+    """Return a function writing a TIFF image and returning
+    `(image, path)`.
+
+    The image (YX or YXC) is random samples of `shape` and `dtype` unless
+    `image` is given, and is returned as is. It is written with tiles of
+    `tile` (`(height, width)`), or with strips of `rowsperstrip` rows if
+    `tile` is None, and with `levels` resolution levels (each halving the
+    previous one). `planarconfig` 'separate' stores the samples plane by
+    plane. Other keyword arguments are passed to `TiffWriter.write()`
+    (e.g., `resolution` or `predictor`).
+    """
+    from tifffile import TiffWriter
+
+    def write(
+        image=None,
+        *,
+        shape=(256, 320, 3),
+        dtype=np.uint8,
+        tile=(32, 32),
+        rowsperstrip=None,
+        compression="zlib",
+        levels=1,
+        planarconfig="contig",
+        name="slide.tif",
+        **kwargs,
+    ):
+        if image is None:
+            image = random_image(shape, dtype)
+        channels = image.shape[2] if image.ndim == 3 else 1
+        kwargs.setdefault(
+            "photometric", "rgb" if channels in (3, 4) else "minisblack"
+        )
+        if channels == 4:
+            kwargs.setdefault("extrasamples", ("unassalpha",))
+        path = str(tmp_path / name)
+        with TiffWriter(path) as tif:
+            # A single sample per pixel is written as a YX image.
+            level_image = image
+            if image.ndim == 3 and channels == 1:
+                level_image = image[..., 0]
+            for level in range(levels):
+                tif.write(
+                    level_image.transpose(2, 0, 1)
+                    if planarconfig == "separate"
+                    else level_image,
+                    tile=tile,
+                    rowsperstrip=None if tile else rowsperstrip,
+                    compression=compression,
+                    planarconfig=planarconfig,
+                    subfiletype=1 if level > 0 else 0,
+                    **kwargs,
+                )
+                level_image = level_image[::2, ::2]
+        return image, path
+
+    return write
+
+
+@pytest.fixture
+def tiff_image(request, make_tiff):
+    """`(image, path)` of a TIFF image written by `make_tiff`, with the
+    keyword arguments given by indirect parametrization (if any).
+    """
+    return make_tiff(**getattr(request, "param", {}))
@@ -0,0 +1,102 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+# skip if imagecodecs package is not available (needed by ImageGenerator)
+pytest.importorskip("imagecodecs")
+
+
+def _tile_bytes(page, index):
+    """Return the bytes of a tile (with JPEG tables merged, if any)."""
+    fh = page.parent.filehandle
+    fh.seek(page.dataoffsets[index])
+    data = fh.read(page.databytecounts[index])
+    if page.jpegtables:
+        data = page.jpegtables[:-2] + data[2:]
+    return data
+
+
+def test_copy_tiles(tmp_path, testimg_tiff_stripe_4096x4096_256_jpeg):
+    import tifffile
+
+    from cucim import CuImage
+
+    output_path = str(tmp_path / "copied.tif")
+    with CuImage(testimg_tiff_stripe_4096x4096_256_jpeg) as slide:
+        level_count = slide.resolutions["level_count"]
+        slide.save_pyramid(output_path, tile_size=256, copy_tiles=True)
+
+    with tifffile.TiffFile(
+        testimg_tiff_stripe_4096x4096_256_jpeg
+    ) as source, tifffile.TiffFile(output_path) as output:
+        assert output.is_bigtiff
+        assert len(output.pages) == level_count
+        for source_page, page in zip(source.pages, output.pages):
+            assert page.shape == source_page.shape
+            assert page.tile == source_page.tile
+            assert page.compression == tifffile.COMPRESSION.JPEG
+            # Tiles are copied as they are.
+            for index in (0, len(page.dataoffsets) - 1):
+                assert _tile_bytes(page, index) == _tile_bytes(
+                    source_page, index
+                )
+
+    with CuImage(
+        testimg_tiff_stripe_4096x4096_256_jpeg
+    ) as source, CuImage(output_path) as output:
+        for level in (0, level_count - 1):
+            width, height = source.resolutions["level_dimensions"][level]
+            expected = source.read_region((0, 0), (width, height), level)
+            region = output.read_region((0, 0), (width, height), level)
+            assert np.array_equal(np.asarray(region), np.asarray(expected))
+
+
+def test_copy_tiles_new_levels(
+    tmp_path, testimg_tiff_stripe_4096x4096_256_jpeg
+):
+    import tifffile
+
+    from cucim import CuImage
+
+    output_path = str(tmp_path / "copied.tif")
+    with CuImage(testimg_tiff_stripe_4096x4096_256_jpeg) as slide:
+        level_count = slide.resolutions["level_count"]
+        width, height = slide.resolutions["level_dimensions"][-1]
+        # Levels below the last level of the source are computed.
+        slide.save_pyramid(output_path, tile_size=16, copy_tiles=True)
+
+    with tifffile.TiffFile(output_path) as tif:
+        assert len(tif.pages) > level_count
+        assert tif.pages[level_count - 1].tile == (256, 256)
+        assert tif.pages[level_count].shape == (height // 2, width // 2, 3)
+        assert tif.pages[level_count].tile == (16, 16)
+        assert tif.pages[-1].shape[0] <= 16 and tif.pages[-1].shape[1] <= 16
+
+
+def test_copy_tiles_cli(tmp_path, testimg_tiff_stripe_4096x4096_256_jpeg):
+    import tifffile
+    from click.testing import CliRunner
+
+    from cucim.clara.cli import main
+
+    runner = CliRunner()
+    result = runner.invoke(
+        main,
+        [
+            "convert",
+            testimg_tiff_stripe_4096x4096_256_jpeg,
+            str(tmp_path),
+            "--copy-tiles",
+            "--output-filename",
+            "copied.tif",
+        ],
+    )
+    assert result.exit_code == 0, result.output
+
+    with tifffile.TiffFile(tmp_path / "copied.tif") as tif:
+        assert tif.pages[0].shape == (4096, 4096, 3)
+        assert tif.pages[0].compression == tifffile.COMPRESSION.JPEG
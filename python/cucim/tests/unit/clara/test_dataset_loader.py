@@ -0,0 +1,104 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...fixtures.testimage import random_image
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slides(make_tiff, count):
+    images = []
+    paths = []
+    for i in range(count):
+        image, path = make_tiff(
+            random_image((160, 200, 3), seed=i), name=f"slide{i}.tif"
+        )
+        images.append(image)
+        paths.append(path)
+    return images, paths
+
+
+def test_dataset_loader_mixed_slides(make_tiff):
+    """Batches mixing patches of several slides match regions read from
+    each slide, while at most `max_open_files` slides are kept open.
+    """
+    from cucim.clara import DatasetLoader
+
+    images, paths = _write_slides(make_tiff, 3)
+    size = (48, 40)
+    samples = [
+        (i % 3, 0, (i * 37) % 150 - 10, (i * 23) % 120 - 10) for i in range(20)
+    ]
+    expected = [
+        np.asarray(open_image_cucim(paths[f]).read_region((x, y), size))
+        for f, _, x, y in samples
+    ]
+
+    dataset = DatasetLoader(paths, max_open_files=2)
+    batches = dataset.read(samples, size, batch_size=6, num_workers=2)
+    assert len(batches) == 4
+    index = 0
+    for batch in batches:
+        batch = np.asarray(batch)
+        assert batch.shape[1:] == (40, 48, 3)
+        for patch in batch:
+            assert np.array_equal(patch, expected[index])
+            index += 1
+    assert index == len(samples)
+    assert dataset.open_file_count <= 2
+
+    # Files can also be specified by their paths.
+    samples_by_path = [(paths[f], level, x, y) for f, level, x, y in samples]
+    batches = dataset.read(samples_by_path[:4], size, batch_size=4, num_workers=2)
+    assert np.array_equal(np.asarray(next(batches)), np.stack(expected[:4]))
+
+
+def test_dataset_loader_invalid_sample(tmp_path, make_tiff):
+    from cucim.clara import DatasetLoader
+
+    _, paths = _write_slides(make_tiff, 1)
+    dataset = DatasetLoader(paths)
+    with pytest.raises(IndexError):
+        dataset.read([(1, 0, 0, 0)], (16, 16))
+    with pytest.raises(ValueError):
+        dataset.read([(str(tmp_path / "missing.tif"), 0, 0, 0)], (16, 16))
+
+
+def test_dataset_loader_uses_tile_cache(make_tiff):
+    """Patches are decoded through the tile cache of their files: reading the
+    same samples again decodes no tile.
+    """
+    from cucim import CuImage
+    from cucim.clara import DatasetLoader
+
+    images, paths = _write_slides(make_tiff, 2)
+    size = (40, 40)
+    samples = [(i % 2, 0, (i * 29) % 120, (i * 17) % 100) for i in range(8)]
+
+    cache = CuImage.cache("per_process", memory_capacity=64, record_stat=True)
+    try:
+        dataset = DatasetLoader(paths)
+
+        def read_samples():
+            batches = dataset.read(samples, size, batch_size=4, num_workers=2)
+            patches = np.concatenate([np.asarray(batch) for batch in batches])
+            for (f, _, x, y), patch in zip(samples, patches):
+                np.testing.assert_array_equal(
+                    patch, images[f][y : y + 40, x : x + 40]
+                )
+
+        read_samples()
+        miss_count = cache.miss_count
+        hit_count = cache.hit_count
+        assert miss_count > 0
+        read_samples()
+        assert cache.miss_count == miss_count
+        assert cache.hit_count > hit_count
+    finally:
+        CuImage.cache("nocache")
@@ -0,0 +1,126 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff):
+    """Write a 320x256 slide with a 128x128 block of tissue at (96, 64)."""
+    rng = np.random.default_rng(0)
+    image = rng.integers(228, 243, (256, 320, 3), dtype=np.uint8)
+    tissue = rng.integers(-10, 10, (128, 128, 3)) + np.array([190, 90, 160])
+    image[64:192, 96:224] = tissue.astype(np.uint8)
+    return make_tiff(image)
+
+
+def test_grid_locations(make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        locations = slide.grid_locations((32, 32))
+        assert locations.dtype == np.int64
+        assert locations.shape == (80, 2)
+        assert tuple(locations[0]) == (0, 0)
+        assert tuple(locations[1]) == (32, 0)
+        assert tuple(locations[-1]) == (288, 224)
+
+        # Overlapping patches cover the whole image.
+        locations = slide.grid_locations((100, 100), stride=(50, 50))
+        assert sorted(set(locations[:, 0])) == [0, 50, 100, 150, 200, 250]
+        assert sorted(set(locations[:, 1])) == [0, 50, 100, 150, 200]
+
+
+def test_grid_locations_tissue_mask(make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        mask = slide.tissue_mask()
+        assert mask.shape == (256, 320)
+        assert mask[64:192, 96:224].all()
+        assert mask.sum() == 128 * 128
+
+        locations = slide.grid_locations((32, 32), tissue_mask="otsu")
+        expected = [
+            (x, y) for y in range(64, 192, 32) for x in range(96, 224, 32)
+        ]
+        assert [tuple(location) for location in locations] == expected
+
+        # Patches half on tissue are kept only if min_tissue_fraction allows.
+        locations = slide.grid_locations(
+            (64, 64), stride=(32, 32), tissue_mask="otsu"
+        )
+        assert (64, 64) in [tuple(location) for location in locations]
+        locations = slide.grid_locations(
+            (64, 64),
+            stride=(32, 32),
+            tissue_mask="otsu",
+            min_tissue_fraction=1.0,
+        )
+        assert (64, 64) not in [tuple(location) for location in locations]
+
+        # A supplied mask (one value per 32x32 cell here).
+        cell_mask = np.zeros((8, 10), dtype=bool)
+        cell_mask[1, 2] = True
+        cell_mask[6, 9] = True
+        locations = slide.grid_locations((32, 32), tissue_mask=cell_mask)
+        assert [tuple(location) for location in locations] == [
+            (64, 32),
+            (288, 192),
+        ]
+
+        with pytest.raises(ValueError):
+            slide.grid_locations((32, 32), tissue_mask="unknown")
+
+
+def test_read_grid(make_tiff):
+    image, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        batches = slide.read_grid(
+            (32, 32), tissue_mask="otsu", batch_size=5, num_workers=2
+        )
+        assert len(batches) == 4
+        patches = np.concatenate([np.asarray(batch) for batch in batches])
+        expected = [
+            image[y : y + 32, x : x + 32]
+            for y in range(64, 192, 32)
+            for x in range(96, 224, 32)
+        ]
+        assert np.array_equal(patches, np.stack(expected))
+
+        # No tissue is kept.
+        with pytest.raises(ValueError):
+            slide.read_grid(
+                (32, 32), tissue_mask=np.zeros((8, 10), dtype=np.uint8)
+            )
+
+
+def test_read_grid_level(testimg_tiff_stripe_4096x4096_256):
+    """Grid locations at a level map exactly to the grid positions at that
+    level.
+    """
+    # needed by the ImageGenerator utility of the fixture
+    pytest.importorskip("imagecodecs")
+
+    level = 2
+    size = (256, 256)
+    with open_image_cucim(testimg_tiff_stripe_4096x4096_256) as slide:
+        downsample = slide.resolutions["level_downsamples"][level]
+        locations = slide.grid_locations(size, level=level, stride=(200, 200))
+        assert len(locations) == 25
+        positions = np.floor(locations / downsample).astype(np.int64)
+        assert sorted(set(positions[:, 0])) == [0, 200, 400, 600, 800]
+
+        batches = slide.read_grid(
+            size, level=level, stride=(200, 200), batch_size=25
+        )
+        patches = np.asarray(next(batches))
+        for patch, location in zip(patches, locations):
+            expected = np.asarray(
+                slide.read_region(tuple(location), size, level)
+            )
+            assert np.array_equal(patch, expected)
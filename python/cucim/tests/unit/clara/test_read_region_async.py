@@ -0,0 +1,80 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import asyncio
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff):
+    return make_tiff(shape=(256, 320, 3))
+
+
+def test_read_region_async_result(make_tiff):
+    image, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        future = slide.read_region_async((40, 30), (64, 48))
+        assert future.fileno() >= 0
+        region = future.result()
+        assert future.done()
+        assert np.array_equal(np.asarray(region), image[30:78, 40:104])
+        # The result is kept.
+        assert future.result() is region
+
+
+def test_read_region_async_await(make_tiff):
+    image, path = _write_slide(make_tiff)
+    locations = [((i * 37) % 280, (i * 23) % 200) for i in range(100)]
+
+    async def read_all(slide):
+        futures = [
+            slide.read_region_async(location, (40, 40))
+            for location in locations
+        ]
+        return await asyncio.gather(*futures)
+
+    with open_image_cucim(path) as slide:
+        regions = asyncio.run(read_all(slide))
+    assert len(regions) == len(locations)
+    for region, (x, y) in zip(regions, locations):
+        assert np.array_equal(np.asarray(region), image[y : y + 40, x : x + 40])
+
+
+def test_read_region_async_error(make_tiff):
+    _, path = _write_slide(make_tiff)
+
+    async def read_invalid(slide):
+        return await slide.read_region_async((0, 0), (32, 32), level=5)
+
+    with open_image_cucim(path) as slide:
+        with pytest.raises(ValueError):
+            asyncio.run(read_invalid(slide))
+        with pytest.raises(ValueError):
+            slide.read_region_async((0, 0), (32, 32), device="cuda")
+
+
+def test_read_region_async_priority_and_timeout(make_tiff):
+    from cucim.clara import TaskExpiredError
+
+    image, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        for priority in ("high", "normal", "low"):
+            region = slide.read_region_async(
+                (0, 0), (32, 32), priority=priority, timeout=60
+            ).result()
+            assert np.array_equal(np.asarray(region), image[:32, :32])
+        with pytest.raises(ValueError):
+            slide.read_region_async((0, 0), (32, 32), priority="urgent")
+
+        # A read that can't start before its deadline is dropped.
+        future = slide.read_region_async((0, 0), (32, 32), timeout=0)
+        with pytest.raises(TaskExpiredError):
+            future.result()
+        assert issubclass(TaskExpiredError, TimeoutError)
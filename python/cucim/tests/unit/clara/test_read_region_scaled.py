@@ -0,0 +1,120 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff):
+    """Write a 320x256 slide of 0.25 micrometers per pixel."""
+    return make_tiff(resolution=(40000, 40000), resolutionunit="CENTIMETER")
+
+
+def _area_weights(offset, scale, count):
+    """Return the (count, source length) matrix of area-average weights."""
+    length = int(np.ceil(offset + count * scale))
+    weights = np.zeros((count, length))
+    for i in range(count):
+        start = offset + i * scale
+        end = start + scale
+        for pixel in range(int(np.floor(start)), int(np.ceil(end))):
+            weights[i, pixel] = min(pixel + 1, end) - max(pixel, start)
+    return weights / scale
+
+
+def _area_average(image, location, size, scale):
+    x, y = location
+    wx = _area_weights(x - int(x), scale, size[0])
+    wy = _area_weights(y - int(y), scale, size[1])
+    source = image[
+        int(y) : int(y) + wy.shape[1], int(x) : int(x) + wx.shape[1]
+    ].astype(np.float64)
+    return np.einsum("yi,ijc,xj->yxc", wy, source, wx)
+
+
+@pytest.mark.parametrize("downsample", [2.0, 2.5, 3.7])
+def test_read_region_downsample(make_tiff, downsample):
+    image, path = _write_slide(make_tiff)
+    location = (30, 21)
+    size = (40, 30)
+    with open_image_cucim(path) as slide:
+        region = slide.read_region(location, size, downsample=downsample)
+        region = np.asarray(region)
+    assert region.shape == (30, 40, 3)
+    expected = _area_average(image, location, size, downsample)
+    assert np.abs(region - expected).max() <= 1.0
+
+
+def test_read_region_mpp(make_tiff):
+    image, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        assert slide.spacing()[:2] == pytest.approx([0.25, 0.25])
+        by_mpp = np.asarray(slide.read_region((0, 0), (64, 64), mpp=0.5))
+        by_downsample = np.asarray(
+            slide.read_region((0, 0), (64, 64), downsample=2)
+        )
+    assert np.array_equal(by_mpp, by_downsample)
+    expected = image[:128, :128].reshape(64, 2, 64, 2, 3).mean(axis=(1, 3))
+    assert np.abs(by_mpp - expected).max() <= 1.0
+
+
+def test_read_region_scaled_invalid(make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        with pytest.raises(ValueError):
+            slide.read_region((0, 0), (16, 16), downsample=0.5)
+        with pytest.raises(ValueError):
+            slide.read_region((0, 0), (16, 16), downsample=2, mpp=0.5)
+        with pytest.raises(ValueError):
+            slide.read_region((0, 0), (16, 16), level=1, downsample=2)
+        with pytest.raises(ValueError):
+            slide.read_region([(0, 0), (16, 16)], (16, 16), downsample=2)
+
+
+def test_read_region_level_downsample(testimg_tiff_stripe_4096x4096_256):
+    """A downsample matching a level reads that level."""
+    # needed by the ImageGenerator utility of the fixture
+    pytest.importorskip("imagecodecs")
+
+    with open_image_cucim(testimg_tiff_stripe_4096x4096_256) as slide:
+        downsample = slide.resolutions["level_downsamples"][1]
+        scaled = slide.read_region(
+            (512, 256), (300, 200), downsample=downsample
+        )
+        expected = slide.read_region((512, 256), (300, 200), level=1)
+        assert np.array_equal(np.asarray(scaled), np.asarray(expected))
+
+
+def test_read_region_scaled_decodes_each_tile_once(make_tiff):
+    """Source rows are read in bands of whole tile rows, so a region spanning
+    several bands decodes each tile it overlaps once.
+    """
+    from cucim import CuImage
+
+    image, path = make_tiff(shape=(1200, 320, 3), tile=(32, 32))
+    location = (5, 13)
+    size = (60, 300)
+    downsample = 3.7
+    rows = _area_weights(0.0, downsample, size[1]).shape[1]
+    columns = _area_weights(0.0, downsample, size[0]).shape[1]
+    tile_count = ((location[1] + rows - 1) // 32 - location[1] // 32 + 1) * (
+        (location[0] + columns - 1) // 32 - location[0] // 32 + 1
+    )
+
+    cache = CuImage.cache("per_process", memory_capacity=64, record_stat=True)
+    try:
+        with open_image_cucim(path) as slide:
+            region = slide.read_region(location, size, downsample=downsample)
+            region = np.asarray(region)
+        expected = _area_average(image, location, size, downsample)
+        assert np.abs(region - expected).max() <= 1.0
+        assert cache.miss_count == tile_count
+        assert cache.hit_count == 0
+    finally:
+        CuImage.cache("nocache")
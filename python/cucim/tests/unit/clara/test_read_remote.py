@@ -0,0 +1,135 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import http.server
+import os
+import re
+import threading
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+class _RangeRequestHandler(http.server.BaseHTTPRequestHandler):
+    """Serve the files of `directory` with range requests (only)."""
+
+    protocol_version = "HTTP/1.1"
+    directory = None
+    served_bytes = 0
+    # Tests break the responses with these.
+    content_length = None
+    max_request_count = None
+    request_count = 0
+
+    def log_message(self, *args):
+        pass
+
+    def do_GET(self):
+        path = os.path.join(self.directory, self.path.lstrip("/"))
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+        size = os.path.getsize(path)
+        match = re.fullmatch(r"bytes=(\d+)-(\d+)", self.headers["Range"] or "")
+        if match is None:
+            self.send_error(400)
+            return
+        first, last = int(match[1]), min(int(match[2]), size - 1)
+        type(self).request_count += 1
+        if (
+            self.max_request_count is not None
+            and self.request_count > self.max_request_count
+        ):
+            self.send_error(500)
+            return
+        self.send_response(206)
+        self.send_header("Content-Range", f"bytes {first}-{last}/{size}")
+        self.send_header(
+            "Content-Length", self.content_length or str(last - first + 1)
+        )
+        self.send_header("ETag", '"1"')
+        self.end_headers()
+        with open(path, "rb") as f:
+            f.seek(first)
+            self.wfile.write(f.read(last - first + 1))
+        type(self).served_bytes += last - first + 1
+
+
+@pytest.fixture
+def http_server(tmp_path):
+    handler = type("Handler", (_RangeRequestHandler,), {})
+    handler.directory = str(tmp_path)
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), handler)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield handler, f"http://127.0.0.1:{server.server_address[1]}"
+    server.shutdown()
+    server.server_close()
+
+
+def _write_slide(make_tiff):
+    return make_tiff(shape=(2048, 2048, 3), tile=(256, 256))
+
+
+def test_read_remote(make_tiff, http_server):
+    handler, url = http_server
+    image, path = _write_slide(make_tiff)
+
+    with open_image_cucim(f"{url}/slide.tif") as slide:
+        assert slide.path == f"{url}/slide.tif"
+        assert slide.shape == [2048, 2048, 3]
+
+        region = np.asarray(slide.read_region((300, 500), (100, 80)))
+        assert np.array_equal(region, image[500:580, 300:400])
+        # Only the bytes needed are fetched.
+        assert handler.served_bytes < os.path.getsize(path) // 2
+
+        # A region spanning many tiles (fetched in parallel)
+        region = np.asarray(slide.read_region((0, 0), (2048, 1024)))
+        assert np.array_equal(region, image[:1024])
+
+    with open_image_cucim(path) as local_slide, open_image_cucim(
+        f"{url}/slide.tif"
+    ) as slide:
+        assert slide.resolutions == local_slide.resolutions
+        locations = [(x, x // 2) for x in range(0, 1800, 150)]
+        remote = slide.read_region(locations, (200, 200), num_workers=4)
+        local = local_slide.read_region(locations, (200, 200), num_workers=4)
+        for remote_batch, local_batch in zip(remote, local):
+            assert np.array_equal(
+                np.asarray(remote_batch), np.asarray(local_batch)
+            )
+
+
+def test_read_remote_invalid(http_server):
+    _, url = http_server
+    with pytest.raises(ValueError):
+        open_image_cucim(f"{url}/missing.tif")
+    with pytest.raises(ValueError):
+        open_image_cucim("https://127.0.0.1:1/slide.tif")
+
+
+def test_read_remote_invalid_response(make_tiff, http_server):
+    handler, url = http_server
+    _write_slide(make_tiff)
+    handler.content_length = "abc"
+    with pytest.raises(ValueError, match="Invalid content length 'abc'"):
+        open_image_cucim(f"{url}/slide.tif")
+
+
+def test_read_remote_read_error(make_tiff, http_server):
+    """The error of a failed read is reported when the file can't be
+    loaded.
+    """
+    handler, url = http_server
+    _write_slide(make_tiff)
+    # Only the request of the size of the file succeeds.
+    handler.max_request_count = 1
+    with pytest.raises(ValueError, match="status: 500"):
+        open_image_cucim(f"{url}/slide.tif")
@@ -0,0 +1,96 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff, samples_per_pixel=3):
+    # Smooth image (kept close by JPEG compression)
+    y, x = np.mgrid[0:600, 0:1000]
+    image = np.stack(
+        [x * 255 // 999, y * 255 // 599, (x + y) * 255 // 1598], axis=-1
+    ).astype(np.uint8)
+    if samples_per_pixel == 1:
+        image = image[..., 0]
+    return make_tiff(
+        image, tile=(128, 128), compression=None, name="source.tif"
+    )
+
+
+def _read_ppm(path):
+    with open(path, "rb") as f:
+        magic = f.readline().strip()
+        width = int(f.readline())
+        height = int(f.readline())
+        assert int(f.readline()) == 255
+        data = np.frombuffer(f.read(), dtype=np.uint8)
+    if magic == b"P5":
+        return data.reshape(height, width)
+    assert magic == b"P6"
+    return data.reshape(height, width, 3)
+
+
+@pytest.mark.parametrize("samples_per_pixel", [1, 3])
+def test_save_ppm(tmp_path, make_tiff, samples_per_pixel):
+    image, path = _write_slide(make_tiff, samples_per_pixel)
+    with open_image_cucim(path) as slide:
+        region = slide.read_region((100, 50), (300, 200))
+        region.save(str(tmp_path / "region.ppm"))
+        # Level 0 of the file is read if the image is not loaded.
+        slide.save(str(tmp_path / "slide.ppm"))
+
+    assert np.array_equal(
+        _read_ppm(tmp_path / "region.ppm"), image[50:250, 100:400]
+    )
+    assert np.array_equal(_read_ppm(tmp_path / "slide.ppm"), image)
+
+
+@pytest.mark.parametrize("extension", [".png", ".jpg", ".tif"])
+def test_save_formats(tmp_path, make_tiff, extension):
+    imagecodecs = pytest.importorskip("imagecodecs")
+
+    image, path = _write_slide(make_tiff)
+    output_path = str(tmp_path / f"region{extension}")
+    with open_image_cucim(path) as slide:
+        region = slide.read_region((0, 0), (1000, 600))
+    region.save(output_path, quality=95)
+
+    if extension == ".tif":
+        with open_image_cucim(output_path) as slide:
+            assert slide.resolutions["level_count"] == 1
+            saved = np.asarray(slide.read_region((0, 0), (1000, 600)))
+    else:
+        saved = imagecodecs.imread(output_path)
+    assert saved.shape == image.shape
+    if extension == ".jpg":
+        error = np.abs(saved.astype(np.int32) - image.astype(np.int32))
+        assert error.mean() < 2
+    else:
+        assert np.array_equal(saved, image)
+
+
+def test_save_format_option(tmp_path, make_tiff):
+    imagecodecs = pytest.importorskip("imagecodecs")
+
+    image, path = _write_slide(make_tiff, samples_per_pixel=1)
+    output_path = str(tmp_path / "region.img")
+    with open_image_cucim(path) as slide:
+        slide.save(output_path, format="png")
+    assert np.array_equal(imagecodecs.imread(output_path), image)
+
+
+def test_save_invalid(tmp_path, make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        region = slide.read_region((0, 0), (100, 100))
+    with pytest.raises(ValueError):
+        region.save(str(tmp_path / "region.img"), format="bmp")
+    with pytest.raises(ValueError):
+        region.save(str(tmp_path / "region.jpg"), quality=0)
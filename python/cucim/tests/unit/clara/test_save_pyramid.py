@@ -0,0 +1,114 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff):
+    return make_tiff(
+        shape=(600, 1000, 3),
+        tile=(128, 128),
+        name="source.tif",
+        resolution=(40000, 40000),
+        resolutionunit="CENTIMETER",
+    )
+
+
+def _downsample(image):
+    """Average 2x2 pixels (rounded to the nearest integer)."""
+    h, w = image.shape[0] // 2, image.shape[1] // 2
+    pixels = image[: h * 2, : w * 2].astype(np.uint32)
+    total = (
+        pixels[0::2, 0::2]
+        + pixels[0::2, 1::2]
+        + pixels[1::2, 0::2]
+        + pixels[1::2, 1::2]
+    )
+    return ((total + 2) // 4).astype(np.uint8)
+
+
+@pytest.mark.parametrize("compression", ["deflate", "zstd", "raw"])
+def test_save_pyramid_lossless(tmp_path, make_tiff, compression):
+    import tifffile
+
+    image, path = _write_slide(make_tiff)
+    output_path = str(tmp_path / "pyramid.tif")
+    with open_image_cucim(path) as slide:
+        slide.save_pyramid(
+            output_path, tile_size=128, compression=compression
+        )
+
+    dimensions = [(1000, 600), (500, 300), (250, 150), (125, 75)]
+    with tifffile.TiffFile(output_path) as tif:
+        assert tif.is_bigtiff
+        assert len(tif.pages) == len(dimensions)
+        assert tif.pages[0].tilewidth == 128
+
+    with open_image_cucim(output_path) as slide:
+        resolutions = slide.resolutions
+        assert resolutions["level_count"] == len(dimensions)
+        assert [tuple(d) for d in resolutions["level_dimensions"]] == dimensions
+        assert slide.spacing("XY") == pytest.approx([0.25, 0.25])
+
+        expected = image
+        for level, (width, height) in enumerate(dimensions):
+            region = slide.read_region((0, 0), (width, height), level)
+            assert np.array_equal(np.asarray(region), expected)
+            expected = _downsample(expected)
+
+
+def test_save_pyramid_jpeg(tmp_path, make_tiff):
+    # JPEG keeps smooth images close to the source.
+    y, x = np.mgrid[0:600, 0:1000]
+    image = np.stack(
+        [x * 255 // 999, y * 255 // 599, (x + y) * 255 // 1598], axis=-1
+    ).astype(np.uint8)
+    image, path = make_tiff(
+        image, tile=(128, 128), compression=None, name="source.tif"
+    )
+
+    output_path = str(tmp_path / "pyramid.tif")
+    with open_image_cucim(path) as slide:
+        slide.save_pyramid(output_path, quality=95, level_count=2)
+
+    with open_image_cucim(output_path) as slide:
+        assert slide.resolutions["level_count"] == 2
+        expected = image
+        for level, (width, height) in enumerate([(1000, 600), (500, 300)]):
+            region = slide.read_region((0, 0), (width, height), level)
+            error = np.abs(
+                np.asarray(region).astype(np.int32) - expected.astype(np.int32)
+            )
+            assert error.mean() < 2
+            expected = _downsample(expected)
+
+
+def test_save_pyramid_region(tmp_path, make_tiff):
+    image, path = _write_slide(make_tiff)
+    output_path = str(tmp_path / "region.tif")
+    with open_image_cucim(path) as slide:
+        region = slide.read_region((100, 50), (300, 200))
+    region.save_pyramid(output_path, tile_size=64, compression="deflate")
+
+    with open_image_cucim(output_path) as slide:
+        assert slide.resolutions["level_count"] == 4
+        region = slide.read_region((0, 0), (300, 200))
+        assert np.array_equal(np.asarray(region), image[50:250, 100:400])
+
+
+def test_save_pyramid_invalid(tmp_path, make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        with pytest.raises(ValueError):
+            slide.save_pyramid(str(tmp_path / "a.tif"), compression="lzma")
+        with pytest.raises(ValueError):
+            slide.save_pyramid(str(tmp_path / "a.tif"), tile_size=100)
+        with pytest.raises(ValueError):
+            slide.save_pyramid(str(tmp_path / "a.png"))
@@ -0,0 +1,153 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import json
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff):
+    return make_tiff(
+        shape=(600, 1000, 3),
+        tile=(128, 128),
+        name="source.tif",
+        resolution=(40000, 40000),
+        resolutionunit="CENTIMETER",
+    )
+
+
+def _read_array(path, decode=bytes):
+    """Assemble a Zarr (v2) array in the 'cyx' order written with '/'."""
+    with open(path / ".zarray") as f:
+        zarray = json.load(f)
+    channels, height, width = zarray["shape"]
+    _, chunk_height, chunk_width = zarray["chunks"]
+    rows = -(-height // chunk_height)
+    cols = -(-width // chunk_width)
+    array = np.zeros(
+        (channels, rows * chunk_height, cols * chunk_width), dtype=np.uint8
+    )
+    for ty in range(rows):
+        for tx in range(cols):
+            data = decode((path / "0" / str(ty) / str(tx)).read_bytes())
+            chunk = np.frombuffer(data, dtype=np.uint8).reshape(
+                zarray["chunks"]
+            )
+            array[
+                :,
+                ty * chunk_height : (ty + 1) * chunk_height,
+                tx * chunk_width : (tx + 1) * chunk_width,
+            ] = chunk
+    return zarray, array[:, :height, :width]
+
+
+def test_save_zarr_metadata(tmp_path, make_tiff):
+    _, path = _write_slide(make_tiff)
+    output_path = tmp_path / "image.zarr"
+    with open_image_cucim(path) as slide:
+        slide.save_zarr(str(output_path), compression="raw")
+
+    with open(output_path / ".zgroup") as f:
+        assert json.load(f)["zarr_format"] == 2
+    with open(output_path / ".zattrs") as f:
+        multiscales = json.load(f)["multiscales"]
+    assert multiscales[0]["version"] == "0.4"
+    assert [axis["name"] for axis in multiscales[0]["axes"]] == [
+        "c",
+        "y",
+        "x",
+    ]
+    datasets = multiscales[0]["datasets"]
+    assert len(datasets) == 1
+    assert datasets[0]["path"] == "0"
+    scale = datasets[0]["coordinateTransformations"][0]["scale"]
+    assert scale == pytest.approx([1.0, 0.25, 0.25])
+
+    zarray, _ = _read_array(output_path / "0")
+    assert zarray["shape"] == [3, 600, 1000]
+    # Chunks are the tiles of the level.
+    assert zarray["chunks"] == [3, 128, 128]
+    assert zarray["dtype"] == "|u1"
+    assert zarray["compressor"] is None
+    assert zarray["dimension_separator"] == "/"
+
+
+@pytest.mark.parametrize("compression", ["raw", "zstd"])
+def test_save_zarr(tmp_path, make_tiff, compression):
+    decode = bytes
+    if compression == "zstd":
+        imagecodecs = pytest.importorskip("imagecodecs")
+        decode = imagecodecs.zstd_decode
+
+    image, path = _write_slide(make_tiff)
+    output_path = tmp_path / "image.zarr"
+    with open_image_cucim(path) as slide:
+        slide.save_zarr(
+            str(output_path), compression=compression, chunk_size=96
+        )
+
+    zarray, array = _read_array(output_path / "0", decode)
+    assert zarray["chunks"] == [3, 96, 96]
+    if compression == "zstd":
+        assert zarray["compressor"]["id"] == "zstd"
+    assert np.array_equal(array, np.moveaxis(image, -1, 0))
+
+
+def test_save_zarr_levels(tmp_path, make_tiff):
+    _, path = _write_slide(make_tiff)
+    pyramid_path = str(tmp_path / "pyramid.tif")
+    with open_image_cucim(path) as slide:
+        slide.save_pyramid(pyramid_path, tile_size=64, compression="deflate")
+
+    output_path = tmp_path / "image.zarr"
+    with open_image_cucim(pyramid_path) as slide:
+        resolutions = slide.resolutions
+        slide.save_zarr(str(output_path), compression="raw", level_count=3)
+
+        with open(output_path / ".zattrs") as f:
+            datasets = json.load(f)["multiscales"][0]["datasets"]
+        assert [dataset["path"] for dataset in datasets] == ["0", "1", "2"]
+        for level in range(3):
+            width, height = resolutions["level_dimensions"][level]
+            downsample = resolutions["level_downsamples"][level]
+            scale = datasets[level]["coordinateTransformations"][0]["scale"]
+            spacing = 0.25 * downsample
+            assert scale == pytest.approx([1.0, spacing, spacing])
+
+            zarray, array = _read_array(output_path / str(level))
+            assert zarray["shape"] == [3, height, width]
+            assert zarray["chunks"] == [3, 64, 64]
+            region = slide.read_region((0, 0), (width, height), level)
+            expected = np.moveaxis(np.asarray(region), -1, 0)
+            assert np.array_equal(array, expected)
+
+
+def test_save_zarr_region(tmp_path, make_tiff):
+    image, path = _write_slide(make_tiff)
+    output_path = tmp_path / "region.zarr"
+    with open_image_cucim(path) as slide:
+        region = slide.read_region((100, 50), (300, 200))
+    region.save_zarr(str(output_path), compression="raw", chunk_size=64)
+
+    zarray, array = _read_array(output_path / "0")
+    assert zarray["chunks"] == [3, 64, 64]
+    expected = np.moveaxis(image[50:250, 100:400], -1, 0)
+    assert np.array_equal(array, expected)
+
+
+def test_save_zarr_invalid(tmp_path, make_tiff):
+    _, path = _write_slide(make_tiff)
+    with open_image_cucim(path) as slide:
+        with pytest.raises(ValueError):
+            slide.save_zarr(str(tmp_path / "a.zarr"), compression="lzma")
+        slide.save_zarr(str(tmp_path / "b.zarr"), compression="raw")
+        # The directory exists.
+        with pytest.raises(ValueError):
+            slide.save_zarr(str(tmp_path / "b.zarr"), compression="raw")
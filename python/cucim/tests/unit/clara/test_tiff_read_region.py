@@ -6,6 +6,7 @@
 import numpy as np
 import pytest
 
+from ...fixtures.testimage import random_image
 from ...util.io import open_image_cucim
 
 # skip if imagecodecs package not available (needed by ImageGenerator utility)
@@ -226,3 +227,437 @@ def test_tiff_iterator(testimg_tiff_stripe_4096x4096_256):
         _ = next(x)
         x = slide.read_region([(0, 0), (0, 0)], size, level, num_workers=1)
         _ = next(x)
+
+
+@pytest.mark.parametrize(
+    "dtype, channels, compression, predictor",
+    [
+        (np.uint8, 1, None, None),
+        (np.uint8, 4, "deflate", None),
+        (np.uint16, 1, "deflate", 2),
+        (np.uint16, 3, "lzw", 2),
+        (np.int16, 2, None, None),
+        (np.float32, 5, "deflate", None),
+    ],
+)
+def test_tiff_generic_sample_layout(
+    make_tiff, dtype, channels, compression, predictor
+):
+    """Tiled images with any samples per pixel and 8/16/32-bit integer or
+    floating point samples are read by the fast path with the source dtype.
+    """
+    shape = (100, 120, channels)
+    image, file_path = make_tiff(
+        shape=shape, dtype=dtype, compression=compression, predictor=predictor
+    )
+
+    cucim_img = open_image_cucim(file_path)
+    assert cucim_img.shape == list(shape)
+    assert np.dtype(cucim_img.typestr) == np.dtype(dtype)
+    assert len(cucim_img.channel_names) == channels
+
+    region_list = [
+        ((0, 0), (120, 100)),  # whole
+        ((10, 20), (50, 40)),  # across tiles
+        ((100, 90), (40, 30)),  # out of boundary
+    ]
+    for (x, y), (w, h) in region_list:
+        region = np.asarray(cucim_img.read_region((x, y), (w, h)))
+        assert region.dtype == np.dtype(dtype)
+        assert region.shape == (h, w, channels)
+        expected = image[y : y + h, x : x + w]
+        np.testing.assert_array_equal(
+            region[: expected.shape[0], : expected.shape[1]], expected
+        )
+
+    # Multiple locations with workers
+    locations = [(0, 0), (32, 16), (64, 64)]
+    regions = list(
+        cucim_img.read_region(locations, (24, 24), num_workers=2)
+    )
+    for (x, y), region in zip(locations, regions):
+        np.testing.assert_array_equal(
+            np.asarray(region), image[y : y + 24, x : x + 24]
+        )
+
+
+@pytest.mark.parametrize("compression", [None, "deflate", "lzw", "jpeg"])
+def test_tiff_strip_read_region(make_tiff, compression):
+    """Stripped images are read by the fast path (strips as full-width
+    tiles), including a last strip that is shorter than the others.
+    """
+    image = None
+    if compression == "jpeg":
+        # Smooth image to keep JPEG error small
+        image = np.broadcast_to(
+            np.linspace(0, 255, 50, dtype=np.uint8)[None, :, None],
+            (70, 50, 3),
+        ).copy()
+    image, file_path = make_tiff(
+        image,
+        shape=(70, 50, 3),
+        tile=None,
+        rowsperstrip=16,
+        compression=compression,
+    )
+
+    cucim_img = open_image_cucim(file_path)
+    region_list = [
+        ((0, 0), (50, 70)),  # whole
+        ((5, 10), (30, 40)),  # across strips
+        ((20, 60), (20, 10)),  # last (short) strip
+        ((40, 60), (20, 20)),  # out of boundary
+    ]
+    for (x, y), (w, h) in region_list:
+        region = np.asarray(cucim_img.read_region((x, y), (w, h)))
+        assert region.shape == (h, w, 3)
+        expected = image[y : y + h, x : x + w]
+        actual = region[: expected.shape[0], : expected.shape[1]]
+        if compression == "jpeg":
+            assert np.abs(actual.astype(int) - expected).max() < 8
+        else:
+            np.testing.assert_array_equal(actual, expected)
+
+    # Batch loading
+    locations = [(0, 0), (10, 20), (25, 50)]
+    batches = list(
+        cucim_img.read_region(
+            locations, (16, 16), batch_size=3, num_workers=2
+        )
+    )
+    assert np.asarray(batches[0]).shape == (3, 16, 16, 3)
+
+
+@pytest.mark.parametrize("compression", [None, "deflate"])
+@pytest.mark.parametrize("cache_type", ["nocache", "per_process"])
+def test_tiff_single_strip_read_region(make_tiff, compression, cache_type):
+    """An image stored as a single strip larger than 4 MiB is not decoded as
+    a whole for each region: an uncompressed strip is read in bands of rows
+    (each cached on its own) and a compressed strip is decoded once even
+    without an image cache.
+    """
+    from cucim import CuImage
+
+    image, file_path = make_tiff(
+        shape=(3000, 600, 3),
+        tile=None,
+        rowsperstrip=3000,
+        compression=compression,
+    )
+    cache = CuImage.cache(cache_type, memory_capacity=64, record_stat=True)
+    try:
+        cucim_img = open_image_cucim(file_path)
+        region = np.asarray(cucim_img.read_region((10, 20), (100, 80)))
+        np.testing.assert_array_equal(region, image[20:100, 10:110])
+        if cache_type != "nocache":
+            assert cache.miss_count == 1
+            if compression is None:
+                # Only the band of the first 2330 rows (4 MiB) is cached.
+                assert cache.memory_size < image.nbytes
+
+        region = np.asarray(cucim_img.read_region((500, 2950), (150, 100)))
+        np.testing.assert_array_equal(region[:50, :100], image[2950:, 500:])
+
+        locations = [(x, y) for y in range(0, 3000, 500) for x in (0, 300)]
+        patches = cucim_img.read_region(
+            locations, (64, 64), batch_size=4, num_workers=2
+        )
+        patches = np.concatenate([np.asarray(batch) for batch in patches])
+        for (x, y), patch in zip(locations, patches):
+            np.testing.assert_array_equal(patch, image[y : y + 64, x : x + 64])
+    finally:
+        CuImage.cache("nocache")
+
+
+@pytest.mark.parametrize("tile", [(32, 32), None])
+@pytest.mark.parametrize("compression", [None, "deflate"])
+def test_tiff_planar_separate_read_region(make_tiff, tile, compression):
+    """Planar-separate images are read plane by plane, either interleaved
+    ('YXC'), channel-first ('CYX') or as a single channel ('C=<index>').
+    """
+    image, file_path = make_tiff(
+        shape=(70, 90, 5),
+        dtype=np.uint16,
+        tile=tile,
+        rowsperstrip=16,
+        planarconfig="separate",
+        compression=compression,
+    )
+    image = image.transpose(2, 0, 1)  # CYX
+
+    cucim_img = open_image_cucim(file_path)
+    assert cucim_img.shape == [70, 90, 5]
+    assert np.dtype(cucim_img.typestr) == np.uint16
+
+    (x, y), (w, h) = (10, 20), (60, 40)
+    expected = image[:, y : y + h, x : x + w]
+
+    region = np.asarray(cucim_img.read_region((x, y), (w, h)))
+    np.testing.assert_array_equal(region, expected.transpose(1, 2, 0))
+
+    region = cucim_img.read_region((x, y), (w, h), dims="CYX")
+    assert region.dims == "CYX"
+    np.testing.assert_array_equal(np.asarray(region), expected)
+
+    region = np.asarray(cucim_img.read_region((x, y), (w, h), C=2))
+    np.testing.assert_array_equal(region, expected[2:3].transpose(1, 2, 0))
+
+    region = np.asarray(
+        cucim_img.read_region((x, y), (w, h), dims="CYX", C=4)
+    )
+    np.testing.assert_array_equal(region, expected[4:5])
+
+    # Out of boundary
+    region = np.asarray(
+        cucim_img.read_region((80, 60), (20, 20), dims="CYX")
+    )
+    np.testing.assert_array_equal(region[:, :10, :10], image[:, 60:, 80:])
+
+    # Batch loading
+    locations = [(0, 0), (10, 20), (50, 30)]
+    batches = list(
+        cucim_img.read_region(
+            locations, (16, 16), batch_size=3, num_workers=2, dims="CYX"
+        )
+    )
+    batch = np.asarray(batches[0])
+    assert batch.shape == (3, 5, 16, 16)
+    for i, (bx, by) in enumerate(locations):
+        np.testing.assert_array_equal(
+            batch[i], image[:, by : by + 16, bx : bx + 16]
+        )
+
+
+@pytest.mark.parametrize(
+    "compression, dtype, channels, predictor",
+    [
+        ("zstd", np.uint8, 3, None),
+        ("zstd", np.uint16, 1, "horizontal"),
+        ("zstd", np.float32, 2, None),
+        ("webp", np.uint8, 3, None),
+        ("webp", np.uint8, 4, None),
+        ("jpegxl", np.uint8, 3, None),
+        ("jpegxl", np.uint16, 1, None),
+    ],
+)
+def test_tiff_zstd_webp_jpegxl_read_region(
+    make_tiff, compression, dtype, channels, predictor
+):
+    """Tiles compressed with zstd (50000), WebP (50001) and JPEG XL (50002)
+    are decoded by the fast path.
+    """
+    from imagecodecs import TIFF
+
+    if not getattr(TIFF, compression.upper(), None):
+        pytest.skip(f"imagecodecs is built without {compression}")
+
+    image = random_image((100, 120, channels), dtype)
+    if channels == 4:
+        # Lossless WebP may alter the color of fully transparent pixels
+        image[..., 3] = 255
+
+    compressionargs = {}
+    if compression in ("webp", "jpegxl"):
+        compressionargs = {"lossless": True}
+
+    image, file_path = make_tiff(
+        image,
+        compression=compression,
+        compressionargs=compressionargs,
+        predictor=predictor,
+    )
+
+    cucim_img = open_image_cucim(file_path)
+    assert np.dtype(cucim_img.typestr) == dtype
+    region_list = [
+        ((0, 0), (120, 100)),  # whole
+        ((10, 20), (50, 40)),  # across tiles
+        ((100, 90), (30, 30)),  # out of boundary
+    ]
+    for (x, y), (w, h) in region_list:
+        region = np.asarray(cucim_img.read_region((x, y), (w, h)))
+        assert region.shape == (h, w, channels)
+        expected = image[y : y + h, x : x + w]
+        np.testing.assert_array_equal(
+            region[: expected.shape[0], : expected.shape[1]], expected
+        )
+
+    # Batch loading
+    locations = [(0, 0), (32, 16), (64, 64)]
+    regions = list(
+        cucim_img.read_region(locations, (24, 24), num_workers=2)
+    )
+    for (x, y), region in zip(locations, regions):
+        np.testing.assert_array_equal(
+            np.asarray(region), image[y : y + 24, x : x + 24]
+        )
+
+
+@pytest.mark.parametrize(
+    "tiff_image",
+    [
+        {"shape": (300, 260, 3), "tile": (16, 16), "planarconfig": config}
+        for config in ("contig", "separate")
+    ],
+    indirect=True,
+)
+def test_tiff_large_region_split_read_region(tiff_image):
+    """A region covering more tiles than
+    `concurrency.region_split_tile_count` is read in bands of tile rows, and
+    the result is identical to reading the image at once.
+    """
+    image, file_path = tiff_image
+    cucim_img = open_image_cucim(file_path)
+    region_list = [
+        ((0, 0), (260, 300)),  # whole
+        ((5, 7), (250, 283)),  # unaligned
+        ((-20, -30), (300, 340)),  # partially outside
+    ]
+    for (x, y), (w, h) in region_list:
+        region = np.asarray(cucim_img.read_region((x, y), (w, h)))
+        expected = np.zeros((h, w, 3), dtype=np.uint8)
+        sx, sy = max(x, 0), max(y, 0)
+        ex, ey = min(x + w, 260), min(y + h, 300)
+        # The background of a generic TIFF is 0 outside of the image.
+        expected[sy - y : ey - y, sx - x : ex - x] = image[sy:ey, sx:ex]
+        assert np.array_equal(region, expected)
+
+
+def test_tiff_overlapping_patches_batch_read_region(make_tiff):
+    """Overlapping patches in a batch share decoded tiles and each patch is
+    identical to a region read on its own.
+    """
+    _, file_path = make_tiff(shape=(200, 180, 3))
+    cucim_img = open_image_cucim(file_path)
+    size = (64, 64)
+    # Sliding window with 50% overlap, including patches crossing the edge
+    locations = [(x, y) for y in range(-32, 200, 32) for x in range(-32, 180, 32)]
+    expected = [
+        np.asarray(cucim_img.read_region(location, size))
+        for location in locations
+    ]
+    for batch_size in (1, 4, 7):
+        patches = cucim_img.read_region(
+            locations, size, batch_size=batch_size, num_workers=2
+        )
+        index = 0
+        for batch in patches:
+            batch = np.asarray(batch)
+            if batch_size == 1:
+                batch = batch[np.newaxis]
+            for patch in batch:
+                assert np.array_equal(patch, expected[index])
+                index += 1
+        assert index == len(locations)
+
+
+def test_tiff_batch_read_region_loader_stats(make_tiff):
+    """The loader reports its prefetch factor, how long the consumer waited
+    for batches and how many patches were read ahead.
+    """
+    _, file_path = make_tiff(shape=(128, 128, 3))
+    cucim_img = open_image_cucim(file_path)
+    locations = [(x, y) for y in range(0, 96, 16) for x in range(0, 96, 16)]
+    patches = cucim_img.read_region(
+        locations, (32, 32), batch_size=4, num_workers=2, prefetch_factor=2
+    )
+    batch_count = 0
+    for _ in patches:
+        batch_count += 1
+    stats = patches.loader_stats
+    assert stats["batch_count"] == batch_count == 9
+    assert stats["stall_count"] <= batch_count
+    assert 1 <= stats["prefetch_factor"] <= stats["peak_prefetch_factor"]
+    # Tiles of all patches are hinted ahead (`concurrency.readahead_batches`).
+    assert stats["readahead_count"] == len(locations)
+
+
+def test_tiff_batch_read_region_readahead_keeps_cache_stats(make_tiff):
+    """Reading ahead hints the byte ranges of the tiles of the patches to the
+    file without counting image cache hits or misses.
+    """
+    from tifffile import TiffFile
+
+    from cucim import CuImage
+
+    _, file_path = make_tiff(shape=(128, 128, 3), tile=(32, 32))
+    with TiffFile(file_path) as tif:
+        tile_bytes = sum(tif.pages[0].databytecounts)
+    # Each patch is a single tile.
+    locations = [(x, y) for y in range(0, 128, 32) for x in range(0, 128, 32)]
+    cache = CuImage.cache("per_process", memory_capacity=64, record_stat=True)
+    try:
+        cucim_img = open_image_cucim(file_path)
+        for read_count in (1, 2):
+            patches = cucim_img.read_region(
+                locations, (32, 32), batch_size=4, num_workers=2
+            )
+            for _ in patches:
+                pass
+            # Tiles of a local file are hinted even if they are cached.
+            assert patches.loader_stats["readahead_bytes"] == tile_bytes
+            assert cache.miss_count == len(locations)
+            assert cache.hit_count == (read_count - 1) * len(locations)
+    finally:
+        CuImage.cache("nocache")
+
+
+@pytest.mark.parametrize("method", ["cancel", "close"])
+def test_tiff_batch_read_region_stop_early(make_tiff, method):
+    """Stopping an iterator early ends the iteration and keeps the batch
+    returned last intact.
+    """
+    image, file_path = make_tiff(shape=(256, 256, 3))
+    cucim_img = open_image_cucim(file_path)
+    locations = [(x, y) for y in range(0, 224, 8) for x in range(0, 224, 8)]
+    patches = cucim_img.read_region(
+        locations, (32, 32), batch_size=8, num_workers=2, prefetch_factor=4
+    )
+    batch = next(patches)
+    expected = np.stack([image[y : y + 32, x : x + 32] for x, y in locations[:8]])
+    getattr(patches, method)()
+    assert np.array_equal(np.asarray(batch), expected)
+    assert list(patches) == []
+
+
+@pytest.mark.parametrize(
+    "dtype, background",
+    [
+        (np.uint16, 65535),
+        (np.int16, 32767),
+        (np.float32, 1.0),
+        (np.float64, 1.0),
+    ],
+)
+def test_tiff_white_background_by_dtype(make_tiff, dtype, background):
+    """The white background of an Aperio image is the maximal value of the
+    sample type (1.0 for floating-point samples), not 0xFF bytes.
+    """
+    image, file_path = make_tiff(
+        shape=(100, 120, 1),
+        dtype=dtype,
+        description="Aperio Image Library Test|AppMag = 20",
+        metadata=None,
+    )
+    cucim_img = open_image_cucim(file_path)
+
+    for location in [(100, 90), (-10, -10)]:
+        region = np.asarray(cucim_img.read_region(location, (30, 30)))
+        assert region.dtype == np.dtype(dtype)
+        x, y = location
+        expected = np.full((30, 30, 1), background, dtype=dtype)
+        sx, sy = max(x, 0), max(y, 0)
+        ex, ey = min(x + 30, 120), min(y + 30, 100)
+        expected[sy - y : ey - y, sx - x : ex - x] = image[sy:ey, sx:ex]
+        np.testing.assert_array_equal(region, expected)
+
+    # Batch loading
+    batch = np.asarray(
+        next(
+            cucim_img.read_region(
+                [(100, 90), (0, 0)], (30, 30), batch_size=2, num_workers=2
+            )
+        )
+    )
+    assert np.all(batch[0, 10:] == background)
+    assert np.all(batch[0, :, 20:] == background)
@@ -0,0 +1,98 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026, NVIDIA CORPORATION.
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import numpy as np
+import pytest
+
+from ...util.io import open_image_cucim
+
+pytest.importorskip("tifffile")
+
+
+def _write_slide(make_tiff, tile):
+    return make_tiff(shape=(776, 1000, 3), tile=tile, rowsperstrip=64)
+
+
+def _downsample(image):
+    """Average 2x2 pixels (rounded to the nearest integer)."""
+    h, w = image.shape[0] // 2, image.shape[1] // 2
+    pixels = image[: h * 2, : w * 2].astype(np.uint32)
+    total = (
+        pixels[0::2, 0::2]
+        + pixels[0::2, 1::2]
+        + pixels[1::2, 0::2]
+        + pixels[1::2, 1::2]
+    )
+    return ((total + 2) // 4).astype(np.uint8)
+
+
+@pytest.fixture
+def virtual_pyramid_cache():
+    from cucim import CuImage
+
+    cache = CuImage.cache(
+        "per_process",
+        memory_capacity=64,
+        record_stat=True,
+        virtual_pyramid=True,
+    )
+    yield cache
+    CuImage.cache("nocache")
+
+
+@pytest.mark.parametrize(
+    "tile, dimensions",
+    [
+        ((128, 128), [(1000, 776), (500, 388), (250, 194), (125, 97)]),
+        # Stripped images get 256x256 virtual tiles.
+        (None, [(1000, 776), (500, 388), (250, 194)]),
+    ],
+)
+def test_virtual_pyramid(make_tiff, virtual_pyramid_cache, tile, dimensions):
+    image, path = _write_slide(make_tiff, tile)
+    assert virtual_pyramid_cache.config["virtual_pyramid"]
+    with open_image_cucim(path) as slide:
+        resolutions = slide.resolutions
+        assert resolutions["level_count"] == len(dimensions)
+        level_dimensions = resolutions["level_dimensions"]
+        assert [tuple(d) for d in level_dimensions] == dimensions
+        assert list(resolutions["level_downsamples"]) == [
+            2**i for i in range(len(dimensions))
+        ]
+
+        expected = image
+        for level, (width, height) in enumerate(dimensions):
+            region = slide.read_region((0, 0), (width, height), level)
+            assert np.array_equal(np.asarray(region), expected)
+            expected = _downsample(expected)
+
+        # Virtual tiles are cached and reused.
+        hits = virtual_pyramid_cache.hit_count
+        region = slide.read_region((200, 100), (100, 80), 1)
+        assert np.array_equal(
+            np.asarray(region), _downsample(image)[50:130, 100:200]
+        )
+        assert virtual_pyramid_cache.hit_count > hits
+
+
+def test_virtual_pyramid_disabled(make_tiff):
+    _, path = _write_slide(make_tiff, (128, 128))
+    with open_image_cucim(path) as slide:
+        assert slide.resolutions["level_count"] == 1
+
+
+def test_virtual_pyramid_requires_cache(make_tiff):
+    """Without an image cache, virtual levels are not added (each of their
+    tiles would decode exponentially many tiles of the file).
+    """
+    from cucim import CuImage
+
+    _, path = _write_slide(make_tiff, (128, 128))
+    CuImage.cache("nocache", virtual_pyramid=True)
+    try:
+        with open_image_cucim(path) as slide:
+            assert slide.resolutions["level_count"] == 1
+    finally:
+        CuImage.cache("nocache")
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -88,7 +88,8 @@ py::dict py_config(ImageCache& cache)
         "mutex_pool_capacity"_a = pybind11::int_(config.mutex_pool_capacity), //
         "list_padding"_a = pybind11::int_(config.list_padding), //
         "extra_shared_memory_size"_a = pybind11::int_(config.extra_shared_memory_size), //
-        "record_stat"_a = pybind11::bool_(config.record_stat) //
+        "record_stat"_a = pybind11::bool_(config.record_stat), //
+        "virtual_pyramid"_a = pybind11::bool_(config.virtual_pyramid) //
     };
 }
 
@@ -1,21 +1,35 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2023, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "cucim_py.h"
 #include "cucim_pydoc.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <mutex>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <Python.h>
 #include <pybind11/buffer_info.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
 
 #include <cucim/cuimage.h>
+#include <cucim/loader/dataset_loader.h>
+#include <cucim/loader/grid_sampler.h>
 
 #include "cache/cache_py.h"
 #include "filesystem/filesystem_py.h"
@@ -155,14 +169,63 @@ PYBIND11_MODULE(_cucim, m)
              py::arg("seed") = py::int_(0), //
              py::arg("device") = io::Device(), //
              py::arg("buf") = py::none(), //
-             py::arg("shm_name") = "") //
+             py::arg("shm_name") = "", //
+             py::arg("dims") = "", //
+             py::arg("downsample") = py::none(), //
+             py::arg("mpp") = py::none()) //
+        .def("read_region_async", &py_read_region_async, doc::CuImage::doc_read_region_async,
+             py::call_guard<py::gil_scoped_release>(), //
+             py::arg("location") = py::tuple{}, //
+             py::arg("size") = py::tuple{}, //
+             py::arg("level") = 0, //
+             py::arg("device") = io::Device(), //
+             py::arg("dims") = "", //
+             py::arg("priority") = "high", //
+             py::arg("timeout") = py::none()) //
+        .def("tissue_mask", &py_tissue_mask, doc::CuImage::doc_tissue_mask, py::call_guard<py::gil_scoped_release>()) //
+        .def("grid_locations", &py_grid_locations, doc::CuImage::doc_grid_locations,
+             py::call_guard<py::gil_scoped_release>(), //
+             py::arg("size"), //
+             py::arg("level") = 0, //
+             py::arg("stride") = py::none(), //
+             py::arg("tissue_mask") = py::none(), //
+             py::arg("min_tissue_fraction") = loader::kDefaultMinTissueFraction) //
+        .def("read_grid", &py_read_grid, doc::CuImage::doc_read_grid, py::call_guard<py::gil_scoped_release>(), //
+             py::arg("size"), //
+             py::arg("level") = 0, //
+             py::arg("stride") = py::none(), //
+             py::arg("tissue_mask") = py::none(), //
+             py::arg("min_tissue_fraction") = loader::kDefaultMinTissueFraction, //
+             py::arg("num_workers") = 1, //
+             py::arg("batch_size") = 1, //
+             py::arg("drop_last") = py::bool_(false), //
+             py::arg("prefetch_factor") = 2, //
+             py::arg("shuffle") = py::bool_(false), //
+             py::arg("seed") = py::int_(0), //
+             py::arg("device") = io::Device()) //
         .def_property("associated_images", &CuImage::associated_images, nullptr, doc::CuImage::doc_associated_images,
                       py::call_guard<py::gil_scoped_release>()) //
         .def("associated_image", &py_associated_image, doc::CuImage::doc_associated_image,
              py::call_guard<py::gil_scoped_release>(), //
              py::arg("name") = "", //
              py::arg("device") = io::Device()) //
-        .def("save", &CuImage::save, doc::CuImage::doc_save, py::call_guard<py::gil_scoped_release>()) //
+        .def("save", &CuImage::save, doc::CuImage::doc_save, py::call_guard<py::gil_scoped_release>(), //
+             py::arg("path"), //
+             py::arg("format") = "", //
+             py::arg("quality") = 90) //
+        .def("save_pyramid", &CuImage::save_pyramid, doc::CuImage::doc_save_pyramid,
+             py::call_guard<py::gil_scoped_release>(), //
+             py::arg("path"), //
+             py::arg("tile_size") = 256, //
+             py::arg("compression") = "jpeg", //
+             py::arg("quality") = 90, //
+             py::arg("level_count") = 0, //
+             py::arg("copy_tiles") = true) //
+        .def("save_zarr", &CuImage::save_zarr, doc::CuImage::doc_save_zarr, py::call_guard<py::gil_scoped_release>(), //
+             py::arg("path"), //
+             py::arg("compression") = "zstd", //
+             py::arg("level_count") = 0, //
+             py::arg("chunk_size") = 0) //
         .def("close", &CuImage::close, doc::CuImage::doc_close, py::call_guard<py::gil_scoped_release>()) //
         .def("__bool__", &CuImage::operator bool, py::call_guard<py::gil_scoped_release>()) //
         .def(
@@ -208,6 +271,28 @@ PYBIND11_MODULE(_cucim, m)
             }, //
             py::call_guard<py::gil_scoped_release>())
         .def("__next__", &py_cuimage_iterator_next, py::call_guard<py::gil_scoped_release>())
+        .def("cancel", &CuImageIterator<CuImage>::cancel, doc::CuImageIterator::doc_cancel,
+             py::call_guard<py::gil_scoped_release>())
+        .def("close", &CuImageIterator<CuImage>::close, doc::CuImageIterator::doc_close,
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly(
+            "loader_stats", //
+            [](CuImageIterator<CuImage>& it) -> py::object { //
+                cucim::loader::ThreadBatchDataLoader* loader = (*it)->loader();
+                if (!loader)
+                {
+                    return py::none();
+                }
+                const cucim::loader::LoaderStats stats = loader->stats();
+                return py::dict{ "prefetch_factor"_a = stats.prefetch_factor,
+                                 "peak_prefetch_factor"_a = stats.peak_prefetch_factor,
+                                 "batch_count"_a = stats.batch_count,
+                                 "stall_count"_a = stats.stall_count,
+                                 "stall_time_ns"_a = stats.stall_time_ns,
+                                 "readahead_count"_a = stats.readahead_count,
+                                 "readahead_bytes"_a = stats.readahead_bytes };
+            },
+            doc::CuImageIterator::doc_loader_stats)
         .def(
             "__repr__", //
             [](CuImageIterator<CuImage>& it) { //
@@ -215,6 +300,47 @@ PYBIND11_MODULE(_cucim, m)
             },
             py::call_guard<py::gil_scoped_release>());
 
+    py::register_exception<concurrent::TaskExpiredError>(m, "TaskExpiredError", PyExc_TimeoutError);
+
+    py::class_<RegionFuture, std::shared_ptr<RegionFuture>>(m, "RegionFuture") //
+        .def("fileno", &RegionFuture::fileno, doc::RegionFuture::doc_fileno, py::call_guard<py::gil_scoped_release>())
+        .def("done", &RegionFuture::done, doc::RegionFuture::doc_done, py::call_guard<py::gil_scoped_release>())
+        .def("result", &RegionFuture::result, doc::RegionFuture::doc_result)
+        .def(
+            "__await__", //
+            [](const py::object& future) { //
+                return py::module_::import("cucim.clara._region_future").attr("wait")(future).attr("__await__")();
+            }, //
+            doc::RegionFuture::doc___await__);
+
+    py::class_<loader::DatasetLoader, std::shared_ptr<loader::DatasetLoader>>(m, "DatasetLoader") //
+        .def(py::init<std::vector<std::string>, uint32_t>(), doc::DatasetLoader::doc_DatasetLoader, //
+             py::arg("paths"), //
+             py::arg("max_open_files") = loader::kDefaultDatasetMaxOpenFiles, //
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("paths", &loader::DatasetLoader::paths, doc::DatasetLoader::doc_paths,
+                               py::call_guard<py::gil_scoped_release>()) //
+        .def_property_readonly("max_open_files", &loader::DatasetLoader::max_open_files,
+                               doc::DatasetLoader::doc_max_open_files, py::call_guard<py::gil_scoped_release>()) //
+        .def_property_readonly("open_file_count", &loader::DatasetLoader::open_file_count,
+                               doc::DatasetLoader::doc_open_file_count, py::call_guard<py::gil_scoped_release>()) //
+        .def("read", &py_dataset_loader_read, doc::DatasetLoader::doc_read, py::call_guard<py::gil_scoped_release>(), //
+             py::arg("samples"), //
+             py::arg("size"), //
+             py::arg("batch_size") = 1, //
+             py::arg("num_workers") = 1, //
+             py::arg("drop_last") = py::bool_(false), //
+             py::arg("prefetch_factor") = 2, //
+             py::arg("shuffle") = py::bool_(false), //
+             py::arg("seed") = py::int_(0), //
+             py::arg("device") = io::Device()) //
+        .def(
+            "__repr__", //
+            [](const loader::DatasetLoader& dataset_loader) { //
+                return fmt::format("<cucim.DatasetLoader files:{}>", dataset_loader.paths().size());
+            },
+            py::call_guard<py::gil_scoped_release>());
+
     // We can use `"cpu"` instead of `Device("cpu")`
     py::implicitly_convertible<const char*, io::Device>();
 }
@@ -288,6 +414,10 @@ std::shared_ptr<cucim::cache::ImageCache> py_cache(const py::object& type, const
         {
             config.record_stat = py::cast<bool>(kwargs["record_stat"]);
         }
+        if (kwargs.contains("virtual_pyramid"))
+        {
+            config.virtual_pyramid = py::cast<bool>(kwargs["virtual_pyramid"]);
+        }
         return CuImage::cache(config);
     }
     else if (type.is_none())
@@ -411,6 +541,46 @@ py::dict py_resolutions(const CuImage& cuimg)
 }
 
 
+namespace
+{
+
+// Parse dimension indices (e.g., `C=0`) given as keyword arguments.
+cucim::DimIndices py_dim_indices(const py::kwargs& kwargs)
+{
+    std::vector<std::pair<char, int64_t>> indices_args;
+    {
+        py::gil_scoped_acquire scope_guard;
+
+        if (!kwargs)
+        {
+            return cucim::DimIndices{};
+        }
+
+        for (auto item : kwargs)
+        {
+            auto key = std::string(py::str(item.first));
+            auto value = py::cast<int>(item.second);
+
+            if (key.size() != 1)
+            {
+                throw std::invalid_argument(
+                    fmt::format("Argument name for Dimension should be a single character but '{}' is used.", key));
+            }
+            char key_char = key[0] & ~32;
+            if (key_char < 'A' || key_char > 'Z')
+            {
+                throw std::invalid_argument(
+                    fmt::format("Dimension character should be an alphabet but '{}' is used.", key));
+            }
+
+            indices_args.emplace_back(std::make_pair(key_char, value));
+        }
+    }
+    return cucim::DimIndices(indices_args);
+}
+
+} // namespace
+
 py::object py_read_region(const CuImage& cuimg,
                           const py::iterable& location,
                           std::vector<int64_t>&& size,
@@ -424,14 +594,26 @@ py::object py_read_region(const CuImage& cuimg,
                           const io::Device& device,
                           const py::object& buf,
                           const std::string& shm_name,
+                          const std::string& dims,
+                          std::optional<float> downsample,
+                          std::optional<float> mpp,
                           const py::kwargs& kwargs)
 {
     if (!size.empty() && size.size() != 2)
     {
         throw std::runtime_error("size (patch size) should be 2!");
     }
+    if (downsample && mpp)
+    {
+        throw std::invalid_argument("Only one of 'downsample' and 'mpp' can be specified!");
+    }
+    const bool scaled = downsample || mpp;
+    if (scaled && (level != 0 || batch_size > 1 || num_workers > 0 || !dims.empty()))
+    {
+        throw std::invalid_argument(
+            "'downsample' or 'mpp' can't be used with 'level', 'batch_size', 'num_workers' or 'dims'!");
+    }
 
-    cucim::DimIndices indices;
     std::vector<int64_t> locations;
     {
         py::gil_scoped_acquire scope_guard;
@@ -487,43 +669,24 @@ py::object py_read_region(const CuImage& cuimg,
         }
     }
 
-    if (kwargs)
-    {
-        std::vector<std::pair<char, int64_t>> indices_args;
+    const cucim::DimIndices indices = py_dim_indices(kwargs);
 
-        {
-            py::gil_scoped_acquire scope_guard;
-
-            for (auto item : kwargs)
-            {
-                auto key = std::string(py::str(item.first));
-                auto value = py::cast<int>(item.second);
+    if (scaled)
+    {
+        const float target_downsample = downsample ? *downsample : cuimg.mpp_to_downsample(*mpp);
+        auto region_ptr = std::make_shared<cucim::CuImage>(
+            cuimg.read_region_scaled(std::move(locations), std::move(size), target_downsample, indices, device));
 
-                if (key.size() != 1)
-                {
-                    throw std::invalid_argument(
-                        fmt::format("Argument name for Dimension should be a single character but '{}' is used.", key));
-                }
-                char key_char = key[0] & ~32;
-                if (key_char < 'A' || key_char > 'Z')
-                {
-                    throw std::invalid_argument(
-                        fmt::format("Dimension character should be an alphabet but '{}' is used.", key));
-                }
+        py::gil_scoped_acquire scope_guard;
 
-                indices_args.emplace_back(std::make_pair(key_char, value));
-            }
-        }
-        indices = cucim::DimIndices(indices_args);
-    }
-    else
-    {
-        indices = cucim::DimIndices{};
+        py::object region = py::cast(region_ptr);
+        _set_array_interface(region);
+        return region;
     }
 
     auto region_ptr = std::make_shared<cucim::CuImage>(
         std::move(cuimg.read_region(std::move(locations), std::move(size), level, num_workers, batch_size, drop_last,
-                                    prefetch_factor, shuffle, seed, indices, device, nullptr, "")));
+                                    prefetch_factor, shuffle, seed, indices, device, nullptr, "", dims)));
     auto loader = region_ptr->loader();
     if (batch_size > 1 || (loader && loader->size() > 1))
     {
@@ -548,6 +711,145 @@ py::object py_read_region(const CuImage& cuimg,
     }
 }
 
+struct RegionFuture::State
+{
+    int event_fd = -1;
+    std::atomic<bool> ready{ false };
+    std::future<CuImage> future;
+
+    std::mutex mutex;
+    std::shared_ptr<CuImage> image;
+    std::exception_ptr error;
+
+    ~State()
+    {
+        if (event_fd >= 0)
+        {
+            close(event_fd);
+        }
+    }
+};
+
+RegionFuture::RegionFuture(const CuImage& cuimg,
+                           std::vector<int64_t>&& location,
+                           std::vector<int64_t>&& size,
+                           uint16_t level,
+                           const DimIndices& indices,
+                           const io::Device& device,
+                           const std::string& dims,
+                           concurrent::TaskPriority priority,
+                           concurrent::TaskDeadline deadline)
+    : state_(std::make_shared<State>())
+{
+    state_->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (state_->event_fd < 0)
+    {
+        throw std::runtime_error(fmt::format("Failed to create an eventfd: {}", std::strerror(errno)));
+    }
+    state_->future = cuimg.read_region_async(
+        std::move(location), std::move(size), level, indices, device, dims, [state = state_]() {
+            state->ready = true;
+            const uint64_t count = 1;
+            [[maybe_unused]] const ssize_t written = write(state->event_fd, &count, sizeof(count));
+        },
+        priority, deadline);
+}
+
+int RegionFuture::fileno() const
+{
+    return state_->event_fd;
+}
+
+bool RegionFuture::done() const
+{
+    return state_->ready;
+}
+
+py::object RegionFuture::result()
+{
+    if (result_)
+    {
+        return result_;
+    }
+
+    std::shared_ptr<CuImage> image;
+    {
+        py::gil_scoped_release release;
+
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (!state_->image && !state_->error)
+        {
+            try
+            {
+                state_->image = std::make_shared<CuImage>(state_->future.get());
+            }
+            catch (...)
+            {
+                state_->error = std::current_exception();
+            }
+        }
+        if (state_->error)
+        {
+            std::rethrow_exception(state_->error);
+        }
+        image = state_->image;
+    }
+
+    if (!result_)
+    {
+        result_ = py::cast(image);
+        // Add `__array_interface__` in runtime.
+        _set_array_interface(result_);
+    }
+    return result_;
+}
+
+std::shared_ptr<RegionFuture> py_read_region_async(const CuImage& cuimg,
+                                                   std::vector<int64_t>&& location,
+                                                   std::vector<int64_t>&& size,
+                                                   uint16_t level,
+                                                   const io::Device& device,
+                                                   const std::string& dims,
+                                                   const std::string& priority,
+                                                   std::optional<double> timeout,
+                                                   const py::kwargs& kwargs)
+{
+    if (!size.empty() && size.size() != 2)
+    {
+        throw std::runtime_error("size (patch size) should be 2!");
+    }
+
+    concurrent::TaskPriority task_priority;
+    if (priority == "high")
+    {
+        task_priority = concurrent::TaskPriority::kHigh;
+    }
+    else if (priority == "normal")
+    {
+        task_priority = concurrent::TaskPriority::kNormal;
+    }
+    else if (priority == "low")
+    {
+        task_priority = concurrent::TaskPriority::kLow;
+    }
+    else
+    {
+        throw std::invalid_argument(
+            fmt::format("priority should be one of 'high', 'normal' or 'low' but '{}' is used.", priority));
+    }
+    concurrent::TaskDeadline deadline = concurrent::kNoTaskDeadline;
+    if (timeout)
+    {
+        deadline = std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::duration<double>(std::max(0.0, *timeout)));
+    }
+
+    const cucim::DimIndices indices = py_dim_indices(kwargs);
+    return std::make_shared<RegionFuture>(
+        cuimg, std::move(location), std::move(size), level, indices, device, dims, task_priority, deadline);
+}
+
 py::object py_associated_image(const CuImage& cuimg, const std::string& name, const io::Device& device)
 {
     auto image_ptr = std::make_shared<cucim::CuImage>(cuimg.associated_image(name, device));
@@ -564,6 +866,114 @@ py::object py_associated_image(const CuImage& cuimg, const std::string& name, co
     }
 }
 
+namespace
+{
+
+loader::GridSampler py_grid_sampler(const CuImage& cuimg,
+                                    std::vector<int64_t>&& size,
+                                    uint16_t level,
+                                    const py::object& stride,
+                                    const py::object& tissue_mask,
+                                    float min_tissue_fraction)
+{
+    std::vector<int64_t> grid_stride;
+    std::shared_ptr<const loader::TissueMask> mask;
+    bool use_otsu = false;
+    {
+        py::gil_scoped_acquire scope_guard;
+
+        if (!stride.is_none())
+        {
+            grid_stride = py::cast<std::vector<int64_t>>(stride);
+        }
+        if (py::isinstance<py::str>(tissue_mask))
+        {
+            const auto method = py::cast<std::string>(tissue_mask);
+            if (method != "otsu")
+            {
+                throw std::invalid_argument(
+                    fmt::format("tissue_mask should be None, 'otsu' or an array but '{}' is used.", method));
+            }
+            use_otsu = true;
+        }
+        else if (!tissue_mask.is_none())
+        {
+            auto mask_array = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>::ensure(tissue_mask);
+            if (!mask_array || mask_array.ndim() != 2)
+            {
+                throw std::invalid_argument("tissue_mask should be a 2D array!");
+            }
+            const uint8_t* mask_data = mask_array.data();
+            std::vector<uint8_t> data(mask_data, mask_data + mask_array.size());
+            const auto width = static_cast<uint32_t>(mask_array.shape(1));
+            const auto height = static_cast<uint32_t>(mask_array.shape(0));
+            mask = std::make_shared<loader::TissueMask>(std::move(data), width, height);
+        }
+    }
+    if (use_otsu)
+    {
+        mask = loader::TissueMask::from_image(cuimg);
+    }
+    return loader::GridSampler(cuimg, std::move(size), level, std::move(grid_stride), std::move(mask),
+                               min_tissue_fraction);
+}
+
+} // namespace
+
+py::object py_tissue_mask(const CuImage& cuimg)
+{
+    auto mask = loader::TissueMask::from_image(cuimg);
+
+    py::gil_scoped_acquire scope_guard;
+    py::array_t<uint8_t> mask_array(
+        { static_cast<py::ssize_t>(mask->height()), static_cast<py::ssize_t>(mask->width()) });
+    std::memcpy(mask_array.mutable_data(), mask->data().data(), mask->data().size());
+    return mask_array;
+}
+
+py::object py_grid_locations(const CuImage& cuimg,
+                             std::vector<int64_t>&& size,
+                             uint16_t level,
+                             const py::object& stride,
+                             const py::object& tissue_mask,
+                             float min_tissue_fraction)
+{
+    auto sampler = py_grid_sampler(cuimg, std::move(size), level, stride, tissue_mask, min_tissue_fraction);
+    std::vector<int64_t> locations = sampler.locations();
+
+    py::gil_scoped_acquire scope_guard;
+    py::array_t<int64_t> location_array(
+        { static_cast<py::ssize_t>(locations.size() / 2), static_cast<py::ssize_t>(2) });
+    if (!locations.empty())
+    {
+        std::memcpy(location_array.mutable_data(), locations.data(), locations.size() * sizeof(int64_t));
+    }
+    return location_array;
+}
+
+py::object py_read_grid(const CuImage& cuimg,
+                        std::vector<int64_t>&& size,
+                        uint16_t level,
+                        const py::object& stride,
+                        const py::object& tissue_mask,
+                        float min_tissue_fraction,
+                        uint32_t num_workers,
+                        uint32_t batch_size,
+                        bool drop_last,
+                        uint32_t prefetch_factor,
+                        bool shuffle,
+                        uint64_t seed,
+                        const io::Device& device)
+{
+    auto sampler = py_grid_sampler(cuimg, std::move(size), level, stride, tissue_mask, min_tissue_fraction);
+    auto region_ptr = std::make_shared<cucim::CuImage>(
+        cuimg.read_grid(sampler, num_workers, batch_size, drop_last, prefetch_factor, shuffle, seed, device));
+    auto iter_ptr = std::make_shared<CuImageIterator<CuImage>>(region_ptr->shared_from_this());
+
+    py::gil_scoped_acquire scope_guard;
+    return py::cast(iter_ptr, py::return_value_policy::take_ownership);
+}
+
 py::object py_cuimage_iterator_next(CuImageIterator<CuImage>& it)
 {
     bool stop_iteration = (it.index() == it.size());
@@ -591,6 +1001,65 @@ py::object py_cuimage_iterator_next(CuImageIterator<CuImage>& it)
     }
 }
 
+py::object py_dataset_loader_read(const loader::DatasetLoader& dataset_loader,
+                                  const py::iterable& samples,
+                                  std::vector<int64_t>&& size,
+                                  uint32_t batch_size,
+                                  uint32_t num_workers,
+                                  bool drop_last,
+                                  uint32_t prefetch_factor,
+                                  bool shuffle,
+                                  uint64_t seed,
+                                  const io::Device& device)
+{
+    std::vector<loader::DatasetSample> dataset_samples;
+    {
+        py::gil_scoped_acquire scope_guard;
+
+        // A file is specified by its index in `paths` or by its path.
+        std::unordered_map<std::string, uint32_t> file_indices;
+        const auto& paths = dataset_loader.paths();
+        for (uint32_t i = 0; i < paths.size(); ++i)
+        {
+            file_indices.emplace(paths[i], i);
+        }
+        for (auto item : samples)
+        {
+            auto sample = py::cast<py::sequence>(item);
+            if (sample.size() != 4)
+            {
+                throw std::invalid_argument("Each sample should be a (file, level, x, y) tuple!");
+            }
+            loader::DatasetSample dataset_sample;
+            if (py::isinstance<py::str>(sample[0]))
+            {
+                const auto path = py::cast<std::string>(sample[0]);
+                auto it = file_indices.find(path);
+                if (it == file_indices.end())
+                {
+                    throw std::invalid_argument(fmt::format("File '{}' is not in the dataset!", path));
+                }
+                dataset_sample.file_index = it->second;
+            }
+            else
+            {
+                dataset_sample.file_index = py::cast<uint32_t>(sample[0]);
+            }
+            dataset_sample.level = py::cast<uint16_t>(sample[1]);
+            dataset_sample.x = py::cast<int64_t>(sample[2]);
+            dataset_sample.y = py::cast<int64_t>(sample[3]);
+            dataset_samples.emplace_back(dataset_sample);
+        }
+    }
+
+    auto image_ptr = dataset_loader.read(std::move(dataset_samples), size, batch_size, num_workers, drop_last,
+                                         prefetch_factor, shuffle, seed, device);
+    auto iter_ptr = std::make_shared<CuImageIterator<CuImage>>(image_ptr);
+
+    py::gil_scoped_acquire scope_guard;
+    return py::cast(iter_ptr, py::return_value_policy::take_ownership);
+}
+
 void _set_array_interface(const py::object& cuimg_obj)
 {
     const auto& cuimg = cuimg_obj.cast<const CuImage&>();
@@ -1,13 +1,17 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #ifndef PYCUCIM_CUIMAGE_PY_H
 #define PYCUCIM_CUIMAGE_PY_H
 
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include <cucim/concurrent/threadpool.h>
 #include <nlohmann/json.hpp>
 #include <pybind11_json/pybind11_json.hpp>
 
@@ -20,6 +24,7 @@ namespace cucim
 class CuImage;
 template <typename DataType = CuImage>
 class CuImageIterator;
+class DimIndices;
 namespace io
 {
 class Device;
@@ -32,6 +37,45 @@ namespace profiler
 {
 class Profiler;
 }
+namespace loader
+{
+class DatasetLoader;
+}
+
+/**
+ * A pending result of CuImage::read_region_async() for Python.
+ *
+ * Its eventfd (fileno()) becomes readable once the result is ready, so an event loop (e.g., asyncio) can wait for
+ * many reads without a thread per read.
+ */
+class RegionFuture
+{
+public:
+    RegionFuture(const CuImage& cuimg,
+                 std::vector<int64_t>&& location,
+                 std::vector<int64_t>&& size,
+                 uint16_t level,
+                 const DimIndices& indices,
+                 const io::Device& device,
+                 const std::string& dims,
+                 concurrent::TaskPriority priority,
+                 concurrent::TaskDeadline deadline);
+    RegionFuture(const RegionFuture&) = delete;
+    RegionFuture& operator=(const RegionFuture&) = delete;
+
+    int fileno() const;
+    bool done() const;
+    /**
+     * Wait for (with the GIL released) and return the region, or raise the error of the read.
+     */
+    py::object result();
+
+private:
+    struct State;
+    // Shared with the read task, which signals the eventfd even if this object is gone.
+    std::shared_ptr<State> state_;
+    py::object result_;
+};
 
 std::string get_plugin_root();
 void set_plugin_root(std::string path);
@@ -70,11 +114,54 @@ py::object py_read_region(const CuImage& cuimg,
                           const io::Device& device,
                           const py::object& buf,
                           const std::string& shm_name,
+                          const std::string& dims,
+                          std::optional<float> downsample,
+                          std::optional<float> mpp,
                           const py::kwargs& kwargs);
+std::shared_ptr<RegionFuture> py_read_region_async(const CuImage& cuimg,
+                                                   std::vector<int64_t>&& location,
+                                                   std::vector<int64_t>&& size,
+                                                   uint16_t level,
+                                                   const io::Device& device,
+                                                   const std::string& dims,
+                                                   const std::string& priority,
+                                                   std::optional<double> timeout,
+                                                   const py::kwargs& kwargs);
 py::object py_associated_image(const CuImage& cuimg, const std::string& name, const io::Device& device);
+py::object py_tissue_mask(const CuImage& cuimg);
+py::object py_grid_locations(const CuImage& cuimg,
+                             std::vector<int64_t>&& size,
+                             uint16_t level,
+                             const py::object& stride,
+                             const py::object& tissue_mask,
+                             float min_tissue_fraction);
+py::object py_read_grid(const CuImage& cuimg,
+                        std::vector<int64_t>&& size,
+                        uint16_t level,
+                        const py::object& stride,
+                        const py::object& tissue_mask,
+                        float min_tissue_fraction,
+                        uint32_t num_workers,
+                        uint32_t batch_size,
+                        bool drop_last,
+                        uint32_t prefetch_factor,
+                        bool shuffle,
+                        uint64_t seed,
+                        const io::Device& device);
 
 py::object py_cuimage_iterator_next(CuImageIterator<CuImage>& it);
 
+py::object py_dataset_loader_read(const loader::DatasetLoader& dataset_loader,
+                                  const py::iterable& samples,
+                                  std::vector<int64_t>&& size,
+                                  uint32_t batch_size,
+                                  uint32_t num_workers,
+                                  bool drop_last,
+                                  uint32_t prefetch_factor,
+                                  bool shuffle,
+                                  uint64_t seed,
+                                  const io::Device& device);
+
 void _set_array_interface(const py::object& cuimg_obj);
 } // namespace cucim
 
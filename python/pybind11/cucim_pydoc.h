@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021, NVIDIA CORPORATION.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026, NVIDIA CORPORATION.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -45,6 +45,10 @@ namespace CuImage
 // CuImage(const filesystem::Path& path);
 PYDOC(CuImage, R"doc(
 Constructor of CuImage.
+
+Args:
+    path: Path of the image file, or URL (`http://...`) of a remote file (e.g., an object of an S3-compatible object
+        store). A remote file is read with HTTP range requests: only the bytes needed are fetched (and cached).
 )doc")
 
 // CuImage(const filesystem::Path& path, const std::string& plugin_name);
@@ -194,7 +198,8 @@ Returns a dict that includes resolution information.
 //                     DimIndices region_dim_indices={},
 //                     io::Device device="cpu",
 //                     DLTensor* buf=nullptr,
-//                     std::string shm_name="");
+//                     std::string shm_name="",
+//                     std::string dims="");
 PYDOC(read_region, R"doc(
 Returns a subresolution image.
 
@@ -204,13 +209,65 @@ Returns a subresolution image.
 - Like OpenSlide, location is level-0 based coordinates (using the level-0 reference frame)
 - If `size` is not specified, size would be (width, height) of the image at the specified `level`.
 - `<not supported yet>` Additional parameters (S,T,C,Z) are similar to <https://allencellmodeling.github.io/aicsimageio/aicsimageio.html#aicsimageio.aics_image.AICSImage.get_image_data>
-- Do not yet support indices/ranges for (S,T,C,Z).
+- Do not yet support indices/ranges for (S,T,Z).
 - Default value for level, S, T, Z are zero.
-- Default value for C is -1 (whole channels)
+- Default value for C is -1 (whole channels). For planar-separate TIFF images, `C=<index>` reads a single channel
+  without decoding the other channel planes.
+- `dims` is the dimension order of the output: `'YXC'` (default) or `'CYX'`. `'CYX'` is supported for planar-separate
+  TIFF images and returns the channel planes without a transpose.
 - `<not supported yet>` `device` could be one of the following strings or Device object: e.g., `'cpu'`, `'cuda'`, `'cuda:0'` (use index 0), `cucim.clara.io.Device(cucim.clara.io.CUDA,0)`.
 - `<not supported yet>` If `buf` is specified (buf's type can be either numpy object that implements `__array_interface__`, or cupy-compatible object that implements `__cuda_array_interface__`), the read image would be saved into buf object without creating CPU/GPU memory.
 - `<not supported yet>` If `shm_name` is specified, shared memory would be created and data would be read in the shared memory.
+- If `downsample` (relative to level 0) or `mpp` (micrometers per pixel) is specified instead of `level`, `size` is
+  the output size at that resolution. The finest level needed is read in bands that are area-averaged into the
+  output as they are read, so the larger region at that level is never in memory at once. Only a single 8-bit region
+  in the `'YXC'` order is supported.
+
+)doc")
+
+// std::future<CuImage> read_region_async(std::vector<int64_t>&& location, ...) const;
+PYDOC(read_region_async, R"doc(
+Reads a region asynchronously and returns a `RegionFuture`.
+
+- The arguments are the same as `read_region()` for a single region (`location` is one (X, Y) pair). Only `'cpu'`
+  device is supported.
+- The region is read by the process-wide thread pool, so many reads can be in flight without a thread per read.
+- The returned future can be awaited in a coroutine (`region = await img.read_region_async(...)`) or waited for
+  with `result()`.
+- `priority` (`'high'` (default), `'normal'` or `'low'`) orders the read among queued decode work. Batch loaders
+  queue their work with `'low'` priority, so interactive reads don't wait behind prefetching.
+- If `timeout` (in seconds) is given and the read can't start in time, it is dropped and the future raises
+  `TaskExpiredError` (a `TimeoutError`).
+)doc")
+
+// std::shared_ptr<loader::TissueMask> loader::TissueMask::from_image(const CuImage& image);
+PYDOC(tissue_mask, R"doc(
+Returns the tissue mask of the image as a 2D uint8 array (1 for tissue) covering the whole image.
+
+The mask is computed from the lowest-resolution level: a pixel is tissue if its saturation (of HSV) is above the Otsu
+threshold of the saturation histogram, which separates stained tissue from the (white or gray) glass background.
+)doc")
+
+// std::vector<int64_t> loader::GridSampler::locations() const;
+PYDOC(grid_locations, R"doc(
+Returns the locations of the patches on a regular grid over a level of the image, as an (N, 2) int64 array.
+
+- Patches of `size` (width, height) are placed every `stride` (default: `size`) pixels from the top-left corner of
+  `level`, covering the whole level. A `stride` smaller than `size` makes patches overlap.
+- Locations are level-0 (X, Y) coordinates, as expected by `read_region()`, in row-major grid order.
+- `tissue_mask` is None (keep all patches), `'otsu'` (use `tissue_mask()`) or a 2D array covering the whole image
+  where nonzero values mark tissue. Patches whose tissue fraction is below `min_tissue_fraction` are dropped.
+)doc")
+
+// CuImage read_grid(const loader::GridSampler& sampler, ...) const;
+PYDOC(read_grid, R"doc(
+Returns an iterator over batches of the patches of `grid_locations()`.
+
+This is the same as `read_region(grid_locations(...), size, level, ...)` but the grid locations are generated
+natively, so no Python list of locations is built. The order of patches (without shuffling) is the order of
+`grid_locations()` with the same arguments.
 
+Raises ValueError if no patch is kept by the tissue mask.
 )doc")
 
 // std::set<std::string> associated_images() const;
@@ -226,11 +283,45 @@ PYDOC(associated_image, R"doc(
 Returns an associated image for the given name, as a CuImage object.
 )doc")
 
-// void save(std::string file_path) const;
+// void save(std::string file_path, const std::string& format, int32_t quality) const;
 PYDOC(save, R"doc(
 Saves image data to the file path.
 
-Currently it supports only .ppm file format that can be viewed by `eog` command in Ubuntu.
+The file format is `format` ('ppm', 'png', 'jpeg' or 'tiff'), or is chosen by the extension of the file path
+('.ppm', '.png', '.jpg', '.jpeg', '.tif' or '.tiff'; other extensions are saved as PPM files).
+PPM (PGM for grayscale images), PNG (grayscale, RGB or RGBA), JPEG (grayscale or RGB, with `quality`) and TIFF
+(tiled, deflate-compressed) files are supported. The image is written in bulk, and large images are encoded in
+parallel (in strips or tiles). If the image is not loaded in memory, level 0 of the file is read.
+Only 8-bit images are supported.
+)doc")
+
+// void save_pyramid(const std::string& file_path, uint32_t tile_size, const std::string& compression, ...) const;
+PYDOC(save_pyramid, R"doc(
+Writes the image as a tiled, pyramidal (BigTIFF) file.
+
+The whole image (level 0), or the image data of a loaded region, is streamed band by band, so the image doesn't need
+to fit in memory. Tiles of `tile_size` pixels (a multiple of 16) are encoded in parallel with `compression` ('jpeg',
+'deflate', 'zstd' or 'raw'; 'jpeg' uses `quality` and needs RGB pixels). Each level is the 2x2 average of the
+previous one, and levels are added until a level fits in a tile unless `level_count` is given.
+Only 8-bit images are supported.
+
+With `copy_tiles` (and 'jpeg' compression), the JPEG tiles of the levels of a TIFF file are copied without being
+decoded (keeping their tile size), and only the levels below them are computed, so converting a JPEG-compressed slide
+takes little more than copying the file.
+)doc")
+
+// void save_zarr(const std::string& dir_path, const std::string& compression, uint16_t level_count, ...) const;
+PYDOC(save_zarr, R"doc(
+Writes the levels of the image as an OME-Zarr directory (an OME-NGFF 0.4 multiscale image in the Zarr v2 format).
+
+Each level of the file (or the image data of a loaded region) becomes an array ('0', '1', ...) of uint8 values in the
+'cyx' order ('yx' for single-channel images), with the scale of the level (in micrometers if the spacing is known)
+in the 'multiscales' metadata. Chunks are the tiles of each level, so that each tile is decoded once, or
+`chunk_size` x `chunk_size` pixels if `chunk_size` is given or the level is not tiled (256 by default).
+Chunks are compressed with `compression` ('zstd' or 'raw') and written in parallel.
+`level_count` limits the number of levels written (0: all levels).
+
+`path` must end with '.zarr' and must not exist. Only 8-bit images are supported.
 )doc")
 
 // void close();
@@ -263,8 +354,92 @@ PYDOC(CuImageIterator, R"doc(
 Constructor of CuImageIterator.
 )doc")
 
+PYDOC(cancel, R"doc(
+Stops loading the remaining batches without waiting for the tasks that are running.
+
+Queued tile loads return without decoding and the iteration ends.
+)doc")
+
+PYDOC(close, R"doc(
+Stops loading the remaining batches, waits for the tasks that are running and releases prefetched batch buffers.
+
+The iteration ends. The batch returned last stays valid.
+)doc")
+
+PYDOC(loader_stats, R"doc(
+Statistics of the batch data loader as a dict, or None if the image is not loaded by a loader.
+
+`prefetch_factor` is the current number of batches loaded ahead (adjusted between `concurrency.min_prefetch_factor`
+and `concurrency.max_prefetch_factor` if `concurrency.adaptive_prefetch` is enabled), `peak_prefetch_factor` the
+largest one used, `batch_count` the number of batches returned, `stall_count`/`stall_time_ns` the number of
+batches that were not ready yet and the total time spent waiting for them, and `readahead_count`/`readahead_bytes`
+the number of locations whose tiles were hinted to the file ahead of their loading (see
+`concurrency.readahead_batches`) and the number of bytes hinted.
+)doc")
+
 } // namespace CuImageIterator
 
+namespace RegionFuture
+{
+
+// int fileno() const;
+PYDOC(fileno, R"doc(
+Returns an eventfd file descriptor that becomes readable once the result is ready.
+
+It can be registered in an event loop (e.g., `loop.add_reader()`). The descriptor is owned by the future.
+)doc")
+
+// bool done() const;
+PYDOC(done, R"doc(
+Returns True if the read is finished (successfully or not).
+)doc")
+
+// py::object result();
+PYDOC(result, R"doc(
+Waits for the read to finish and returns the region (a CuImage object), or raises the error of the read.
+)doc")
+
+PYDOC(__await__, R"doc(
+Waits for the read in an asyncio event loop (without blocking the loop) and returns the region.
+)doc")
+
+} // namespace RegionFuture
+
+namespace DatasetLoader
+{
+
+// DatasetLoader(std::vector<std::string> paths, uint32_t max_open_files = kDefaultDatasetMaxOpenFiles);
+PYDOC(DatasetLoader, R"doc(
+Constructor of DatasetLoader, which reads batches of patches from many image files.
+
+Files are opened on demand and at most `max_open_files` files are kept open (the least recently used file is closed
+first). Patches of different files can be mixed in a batch.
+)doc")
+
+PYDOC(paths, R"doc(
+Paths of the image files of the dataset.
+)doc")
+
+PYDOC(max_open_files, R"doc(
+The maximum number of files kept open.
+)doc")
+
+PYDOC(open_file_count, R"doc(
+The number of files currently kept open.
+)doc")
+
+PYDOC(read, R"doc(
+Returns an iterator over batches of patches.
+
+- `samples` is an iterable of `(file, level, x, y)` tuples. `file` is an index in `paths` or a path in `paths`, and
+  `(x, y)` is the level-0 based location of the patch, as in `CuImage.read_region()`.
+- `size` is the (width, height) of every patch. Every patch should have the same number of channels and data type.
+- Batches have the shape `(N, height, width, C)` (`(height, width, C)` if `batch_size` is 1).
+- `num_workers` should be at least 1. Patches are read by the process-wide thread pool and use the tile cache.
+)doc")
+
+} // namespace DatasetLoader
+
 } // namespace cucim::doc
 
 #endif // PYCUCIM_CUCIM_PYDOC_H